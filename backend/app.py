@@ -2,7 +2,7 @@ import logging
 from flask import Flask
 from flask_cors import CORS
 from config import get_config
-from services.server_c_client import ServerCClient
+from services.server_c_pool import ServerCPool
 from services.frontend_client import FrontEndClient
 from routes.api import api_bp
 
@@ -46,10 +46,12 @@ def create_app(config_name='default'):
     # Configurar CORS
     CORS(app, origins=app.config['CORS_ORIGINS'])
     
-    # Inicializar cliente del Servidor C
-    app.server_c_client = ServerCClient(
-        base_url=app.config['SERVER_C_BASE'],
-        default_timeout=app.config['SERVER_C_TIMEOUT']
+    # Inicializar el pool de Servidores C (misma interfaz que un solo cliente)
+    app.server_c_client = ServerCPool(
+        base_urls=app.config['SERVER_C_NODES'],
+        default_timeout=app.config['SERVER_C_TIMEOUT'],
+        health_timeout=app.config['SERVER_C_HEALTH_TIMEOUT'],
+        health_interval=app.config['SERVER_C_HEALTH_INTERVAL']
     )
     
     # Inicializar cliente del Frontend
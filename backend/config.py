@@ -15,6 +15,9 @@ class Config:
     SERVER_C_BASE = os.getenv('SERVER_C_BASE', 'http://192.168.18.40:8080')
     SERVER_C_TIMEOUT = int(os.getenv('SERVER_C_TIMEOUT', '30'))
     SERVER_C_HEALTH_TIMEOUT = int(os.getenv('SERVER_C_HEALTH_TIMEOUT', '2'))
+    # Pool de servidores C (separar con comas); vacío = solo SERVER_C_BASE
+    SERVER_C_NODES = [url for url in os.getenv('SERVER_C_NODES', '').split(',') if url.strip()] or [SERVER_C_BASE]
+    SERVER_C_HEALTH_INTERVAL = int(os.getenv('SERVER_C_HEALTH_INTERVAL', '10'))
     
     # Logging
     LOG_LEVEL = os.getenv('LOG_LEVEL', 'INFO')
@@ -65,6 +65,19 @@ def rerun_algorithm():
     data, status_code = client.rerun_algorithm(request)
     return jsonify(data), status_code
 
+@api_bp.route('/estimations/rerun/batch', methods=['POST'])
+def rerun_batch():
+    """Re-ejecuta varios algoritmos repartidos entre los servidores C"""
+    client = current_app.frontend_client
+    data, status_code = client.rerun_batch(request)
+    return jsonify(data), status_code
+
+@api_bp.route('/servers/c/nodes', methods=['GET'])
+def server_c_nodes():
+    """Estado y rendimiento de cada servidor C del pool"""
+    client = current_app.server_c_client
+    return jsonify(client.stats()), 200
+
 # @api_bp.route('/estimations/rerun', methods=['POST'])
 # def rerun_algorithm():
 #     """Endpoint para re-ejecutar un algoritmo específico"""
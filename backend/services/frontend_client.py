@@ -67,12 +67,7 @@ class FrontEndClient:
             result_data, result_status = server_c_client.run_algorithm(algorithm_name)
             
             # Actualizar la base de datos con el nuevo resultado
-            if result_status == 200:
-                success = update_estimation_after_rerun(algorithm_name, result_data)
-                if success:
-                    logger.info(f"Base de datos actualizada para {algorithm_name}")
-                else:
-                    logger.warning(f"No se pudo actualizar la base de datos para {algorithm_name}")
+            self._store_rerun(algorithm_name, result_data, result_status)
             
             return {
                 'algorithmName': algorithm_name,
@@ -85,6 +80,65 @@ class FrontEndClient:
                 'error': 'Error processing request',
                 'details': str(e)
             }, 500
+
+    def rerun_batch(self, request) -> Tuple[Dict[str, Any], int]:
+        """
+        Re-ejecuta varios algoritmos repartidos entre los servidores C y
+        actualiza la base de datos con cada resultado exitoso
+        
+        Args:
+            request: Objeto request de Flask con {"algorithmNames": [...]}
+            
+        Returns:
+            Tuple[Dict, int]: (response_data, status_code); 200 si todos
+            terminaron bien, 207 si solo algunos
+        """
+        try:
+            data = request.get_json(silent=True)
+            names = data.get('algorithmNames') if isinstance(data, dict) else None
+            
+            if not isinstance(names, list) or not names or not all(isinstance(n, str) for n in names):
+                return {
+                    'error': 'algorithmNames must be a non-empty list of names'
+                }, 400
+            
+            server_c_client = current_app.server_c_client
+            results = server_c_client.run_batch(names)
+            
+            # SQLite desde un solo hilo: los resultados se guardan al final
+            for name, (result_data, result_status) in zip(names, results):
+                self._store_rerun(name, result_data, result_status)
+            
+            succeeded = sum(1 for _, status in results if status == 200)
+            return {
+                'results': [
+                    {
+                        'algorithmName': name,
+                        'status': result_status,
+                        'result': result_data
+                    }
+                    for name, (result_data, result_status) in zip(names, results)
+                ],
+                'succeeded': succeeded,
+                'failed': len(names) - succeeded
+            }, 200 if succeeded == len(names) else 207
+            
+        except Exception as e:
+            logger.exception("Error processing batch rerun request")
+            return {
+                'error': 'Error processing request',
+                'details': str(e)
+            }, 500
+
+    def _store_rerun(self, algorithm_name: str, result_data: Dict[str, Any], result_status: int):
+        """Guarda en la base de datos el resultado de una re-ejecución exitosa"""
+        if result_status != 200:
+            return
+        success = update_estimation_after_rerun(algorithm_name, result_data)
+        if success:
+            logger.info(f"Base de datos actualizada para {algorithm_name}")
+        else:
+            logger.warning(f"No se pudo actualizar la base de datos para {algorithm_name}")
         
     def get_algorithms_info(self) -> Tuple[Dict[str, Any], int]:
         """
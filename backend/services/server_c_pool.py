@@ -0,0 +1,214 @@
+import time
+import logging
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from typing import Dict, Tuple, List, Any, Optional
+from services.server_c_client import ServerCClient
+
+logger = logging.getLogger(__name__)
+
+
+class ServerCNode:
+    """Estado de un servidor C dentro del pool"""
+    def __init__(self, base_url: str, default_timeout: int = 30):
+        self.client = ServerCClient(base_url, default_timeout)
+        self.base_url = self.client.base_url
+        self.healthy = True          # optimista hasta el primer fallo
+        self.last_check = 0.0        # time.monotonic() del último health check
+        self.last_error: Optional[str] = None
+        self.in_flight = 0
+        self.completed = 0
+        self.failed = 0
+        self.timeouts = 0
+        self.busy_seconds = 0.0
+
+    def mean_seconds(self) -> Optional[float]:
+        """Duración media de una ejecución exitosa, si hay historial"""
+        return self.busy_seconds / self.completed if self.completed else None
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            'base_url': self.base_url,
+            'healthy': self.healthy,
+            'in_flight': self.in_flight,
+            'completed': self.completed,
+            'failed': self.failed,
+            'timeouts': self.timeouts,
+            'busy_seconds': round(self.busy_seconds, 6),
+            'runs_per_second': round(self.completed / self.busy_seconds, 6) if self.busy_seconds > 0 else None,
+            'last_error': self.last_error
+        }
+
+
+class ServerCPool:
+    """
+    Pool de servidores C con la misma interfaz que ServerCClient.
+
+    Cada ejecución va al nodo sano con menos ejecuciones en curso y, a
+    igualdad, al de menor duración media. Un nodo que falla se marca como
+    caído y la ejecución se reintenta en otro; los nodos caídos se vuelven
+    a comprobar con /api/health cada `health_interval` segundos.
+
+    Un timeout (504) no cuenta como caída: el servidor C atiende de una en
+    una, así que una ejecución larga lo deja lento, no muerto. Se devuelve
+    tal cual, sin marcar el nodo ni reintentar en otro, para que un trabajo
+    lento no vaya sacando nodos de la rotación uno tras otro.
+    """
+    RETRY_STATUS_CODES = (500, 502, 503)
+    TIMEOUT_STATUS_CODE = 504
+
+    def __init__(self, base_urls: List[str], default_timeout: int = 30,
+                 health_timeout: int = 2, health_interval: int = 10):
+        urls = [url.strip() for url in base_urls if url and url.strip()]
+        if not urls:
+            raise ValueError('Se necesita al menos un servidor C')
+        self.nodes = [ServerCNode(url, default_timeout) for url in urls]
+        self.default_timeout = default_timeout
+        self.health_timeout = health_timeout
+        self.health_interval = health_interval
+        self.lock = threading.Lock()
+
+    # ---------- Membresía ----------
+
+    def _check_node(self, node: ServerCNode, timeout: int) -> Tuple[Dict, int]:
+        data, status_code = node.client.health_check(timeout=timeout)
+        with self.lock:
+            node.healthy = status_code == 200
+            node.last_check = time.monotonic()
+            node.last_error = None if node.healthy else data.get('error', data.get('server_c_status'))
+        return data, status_code
+
+    def refresh_health(self) -> int:
+        """Vuelve a comprobar los nodos caídos cuyo intervalo venció; devuelve los nodos sanos"""
+        now = time.monotonic()
+        for node in self.nodes:
+            if not node.healthy and now - node.last_check >= self.health_interval:
+                self._check_node(node, self.health_timeout)
+        return sum(1 for node in self.nodes if node.healthy)
+
+    def health_check(self, timeout: int = 2) -> Tuple[Dict, int]:
+        """
+        Verifica todos los servidores C
+
+        Returns:
+            Tuple[Dict, int]: (response_data, status_code); 200 si al menos
+            un nodo responde, si no el código del primer nodo
+        """
+        nodes = []
+        first_error = None
+        healthy = 0
+        for node in self.nodes:
+            data, status_code = self._check_node(node, timeout)
+            if status_code == 200:
+                healthy += 1
+            elif first_error is None:
+                first_error = (data, status_code)
+            nodes.append({'base_url': node.base_url, **data})
+
+        # Contado con estas respuestas, no con node.healthy: otras
+        # ejecuciones pueden cambiarlo mientras tanto
+        if healthy == 0:
+            data, status_code = first_error
+            return {**data, 'healthy_nodes': 0, 'nodes': nodes}, status_code
+        return {
+            'server_c_status': 'ok',
+            'healthy_nodes': healthy,
+            'nodes': nodes
+        }, 200
+
+    # ---------- Despacho ----------
+
+    def _acquire_node(self, exclude: List[ServerCNode]) -> Optional[ServerCNode]:
+        """Reserva el nodo sano menos cargado que no esté en `exclude`"""
+        with self.lock:
+            candidates = [node for node in self.nodes if node.healthy and node not in exclude]
+            if not candidates:
+                return None
+            # Sin historial, un nodo cuenta como la media de los demás
+            known = [node.mean_seconds() for node in self.nodes if node.completed]
+            default_seconds = sum(known) / len(known) if known else 0.0
+
+            def load(node: ServerCNode) -> Tuple[int, float]:
+                mean = node.mean_seconds()
+                return (node.in_flight, mean if mean is not None else default_seconds)
+
+            node = min(candidates, key=load)
+            node.in_flight += 1
+            return node
+
+    def _release_node(self, node: ServerCNode, seconds: float, ok: bool, error: Optional[str],
+                      timed_out: bool = False):
+        with self.lock:
+            node.in_flight -= 1
+            if ok:
+                node.completed += 1
+                node.busy_seconds += seconds
+            elif timed_out:
+                # Ocupado, no caído: sigue en la rotación
+                node.timeouts += 1
+                node.last_error = error
+            else:
+                node.failed += 1
+                node.healthy = False
+                node.last_check = time.monotonic()
+                node.last_error = error
+
+    def run_algorithm(self, algorithm: str) -> Tuple[Dict, int]:
+        """
+        Ejecuta un algoritmo en el nodo menos cargado, reintentando en otro
+        nodo si falla
+
+        Returns:
+            Tuple[Dict, int]: (response_data, status_code); la respuesta
+            incluye 'node' con el servidor que la produjo
+        """
+        self.refresh_health()
+        tried: List[ServerCNode] = []
+        result = None
+        while len(tried) < len(self.nodes):
+            node = self._acquire_node(tried)
+            if node is None:
+                break
+            tried.append(node)
+            start = time.monotonic()
+            data, status_code = node.client.run_algorithm(algorithm)
+            failed = status_code in self.RETRY_STATUS_CODES
+            timed_out = status_code == self.TIMEOUT_STATUS_CODE
+            self._release_node(node, time.monotonic() - start, not failed and not timed_out,
+                               data.get('error') if failed or timed_out else None, timed_out)
+            result = ({**data, 'node': node.base_url}, status_code)
+            if not failed:
+                return result
+            logger.warning(f"Nodo {node.base_url} falló con {algorithm} ({status_code}), reintentando")
+
+        if result is not None:
+            return result
+        return {
+            'error': 'Ningún servidor C disponible',
+            'algorithm': algorithm
+        }, 503
+
+    def run_batch(self, algorithms: List[str]) -> List[Tuple[Dict, int]]:
+        """Ejecuta varios algoritmos en paralelo, uno por nodo sano a la vez; resultados en orden"""
+        if not algorithms:
+            return []
+        workers = max(1, min(len(algorithms), self.refresh_health()))
+        with ThreadPoolExecutor(max_workers=workers) as executor:
+            return list(executor.map(self.run_algorithm, algorithms))
+
+    def stats(self) -> Dict[str, Any]:
+        """Estado y rendimiento por nodo"""
+        with self.lock:
+            nodes = [node.to_dict() for node in self.nodes]
+        return {
+            'nodes': nodes,
+            'healthy_nodes': sum(1 for node in nodes if node['healthy']),
+            'completed': sum(node['completed'] for node in nodes),
+            'failed': sum(node['failed'] for node in nodes),
+            'timeouts': sum(node['timeouts'] for node in nodes)
+        }
+
+    def close(self):
+        """Cierra las sesiones de todos los nodos"""
+        for node in self.nodes:
+            node.client.close()
@@ -329,6 +329,57 @@ class TestServerCHealthEndpoint:
         app.server_c_client.health_check.assert_called_once_with(timeout=5)
 
 
+class TestServerCPoolEndpoints:
+    """Tests for /api/v1/servers/c/nodes and /api/v1/estimations/rerun/batch"""
+    
+    def test_server_c_nodes(self, app, client):
+        """Test per-node stats from the pool"""
+        # Arrange
+        mock_stats = {
+            "nodes": [{"base_url": "http://a:8080", "healthy": True, "completed": 3}],
+            "healthy_nodes": 1,
+            "completed": 3,
+            "failed": 0
+        }
+        app.server_c_client.stats.return_value = mock_stats
+        
+        # Act
+        response = client.get('/api/v1/servers/c/nodes')
+        
+        # Assert
+        assert response.status_code == 200
+        assert response.get_json() == mock_stats
+    
+    def test_rerun_batch(self, app, client):
+        """Test that batch reruns are passed to the frontend client"""
+        # Arrange
+        mock_data = {"results": [], "succeeded": 2, "failed": 0}
+        app.frontend_client.rerun_batch.return_value = (mock_data, 200)
+        
+        # Act
+        response = client.post('/api/v1/estimations/rerun/batch',
+                               json={"algorithmNames": ["leibniz", "euler"]})
+        
+        # Assert
+        assert response.status_code == 200
+        assert response.get_json()['succeeded'] == 2
+        app.frontend_client.rerun_batch.assert_called_once()
+    
+    def test_rerun_batch_partial_failure(self, app, client):
+        """Test that a partly failed batch keeps its 207"""
+        app.frontend_client.rerun_batch.return_value = ({"succeeded": 1, "failed": 1}, 207)
+        
+        response = client.post('/api/v1/estimations/rerun/batch', json={"algorithmNames": ["a", "b"]})
+        
+        assert response.status_code == 207
+    
+    def test_rerun_batch_only_accepts_post(self, client):
+        """Test that GET is not allowed for batch reruns"""
+        response = client.get('/api/v1/estimations/rerun/batch')
+        
+        assert response.status_code == 405
+
+
 class TestErrorHandlers:
     """Tests for error handlers"""
     
@@ -387,7 +438,9 @@ class TestBlueprintConfiguration:
             '/api/v1/formulas',
             '/api/v1/algorithms',
             '/api/v1/estimations/top',
-            '/api/v1/servers/c/health'
+            '/api/v1/servers/c/health',
+            '/api/v1/servers/c/nodes',
+            '/api/v1/estimations/rerun/batch'
         ]
         
         for endpoint in expected_endpoints:
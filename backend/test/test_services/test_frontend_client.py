@@ -2,6 +2,7 @@ import pytest,os,sys
 from unittest.mock import patch, MagicMock, Mock
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../..'))
 from services.frontend_client import FrontEndClient
+from flask import Flask
 
 class TestFrontEndClientInit:
     """Tests for FrontEndClient initialization"""
@@ -302,4 +303,63 @@ class TestHelperMethods:
         
         client.close()
         
-        client.session.close.assert_called_once()
\ No newline at end of file
+        client.session.close.assert_called_once()
+
+class TestRerunBatch:
+    """Tests for rerun_batch method"""
+    
+    def make_request(self, body):
+        request = Mock()
+        request.get_json.return_value = body
+        return request
+    
+    @patch('services.frontend_client.update_estimation_after_rerun')
+    def test_rerun_batch_success(self, mock_update):
+        """Test that every result is stored and returned in order"""
+        # Arrange
+        client = FrontEndClient("http://localhost:5000")
+        app = Flask(__name__)
+        app.server_c_client = Mock()
+        app.server_c_client.run_batch.return_value = [
+            ({"pi_estimate": 3.14, "node": "http://a:8080"}, 200),
+            ({"pi_estimate": 3.141, "node": "http://b:8080"}, 200)
+        ]
+        mock_update.return_value = True
+        
+        # Act
+        with app.app_context():
+            response, status_code = client.rerun_batch(self.make_request({"algorithmNames": ["leibniz", "euler"]}))
+        
+        # Assert
+        assert status_code == 200
+        assert response['succeeded'] == 2
+        assert [r['algorithmName'] for r in response['results']] == ["leibniz", "euler"]
+        app.server_c_client.run_batch.assert_called_once_with(["leibniz", "euler"])
+        assert mock_update.call_count == 2
+    
+    @patch('services.frontend_client.update_estimation_after_rerun')
+    def test_rerun_batch_partial_failure(self, mock_update):
+        """Test that failed runs are reported and not stored"""
+        client = FrontEndClient("http://localhost:5000")
+        app = Flask(__name__)
+        app.server_c_client = Mock()
+        app.server_c_client.run_batch.return_value = [
+            ({"pi_estimate": 3.14}, 200),
+            ({"error": "Ningún servidor C disponible"}, 503)
+        ]
+        
+        with app.app_context():
+            response, status_code = client.rerun_batch(self.make_request({"algorithmNames": ["leibniz", "euler"]}))
+        
+        assert status_code == 207
+        assert response['failed'] == 1
+        assert response['results'][1]['status'] == 503
+        mock_update.assert_called_once_with("leibniz", {"pi_estimate": 3.14})
+    
+    def test_rerun_batch_requires_names(self):
+        """Test that a missing or empty list is a 400"""
+        client = FrontEndClient("http://localhost:5000")
+        
+        for body in [None, {}, {"algorithmNames": []}, {"algorithmNames": "leibniz"}, {"algorithmNames": [1]}]:
+            response, status_code = client.rerun_batch(self.make_request(body))
+            assert status_code == 400
@@ -0,0 +1,230 @@
+import pytest,os,sys,time
+from unittest.mock import patch, Mock
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../..'))
+from services.server_c_pool import ServerCPool
+
+
+def make_pool(count=3, **kwargs):
+    """Pool of `count` nodes at localhost:8081, 8082, ..."""
+    return ServerCPool([f"http://localhost:{8081 + i}" for i in range(count)], **kwargs)
+
+
+class TestServerCPoolInit:
+    """Tests for ServerCPool initialization"""
+
+    def test_init_creates_one_node_per_url(self):
+        """Test that each base URL becomes a node"""
+        pool = ServerCPool(["http://a:8080/", " http://b:8080", ""], default_timeout=45)
+        assert [node.base_url for node in pool.nodes] == ["http://a:8080", "http://b:8080"]
+        assert all(node.client.default_timeout == 45 for node in pool.nodes)
+        assert all(node.healthy for node in pool.nodes)
+
+    def test_init_without_nodes_fails(self):
+        """Test that an empty pool is rejected"""
+        with pytest.raises(ValueError):
+            ServerCPool(["", " "])
+
+
+class TestDispatch:
+    """Tests for least-loaded dispatch"""
+
+    def test_run_algorithm_adds_node(self):
+        """Test that the response says which node produced it"""
+        pool = make_pool(1)
+        with patch.object(pool.nodes[0].client, 'run_algorithm', return_value=({"pi_estimate": 3.14}, 200)):
+            response, status_code = pool.run_algorithm("leibniz")
+
+        assert status_code == 200
+        assert response['pi_estimate'] == 3.14
+        assert response['node'] == "http://localhost:8081"
+        assert pool.nodes[0].completed == 1
+        assert pool.nodes[0].in_flight == 0
+
+    def test_prefers_idle_node(self):
+        """Test that a node with requests in flight is skipped"""
+        pool = make_pool(2)
+        pool.nodes[0].in_flight = 1
+        with patch.object(pool.nodes[1].client, 'run_algorithm', return_value=({}, 200)) as second:
+            pool.run_algorithm("leibniz")
+
+        second.assert_called_once_with("leibniz")
+
+    def test_prefers_faster_node(self):
+        """Test that equal queues go to the node with the shorter mean run"""
+        pool = make_pool(2)
+        pool.nodes[0].completed, pool.nodes[0].busy_seconds = 4, 8.0
+        pool.nodes[1].completed, pool.nodes[1].busy_seconds = 4, 2.0
+        with patch.object(pool.nodes[1].client, 'run_algorithm', return_value=({}, 200)) as fast:
+            pool.run_algorithm("euler")
+
+        fast.assert_called_once()
+
+    def test_skips_unhealthy_node(self):
+        """Test that a node marked down gets no work before its recheck"""
+        pool = make_pool(2, health_interval=60)
+        pool._release_node(pool.nodes[0], 0.0, False, "down")
+        pool.nodes[0].in_flight = 0
+        with patch.object(pool.nodes[0].client, 'run_algorithm') as down, \
+             patch.object(pool.nodes[1].client, 'run_algorithm', return_value=({}, 200)):
+            pool.run_algorithm("leibniz")
+
+        down.assert_not_called()
+
+
+class TestRetry:
+    """Tests for retrying on another node"""
+
+    def test_retry_on_another_node(self):
+        """Test that a failed run is retried elsewhere and the node marked down"""
+        pool = make_pool(2)
+        with patch.object(pool.nodes[0].client, 'run_algorithm', return_value=({"error": "unreachable"}, 503)), \
+             patch.object(pool.nodes[1].client, 'run_algorithm', return_value=({"pi_estimate": 3.14}, 200)):
+            response, status_code = pool.run_algorithm("leibniz")
+
+        assert status_code == 200
+        assert response['node'] == "http://localhost:8082"
+        assert pool.nodes[0].healthy is False
+        assert pool.nodes[0].failed == 1
+        assert pool.nodes[0].last_error == "unreachable"
+
+    def test_timeout_is_not_retried(self):
+        """Test that a 504 (slow run) is returned as is and the node stays up"""
+        pool = make_pool(2)
+        with patch.object(pool.nodes[0].client, 'run_algorithm', return_value=({"error": "timeout"}, 504)), \
+             patch.object(pool.nodes[1].client, 'run_algorithm') as second:
+            response, status_code = pool.run_algorithm("leibniz")
+
+        assert status_code == 504
+        second.assert_not_called()
+        assert pool.nodes[0].healthy is True
+        assert pool.nodes[0].failed == 0
+        assert pool.nodes[0].timeouts == 1
+        assert pool.nodes[0].in_flight == 0
+
+    def test_client_errors_are_not_retried(self):
+        """Test that a 400 (bad algorithm) is returned as is"""
+        pool = make_pool(2)
+        with patch.object(pool.nodes[0].client, 'run_algorithm', return_value=({"error": "Unknown algorithm"}, 400)), \
+             patch.object(pool.nodes[1].client, 'run_algorithm') as second:
+            response, status_code = pool.run_algorithm("nope")
+
+        assert status_code == 400
+        second.assert_not_called()
+        assert pool.nodes[0].healthy is True
+
+    def test_all_nodes_fail(self):
+        """Test that the last failure is returned when every node fails"""
+        pool = make_pool(2)
+        with patch.object(pool.nodes[0].client, 'run_algorithm', return_value=({"error": "a"}, 503)), \
+             patch.object(pool.nodes[1].client, 'run_algorithm', return_value=({"error": "b"}, 504)):
+            response, status_code = pool.run_algorithm("leibniz")
+
+        assert status_code == 504
+        assert response['error'] == "b"
+
+    def test_no_healthy_nodes(self):
+        """Test the 503 when every node is down and not yet due a recheck"""
+        pool = make_pool(1, health_interval=60)
+        pool._release_node(pool.nodes[0], 0.0, False, "down")
+        pool.nodes[0].in_flight = 0
+        response, status_code = pool.run_algorithm("leibniz")
+
+        assert status_code == 503
+        assert response['algorithm'] == "leibniz"
+
+    def test_down_node_rejoins_after_health_check(self):
+        """Test that a node due a recheck rejoins once /api/health answers"""
+        pool = make_pool(1, health_interval=0)
+        pool._release_node(pool.nodes[0], 0.0, False, "down")
+        pool.nodes[0].in_flight = 0
+        with patch.object(pool.nodes[0].client, 'health_check', return_value=({"server_c_status": "ok"}, 200)), \
+             patch.object(pool.nodes[0].client, 'run_algorithm', return_value=({}, 200)):
+            response, status_code = pool.run_algorithm("leibniz")
+
+        assert status_code == 200
+        assert pool.nodes[0].healthy is True
+
+
+class TestHealthAndStats:
+    """Tests for pool health and throughput stats"""
+
+    def test_health_check_ok_with_one_node_up(self):
+        """Test that the pool is healthy while any node is"""
+        pool = make_pool(2)
+        with patch.object(pool.nodes[0].client, 'health_check', return_value=({"server_c_status": "unreachable"}, 503)), \
+             patch.object(pool.nodes[1].client, 'health_check', return_value=({"server_c_status": "ok"}, 200)):
+            response, status_code = pool.health_check(timeout=5)
+
+        assert status_code == 200
+        assert response['healthy_nodes'] == 1
+        assert response['nodes'][0]['server_c_status'] == 'unreachable'
+        assert pool.nodes[0].healthy is False
+
+    def test_health_check_all_down(self):
+        """Test that the first node's error is returned when all are down"""
+        pool = make_pool(2)
+        with patch.object(pool.nodes[0].client, 'health_check', return_value=({"server_c_status": "timeout"}, 504)), \
+             patch.object(pool.nodes[1].client, 'health_check', return_value=({"server_c_status": "unreachable"}, 503)):
+            response, status_code = pool.health_check()
+
+        assert status_code == 504
+        assert response['healthy_nodes'] == 0
+
+    def test_health_check_counts_its_own_answers(self):
+        """Test that a node marked down mid-check still counts if it answered"""
+        pool = make_pool(1)
+
+        def answer_then_fail(timeout):
+            pool._release_node(pool.nodes[0], 0.0, False, "down")
+            return {"server_c_status": "ok"}, 200
+
+        pool.nodes[0].in_flight = 1
+        with patch.object(pool, '_check_node', side_effect=lambda node, timeout: answer_then_fail(timeout)):
+            response, status_code = pool.health_check()
+
+        assert status_code == 200
+        assert response['healthy_nodes'] == 1
+
+    def test_stats(self):
+        """Test per-node throughput"""
+        pool = make_pool(2)
+        pool.nodes[0].completed, pool.nodes[0].busy_seconds = 4, 2.0
+        stats = pool.stats()
+
+        assert stats['completed'] == 4
+        assert stats['healthy_nodes'] == 2
+        assert stats['nodes'][0]['runs_per_second'] == 2.0
+        assert stats['nodes'][1]['runs_per_second'] is None
+
+
+class TestBatch:
+    """Tests for run_batch"""
+
+    def test_batch_spreads_over_nodes(self):
+        """Test that a batch keeps order and uses every node"""
+        pool = make_pool(3)
+        def run(algorithm):
+            time.sleep(0.05)
+            return {"algorithm": algorithm}, 200
+        for node in pool.nodes:
+            node.client.run_algorithm = Mock(side_effect=run)
+        algorithms = ["leibniz", "euler", "machin", "bbp", "takano", "stormer"]
+        results = pool.run_batch(algorithms)
+
+        assert [data['algorithm'] for data, _ in results] == algorithms
+        assert all(status == 200 for _, status in results)
+        assert sum(node.completed for node in pool.nodes) == 6
+        assert all(node.completed > 0 for node in pool.nodes)
+
+    def test_empty_batch(self):
+        """Test that an empty batch does nothing"""
+        assert make_pool(1).run_batch([]) == []
+
+    def test_close_closes_every_node(self):
+        """Test that close reaches every node's session"""
+        pool = make_pool(2)
+        for node in pool.nodes:
+            node.client.session = Mock()
+        pool.close()
+
+        assert all(node.client.session.close.call_count == 1 for node in pool.nodes)
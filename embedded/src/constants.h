@@ -6,6 +6,88 @@
 #define MAX_ITERATIONS 100000000LL
 #define NO_IMPROVEMENT_THRESHOLD 3
 #define PI_REFERENCE 3.14159265358979323846264338327950288419716939937510L
+#define PREDICTOR_MAX_PROBES 32
+#define PREDICTOR_MIN_PROBE_SECONDS 1e-4
+#define PREDICTOR_BUDGET_FRACTION 0.9
+#define PREDICTOR_MIN_GROWTH 1.1
+#define PREDICTOR_MAX_GROWTH 100
+#define PHASE3_MAX_CANDIDATES 8
+#define TARGET_DIGITS_TIME_LIMIT 10.0
+#define PROFILE_PATH "pi_profiles.bin"
+#define PROFILE_MAX_ENTRIES 64
+#define PROFILE_NAME_LENGTH 32
+#define PROFILE_MODEL_LENGTH 64
+#define PROFILE_BUDGET_BOUND 0.5
+#define ACCEL_EULER_TERMS 64
+#define ACCEL_AITKEN_TERMS 63
+#define ACCEL_RICHARDSON_LEVELS 6
+#define ACCEL_LEVIN_TERMS 17
+#define MACHIN_MAX_ARCTANS 4
+
+///////////////// Spigot /////////////////
+#define SPIGOT_MAX_DIGITS 50000LL
+#define SPIGOT_DEFAULT_DIGITS 1000
+#define SPIGOT_CHUNK_DIGITS 1024
+#define SPIGOT_GUARD_DIGITS 16
+#define SPIGOT_MAX_STREAMS 4
+
+///////////////// Race /////////////////
+#define RACE_MAX_ENTRANTS 16
+#define RACE_DEFAULT_DIGITS 12
+#define RACE_DEADLINE_SECONDS 10.0
+#define RACE_MAX_DEADLINE_SECONDS 60.0
+#define RACE_SLICE_SECONDS 0.005
+#define RACE_MAX_STREAMS 2
+
+///////////////// Reference digits /////////////////
+#define REFERENCE_PATH "pi_reference.bin"
+#define REFERENCE_DIGITS MAX_MP_DIGITS
+#define REFERENCE_GUARD_DIGITS 16
+#define REFERENCE_PARSE_DIGITS 1024
+
+///////////////// Multiprecision /////////////////
+#define MAX_MP_DIGITS 1000000LL
+#define MP_GUARD_DIGITS 10
+#define MP_KARATSUBA_THRESHOLD 32
+#define MP_TOOM3_THRESHOLD 400
+#define MP_NTT_THRESHOLD 2048
+#define MP_NTT_PARALLEL_THRESHOLD 65536
+#define MP_NEWTON_DIV_THRESHOLD 64
+#define MP_DECIMAL_BASE_LIMBS 32
+#define BS_PARALLEL_MIN_TERMS 64
+#define MP_AGM_GUARD_BITS 64
+#define MP_AGM_MAX_ITERATIONS 64
+#define MP_POOL_MIN_CLASS 4
+#define MP_POOL_MAX_CLASS 22
+#define MP_POOL_CACHE_BYTES (64 * 1024 * 1024)
+#define MP_ARENA_CHUNK_BYTES (1024 * 1024)
+#define MP_SPILL_DIRECTORY "pi_spill"
+#define MP_SPILL_MIN_BYTES (1024 * 1024)
+#define MP_OOC_RAM_FRACTION 0.5
+#define MP_OOC_MIN_POINTS 65536
+#define MP_OOC_BLOCK_BYTES (8 * 1024 * 1024)
+
+///////////////// Checkpoints /////////////////
+#define CHECKPOINT_NAME_LENGTH 32
+#define CHECKPOINT_PATH_LENGTH 1024
+#define CHECKPOINT_MAX_VALUES 64
+#define CHECKPOINT_MAX_LIMBS (1 << 24)
+#define CHECKPOINT_BUFFER_BYTES (1024 * 1024)
+#define CHECKPOINT_INTERVAL_SECONDS 60.0
+#define CHECKPOINT_MAX_OVERHEAD 0.03
+#define CHECKPOINT_SEGMENTS 64
+
+///////////////// BBP digit extraction /////////////////
+#define BBP_MAX_POSITION 10000000000LL
+#define BBP_MAX_HEX_COUNT 1024
+#define BBP_HEX_DIGITS_PER_EVAL 16
+#define BBP_MIN_TERMS_PER_TASK 16384
+// Cap on position * evaluations for /api/pi/bbp/hex, which runs on the
+// accept loop: about 0.7 s per 1e6 on two cores, so a few seconds at most
+#define BBP_MAX_WORK 5000000LL
+
+///////////////// Compute pool /////////////////
+#define COMPUTE_POOL_MAX_THREADS 64
 
 ///////////////// Server /////////////////
 #define PORT 8080//5000
@@ -14,4 +96,25 @@
 #define MAX_CONNECTIONS 10
 #define TIMEOUT_SECONDS 30
 
+///////////////// Results /////////////////
+#define RESULTS_DIRECTORY "pi_results"
+#define RESULTS_INLINE_DIGITS 100000
+#define RESULTS_MAX_FILES 32
+#define RESULTS_ID_LENGTH 17
+#define RESULTS_PATH_LENGTH 1024
+#define RESULTS_MAX_DOWNLOADS 4
+#define RESULTS_SEND_TIMEOUT_SECONDS 30
+
+///////////////// Cluster /////////////////
+#define PARTIAL_MAX_VALUES 4
+#define CLUSTER_MAX_NODES 16
+#define CLUSTER_NODE_LENGTH 128
+#define CLUSTER_TIMEOUT_SECONDS 300
+#define CLUSTER_MAX_RUNS 2
+#define CLUSTER_MAX_RESPONSE_BYTES (256 * 1024 * 1024)
+
+///////////////// Jobs /////////////////
+#define JOBS_DIRECTORY "pi_jobs"
+#define JOBS_MAX_ENTRIES 16
+
 #endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "cpu_features.h"
+#include <string.h>
+#include <pthread.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+static const char *CPU_LEVEL_NAMES[CPU_LEVEL_COUNT] = {
+    "scalar", "sse4.2", "avx2", "avx512", "neon"
+};
+
+static pthread_once_t cpu_once = PTHREAD_ONCE_INIT;
+static CpuLevel detected_level = CPU_LEVEL_SCALAR;
+static int active_level = CPU_LEVEL_SCALAR;
+static char model_name[64] = "unknown";
+
+static CpuLevel detect_level(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    // libgcc also checks XCR0, so these are false if the OS does not save the registers
+    if (__builtin_cpu_supports("avx512f")) return CPU_LEVEL_AVX512;
+    if (__builtin_cpu_supports("avx2")) return CPU_LEVEL_AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return CPU_LEVEL_SSE42;
+#elif defined(__aarch64__) && defined(__linux__)
+    if (getauxval(AT_HWCAP) & HWCAP_ASIMD) return CPU_LEVEL_NEON;
+#endif
+    return CPU_LEVEL_SCALAR;
+}
+
+static void detect_model(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int regs[12];
+    if (__get_cpuid_max(0x80000000, NULL) >= 0x80000004) {
+        for (unsigned int i = 0; i < 3; i++) {
+            __get_cpuid(0x80000002 + i, &regs[4 * i], &regs[4 * i + 1], &regs[4 * i + 2], &regs[4 * i + 3]);
+        }
+        char brand[sizeof(regs) + 1];
+        memcpy(brand, regs, sizeof(regs));
+        brand[sizeof(regs)] = '\0';
+        const char *start = brand;
+        while (*start == ' ') start++;
+        if (*start != '\0') {
+            snprintf(model_name, sizeof(model_name), "%s", start);
+            return;
+        }
+    }
+#endif
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (cpuinfo == NULL) return;
+    char line[256];
+    while (fgets(line, sizeof(line), cpuinfo) != NULL) {
+        char *value = strchr(line, ':');
+        if (value == NULL) continue;
+        if (strncmp(line, "model name", 10) != 0 && strncmp(line, "CPU part", 8) != 0) continue;
+        value++;
+        while (*value == ' ' || *value == '\t') value++;
+        value[strcspn(value, "\n")] = '\0';
+        snprintf(model_name, sizeof(model_name), "%s", value);
+        break;
+    }
+    fclose(cpuinfo);
+}
+
+// x86 levels are ordered, each implies the ones below it
+static int level_supported(CpuLevel level) {
+    if (level == CPU_LEVEL_SCALAR) return 1;
+    if (level == CPU_LEVEL_NEON) return detected_level == CPU_LEVEL_NEON;
+    return detected_level != CPU_LEVEL_NEON && level <= detected_level;
+}
+
+static void cpu_features_detect(void) {
+    detected_level = detect_level();
+    detect_model();
+    CpuLevel level = detected_level;
+    CpuLevel requested;
+    const char *env = getenv("PI_CPU_LEVEL");
+    if (env != NULL && cpu_level_from_name(env, &requested) && level_supported(requested)) {
+        level = requested;
+    }
+    __atomic_store_n(&active_level, (int)level, __ATOMIC_RELEASE);
+}
+
+void cpu_features_init(void) {
+    pthread_once(&cpu_once, cpu_features_detect);
+}
+
+CpuLevel cpu_level(void) {
+    cpu_features_init();
+    return (CpuLevel)__atomic_load_n(&active_level, __ATOMIC_ACQUIRE);
+}
+
+CpuLevel cpu_detected_level(void) {
+    cpu_features_init();
+    return detected_level;
+}
+
+int cpu_level_override(CpuLevel level) {
+    cpu_features_init();
+    if (level < 0 || level >= CPU_LEVEL_COUNT || !level_supported(level)) return 0;
+    __atomic_store_n(&active_level, (int)level, __ATOMIC_RELEASE);
+    return 1;
+}
+
+const char *cpu_model_name(void) {
+    cpu_features_init();
+    return model_name;
+}
+
+const char *cpu_level_name(CpuLevel level) {
+    if (level < 0 || level >= CPU_LEVEL_COUNT) return "unknown";
+    return CPU_LEVEL_NAMES[level];
+}
+
+int cpu_level_from_name(const char *name, CpuLevel *level) {
+    if (name == NULL) return 0;
+    for (int i = 0; i < CPU_LEVEL_COUNT; i++) {
+        if (strcmp(name, CPU_LEVEL_NAMES[i]) == 0) {
+            *level = (CpuLevel)i;
+            return 1;
+        }
+    }
+    return 0;
+}
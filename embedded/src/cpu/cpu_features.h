@@ -0,0 +1,38 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Instruction-set levels hot kernels are built for. The binary keeps the
+// baseline target flags; wider variants are compiled per function with
+// target attributes and picked once from CPUID (x86) or HWCAP (aarch64).
+typedef enum {
+    CPU_LEVEL_SCALAR = 0,
+    CPU_LEVEL_SSE42,
+    CPU_LEVEL_AVX2,
+    CPU_LEVEL_AVX512,
+    CPU_LEVEL_NEON,
+    CPU_LEVEL_COUNT
+} CpuLevel;
+
+// Detect once (idempotent); PI_CPU_LEVEL=<name> in the environment caps the
+// result, e.g. to compare variants on one machine
+void cpu_features_init(void);
+
+// Level kernels dispatch on: the detected one unless overridden
+CpuLevel cpu_level(void);
+
+// Best level this machine supports, ignoring any override
+CpuLevel cpu_detected_level(void);
+
+// Force a level for subsequent dispatch; returns 0 if the CPU lacks it
+int cpu_level_override(CpuLevel level);
+
+// Processor brand string (CPUID on x86, /proc/cpuinfo elsewhere), or "unknown"
+const char *cpu_model_name(void);
+
+const char *cpu_level_name(CpuLevel level);
+int cpu_level_from_name(const char *name, CpuLevel *level);
+
+#endif
@@ -0,0 +1,89 @@
+#include "dd_real.h"
+
+const dd_real DD_PI = {3.141592653589793116e+00, 1.224646799147353207e-16};
+const qd_real QD_PI = {{3.141592653589793116e+00, 1.224646799147353207e-16,
+                        -2.994769809718339666e-33, 1.112454220863365282e-49}};
+
+///////////////// Roots /////////////////
+// One Newton step on 1/sqrt from a double seed: sqrt(a) ~ a*x + (a - (a*x)^2) * x / 2
+dd_real dd_sqrt(dd_real a) {
+    if (a.hi <= 0.0) return dd_from_d(0.0);
+    double x = 1.0 / sqrt(a.hi);
+    double ax = a.hi * x;
+    double p2;
+    double p1 = two_prod(ax, ax, &p2);
+    dd_real square = {p1, p2};
+    dd_real diff = dd_sub(a, square);
+    return dd_add_d(dd_from_d(ax), diff.hi * (x * 0.5));
+}
+
+// Newton on x = 1/sqrt(a): x += x * (1 - a x^2) / 2, precision doubling each step
+qd_real qd_sqrt(qd_real a) {
+    if (a.x[0] <= 0.0) return qd_from_d(0.0);
+    qd_real x = qd_from_d(1.0 / sqrt(a.x[0]));
+    qd_real half_a = qd_mul_d(a, 0.5);
+    for (int i = 0; i < 3; i++) {
+        qd_real t = qd_mul(half_a, qd_mul(x, x));
+        x = qd_add(x, qd_mul(x, qd_add_d(qd_neg(t), 0.5)));
+    }
+    return qd_mul(a, x);
+}
+
+///////////////// Conversions /////////////////
+// Peel off doubles until the remainder vanishes; exact for any long double
+qd_real qd_from_ld(long double a) {
+    double c[4];
+    for (int i = 0; i < 4; i++) {
+        c[i] = (double)a;
+        a -= (long double)c[i];
+    }
+    return qd_renorm(c[0], c[1], c[2], c[3], 0.0);
+}
+
+long double qd_to_ld(qd_real a) {
+    return (long double)a.x[0] + (long double)a.x[1] + (long double)a.x[2] + (long double)a.x[3];
+}
+
+// Digit-by-digit expansion: take the integer part, subtract it, scale by 10
+static char *expand_digits(qd_real a, int digits, char *buffer, size_t size) {
+    if (size == 0) return buffer;
+    size_t pos = 0;
+    if (a.x[0] < 0.0) {
+        if (pos + 1 < size) buffer[pos++] = '-';
+        a = qd_neg(a);
+    }
+    for (int i = 0; i <= digits && pos + 1 < size; i++) {
+        int d = (int)floor(a.x[0]);
+        qd_real rest = qd_add_d(a, -(double)d);
+        if (rest.x[0] < 0.0) {
+            d--;
+            rest = qd_add_d(rest, 1.0);
+        }
+        if (d < 0) d = 0;
+        if (d > 9) d = 9;
+        buffer[pos++] = (char)('0' + d);
+        if (i == 0 && digits > 0 && pos + 1 < size) buffer[pos++] = '.';
+        a = qd_mul_d(rest, 10.0);
+    }
+    buffer[pos] = '\0';
+    return buffer;
+}
+
+char *dd_to_string(dd_real a, int digits, char *buffer, size_t size) {
+    return expand_digits(qd_from_dd(a), digits, buffer, size);
+}
+
+char *qd_to_string(qd_real a, int digits, char *buffer, size_t size) {
+    return expand_digits(a, digits, buffer, size);
+}
+
+int qd_correct_digits(qd_real estimate, int max_digits) {
+    if (isnan(estimate.x[0]) || isinf(estimate.x[0])) return 0;
+    qd_real error = qd_sub(estimate, QD_PI);
+    double magnitude = fabs(error.x[0]);
+    if (magnitude == 0.0) return max_digits;
+    int digits = (int)floor(-log10(magnitude));
+    if (digits < 0) digits = 0;
+    if (digits > max_digits) digits = max_digits;
+    return digits;
+}
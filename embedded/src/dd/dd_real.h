@@ -0,0 +1,317 @@
+#ifndef DD_REAL_H
+#define DD_REAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Double-double (~32 digits) and quad-double (~64 digits) arithmetic built
+// from error-free transformations on hardware doubles, after Hida, Li and
+// Bailey's QD library. On targets where long double is emulated in software
+// (aarch64 binary128) this is several times faster at similar precision.
+// The value of a dd_real is hi + lo with |lo| <= ulp(hi)/2; a qd_real is
+// x[0] + x[1] + x[2] + x[3], each component non-overlapping.
+
+typedef struct {
+    double hi;
+    double lo;
+} dd_real;
+
+typedef struct {
+    double x[4];
+} qd_real;
+
+#define DD_MAX_DIGITS 31
+#define QD_MAX_DIGITS 62
+
+extern const dd_real DD_PI;
+extern const qd_real QD_PI;
+
+///////////////// Error-free transformations /////////////////
+// s + err == a + b exactly
+static inline double two_sum(double a, double b, double *err) {
+    double s = a + b;
+    double bb = s - a;
+    *err = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+// As two_sum, requires |a| >= |b|
+static inline double quick_two_sum(double a, double b, double *err) {
+    double s = a + b;
+    *err = b - (s - a);
+    return s;
+}
+
+// p + err == a * b exactly; a single fused multiply-add where available
+static inline double two_prod(double a, double b, double *err) {
+    double p = a * b;
+#ifdef FP_FAST_FMA
+    *err = fma(a, b, -p);
+#else
+    // Dekker split when fma would be a library call
+    const double split = 134217729.0;  // 2^27 + 1
+    double t = split * a;
+    double a_hi = t - (t - a), a_lo = a - a_hi;
+    t = split * b;
+    double b_hi = t - (t - b), b_lo = b - b_hi;
+    *err = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+    return p;
+}
+
+///////////////// Double-double /////////////////
+static inline dd_real dd_from_d(double a) {
+    dd_real r = {a, 0.0};
+    return r;
+}
+
+static inline dd_real dd_neg(dd_real a) {
+    dd_real r = {-a.hi, -a.lo};
+    return r;
+}
+
+static inline dd_real dd_add(dd_real a, dd_real b) {
+    double s1, s2, t1, t2;
+    s1 = two_sum(a.hi, b.hi, &s2);
+    t1 = two_sum(a.lo, b.lo, &t2);
+    s2 += t1;
+    s1 = quick_two_sum(s1, s2, &s2);
+    s2 += t2;
+    dd_real r;
+    r.hi = quick_two_sum(s1, s2, &r.lo);
+    return r;
+}
+
+static inline dd_real dd_add_d(dd_real a, double b) {
+    double s1, s2;
+    s1 = two_sum(a.hi, b, &s2);
+    s2 += a.lo;
+    dd_real r;
+    r.hi = quick_two_sum(s1, s2, &r.lo);
+    return r;
+}
+
+static inline dd_real dd_sub(dd_real a, dd_real b) {
+    return dd_add(a, dd_neg(b));
+}
+
+static inline dd_real dd_mul(dd_real a, dd_real b) {
+    double p1, p2;
+    p1 = two_prod(a.hi, b.hi, &p2);
+    p2 += a.hi * b.lo + a.lo * b.hi;
+    dd_real r;
+    r.hi = quick_two_sum(p1, p2, &r.lo);
+    return r;
+}
+
+static inline dd_real dd_mul_d(dd_real a, double b) {
+    double p1, p2;
+    p1 = two_prod(a.hi, b, &p2);
+    p2 += a.lo * b;
+    dd_real r;
+    r.hi = quick_two_sum(p1, p2, &r.lo);
+    return r;
+}
+
+// Long division: two quotient digits plus a correction
+static inline dd_real dd_div(dd_real a, dd_real b) {
+    double q1 = a.hi / b.hi;
+    dd_real r = dd_sub(a, dd_mul_d(b, q1));
+    double q2 = r.hi / b.hi;
+    r = dd_sub(r, dd_mul_d(b, q2));
+    double q3 = r.hi / b.hi;
+    dd_real q;
+    q.hi = quick_two_sum(q1, q2, &q.lo);
+    return dd_add_d(q, q3);
+}
+
+static inline dd_real dd_div_d(dd_real a, double b) {
+    double q1 = a.hi / b;
+    double p1, p2, s, e;
+    p1 = two_prod(q1, b, &p2);
+    s = two_sum(a.hi, -p1, &e);
+    e += a.lo - p2;
+    double q2 = (s + e) / b;
+    dd_real r;
+    r.hi = quick_two_sum(q1, q2, &r.lo);
+    return r;
+}
+
+static inline double dd_to_d(dd_real a) {
+    return a.hi + a.lo;
+}
+
+dd_real dd_sqrt(dd_real a);
+// Write `digits` decimals of a (|a| < 10) as "d.ddd..."; returns buffer
+char *dd_to_string(dd_real a, int digits, char *buffer, size_t size);
+
+///////////////// Quad-double /////////////////
+static inline qd_real qd_from_d(double a) {
+    qd_real r = {{a, 0.0, 0.0, 0.0}};
+    return r;
+}
+
+static inline qd_real qd_from_dd(dd_real a) {
+    qd_real r = {{a.hi, a.lo, 0.0, 0.0}};
+    return r;
+}
+
+static inline qd_real qd_neg(qd_real a) {
+    qd_real r = {{-a.x[0], -a.x[1], -a.x[2], -a.x[3]}};
+    return r;
+}
+
+static inline void three_sum(double *a, double *b, double *c) {
+    double t1, t2, t3;
+    t1 = two_sum(*a, *b, &t2);
+    *a = two_sum(*c, t1, &t3);
+    *b = two_sum(t2, t3, c);
+}
+
+static inline void three_sum2(double *a, double *b, double c) {
+    double t1, t2, t3;
+    t1 = two_sum(*a, *b, &t2);
+    *a = two_sum(c, t1, &t3);
+    *b = t2 + t3;
+}
+
+// Fold five overlapping components into a normalized quad-double
+static inline qd_real qd_renorm(double c0, double c1, double c2, double c3, double c4) {
+    double s0, s1, s2 = 0.0, s3 = 0.0;
+    s0 = quick_two_sum(c3, c4, &c4);
+    s0 = quick_two_sum(c2, s0, &c3);
+    s0 = quick_two_sum(c1, s0, &c2);
+    c0 = quick_two_sum(c0, s0, &c1);
+
+    s0 = c0;
+    s1 = c1;
+    if (s1 != 0.0) {
+        s1 = quick_two_sum(s1, c2, &s2);
+        if (s2 != 0.0) {
+            s2 = quick_two_sum(s2, c3, &s3);
+            if (s3 != 0.0) s3 += c4;
+            else s2 = quick_two_sum(s2, c4, &s3);
+        } else {
+            s1 = quick_two_sum(s1, c3, &s2);
+            if (s2 != 0.0) s2 = quick_two_sum(s2, c4, &s3);
+            else s1 = quick_two_sum(s1, c4, &s2);
+        }
+    } else {
+        s0 = quick_two_sum(s0, c2, &s1);
+        if (s1 != 0.0) {
+            s1 = quick_two_sum(s1, c3, &s2);
+            if (s2 != 0.0) s2 = quick_two_sum(s2, c4, &s3);
+            else s1 = quick_two_sum(s1, c4, &s2);
+        } else {
+            s0 = quick_two_sum(s0, c3, &s1);
+            if (s1 != 0.0) s1 = quick_two_sum(s1, c4, &s2);
+            else s0 = quick_two_sum(s0, c4, &s1);
+        }
+    }
+    qd_real r = {{s0, s1, s2, s3}};
+    return r;
+}
+
+static inline qd_real qd_add(qd_real a, qd_real b) {
+    double s0, s1, s2, s3, t0, t1, t2, t3;
+    s0 = two_sum(a.x[0], b.x[0], &t0);
+    s1 = two_sum(a.x[1], b.x[1], &t1);
+    s2 = two_sum(a.x[2], b.x[2], &t2);
+    s3 = two_sum(a.x[3], b.x[3], &t3);
+
+    s1 = two_sum(s1, t0, &t0);
+    three_sum(&s2, &t0, &t1);
+    three_sum2(&s3, &t0, t2);
+    t0 = t0 + t1 + t3;
+    return qd_renorm(s0, s1, s2, s3, t0);
+}
+
+static inline qd_real qd_add_d(qd_real a, double b) {
+    double c0, c1, c2, c3, e;
+    c0 = two_sum(a.x[0], b, &e);
+    c1 = two_sum(a.x[1], e, &e);
+    c2 = two_sum(a.x[2], e, &e);
+    c3 = two_sum(a.x[3], e, &e);
+    return qd_renorm(c0, c1, c2, c3, e);
+}
+
+static inline qd_real qd_sub(qd_real a, qd_real b) {
+    return qd_add(a, qd_neg(b));
+}
+
+static inline qd_real qd_mul_d(qd_real a, double b) {
+    double p0, p1, p2, p3, q0, q1, q2, s0, s1, s2, s3, s4;
+    p0 = two_prod(a.x[0], b, &q0);
+    p1 = two_prod(a.x[1], b, &q1);
+    p2 = two_prod(a.x[2], b, &q2);
+    p3 = a.x[3] * b;
+
+    s0 = p0;
+    s1 = two_sum(q0, p1, &s2);
+    three_sum(&s2, &q1, &p2);
+    three_sum2(&q1, &q2, p3);
+    s3 = q1;
+    s4 = q2 + p2;
+    return qd_renorm(s0, s1, s2, s3, s4);
+}
+
+// Product keeping all terms down to order eps^3 (QD's "sloppy" multiply)
+static inline qd_real qd_mul(qd_real a, qd_real b) {
+    double p0, p1, p2, p3, p4, p5;
+    double q0, q1, q2, q3, q4, q5;
+    double t0, t1, s0, s1, s2;
+
+    p0 = two_prod(a.x[0], b.x[0], &q0);
+    p1 = two_prod(a.x[0], b.x[1], &q1);
+    p2 = two_prod(a.x[1], b.x[0], &q2);
+    p3 = two_prod(a.x[0], b.x[2], &q3);
+    p4 = two_prod(a.x[1], b.x[1], &q4);
+    p5 = two_prod(a.x[2], b.x[0], &q5);
+
+    // O(eps) terms
+    three_sum(&p1, &p2, &q0);
+
+    // O(eps^2) terms
+    three_sum(&p2, &q1, &q2);
+    three_sum(&p3, &p4, &p5);
+    s0 = two_sum(p2, p3, &t0);
+    s1 = two_sum(q1, p4, &t1);
+    s2 = q2 + p5;
+    s1 = two_sum(s1, t0, &t0);
+    s2 += (t0 + t1);
+
+    // O(eps^3) terms
+    s1 += a.x[0] * b.x[3] + a.x[1] * b.x[2] + a.x[2] * b.x[1] + a.x[3] * b.x[0] +
+          q0 + q3 + q4 + q5;
+    return qd_renorm(p0, p1, s0, s1, s2);
+}
+
+static inline qd_real qd_div(qd_real a, qd_real b) {
+    double q0, q1, q2, q3;
+    qd_real r;
+    q0 = a.x[0] / b.x[0];
+    r = qd_sub(a, qd_mul_d(b, q0));
+    q1 = r.x[0] / b.x[0];
+    r = qd_sub(r, qd_mul_d(b, q1));
+    q2 = r.x[0] / b.x[0];
+    r = qd_sub(r, qd_mul_d(b, q2));
+    q3 = r.x[0] / b.x[0];
+    r = qd_sub(r, qd_mul_d(b, q3));
+    double q4 = r.x[0] / b.x[0];
+    return qd_renorm(q0, q1, q2, q3, q4);
+}
+
+static inline qd_real qd_div_d(qd_real a, double b) {
+    return qd_div(a, qd_from_d(b));
+}
+
+qd_real qd_sqrt(qd_real a);
+qd_real qd_from_ld(long double a);
+long double qd_to_ld(qd_real a);
+// Write `digits` decimals of a (|a| < 10) as "d.ddd..."; returns buffer
+char *qd_to_string(qd_real a, int digits, char *buffer, size_t size);
+// Correct decimal digits of estimate against QD_PI, capped at max_digits
+int qd_correct_digits(qd_real estimate, int max_digits);
+
+#endif
@@ -16,9 +16,13 @@ void signal_handler(int sig) {
 int main() {
     // Configure signal handler
     signal(SIGINT, signal_handler);
+    // A client closing mid-download must not kill the server (sendfile has
+    // no MSG_NOSIGNAL)
+    signal(SIGPIPE, SIG_IGN);
     
-    // Initialize server on port 8080
-    if (server_init(&server, PORT) < 0) {
+    // Initialize server on port 8080 unless PI_PORT says otherwise
+    const char *port = getenv("PI_PORT");
+    if (server_init(&server, port != NULL ? atoi(port) : PORT) < 0) {
         fprintf(stderr, "Error initializing server\n");
         return 1;
     }
@@ -0,0 +1,385 @@
+#include "mp_alloc.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MP_ALLOC_ALIGN 16
+#define MP_POOL_LARGE_CLASS (-1)
+#define MP_POOL_FILE_CLASS (-2)
+
+// Prefix of every pooled buffer; keeps the payload 16-byte aligned
+typedef union {
+    struct {
+        int size_class;
+        int fd;        // backing file of a spilled buffer
+        size_t bytes;
+        MpMemoryAccount *account;  // charged for the buffer
+    } info;
+    void *next;  // free-list link while cached
+    unsigned char pad[2 * MP_ALLOC_ALIGN];
+} MpPoolHeader;
+
+typedef struct MpArenaChunk {
+    struct MpArenaChunk *prev;
+    size_t size;
+    size_t used;
+    size_t pad;  // header stays a multiple of MP_ALLOC_ALIGN
+} MpArenaChunk;
+
+static size_t memory_in_use;
+static size_t memory_peak;
+static size_t spilled_in_use;
+static size_t spilled_peak;
+
+// Out-of-core settings, read on every large allocation
+static pthread_mutex_t spill_mutex = PTHREAD_MUTEX_INITIALIZER;
+static char *spill_directory = NULL;
+static size_t memory_limit;
+
+static __thread MpPoolHeader *pool_free_lists[MP_POOL_MAX_CLASS + 1];
+static __thread size_t pool_cached_bytes;
+static __thread MpArenaChunk *arena_top;
+static __thread MpArenaChunk *arena_spare;
+static __thread int thread_registered;
+
+static pthread_once_t cleanup_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cleanup_key;
+
+///////////////// Accounting /////////////////
+static void peak_raise(size_t *peak, size_t now) {
+    size_t seen = __atomic_load_n(peak, __ATOMIC_RELAXED);
+    while (now > seen &&
+           !__atomic_compare_exchange_n(peak, &seen, now, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void memory_charge(MpMemoryAccount *account, size_t bytes) {
+    peak_raise(&memory_peak, __atomic_add_fetch(&memory_in_use, bytes, __ATOMIC_RELAXED));
+    if (account != NULL) {
+        peak_raise(&account->peak, __atomic_add_fetch(&account->in_use, bytes, __ATOMIC_RELAXED));
+    }
+}
+
+static void memory_release(MpMemoryAccount *account, size_t bytes) {
+    __atomic_sub_fetch(&memory_in_use, bytes, __ATOMIC_RELAXED);
+    if (account != NULL) __atomic_sub_fetch(&account->in_use, bytes, __ATOMIC_RELAXED);
+}
+
+static void spill_charge(size_t bytes) {
+    peak_raise(&spilled_peak, __atomic_add_fetch(&spilled_in_use, bytes, __ATOMIC_RELAXED));
+}
+
+size_t mp_memory_in_use(void) {
+    return __atomic_load_n(&memory_in_use, __ATOMIC_RELAXED);
+}
+
+size_t mp_memory_peak(void) {
+    return __atomic_load_n(&memory_peak, __ATOMIC_RELAXED);
+}
+
+// The account rides on the pool's task context, so it follows a run's tasks
+MpMemoryAccount *mp_memory_account_install(MpMemoryAccount *account) {
+    MpMemoryAccount *previous = mp_memory_account();
+    compute_pool_set_context(account);
+    return previous;
+}
+
+MpMemoryAccount *mp_memory_account(void) {
+    return (MpMemoryAccount *)compute_pool_context();
+}
+
+///////////////// Thread teardown /////////////////
+// Worker threads hand their caches back to malloc when they exit
+static void thread_cleanup(void *unused) {
+    (void)unused;
+    for (int c = 0; c <= MP_POOL_MAX_CLASS; c++) {
+        while (pool_free_lists[c] != NULL) {
+            MpPoolHeader *h = pool_free_lists[c];
+            pool_free_lists[c] = (MpPoolHeader *)h->next;
+            free(h);
+        }
+    }
+    pool_cached_bytes = 0;
+    while (arena_top != NULL) {
+        MpArenaChunk *prev = arena_top->prev;
+        free(arena_top);
+        arena_top = prev;
+    }
+    free(arena_spare);
+    arena_spare = NULL;
+}
+
+static void create_cleanup_key(void) {
+    pthread_key_create(&cleanup_key, thread_cleanup);
+}
+
+static void register_thread(void) {
+    if (thread_registered) return;
+    pthread_once(&cleanup_once, create_cleanup_key);
+    pthread_setspecific(cleanup_key, (void *)&thread_registered);
+    thread_registered = 1;
+}
+
+static void *checked_malloc(size_t bytes) {
+    void *p = malloc(bytes);
+    if (p == NULL) {
+        fprintf(stderr, "mp_alloc: out of memory allocating %zu bytes\n", bytes);
+        abort();
+    }
+    return p;
+}
+
+///////////////// Out-of-core storage /////////////////
+static size_t page_size(void) {
+    static size_t size;
+    if (size == 0) size = (size_t)sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+// Spilled buffers start on a page, after a page holding just the header,
+// so column blocks of whole pages map to whole pages of the file
+static size_t mapping_length(size_t bytes) {
+    size_t page = page_size();
+    return page + (bytes + page - 1) / page * page;
+}
+
+static unsigned char *mapping_base(const MpPoolHeader *h) {
+    return (unsigned char *)(h + 1) - page_size();
+}
+
+int mp_out_of_core_configure(size_t limit, const char *directory) {
+    if (limit == 0) {
+        long pages = sysconf(_SC_PHYS_PAGES);
+        limit = pages > 0 ? (size_t)((double)pages * (double)page_size() * MP_OOC_RAM_FRACTION) : 0;
+    }
+    char *copy = NULL;
+    int status = 0;
+    if (directory != NULL && directory[0] != '\0') {
+        struct stat info;
+        if ((mkdir(directory, 0700) != 0 && errno != EEXIST) ||
+            stat(directory, &info) != 0 || !S_ISDIR(info.st_mode)) {
+            status = -1;
+        } else {
+            copy = strdup(directory);
+        }
+    }
+    if (copy == NULL) limit = 0;  // nowhere to spill: off
+    pthread_mutex_lock(&spill_mutex);
+    free(spill_directory);
+    spill_directory = copy;
+    __atomic_store_n(&memory_limit, limit, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&spill_mutex);
+    return status;
+}
+
+size_t mp_memory_limit(void) {
+    return __atomic_load_n(&memory_limit, __ATOMIC_RELAXED);
+}
+
+size_t mp_spilled_bytes(void) {
+    return __atomic_load_n(&spilled_in_use, __ATOMIC_RELAXED);
+}
+
+size_t mp_spilled_peak(void) {
+    return __atomic_load_n(&spilled_peak, __ATOMIC_RELAXED);
+}
+
+// A buffer of `bytes` mapped from a fresh file, unlinked at once so it goes
+// away with the process; NULL if spilling is off or fails
+static MpPoolHeader *spill_map(size_t bytes) {
+    size_t limit = mp_memory_limit();
+    if (limit == 0 || bytes < MP_SPILL_MIN_BYTES || mp_memory_in_use() + bytes <= limit) return NULL;
+
+    char path[1024];
+    pthread_mutex_lock(&spill_mutex);
+    int configured = spill_directory != NULL;
+    if (configured) snprintf(path, sizeof(path), "%s/mp-XXXXXX", spill_directory);
+    pthread_mutex_unlock(&spill_mutex);
+    if (!configured) return NULL;
+
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    unlink(path);
+    size_t length = mapping_length(bytes);
+    void *p = ftruncate(fd, (off_t)length) == 0
+                  ? mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                  : MAP_FAILED;
+    if (p == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+    MpPoolHeader *h = (MpPoolHeader *)((unsigned char *)p + page_size()) - 1;
+    h->info.size_class = MP_POOL_FILE_CLASS;
+    h->info.fd = fd;
+    h->info.bytes = bytes;
+    spill_charge(bytes);
+    return h;
+}
+
+static void spill_unmap(MpPoolHeader *h) {
+    int fd = h->info.fd;
+    size_t bytes = h->info.bytes;
+    munmap(mapping_base(h), mapping_length(bytes));
+    close(fd);
+    __atomic_sub_fetch(&spilled_in_use, bytes, __ATOMIC_RELAXED);
+}
+
+int mp_pool_on_disk(const uint32_t *p) {
+    return p != NULL && ((const MpPoolHeader *)p - 1)->info.size_class == MP_POOL_FILE_CLASS;
+}
+
+// Whole pages inside limbs [first, first + n) as an address and file
+// offset; 0 if there are none
+static size_t spill_pages(const uint32_t *p, size_t first, size_t n, unsigned char **start, off_t *offset) {
+    size_t page = page_size();
+    const MpPoolHeader *h = (const MpPoolHeader *)p - 1;
+    uintptr_t base = (uintptr_t)mapping_base(h);
+    uintptr_t low = ((uintptr_t)(p + first) + page - 1) / page * page;
+    uintptr_t high = (uintptr_t)(p + first + n) / page * page;
+    if (high <= low) return 0;
+    *start = (unsigned char *)low;
+    *offset = (off_t)(low - base);
+    return (size_t)(high - low);
+}
+
+void mp_pool_prefetch(const uint32_t *p, size_t first, size_t n) {
+    if (!mp_pool_on_disk(p)) return;
+    unsigned char *start;
+    off_t offset;
+    size_t length = spill_pages(p, first, n, &start, &offset);
+    if (length > 0) madvise(start, length, MADV_WILLNEED);
+}
+
+void mp_pool_evict(const uint32_t *p, size_t first, size_t n) {
+    if (!mp_pool_on_disk(p)) return;
+    unsigned char *start;
+    off_t offset;
+    size_t length = spill_pages(p, first, n, &start, &offset);
+    if (length == 0) return;
+    // Start writeback, drop the pages from this mapping, then ask the page
+    // cache to let go of whatever is already clean
+    int fd = ((const MpPoolHeader *)p - 1)->info.fd;
+#ifdef SYNC_FILE_RANGE_WRITE
+    sync_file_range(fd, offset, (off_t)length, SYNC_FILE_RANGE_WRITE);
+#endif
+    madvise(start, length, MADV_DONTNEED);
+    posix_fadvise(fd, offset, (off_t)length, POSIX_FADV_DONTNEED);
+}
+
+///////////////// Limb pools /////////////////
+uint32_t *mp_pool_alloc(size_t n, size_t *capacity) {
+    int size_class = MP_POOL_MIN_CLASS;
+    while (size_class <= MP_POOL_MAX_CLASS && ((size_t)1 << size_class) < n) size_class++;
+
+    MpPoolHeader *h;
+    size_t limbs;
+    if (n * sizeof(uint32_t) >= MP_SPILL_MIN_BYTES && (h = spill_map(n * sizeof(uint32_t))) != NULL) {
+        // Over the memory limit: on disk, and not charged as RAM
+        if (capacity != NULL) *capacity = n;
+        return (uint32_t *)(h + 1);
+    }
+    if (size_class > MP_POOL_MAX_CLASS) {
+        // Too large to be worth caching: straight to malloc
+        limbs = n;
+        h = (MpPoolHeader *)checked_malloc(sizeof(MpPoolHeader) + limbs * sizeof(uint32_t));
+        h->info.size_class = MP_POOL_LARGE_CLASS;
+    } else {
+        limbs = (size_t)1 << size_class;
+        register_thread();
+        h = pool_free_lists[size_class];
+        if (h != NULL) {
+            pool_free_lists[size_class] = (MpPoolHeader *)h->next;
+            pool_cached_bytes -= limbs * sizeof(uint32_t);
+        } else {
+            h = (MpPoolHeader *)checked_malloc(sizeof(MpPoolHeader) + limbs * sizeof(uint32_t));
+        }
+        h->info.size_class = size_class;
+    }
+    h->info.bytes = limbs * sizeof(uint32_t);
+    h->info.account = mp_memory_account();
+    memory_charge(h->info.account, h->info.bytes);
+
+    if (capacity != NULL) *capacity = limbs;
+    return (uint32_t *)(h + 1);
+}
+
+void mp_pool_free(uint32_t *p) {
+    if (p == NULL) return;
+    MpPoolHeader *h = (MpPoolHeader *)p - 1;
+    int size_class = h->info.size_class;
+    size_t bytes = h->info.bytes;
+    if (size_class == MP_POOL_FILE_CLASS) {
+        spill_unmap(h);
+        return;
+    }
+    memory_release(h->info.account, bytes);
+
+    // Buffers return to the freeing thread's cache, up to its byte budget
+    if (size_class == MP_POOL_LARGE_CLASS || pool_cached_bytes + bytes > MP_POOL_CACHE_BYTES) {
+        free(h);
+        return;
+    }
+    register_thread();
+    h->next = pool_free_lists[size_class];
+    pool_free_lists[size_class] = h;
+    pool_cached_bytes += bytes;
+}
+
+///////////////// Scratch arena /////////////////
+MpArenaMark mp_arena_mark(void) {
+    MpArenaMark mark;
+    mark.chunk = arena_top;
+    mark.used = arena_top ? arena_top->used : 0;
+    return mark;
+}
+
+void *mp_arena_alloc(size_t bytes) {
+    bytes = (bytes + MP_ALLOC_ALIGN - 1) & ~(size_t)(MP_ALLOC_ALIGN - 1);
+    if (bytes == 0) bytes = MP_ALLOC_ALIGN;
+
+    if (arena_top == NULL || arena_top->size - arena_top->used < bytes) {
+        MpArenaChunk *chunk;
+        if (arena_spare != NULL && arena_spare->size >= bytes) {
+            chunk = arena_spare;
+            arena_spare = NULL;
+        } else {
+            size_t size = bytes > MP_ARENA_CHUNK_BYTES ? bytes : MP_ARENA_CHUNK_BYTES;
+            register_thread();
+            chunk = (MpArenaChunk *)checked_malloc(sizeof(MpArenaChunk) + size);
+            chunk->size = size;
+        }
+        chunk->used = 0;
+        chunk->prev = arena_top;
+        arena_top = chunk;
+    }
+
+    void *p = (unsigned char *)(arena_top + 1) + arena_top->used;
+    arena_top->used += bytes;
+    memory_charge(mp_memory_account(), bytes);
+    return p;
+}
+
+void mp_arena_release(MpArenaMark mark) {
+    size_t released = 0;
+    while (arena_top != NULL && arena_top != mark.chunk) {
+        MpArenaChunk *chunk = arena_top;
+        arena_top = chunk->prev;
+        released += chunk->used;
+        // Keep the largest retired chunk (within the cache budget) for the next scope
+        if (chunk->size <= MP_POOL_CACHE_BYTES &&
+            (arena_spare == NULL || arena_spare->size < chunk->size)) {
+            free(arena_spare);
+            arena_spare = chunk;
+        } else {
+            free(chunk);
+        }
+    }
+    if (arena_top != NULL) {
+        released += arena_top->used - mark.used;
+        arena_top->used = mark.used;
+    }
+    // Scopes nest within one task, so the account that charged is installed
+    memory_release(mp_memory_account(), released);
+}
@@ -0,0 +1,80 @@
+#ifndef MP_ALLOC_H
+#define MP_ALLOC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "../constants.h"
+#include "../pool/compute_pool.h"
+
+// Memory for the multiprecision engine, all of it thread-local:
+//  - limb pools: power-of-two size classes with per-thread free lists, used
+//    for MpInt storage so the churn of short-lived temporaries never reaches
+//    malloc once the caches are warm;
+//  - scratch arena: a bump allocator for kernel temporaries, released in
+//    LIFO scopes with mp_arena_mark / mp_arena_release.
+// Both report into process-wide in-use and peak counters, and into the
+// memory account of the run doing the allocating, if it installed one.
+//
+// Out of core: once RAM in use would pass the memory limit, large limb
+// buffers are mapped from unlinked files in a spill directory instead, so
+// the kernel pages them to disk; kernels that stream over such buffers
+// prefetch and evict them explicitly. Spilled bytes are counted apart from
+// RAM in use.
+
+///////////////// Limb pools /////////////////
+// Buffer of at least n 32-bit limbs; *capacity receives the usable size
+uint32_t *mp_pool_alloc(size_t n, size_t *capacity);
+void mp_pool_free(uint32_t *p);
+
+///////////////// Out-of-core storage /////////////////
+// Spill into `directory` (created if needed) once RAM in use would pass
+// memory_limit bytes; 0 picks MP_OOC_RAM_FRACTION of physical memory.
+// A NULL directory turns out-of-core mode off. 0 on success.
+int mp_out_of_core_configure(size_t memory_limit, const char *directory);
+size_t mp_memory_limit(void);
+// Whether a pool buffer is file-backed
+int mp_pool_on_disk(const uint32_t *p);
+// Hint that limbs [first, first + n) of a pool buffer are needed soon, or
+// are done with for now (written back and dropped from RAM); no-ops for
+// buffers in RAM
+void mp_pool_prefetch(const uint32_t *p, size_t first, size_t n);
+void mp_pool_evict(const uint32_t *p, size_t first, size_t n);
+size_t mp_spilled_bytes(void);
+size_t mp_spilled_peak(void);
+
+///////////////// Scratch arena /////////////////
+typedef struct {
+    void *chunk;
+    size_t used;
+} MpArenaMark;
+
+MpArenaMark mp_arena_mark(void);
+// 16-byte aligned scratch valid until the enclosing mark is released
+void *mp_arena_alloc(size_t bytes);
+void mp_arena_release(MpArenaMark mark);
+
+///////////////// Accounting /////////////////
+// Process-wide: everything in use, and the most ever in use
+size_t mp_memory_in_use(void);
+size_t mp_memory_peak(void);
+
+// Per run: runs overlap (jobs, races, distributed parts), so each measures
+// its own big-number storage in an account instead of the process figures.
+// Allocations by the installing thread, and by pool tasks it spawns, are
+// charged to the account; a buffer is credited back to the account it was
+// charged to, whichever thread frees it, so the account has to outlive the
+// run's buffers. Spilled buffers are not RAM and are not charged.
+typedef struct {
+    size_t in_use;
+    size_t peak;
+} MpMemoryAccount;
+
+// Install `account` (NULL for none) on the calling thread; returns the one
+// installed before, to put back when the run is over
+MpMemoryAccount *mp_memory_account_install(MpMemoryAccount *account);
+MpMemoryAccount *mp_memory_account(void);
+
+#endif
@@ -0,0 +1,108 @@
+#include "mp_fixed.h"
+
+// Below this many bits the root seed comes straight from libm
+#define MP_FIXED_BASE_BITS 48
+// Extra bits carried by each Newton level over half the target precision
+#define MP_FIXED_NEWTON_GUARD 8
+
+void mp_fixed_set_ui(MpInt *r, uint32_t value, size_t bits) {
+    mp_set_ui(r, value);
+    mp_shl(r, r, bits);
+}
+
+void mp_fixed_mul(MpInt *r, const MpInt *a, const MpInt *b, size_t bits) {
+    mp_mul(r, a, b);
+    mp_shr(r, r, bits);
+}
+
+void mp_fixed_div(MpInt *r, const MpInt *a, const MpInt *b, size_t bits) {
+    MpInt num;
+    mp_init(&num);
+    mp_shl(&num, a, bits);
+    mp_divmod(r, NULL, &num, b);
+    mp_clear(&num);
+}
+
+// x^(-1/n) at `bits` precision: seed from a half-precision solve, then
+// r <- r + r * (1 - x * r^n) / n
+void mp_fixed_inv_root(MpInt *r, const MpInt *x, unsigned n, size_t bits) {
+    if (bits <= MP_FIXED_BASE_BITS) {
+        // x < 2^(bits + 12) in every caller, so it fits a 64-bit word
+        uint64_t raw = 0;
+        for (size_t i = x->size; i-- > 0;) raw = (raw << MP_LIMB_BITS) | x->limbs[i];
+        double value = ldexp((double)raw, -(int)bits);
+        double seed = (n == 2) ? 1.0 / sqrt(value) : 1.0 / sqrt(sqrt(value));
+        mp_set_ui(r, (uint64_t)ldexp(seed, (int)bits));
+        return;
+    }
+
+    size_t half = bits / 2 + MP_FIXED_NEWTON_GUARD;
+    MpInt x_copy, x_half, power, correction;
+    mp_init(&x_copy);
+    mp_init(&x_half);
+    mp_init(&power);
+    mp_init(&correction);
+    if (r == x) {
+        mp_copy(&x_copy, x);
+        x = &x_copy;
+    }
+
+    mp_shr(&x_half, x, bits - half);
+    mp_fixed_inv_root(r, &x_half, n, half);
+    mp_shl(r, r, bits - half);
+
+    // correction = 1 - x * r^n
+    mp_fixed_mul(&power, r, r, bits);
+    if (n == 4) mp_fixed_mul(&power, &power, &power, bits);
+    mp_fixed_mul(&power, &power, x, bits);
+    mp_fixed_set_ui(&correction, 1, bits);
+    mp_sub(&correction, &correction, &power);
+
+    // r += r * correction / n
+    mp_fixed_mul(&correction, &correction, r, bits);
+    mp_shr(&correction, &correction, n == 4 ? 2 : 1);
+    mp_add(r, r, &correction);
+
+    mp_clear(&x_copy);
+    mp_clear(&x_half);
+    mp_clear(&power);
+    mp_clear(&correction);
+}
+
+void mp_fixed_sqrt(MpInt *r, const MpInt *x, size_t bits) {
+    if (mp_is_zero(x)) {
+        mp_set_ui(r, 0);
+        return;
+    }
+    MpInt inv;
+    mp_init(&inv);
+    mp_fixed_inv_root(&inv, x, 2, bits);
+    mp_fixed_mul(r, x, &inv, bits);
+    mp_clear(&inv);
+}
+
+void mp_fixed_root4(MpInt *r, const MpInt *x, size_t bits) {
+    if (mp_is_zero(x)) {
+        mp_set_ui(r, 0);
+        return;
+    }
+    // x^(1/4) = x * (x^(-1/4))^3
+    MpInt inv, cube;
+    mp_init(&inv);
+    mp_init(&cube);
+    mp_fixed_inv_root(&inv, x, 4, bits);
+    mp_fixed_mul(&cube, &inv, &inv, bits);
+    mp_fixed_mul(&cube, &cube, &inv, bits);
+    mp_fixed_mul(r, x, &cube, bits);
+    mp_clear(&inv);
+    mp_clear(&cube);
+}
+
+void mp_fixed_to_decimal_scaled(MpInt *r, const MpInt *x, long long decimals, size_t bits) {
+    MpInt scale;
+    mp_init(&scale);
+    mp_pow_ui(&scale, 10, (uint64_t)decimals);
+    mp_mul(r, x, &scale);
+    mp_shr(r, r, bits);
+    mp_clear(&scale);
+}
@@ -0,0 +1,27 @@
+#ifndef MP_FIXED_H
+#define MP_FIXED_H
+
+#include "mp_int.h"
+
+// Binary fixed point on top of MpInt: a value v is stored as floor(v * 2^bits).
+// The root routines are Newton iterations on the inverse root, which need no
+// division and double their precision at each level of recursion, so only
+// the final step runs at the full working precision.
+
+void mp_fixed_set_ui(MpInt *r, uint32_t value, size_t bits);
+// r = a * b
+void mp_fixed_mul(MpInt *r, const MpInt *a, const MpInt *b, size_t bits);
+// r = a / b, b != 0
+void mp_fixed_div(MpInt *r, const MpInt *a, const MpInt *b, size_t bits);
+
+// r = x^(-1/n) for n in {2, 4} and x > 0
+void mp_fixed_inv_root(MpInt *r, const MpInt *x, unsigned n, size_t bits);
+// r = sqrt(x), x >= 0
+void mp_fixed_sqrt(MpInt *r, const MpInt *x, size_t bits);
+// r = x^(1/4), x >= 0
+void mp_fixed_root4(MpInt *r, const MpInt *x, size_t bits);
+
+// floor(x * 10^decimals), the scaled integer the digit formatter expects
+void mp_fixed_to_decimal_scaled(MpInt *r, const MpInt *x, long long decimals, size_t bits);
+
+#endif
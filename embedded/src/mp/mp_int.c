@@ -0,0 +1,872 @@
+#include "mp_int.h"
+#include "mp_ntt.h"
+
+///////////////// Limb buffers /////////////////
+// MpInt storage comes from the size-class pools; kernel temporaries come
+// from the scratch arena and are released with their enclosing scope.
+static mp_limb_t *mp_limbs_alloc(size_t n, size_t *capacity) {
+    return mp_pool_alloc(n ? n : 1, capacity);
+}
+
+static void mp_limbs_free(mp_limb_t *p) {
+    mp_pool_free(p);
+}
+
+static mp_limb_t *mp_scratch_alloc(size_t n) {
+    return (mp_limb_t *)mp_arena_alloc(n * sizeof(mp_limb_t));
+}
+
+///////////////// Natural-number kernels (mpn) /////////////////
+static size_t mpn_normalized_size(const mp_limb_t *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) n--;
+    return n;
+}
+
+static int mpn_cmp(const mp_limb_t *a, size_t an, const mp_limb_t *b, size_t bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (size_t i = an; i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// r = a + b with an >= bn; returns the carry out of limb an-1
+static mp_limb_t mpn_add(mp_limb_t *r, const mp_limb_t *a, size_t an,
+                         const mp_limb_t *b, size_t bn) {
+    mp_dlimb_t carry = 0;
+    size_t i;
+    for (i = 0; i < bn; i++) {
+        carry += (mp_dlimb_t)a[i] + b[i];
+        r[i] = (mp_limb_t)carry;
+        carry >>= MP_LIMB_BITS;
+    }
+    for (; i < an; i++) {
+        carry += a[i];
+        r[i] = (mp_limb_t)carry;
+        carry >>= MP_LIMB_BITS;
+    }
+    return (mp_limb_t)carry;
+}
+
+// r = a - b with a >= b; returns the final borrow
+static mp_limb_t mpn_sub(mp_limb_t *r, const mp_limb_t *a, size_t an,
+                         const mp_limb_t *b, size_t bn) {
+    mp_limb_t borrow = 0;
+    size_t i;
+    for (i = 0; i < bn; i++) {
+        mp_dlimb_t d = (mp_dlimb_t)a[i] - b[i] - borrow;
+        r[i] = (mp_limb_t)d;
+        borrow = (mp_limb_t)(d >> 63);
+    }
+    for (; i < an; i++) {
+        mp_dlimb_t d = (mp_dlimb_t)a[i] - borrow;
+        r[i] = (mp_limb_t)d;
+        borrow = (mp_limb_t)(d >> 63);
+    }
+    return borrow;
+}
+
+// r[0..n) += a[0..n) * m; returns the carry limb
+static mp_limb_t mpn_addmul_1(mp_limb_t *r, const mp_limb_t *a, size_t n, mp_limb_t m) {
+    mp_dlimb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        carry += (mp_dlimb_t)a[i] * m + r[i];
+        r[i] = (mp_limb_t)carry;
+        carry >>= MP_LIMB_BITS;
+    }
+    return (mp_limb_t)carry;
+}
+
+static void mpn_mul_basecase(mp_limb_t *r, const mp_limb_t *a, size_t an,
+                             const mp_limb_t *b, size_t bn) {
+    memset(r, 0, (an + bn) * sizeof(mp_limb_t));
+    for (size_t j = 0; j < bn; j++) {
+        r[j + an] = mpn_addmul_1(r + j, a, an, b[j]);
+    }
+}
+
+static void mpn_mul(mp_limb_t *r, const mp_limb_t *a, size_t an,
+                    const mp_limb_t *b, size_t bn);
+static void mpn_mul_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, size_t n);
+
+// Karatsuba: three half-size products instead of four
+static void mpn_mul_karatsuba(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, size_t n) {
+    size_t lo = n / 2;
+    size_t hi = n - lo;
+    size_t m = hi + 1;
+
+    MpArenaMark scope = mp_arena_mark();
+    mp_limb_t *sa = mp_scratch_alloc(m);
+    mp_limb_t *sb = mp_scratch_alloc(m);
+    mp_limb_t *mid = mp_scratch_alloc(2 * m);
+
+    sa[hi] = mpn_add(sa, a + lo, hi, a, lo);
+    sb[hi] = mpn_add(sb, b + lo, hi, b, lo);
+    mpn_mul_n(mid, sa, sb, m);
+
+    mpn_mul_n(r, a, b, lo);
+    mpn_mul_n(r + 2 * lo, a + lo, b + lo, hi);
+
+    // mid = (a0 + a1)(b0 + b1) - a0*b0 - a1*b1 = a0*b1 + a1*b0
+    mpn_sub(mid, mid, 2 * m, r, 2 * lo);
+    mpn_sub(mid, mid, 2 * m, r + 2 * lo, 2 * hi);
+    size_t mid_size = mpn_normalized_size(mid, 2 * m);
+    if (mid_size > 0) {
+        mpn_add(r + lo, r + lo, 2 * n - lo, mid, mid_size);
+    }
+
+    mp_arena_release(scope);
+}
+
+static void mp_set_limbs(MpInt *x, const mp_limb_t *limbs, size_t n) {
+    n = mpn_normalized_size(limbs, n);
+    mp_reserve(x, n);
+    if (n > 0) memcpy(x->limbs, limbs, n * sizeof(mp_limb_t));
+    x->size = n;
+    x->negative = 0;
+}
+
+// r[offset..rn) += c for a non-negative c
+static void mpn_add_at(mp_limb_t *r, size_t rn, size_t offset, const MpInt *c) {
+    if (c->size > 0) {
+        mpn_add(r + offset, r + offset, rn - offset, c->limbs, c->size);
+    }
+}
+
+// Toom-3: five third-size products evaluated at 0, 1, -1, 2 and infinity
+static void mpn_mul_toom3(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, size_t n) {
+    size_t k = (n + 2) / 3;
+    size_t top = n - 2 * k;
+
+    MpInt a0, a1, a2, b0, b1, b2, p, q, t, s;
+    MpInt r0, r1, rm1, r2, rinf;
+    MpInt *all[] = {&a0, &a1, &a2, &b0, &b1, &b2, &p, &q, &t, &s,
+                    &r0, &r1, &rm1, &r2, &rinf};
+    size_t count = sizeof(all) / sizeof(all[0]);
+    for (size_t i = 0; i < count; i++) mp_init(all[i]);
+
+    mp_set_limbs(&a0, a, k);
+    mp_set_limbs(&a1, a + k, k);
+    mp_set_limbs(&a2, a + 2 * k, top);
+    mp_set_limbs(&b0, b, k);
+    mp_set_limbs(&b1, b + k, k);
+    mp_set_limbs(&b2, b + 2 * k, top);
+
+    mp_mul(&r0, &a0, &b0);
+    mp_mul(&rinf, &a2, &b2);
+
+    // Points 1 and -1 share a0 + a2
+    mp_add(&t, &a0, &a2);
+    mp_add(&s, &b0, &b2);
+    mp_add(&p, &t, &a1);
+    mp_add(&q, &s, &b1);
+    mp_mul(&r1, &p, &q);
+    mp_sub(&p, &t, &a1);
+    mp_sub(&q, &s, &b1);
+    mp_mul(&rm1, &p, &q);
+
+    // Point 2: a0 + 2*a1 + 4*a2
+    mp_shl(&p, &a2, 1);
+    mp_add(&p, &p, &a1);
+    mp_shl(&p, &p, 1);
+    mp_add(&p, &p, &a0);
+    mp_shl(&q, &b2, 1);
+    mp_add(&q, &q, &b1);
+    mp_shl(&q, &q, 1);
+    mp_add(&q, &q, &b0);
+    mp_mul(&r2, &p, &q);
+
+    // Interpolation; every coefficient is non-negative
+    // c2 = (r1 + rm1)/2 - c0 - c4
+    mp_add(&t, &r1, &rm1);
+    mp_shr(&t, &t, 1);
+    mp_sub(&t, &t, &r0);
+    mp_sub(&t, &t, &rinf);
+    // s = (r1 - rm1)/2 = c1 + c3
+    mp_sub(&s, &r1, &rm1);
+    mp_shr(&s, &s, 1);
+    // p = (r2 - c0 - 4*c2 - 16*c4)/2 = c1 + 4*c3
+    mp_sub(&p, &r2, &r0);
+    mp_shl(&q, &t, 2);
+    mp_sub(&p, &p, &q);
+    mp_shl(&q, &rinf, 4);
+    mp_sub(&p, &p, &q);
+    mp_shr(&p, &p, 1);
+    // c3 = (p - s)/3, c1 = s - c3
+    mp_sub(&p, &p, &s);
+    mp_div_ui(&p, &p, 3);
+    mp_sub(&s, &s, &p);
+
+    size_t rn = 2 * n;
+    memset(r, 0, rn * sizeof(mp_limb_t));
+    mpn_add_at(r, rn, 0, &r0);
+    mpn_add_at(r, rn, k, &s);
+    mpn_add_at(r, rn, 2 * k, &t);
+    mpn_add_at(r, rn, 3 * k, &p);
+    mpn_add_at(r, rn, 4 * k, &rinf);
+
+    for (size_t i = 0; i < count; i++) mp_clear(all[i]);
+}
+
+// Balanced product of two n-limb operands into 2n limbs
+static void mpn_mul_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, size_t n) {
+    if (n < MP_KARATSUBA_THRESHOLD) {
+        mpn_mul_basecase(r, a, n, b, n);
+    } else if (n < MP_TOOM3_THRESHOLD) {
+        mpn_mul_karatsuba(r, a, b, n);
+    } else if (n < MP_NTT_THRESHOLD || 2 * n > mp_ntt_max_limbs()) {
+        mpn_mul_toom3(r, a, b, n);
+    } else {
+        mpn_mul_ntt(r, a, n, b, n);
+    }
+}
+
+// r = a * b with an >= bn >= 1; r must not overlap the operands
+static void mpn_mul(mp_limb_t *r, const mp_limb_t *a, size_t an,
+                    const mp_limb_t *b, size_t bn) {
+    if (bn < MP_KARATSUBA_THRESHOLD) {
+        mpn_mul_basecase(r, a, an, b, bn);
+        return;
+    }
+    if (an == bn) {
+        mpn_mul_n(r, a, b, an);
+        return;
+    }
+    // The transform handles unbalanced operands directly
+    if (bn >= MP_NTT_THRESHOLD && an + bn <= mp_ntt_max_limbs()) {
+        mpn_mul_ntt(r, a, an, b, bn);
+        return;
+    }
+
+    // Unbalanced: multiply bn-sized slices of a and accumulate
+    MpArenaMark scope = mp_arena_mark();
+    mp_limb_t *tmp = mp_scratch_alloc(2 * bn);
+    memset(r, 0, (an + bn) * sizeof(mp_limb_t));
+    for (size_t offset = 0; offset < an; offset += bn) {
+        size_t len = (an - offset < bn) ? an - offset : bn;
+        if (len == bn) {
+            mpn_mul_n(tmp, a + offset, b, bn);
+        } else {
+            mpn_mul(tmp, b, bn, a + offset, len);
+        }
+        mpn_add(r + offset, r + offset, len + bn, tmp, len + bn);
+    }
+    mp_arena_release(scope);
+}
+
+static int mp_clz32(mp_limb_t x) {
+    int n = 0;
+    while (!(x & 0x80000000u)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+
+// Knuth algorithm D: q[0..m-n] = u / v, r[0..n) = u % v, with m >= n >= 2
+static void mpn_divrem_schoolbook(mp_limb_t *q, mp_limb_t *r,
+                                  const mp_limb_t *u, size_t m,
+                                  const mp_limb_t *v, size_t n) {
+    const mp_dlimb_t base = (mp_dlimb_t)1 << MP_LIMB_BITS;
+    int s = mp_clz32(v[n - 1]);
+    MpArenaMark scope = mp_arena_mark();
+    mp_limb_t *vn = mp_scratch_alloc(n);
+    mp_limb_t *un = mp_scratch_alloc(m + 1);
+
+    for (size_t i = n - 1; i > 0; i--) {
+        vn[i] = (v[i] << s) | (mp_limb_t)((mp_dlimb_t)v[i - 1] >> (MP_LIMB_BITS - s));
+    }
+    vn[0] = v[0] << s;
+
+    un[m] = (mp_limb_t)((mp_dlimb_t)u[m - 1] >> (MP_LIMB_BITS - s));
+    for (size_t i = m - 1; i > 0; i--) {
+        un[i] = (u[i] << s) | (mp_limb_t)((mp_dlimb_t)u[i - 1] >> (MP_LIMB_BITS - s));
+    }
+    un[0] = u[0] << s;
+
+    for (size_t jj = m - n + 1; jj-- > 0;) {
+        size_t j = jj;
+        mp_dlimb_t num = ((mp_dlimb_t)un[j + n] << MP_LIMB_BITS) | un[j + n - 1];
+        mp_dlimb_t qhat = num / vn[n - 1];
+        mp_dlimb_t rhat = num - qhat * vn[n - 1];
+
+        while (qhat >= base ||
+               qhat * vn[n - 2] > ((rhat << MP_LIMB_BITS) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >= base) break;
+        }
+
+        // Multiply and subtract
+        int64_t borrow = 0;
+        int64_t t;
+        for (size_t i = 0; i < n; i++) {
+            mp_dlimb_t p = qhat * vn[i];
+            t = (int64_t)un[i + j] - borrow - (int64_t)(p & 0xFFFFFFFFu);
+            un[i + j] = (mp_limb_t)t;
+            borrow = (int64_t)(p >> MP_LIMB_BITS) - (t >> MP_LIMB_BITS);
+        }
+        t = (int64_t)un[j + n] - borrow;
+        un[j + n] = (mp_limb_t)t;
+
+        q[j] = (mp_limb_t)qhat;
+        if (t < 0) {
+            // Estimate was one too large: add back
+            q[j]--;
+            mp_dlimb_t carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                carry += (mp_dlimb_t)un[i + j] + vn[i];
+                un[i + j] = (mp_limb_t)carry;
+                carry >>= MP_LIMB_BITS;
+            }
+            un[j + n] += (mp_limb_t)carry;
+        }
+    }
+
+    if (r != NULL) {
+        for (size_t i = 0; i + 1 < n; i++) {
+            r[i] = (un[i] >> s) | (mp_limb_t)((mp_dlimb_t)un[i + 1] << (MP_LIMB_BITS - s));
+        }
+        r[n - 1] = un[n - 1] >> s;
+    }
+
+    mp_arena_release(scope);
+}
+
+///////////////// Lifecycle /////////////////
+void mp_init(MpInt *x) {
+    x->limbs = NULL;
+    x->size = 0;
+    x->capacity = 0;
+    x->negative = 0;
+}
+
+void mp_clear(MpInt *x) {
+    mp_limbs_free(x->limbs);
+    mp_init(x);
+}
+
+void mp_reserve(MpInt *x, size_t limbs) {
+    if (limbs <= x->capacity) return;
+    // Size classes round up to a power of two, which keeps growth geometric
+    size_t capacity;
+    mp_limb_t *grown = mp_limbs_alloc(limbs, &capacity);
+    if (x->limbs != NULL) memcpy(grown, x->limbs, x->capacity * sizeof(mp_limb_t));
+    mp_limbs_free(x->limbs);
+    x->limbs = grown;
+    x->capacity = capacity;
+}
+
+void mp_swap(MpInt *a, MpInt *b) {
+    MpInt t = *a;
+    *a = *b;
+    *b = t;
+}
+
+// Replace x's storage with a freshly computed buffer of n limbs
+static void mp_take_limbs(MpInt *x, mp_limb_t *limbs, size_t n, size_t capacity, int negative) {
+    mp_limbs_free(x->limbs);
+    x->limbs = limbs;
+    x->capacity = capacity;
+    x->size = mpn_normalized_size(limbs, n);
+    x->negative = x->size ? negative : 0;
+}
+
+static void mp_normalize(MpInt *x) {
+    x->size = mpn_normalized_size(x->limbs, x->size);
+    if (x->size == 0) x->negative = 0;
+}
+
+///////////////// Assignment and conversion /////////////////
+void mp_set_ui(MpInt *x, uint64_t value) {
+    mp_reserve(x, 2);
+    x->limbs[0] = (mp_limb_t)value;
+    x->limbs[1] = (mp_limb_t)(value >> MP_LIMB_BITS);
+    x->size = 2;
+    x->negative = 0;
+    mp_normalize(x);
+}
+
+void mp_set_si(MpInt *x, int64_t value) {
+    uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+    mp_set_ui(x, magnitude);
+    x->negative = (value < 0);
+}
+
+void mp_copy(MpInt *dst, const MpInt *src) {
+    if (dst == src) return;
+    mp_reserve(dst, src->size);
+    if (src->size > 0) memcpy(dst->limbs, src->limbs, src->size * sizeof(mp_limb_t));
+    dst->size = src->size;
+    dst->negative = src->negative;
+}
+
+int mp_set_decimal(MpInt *x, const char *str) {
+    int negative = 0;
+    if (*str == '-') {
+        negative = 1;
+        str++;
+    }
+    if (*str == '\0') return -1;
+
+    mp_set_ui(x, 0);
+    while (*str) {
+        uint32_t chunk = 0;
+        uint32_t scale = 1;
+        for (int i = 0; i < 9 && *str; i++, str++) {
+            if (*str < '0' || *str > '9') return -1;
+            chunk = chunk * 10 + (uint32_t)(*str - '0');
+            scale *= 10;
+        }
+        mp_mul_ui(x, x, scale);
+        mp_add_ui(x, x, chunk);
+    }
+    x->negative = negative && x->size > 0;
+    return 0;
+}
+
+// Write |x| < 10^width as exactly width digits, most significant first
+static void mp_write_decimal_block(const MpInt *x, char *out, size_t width) {
+    MpInt t;
+    mp_init(&t);
+    mp_copy(&t, x);
+    t.negative = 0;
+
+    size_t pos = width;
+    while (pos > 0) {
+        uint32_t chunk = mp_div_ui(&t, &t, 1000000000u);
+        for (int i = 0; i < 9 && pos > 0; i++) {
+            out[--pos] = (char)('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+    mp_clear(&t);
+}
+
+// Divide-and-conquer radix conversion: split by 10^(width/2) and recurse
+static void mp_write_decimal_rec(const MpInt *x, const MpInt *powers, int level,
+                                 char *out, size_t width) {
+    if (level < 0 || x->size <= MP_DECIMAL_BASE_LIMBS) {
+        mp_write_decimal_block(x, out, width);
+        return;
+    }
+    MpInt q, r;
+    mp_init(&q);
+    mp_init(&r);
+    mp_divmod(&q, &r, x, &powers[level]);
+    size_t half = width / 2;
+    mp_write_decimal_rec(&q, powers, level - 1, out, half);
+    mp_write_decimal_rec(&r, powers, level - 1, out + half, half);
+    mp_clear(&q);
+    mp_clear(&r);
+}
+
+char *mp_to_decimal(const MpInt *x) {
+    if (x->size == 0) {
+        char *zero = (char *)malloc(2);
+        if (zero) strcpy(zero, "0");
+        return zero;
+    }
+
+    MpInt abs_x = *x;
+    abs_x.negative = 0;
+
+    // powers[i] = 10^(9 * 2^i), grown until powers[top]^2 > |x|
+    MpInt powers[64];
+    int top = 0;
+    mp_init(&powers[0]);
+    mp_set_ui(&powers[0], 1000000000u);
+    while (2 * (mp_bit_length(&powers[top]) - 1) < mp_bit_length(&abs_x) && top < 63) {
+        mp_init(&powers[top + 1]);
+        mp_mul(&powers[top + 1], &powers[top], &powers[top]);
+        top++;
+    }
+
+    size_t width = (size_t)18 << top;
+    char *buffer = (char *)malloc(width + 2);
+    if (buffer == NULL) {
+        for (int i = 0; i <= top; i++) mp_clear(&powers[i]);
+        return NULL;
+    }
+    mp_write_decimal_rec(&abs_x, powers, top, buffer + 1, width);
+    for (int i = 0; i <= top; i++) mp_clear(&powers[i]);
+
+    size_t skip = 1;
+    while (skip < width && buffer[skip] == '0') skip++;
+    size_t start = skip;
+    if (x->negative) buffer[--start] = '-';
+    size_t len = width + 1 - start;
+    memmove(buffer, buffer + start, len);
+    buffer[len] = '\0';
+    return buffer;
+}
+
+///////////////// Comparison /////////////////
+int mp_is_zero(const MpInt *x) {
+    return x->size == 0;
+}
+
+int mp_cmp_abs(const MpInt *a, const MpInt *b) {
+    return mpn_cmp(a->limbs, a->size, b->limbs, b->size);
+}
+
+int mp_cmp(const MpInt *a, const MpInt *b) {
+    if (a->negative != b->negative) return a->negative ? -1 : 1;
+    int c = mp_cmp_abs(a, b);
+    return a->negative ? -c : c;
+}
+
+size_t mp_bit_length(const MpInt *x) {
+    if (x->size == 0) return 0;
+    return x->size * MP_LIMB_BITS - (size_t)mp_clz32(x->limbs[x->size - 1]);
+}
+
+///////////////// Arithmetic /////////////////
+// r = (-1)^a_neg |a| + (-1)^b_neg |b|
+static void mp_add_signed(MpInt *r, const MpInt *a, int a_neg, const MpInt *b, int b_neg) {
+    if (a->size < b->size) {
+        const MpInt *t = a;
+        a = b;
+        b = t;
+        int tn = a_neg;
+        a_neg = b_neg;
+        b_neg = tn;
+    }
+    size_t an = a->size, bn = b->size;
+
+    if (a_neg == b_neg) {
+        mp_reserve(r, an + 1);
+        mp_limb_t carry = mpn_add(r->limbs, a->limbs, an, b->limbs, bn);
+        r->limbs[an] = carry;
+        r->size = an + 1;
+        r->negative = a_neg;
+    } else if (mpn_cmp(a->limbs, an, b->limbs, bn) >= 0) {
+        mp_reserve(r, an);
+        mpn_sub(r->limbs, a->limbs, an, b->limbs, bn);
+        r->size = an;
+        r->negative = a_neg;
+    } else {
+        // |b| > |a| with bn == an
+        mp_reserve(r, bn);
+        mpn_sub(r->limbs, b->limbs, bn, a->limbs, an);
+        r->size = bn;
+        r->negative = b_neg;
+    }
+    mp_normalize(r);
+}
+
+void mp_add(MpInt *r, const MpInt *a, const MpInt *b) {
+    mp_add_signed(r, a, a->negative, b, b->negative);
+}
+
+void mp_sub(MpInt *r, const MpInt *a, const MpInt *b) {
+    mp_add_signed(r, a, a->negative, b, !b->negative);
+}
+
+void mp_add_ui(MpInt *r, const MpInt *a, uint32_t value) {
+    mp_limb_t limb = value;
+    MpInt v = {&limb, value ? 1u : 0u, 1, 0};
+    mp_add(r, a, &v);
+}
+
+void mp_sub_ui(MpInt *r, const MpInt *a, uint32_t value) {
+    mp_limb_t limb = value;
+    MpInt v = {&limb, value ? 1u : 0u, 1, 0};
+    mp_sub(r, a, &v);
+}
+
+void mp_mul(MpInt *r, const MpInt *a, const MpInt *b) {
+    if (a->size == 0 || b->size == 0) {
+        r->size = 0;
+        r->negative = 0;
+        return;
+    }
+    if (a->size < b->size) {
+        const MpInt *t = a;
+        a = b;
+        b = t;
+    }
+    size_t n = a->size + b->size;
+    size_t capacity;
+    mp_limb_t *limbs = mp_limbs_alloc(n, &capacity);
+    mpn_mul(limbs, a->limbs, a->size, b->limbs, b->size);
+    mp_take_limbs(r, limbs, n, capacity, a->negative != b->negative);
+}
+
+void mp_mul_ui(MpInt *r, const MpInt *a, uint32_t value) {
+    size_t n = a->size;
+    int negative = a->negative;
+    mp_reserve(r, n + 1);
+    mp_dlimb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        carry += (mp_dlimb_t)a->limbs[i] * value;
+        r->limbs[i] = (mp_limb_t)carry;
+        carry >>= MP_LIMB_BITS;
+    }
+    r->limbs[n] = (mp_limb_t)carry;
+    r->size = n + 1;
+    r->negative = negative;
+    mp_normalize(r);
+}
+
+void mp_mul_si(MpInt *r, const MpInt *a, int64_t value) {
+    uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+    if (magnitude <= 0xFFFFFFFFu) {
+        int negative = a->negative;
+        mp_mul_ui(r, a, (uint32_t)magnitude);
+        r->negative = r->size ? (negative != (value < 0)) : 0;
+        return;
+    }
+    MpInt v;
+    mp_init(&v);
+    mp_set_si(&v, value);
+    mp_mul(r, a, &v);
+    mp_clear(&v);
+}
+
+uint32_t mp_div_ui(MpInt *q, const MpInt *a, uint32_t divisor) {
+    size_t n = a->size;
+    int negative = a->negative;
+    if (q != NULL) mp_reserve(q, n);
+    const mp_limb_t *src = a->limbs;
+    mp_dlimb_t rem = 0;
+    for (size_t i = n; i-- > 0;) {
+        rem = (rem << MP_LIMB_BITS) | src[i];
+        if (q != NULL) q->limbs[i] = (mp_limb_t)(rem / divisor);
+        rem %= divisor;
+    }
+    if (q != NULL) {
+        q->size = n;
+        q->negative = negative;
+        mp_normalize(q);
+    }
+    return (uint32_t)rem;
+}
+
+void mp_shl(MpInt *r, const MpInt *a, size_t bits) {
+    if (a->size == 0) {
+        r->size = 0;
+        r->negative = 0;
+        return;
+    }
+    size_t limb_shift = bits / MP_LIMB_BITS;
+    int bit_shift = (int)(bits % MP_LIMB_BITS);
+    size_t n = a->size + limb_shift + 1;
+    size_t capacity;
+    mp_limb_t *limbs = mp_limbs_alloc(n, &capacity);
+    memset(limbs, 0, limb_shift * sizeof(mp_limb_t));
+    limbs[n - 1] = 0;
+    for (size_t i = 0; i < a->size; i++) {
+        mp_dlimb_t v = (mp_dlimb_t)a->limbs[i] << bit_shift;
+        limbs[i + limb_shift] = (i > 0 ? limbs[i + limb_shift] : 0) | (mp_limb_t)v;
+        limbs[i + limb_shift + 1] = (mp_limb_t)(v >> MP_LIMB_BITS);
+    }
+    mp_take_limbs(r, limbs, n, capacity, a->negative);
+}
+
+void mp_shr(MpInt *r, const MpInt *a, size_t bits) {
+    size_t limb_shift = bits / MP_LIMB_BITS;
+    int bit_shift = (int)(bits % MP_LIMB_BITS);
+    if (limb_shift >= a->size) {
+        r->size = 0;
+        r->negative = 0;
+        return;
+    }
+    size_t n = a->size - limb_shift;
+    int negative = a->negative;
+    mp_reserve(r, n);
+    const mp_limb_t *src = a->limbs + limb_shift;
+    for (size_t i = 0; i < n; i++) {
+        mp_dlimb_t v = src[i];
+        if (i + 1 < n) v |= (mp_dlimb_t)src[i + 1] << MP_LIMB_BITS;
+        r->limbs[i] = (mp_limb_t)(v >> bit_shift);
+    }
+    r->size = n;
+    r->negative = negative;
+    mp_normalize(r);
+}
+
+void mp_pow_ui(MpInt *r, uint32_t base, uint64_t exponent) {
+    MpInt result, power;
+    mp_init(&result);
+    mp_init(&power);
+    mp_set_ui(&result, 1);
+    mp_set_ui(&power, base);
+    while (exponent > 0) {
+        if (exponent & 1) mp_mul(&result, &result, &power);
+        exponent >>= 1;
+        if (exponent > 0) mp_mul(&power, &power, &power);
+    }
+    mp_swap(r, &result);
+    mp_clear(&result);
+    mp_clear(&power);
+}
+
+///////////////// Division /////////////////
+// Schoolbook division of magnitudes a >= b > 0
+static void mp_divmod_schoolbook(MpInt *q, MpInt *r, const MpInt *a, const MpInt *b) {
+    if (b->size == 1) {
+        MpInt tq;
+        mp_init(&tq);
+        uint32_t rem = mp_div_ui(&tq, a, b->limbs[0]);
+        tq.negative = 0;
+        if (r != NULL) mp_set_ui(r, rem);
+        if (q != NULL) mp_swap(q, &tq);
+        mp_clear(&tq);
+        return;
+    }
+    size_t m = a->size, n = b->size;
+    size_t q_capacity, r_capacity;
+    mp_limb_t *ql = mp_limbs_alloc(m - n + 1, &q_capacity);
+    mp_limb_t *rl = mp_limbs_alloc(n, &r_capacity);
+    mpn_divrem_schoolbook(ql, rl, a->limbs, m, b->limbs, n);
+    if (q != NULL) mp_take_limbs(q, ql, m - n + 1, q_capacity, 0);
+    else mp_limbs_free(ql);
+    if (r != NULL) mp_take_limbs(r, rl, n, r_capacity, 0);
+    else mp_limbs_free(rl);
+}
+
+// r ~= 2^(bitlen(b) + k) / b, accurate to a few units, via Newton iteration
+// with the working precision doubling at each level of recursion
+static void mp_reciprocal(MpInt *r, const MpInt *b, size_t k) {
+    size_t m = mp_bit_length(b);
+    size_t shift = (m > k + 64) ? m - k - 64 : 0;
+    size_t mt = m - shift;
+
+    MpInt bt, t, e, one;
+    mp_init(&bt);
+    mp_init(&t);
+    mp_init(&e);
+    mp_init(&one);
+    mp_shr(&bt, b, shift);
+    mp_set_ui(&one, 1);
+    mp_shl(&one, &one, mt + k);
+
+    if (k <= (size_t)MP_LIMB_BITS * MP_NEWTON_DIV_THRESHOLD) {
+        mp_divmod_schoolbook(r, NULL, &one, &bt);
+    } else {
+        size_t h = k / 2 + 8;
+        mp_reciprocal(&t, &bt, h);
+        mp_shl(&t, &t, k - h);
+        // r = r0 + r0 * (2^(mt+k) - bt*r0) / 2^(mt+k)
+        mp_mul(&e, &bt, &t);
+        mp_sub(&e, &one, &e);
+        mp_mul(&e, &t, &e);
+        mp_shr(&e, &e, mt + k);
+        mp_add(r, &t, &e);
+    }
+
+    mp_clear(&bt);
+    mp_clear(&t);
+    mp_clear(&e);
+    mp_clear(&one);
+}
+
+// Newton division of magnitudes a >= b > 0: q = a * (1/b), then correct
+static void mp_divmod_newton(MpInt *q, MpInt *r, const MpInt *a, const MpInt *b) {
+    size_t n = mp_bit_length(a), m = mp_bit_length(b);
+    size_t k = n - m + 2;
+
+    MpInt inv, t;
+    mp_init(&inv);
+    mp_init(&t);
+    mp_reciprocal(&inv, b, k);
+    mp_mul(&t, a, &inv);
+    mp_shr(q, &t, m + k);
+    mp_mul(&t, q, b);
+    mp_sub(r, a, &t);
+
+    while (r->negative) {
+        mp_sub_ui(q, q, 1);
+        mp_add(r, r, b);
+    }
+    while (mp_cmp(r, b) >= 0) {
+        mp_add_ui(q, q, 1);
+        mp_sub(r, r, b);
+    }
+    mp_clear(&inv);
+    mp_clear(&t);
+}
+
+void mp_divmod(MpInt *q, MpInt *r, const MpInt *a, const MpInt *b) {
+    if (b->size == 0) {
+        fprintf(stderr, "mp_int: division by zero\n");
+        abort();
+    }
+    int q_negative = a->negative != b->negative;
+    int r_negative = a->negative;
+
+    // Magnitude views sharing the operands' limbs
+    MpInt abs_a = *a, abs_b = *b;
+    abs_a.negative = 0;
+    abs_b.negative = 0;
+
+    MpInt tq, tr;
+    mp_init(&tq);
+    mp_init(&tr);
+    if (mpn_cmp(abs_a.limbs, abs_a.size, abs_b.limbs, abs_b.size) < 0) {
+        mp_copy(&tr, &abs_a);
+    } else if (abs_b.size >= MP_NEWTON_DIV_THRESHOLD &&
+               abs_a.size - abs_b.size >= MP_NEWTON_DIV_THRESHOLD) {
+        mp_divmod_newton(&tq, &tr, &abs_a, &abs_b);
+    } else {
+        mp_divmod_schoolbook(&tq, &tr, &abs_a, &abs_b);
+    }
+    tq.negative = tq.size ? q_negative : 0;
+    tr.negative = tr.size ? r_negative : 0;
+
+    if (q != NULL) mp_swap(q, &tq);
+    if (r != NULL) mp_swap(r, &tr);
+    mp_clear(&tq);
+    mp_clear(&tr);
+}
+
+///////////////// Square root /////////////////
+void mp_sqrt(MpInt *r, const MpInt *a) {
+    size_t bits = mp_bit_length(a);
+    if (bits <= 52) {
+        uint64_t v = a->size ? a->limbs[0] : 0;
+        if (a->size > 1) v |= (uint64_t)a->limbs[1] << MP_LIMB_BITS;
+        uint64_t s = (uint64_t)sqrt((double)v);
+        while (s * s > v) s--;
+        while ((s + 1) * (s + 1) <= v) s++;
+        mp_set_ui(r, s);
+        return;
+    }
+
+    // Recurse on the top half of the bits, then one full-precision Newton step
+    size_t shift = bits / 4;
+    MpInt x, t, rem;
+    mp_init(&x);
+    mp_init(&t);
+    mp_init(&rem);
+    mp_shr(&t, a, 2 * shift);
+    mp_sqrt(&x, &t);
+    mp_shl(&x, &x, shift);
+
+    mp_divmod(&t, NULL, a, &x);
+    mp_add(&x, &x, &t);
+    mp_shr(&x, &x, 1);
+
+    // rem = a - x^2; step x by one until 0 <= rem <= 2x
+    mp_mul(&t, &x, &x);
+    mp_sub(&rem, a, &t);
+    while (rem.negative) {
+        mp_sub_ui(&x, &x, 1);
+        mp_shl(&t, &x, 1);
+        mp_add(&rem, &rem, &t);
+        mp_add_ui(&rem, &rem, 1);
+    }
+    mp_shl(&t, &x, 1);
+    while (mp_cmp(&rem, &t) > 0) {
+        mp_add_ui(&t, &t, 1);
+        mp_sub(&rem, &rem, &t);
+        mp_add_ui(&x, &x, 1);
+        mp_shl(&t, &x, 1);
+    }
+
+    mp_swap(r, &x);
+    mp_clear(&x);
+    mp_clear(&t);
+    mp_clear(&rem);
+}
@@ -0,0 +1,64 @@
+#ifndef MP_INT_H
+#define MP_INT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "../constants.h"
+#include "mp_alloc.h"
+
+typedef uint32_t mp_limb_t;
+typedef uint64_t mp_dlimb_t;
+
+#define MP_LIMB_BITS 32
+
+// Signed arbitrary-precision integer stored as little-endian 32-bit limbs.
+// size == 0 represents zero; limbs[size - 1] is never zero otherwise.
+typedef struct {
+    mp_limb_t *limbs;
+    size_t size;
+    size_t capacity;
+    int negative;
+} MpInt;
+
+///////////////// Lifecycle /////////////////
+void mp_init(MpInt *x);
+void mp_clear(MpInt *x);
+void mp_reserve(MpInt *x, size_t limbs);
+void mp_swap(MpInt *a, MpInt *b);
+
+///////////////// Assignment and conversion /////////////////
+void mp_set_ui(MpInt *x, uint64_t value);
+void mp_set_si(MpInt *x, int64_t value);
+void mp_copy(MpInt *dst, const MpInt *src);
+int mp_set_decimal(MpInt *x, const char *str);
+char *mp_to_decimal(const MpInt *x);
+
+///////////////// Comparison /////////////////
+int mp_is_zero(const MpInt *x);
+int mp_cmp(const MpInt *a, const MpInt *b);
+int mp_cmp_abs(const MpInt *a, const MpInt *b);
+size_t mp_bit_length(const MpInt *x);
+
+///////////////// Arithmetic /////////////////
+void mp_add(MpInt *r, const MpInt *a, const MpInt *b);
+void mp_sub(MpInt *r, const MpInt *a, const MpInt *b);
+void mp_add_ui(MpInt *r, const MpInt *a, uint32_t value);
+void mp_sub_ui(MpInt *r, const MpInt *a, uint32_t value);
+void mp_mul(MpInt *r, const MpInt *a, const MpInt *b);
+void mp_mul_ui(MpInt *r, const MpInt *a, uint32_t value);
+void mp_mul_si(MpInt *r, const MpInt *a, int64_t value);
+uint32_t mp_div_ui(MpInt *q, const MpInt *a, uint32_t divisor);
+void mp_shl(MpInt *r, const MpInt *a, size_t bits);
+void mp_shr(MpInt *r, const MpInt *a, size_t bits);
+void mp_pow_ui(MpInt *r, uint32_t base, uint64_t exponent);
+
+// Truncating division: q = trunc(a / b), r = a - q * b. Either output may be NULL.
+void mp_divmod(MpInt *q, MpInt *r, const MpInt *a, const MpInt *b);
+
+// Floor square root of a non-negative integer
+void mp_sqrt(MpInt *r, const MpInt *a);
+
+#endif
@@ -0,0 +1,354 @@
+#include "mp_ntt.h"
+#include <unistd.h>
+
+// 2^(27|26|26) divides p - 1; product ~ 2^90.5 exceeds 2^26 * (2^32)^2
+static const uint32_t NTT_MODULI[3] = {2013265921u, 1811939329u, 469762049u};
+static const uint32_t NTT_ROOTS[3] = {31u, 13u, 3u};
+
+static uint64_t pow_mod(uint64_t base, uint64_t exponent, uint64_t p) {
+    uint64_t result = 1;
+    base %= p;
+    while (exponent > 0) {
+        if (exponent & 1) result = result * base % p;
+        base = base * base % p;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+static void ntt_prime_init(NttPrime *m, uint32_t p, uint32_t root) {
+    m->p = p;
+    m->root = root;
+    uint32_t inv = p;  // Newton iteration for p^-1 mod 2^32
+    for (int i = 0; i < 5; i++) inv *= 2u - p * inv;
+    m->p_inv = inv;
+    uint64_t r = ((uint64_t)1 << 32) % p;
+    m->r2 = (uint32_t)(r * r % p);
+}
+
+// Transform buffers live in the calling thread's scratch arena
+static uint32_t *ntt_alloc(size_t n) {
+    return (uint32_t *)mp_arena_alloc(n * sizeof(uint32_t));
+}
+
+// Per-stage twiddles: table[len + j] = w^(j * n / (2 len)) for j < len, in
+// Montgomery form; each stage's roots are every other root of the stage above
+static void ntt_twiddles(uint32_t *table, size_t n, uint32_t w, const NttPrime *m) {
+    uint32_t wm = mont_mul(w, m->r2, m);
+    uint32_t cur = mont_mul(1, m->r2, m);
+    uint32_t *top = table + n / 2;
+    for (size_t j = 0; j < n / 2; j++) {
+        top[j] = cur;
+        cur = mont_mul(cur, wm, m);
+    }
+    for (size_t len = n / 4; len >= 1; len >>= 1) {
+        for (size_t j = 0; j < len; j++) table[len + j] = table[2 * len + 2 * j];
+    }
+}
+
+// Cyclic convolution of a and b modulo one prime; result (plain form) in out
+static void ntt_convolve(uint32_t *out, const mp_limb_t *a, size_t an,
+                         const mp_limb_t *b, size_t bn, size_t n, int log2n,
+                         const NttPrime *m) {
+    uint32_t w = (uint32_t)pow_mod(m->root, (m->p - 1) >> log2n, m->p);
+    uint32_t w_inv = (uint32_t)pow_mod(w, m->p - 2, m->p);
+    uint32_t n_inv = (uint32_t)pow_mod(n, m->p - 2, m->p);
+    const NttKernels *kernels = ntt_kernels(cpu_level());
+    MpArenaMark scope = mp_arena_mark();
+    uint32_t *twiddles = ntt_alloc(n);
+
+    // Limbs may exceed p; the Montgomery multiply by r2 reduces them
+    memcpy(out, a, an * sizeof(uint32_t));
+    memset(out + an, 0, (n - an) * sizeof(uint32_t));
+    kernels->scale(out, an, m->r2, m);
+
+    ntt_twiddles(twiddles, n, w, m);
+    kernels->forward(out, n, twiddles, m);
+
+    if (a == b && an == bn) {
+        kernels->pointwise(out, out, n, m);
+    } else {
+        uint32_t *tb = ntt_alloc(n);
+        memcpy(tb, b, bn * sizeof(uint32_t));
+        memset(tb + bn, 0, (n - bn) * sizeof(uint32_t));
+        kernels->scale(tb, bn, m->r2, m);
+        kernels->forward(tb, n, twiddles, m);
+        kernels->pointwise(out, tb, n, m);
+    }
+
+    ntt_twiddles(twiddles, n, w_inv, m);
+    kernels->inverse(out, n, twiddles, m);
+    // Leaving Montgomery form and dividing by n in one multiplication
+    kernels->scale(out, n, n_inv, m);
+    mp_arena_release(scope);
+}
+
+///////////////// Out-of-core transform /////////////////
+// Four-step transform for buffers that may live on disk: n = n1 * n2 is
+// viewed as n2 rows of n1. Columns are gathered a block at a time into
+// RAM, transformed and twiddled; rows are transformed in place. Each pass
+// streams through the buffer once, prefetching the next rows and evicting
+// finished ones, and every single transform is row- or column-sized.
+typedef struct {
+    size_t n1, n2;
+    int log2n2;
+    uint32_t w;                // primitive n-th root
+    const uint32_t *row_twiddles;
+    const uint32_t *column_twiddles;
+    size_t columns;            // per gathered block
+    size_t rows;               // per streamed block
+    const NttKernels *kernels;
+    const NttPrime *m;
+} NttBlocked;
+
+static size_t bit_reverse(size_t x, int bits) {
+    size_t r = 0;
+    for (int i = 0; i < bits; i++, x >>= 1) r = (r << 1) | (x & 1);
+    return r;
+}
+
+// Rows are streamed in blocks of about MP_OOC_BLOCK_BYTES; gathered column
+// blocks are at least a page wide so each pass reads every page once
+static void ntt_blocked_init(NttBlocked *t, size_t n, int log2n, const NttPrime *m) {
+    t->n2 = (size_t)1 << (log2n / 2);
+    t->n1 = n / t->n2;
+    t->log2n2 = log2n / 2;
+    t->kernels = ntt_kernels(cpu_level());
+    t->m = m;
+    size_t block = MP_OOC_BLOCK_BYTES / sizeof(uint32_t);
+    size_t page = (size_t)sysconf(_SC_PAGESIZE) / sizeof(uint32_t);
+    t->columns = block / t->n2 > page ? block / t->n2 : page;
+    if (t->columns > t->n1) t->columns = t->n1;
+    t->rows = block / t->n1 > 0 ? block / t->n1 : 1;
+}
+
+static void ntt_blocked_roots(NttBlocked *t, uint32_t w, uint32_t *row_twiddles, uint32_t *column_twiddles) {
+    t->w = w;
+    ntt_twiddles(row_twiddles, t->n1, (uint32_t)pow_mod(w, t->n2, t->m->p), t->m);
+    ntt_twiddles(column_twiddles, t->n2, (uint32_t)pow_mod(w, t->n1, t->m->p), t->m);
+    t->row_twiddles = row_twiddles;
+    t->column_twiddles = column_twiddles;
+}
+
+// Apply `pass` (forward or inverse) to every row, streaming
+static void ntt_blocked_rows(const NttBlocked *t, uint32_t *a,
+                             void (*pass)(uint32_t *, size_t, const uint32_t *, const NttPrime *)) {
+    for (size_t row = 0; row < t->n2; row += t->rows) {
+        size_t count = t->n2 - row < t->rows ? t->n2 - row : t->rows;
+        if (row + count < t->n2) mp_pool_prefetch(a, (row + count) * t->n1, t->rows * t->n1);
+        for (size_t r = row; r < row + count; r++) pass(a + r * t->n1, t->n1, t->row_twiddles, t->m);
+        mp_pool_evict(a, row * t->n1, count * t->n1);
+    }
+}
+
+// dst[c * dst_stride + r] = src[r * src_stride + c] for r < rows, c < cols,
+// in tiles so neither side strides through memory a word at a time
+static void ntt_transpose(uint32_t *dst, size_t dst_stride, const uint32_t *src, size_t src_stride,
+                          size_t rows, size_t cols) {
+    const size_t tile = 16;
+    for (size_t r0 = 0; r0 < rows; r0 += tile) {
+        size_t r1 = r0 + tile < rows ? r0 + tile : rows;
+        for (size_t c0 = 0; c0 < cols; c0 += tile) {
+            size_t c1 = c0 + tile < cols ? c0 + tile : cols;
+            for (size_t r = r0; r < r1; r++) {
+                for (size_t c = c0; c < c1; c++) dst[c * dst_stride + r] = src[r * src_stride + c];
+            }
+        }
+    }
+}
+
+// Columns: forward transforms then the twiddle w^(i1 k2), or (inverse,
+// with t->w the inverse root) the twiddle first then inverse transforms.
+// Position j of a transformed column holds k2 = bitrev(j).
+static void ntt_blocked_columns(const NttBlocked *t, uint32_t *a, int inverse) {
+    const NttPrime *m = t->m;
+    MpArenaMark scope = mp_arena_mark();
+    uint32_t *gathered = ntt_alloc(t->columns * t->n2);
+    uint32_t *powers = ntt_alloc(t->n2);
+    uint32_t *reversed = ntt_alloc(t->n2);
+    for (size_t j = 0; j < t->n2; j++) reversed[j] = (uint32_t)bit_reverse(j, t->log2n2);
+    uint32_t w_mont = mont_mul(t->w, m->r2, m);
+    uint32_t one = mont_mul(1, m->r2, m);
+    uint32_t step = mont_mul(1, m->r2, m);  // w^i1 for the current column
+
+    for (size_t column = 0; column < t->n1; column += t->columns) {
+        size_t count = t->n1 - column < t->columns ? t->n1 - column : t->columns;
+        ntt_transpose(gathered, t->n2, a + column, t->n1, t->n2, count);
+        for (size_t c = 0; c < count; c++) {
+            uint32_t *v = gathered + c * t->n2;
+            if (!inverse) t->kernels->forward(v, t->n2, t->column_twiddles, m);
+            // powers[k] = w^(i1 k) in Montgomery form
+            uint32_t cur = one;
+            for (size_t k = 0; k < t->n2; k++) {
+                powers[k] = cur;
+                cur = mont_mul(cur, step, m);
+            }
+            for (size_t j = 1; j < t->n2; j++) v[j] = mont_mul(v[j], powers[reversed[j]], m);
+            if (inverse) t->kernels->inverse(v, t->n2, t->column_twiddles, m);
+            step = mont_mul(step, w_mont, m);
+        }
+        ntt_transpose(a + column, t->n1, gathered, t->n2, count, t->n2);
+        // Every row was touched; let the written pages go
+        mp_pool_evict(a, 0, t->n1 * t->n2);
+    }
+    mp_arena_release(scope);
+}
+
+// Limbs into Montgomery form, zero-padded to n, a block at a time
+static void ntt_blocked_load(const NttBlocked *t, uint32_t *dst, const mp_limb_t *src, size_t len, size_t n) {
+    size_t block = t->rows * t->n1;
+    for (size_t first = 0; first < n; first += block) {
+        size_t count = n - first < block ? n - first : block;
+        size_t copy = first < len ? (len - first < count ? len - first : count) : 0;
+        memcpy(dst + first, src + first, copy * sizeof(uint32_t));
+        memset(dst + first + copy, 0, (count - copy) * sizeof(uint32_t));
+        t->kernels->scale(dst + first, copy, t->m->r2, t->m);
+        mp_pool_evict(dst, first, count);
+    }
+}
+
+// ntt_convolve over pool buffers that may be on disk; tb holds b's
+// transform unless squaring (tb == NULL)
+static void ntt_convolve_blocked(uint32_t *out, uint32_t *tb, const mp_limb_t *a, size_t an,
+                                 const mp_limb_t *b, size_t bn, size_t n, int log2n,
+                                 const NttPrime *m) {
+    uint32_t w = (uint32_t)pow_mod(m->root, (m->p - 1) >> log2n, m->p);
+    uint32_t w_inv = (uint32_t)pow_mod(w, m->p - 2, m->p);
+    uint32_t n_inv = (uint32_t)pow_mod(n, m->p - 2, m->p);
+    NttBlocked t;
+    ntt_blocked_init(&t, n, log2n, m);
+    MpArenaMark scope = mp_arena_mark();
+    uint32_t *row_twiddles = ntt_alloc(t.n1);
+    uint32_t *column_twiddles = ntt_alloc(t.n2);
+
+    ntt_blocked_roots(&t, w, row_twiddles, column_twiddles);
+    ntt_blocked_load(&t, out, a, an, n);
+    ntt_blocked_columns(&t, out, 0);
+    ntt_blocked_rows(&t, out, t.kernels->forward);
+    if (tb != NULL) {
+        ntt_blocked_load(&t, tb, b, bn, n);
+        ntt_blocked_columns(&t, tb, 0);
+        ntt_blocked_rows(&t, tb, t.kernels->forward);
+    }
+
+    size_t block = t.rows * t.n1;
+    const uint32_t *other = tb != NULL ? tb : out;
+    for (size_t first = 0; first < n; first += block) {
+        size_t count = n - first < block ? n - first : block;
+        if (first + count < n) {
+            mp_pool_prefetch(out, first + count, block);
+            mp_pool_prefetch(other, first + count, block);
+        }
+        t.kernels->pointwise(out + first, other + first, count, m);
+        mp_pool_evict(out, first, count);
+        mp_pool_evict(other, first, count);
+    }
+
+    ntt_blocked_roots(&t, w_inv, row_twiddles, column_twiddles);
+    ntt_blocked_rows(&t, out, t.kernels->inverse);
+    ntt_blocked_columns(&t, out, 1);
+    for (size_t first = 0; first < n; first += block) {
+        size_t count = n - first < block ? n - first : block;
+        t.kernels->scale(out + first, count, n_inv, m);
+        mp_pool_evict(out, first, count);
+    }
+    mp_arena_release(scope);
+}
+
+typedef struct {
+    uint32_t *out;
+    const mp_limb_t *a;
+    size_t an;
+    const mp_limb_t *b;
+    size_t bn;
+    size_t n;
+    int log2n;
+    const NttPrime *m;
+    int out_of_core;  // out is a pool buffer; b's transform gets its own
+} NttConvolveJob;
+
+static void ntt_convolve_task(void *arg) {
+    NttConvolveJob *job = (NttConvolveJob *)arg;
+    if (!job->out_of_core) {
+        ntt_convolve(job->out, job->a, job->an, job->b, job->bn, job->n, job->log2n, job->m);
+        return;
+    }
+    int squaring = job->a == job->b && job->an == job->bn;
+    uint32_t *tb = squaring ? NULL : mp_pool_alloc(job->n, NULL);
+    ntt_convolve_blocked(job->out, tb, job->a, job->an, job->b, job->bn, job->n, job->log2n, job->m);
+    mp_pool_free(tb);
+}
+
+const char *mp_ntt_kernel_name(void) {
+    return ntt_kernels(cpu_level())->name;
+}
+
+size_t mp_ntt_max_limbs(void) {
+    return (size_t)1 << MP_NTT_MAX_LOG2;
+}
+
+void mpn_mul_ntt(mp_limb_t *r, const mp_limb_t *a, size_t an, const mp_limb_t *b, size_t bn) {
+    size_t rn = an + bn;
+    int log2n = 0;
+    while (((size_t)1 << log2n) < rn) log2n++;
+    size_t n = (size_t)1 << log2n;
+
+    // Past the memory limit the transforms go to pool buffers, which spill
+    // to disk, and run blocked
+    size_t transform_bytes = (a == b && an == bn ? 3 : 6) * n * sizeof(uint32_t);
+    int out_of_core = n >= MP_OOC_MIN_POINTS && mp_memory_limit() > 0 &&
+                      mp_memory_in_use() + transform_bytes > mp_memory_limit();
+
+    MpArenaMark scope = mp_arena_mark();
+    NttPrime primes[3];
+    uint32_t *residues[3];
+    NttConvolveJob jobs[3];
+    for (int k = 0; k < 3; k++) {
+        ntt_prime_init(&primes[k], NTT_MODULI[k], NTT_ROOTS[k]);
+        residues[k] = out_of_core ? mp_pool_alloc(n, NULL) : ntt_alloc(n);
+        NttConvolveJob job = {residues[k], a, an, b, bn, n, log2n, &primes[k], out_of_core};
+        jobs[k] = job;
+    }
+
+    // The three primes are independent; large transforms run them on the pool
+    if (n >= MP_NTT_PARALLEL_THRESHOLD) {
+        PoolTask tasks[3];
+        for (int k = 1; k < 3; k++) pool_task_spawn(&tasks[k], ntt_convolve_task, &jobs[k]);
+        ntt_convolve_task(&jobs[0]);
+        for (int k = 1; k < 3; k++) pool_task_wait(&tasks[k]);
+    } else {
+        for (int k = 0; k < 3; k++) ntt_convolve_task(&jobs[k]);
+    }
+
+    // Garner CRT: x = v1 + p1*v2 + p1*p2*v3, then carry into 32-bit limbs
+    const uint64_t p1 = NTT_MODULI[0], p2 = NTT_MODULI[1], p3 = NTT_MODULI[2];
+    const uint64_t inv_p1_mod_p2 = pow_mod(p1, p2 - 2, p2);
+    const uint64_t inv_p1p2_mod_p3 = pow_mod(p1 * p2 % p3, p3 - 2, p3);
+    const uint64_t p1_mod_p3 = p1 % p3;
+    const unsigned __int128 p1p2 = (unsigned __int128)p1 * p2;
+
+    unsigned __int128 carry = 0;
+    const size_t block = MP_OOC_BLOCK_BYTES / sizeof(uint32_t);
+    for (size_t i = 0; i < rn; i++) {
+        if (out_of_core && i % block == 0) {
+            // Stream the residues: next block in, finished block out
+            for (int k = 0; k < 3; k++) {
+                if (i > 0) mp_pool_evict(residues[k], i - block, block);
+                mp_pool_prefetch(residues[k], i, block);
+            }
+        }
+        uint64_t v1 = residues[0][i];
+        uint64_t v2 = (residues[1][i] + p2 - v1 % p2) % p2 * inv_p1_mod_p2 % p2;
+        uint64_t partial = (v1 % p3 + v2 % p3 * p1_mod_p3) % p3;
+        uint64_t v3 = (residues[2][i] + p3 - partial) % p3 * inv_p1p2_mod_p3 % p3;
+
+        carry += (unsigned __int128)v1 + (unsigned __int128)p1 * v2 + p1p2 * v3;
+        r[i] = (mp_limb_t)carry;
+        carry >>= MP_LIMB_BITS;
+    }
+
+    if (out_of_core) {
+        for (int k = 0; k < 3; k++) mp_pool_free(residues[k]);
+    }
+    mp_arena_release(scope);
+}
@@ -0,0 +1,21 @@
+#ifndef MP_NTT_H
+#define MP_NTT_H
+
+#include "mp_int.h"
+#include "mp_ntt_kernels.h"
+#include "../pool/compute_pool.h"
+
+// Largest transform is 2^26 points, so products are capped at 2^26 limbs
+// (about 645 million decimal digits).
+#define MP_NTT_MAX_LOG2 26
+
+// Butterfly variant in use for the current CPU level ("avx2", "neon", ...)
+const char *mp_ntt_kernel_name(void);
+
+// Product length the NTT can handle without losing exactness
+size_t mp_ntt_max_limbs(void);
+
+// r[0..an+bn) = a * b via three-prime NTT and CRT; requires an + bn <= mp_ntt_max_limbs()
+void mpn_mul_ntt(mp_limb_t *r, const mp_limb_t *a, size_t an, const mp_limb_t *b, size_t bn);
+
+#endif
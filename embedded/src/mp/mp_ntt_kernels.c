@@ -0,0 +1,192 @@
+#include "mp_ntt_kernels.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define PI_NTT_CONCAT_(a, b) a##_##b
+#define PI_NTT_CONCAT(a, b) PI_NTT_CONCAT_(a, b)
+
+///////////////// Scalar /////////////////
+static void ntt_forward_stage(uint32_t *a, size_t n, size_t len, const uint32_t *w, const NttPrime *m) {
+    for (size_t i = 0; i < n; i += 2 * len) {
+        for (size_t j = 0; j < len; j++) {
+            uint32_t u = a[i + j];
+            uint32_t v = a[i + j + len];
+            a[i + j] = mod_add(u, v, m->p);
+            a[i + j + len] = mont_mul(mod_sub(u, v, m->p), w[j], m);
+        }
+    }
+}
+
+static void ntt_inverse_stage(uint32_t *a, size_t n, size_t len, const uint32_t *w, const NttPrime *m) {
+    for (size_t i = 0; i < n; i += 2 * len) {
+        for (size_t j = 0; j < len; j++) {
+            uint32_t u = a[i + j];
+            uint32_t v = mont_mul(a[i + j + len], w[j], m);
+            a[i + j] = mod_add(u, v, m->p);
+            a[i + j + len] = mod_sub(u, v, m->p);
+        }
+    }
+}
+
+static void ntt_forward_scalar(uint32_t *a, size_t n, const uint32_t *twiddles, const NttPrime *m) {
+    for (size_t len = n / 2; len >= 1; len >>= 1) ntt_forward_stage(a, n, len, twiddles + len, m);
+}
+
+static void ntt_inverse_scalar(uint32_t *a, size_t n, const uint32_t *twiddles, const NttPrime *m) {
+    for (size_t len = 1; len < n; len <<= 1) ntt_inverse_stage(a, n, len, twiddles + len, m);
+}
+
+static void ntt_pointwise_scalar(uint32_t *a, const uint32_t *b, size_t n, const NttPrime *m) {
+    for (size_t i = 0; i < n; i++) a[i] = mont_mul(a[i], b[i], m);
+}
+
+static void ntt_scale_scalar(uint32_t *a, size_t n, uint32_t c, const NttPrime *m) {
+    for (size_t i = 0; i < n; i++) a[i] = mont_mul(a[i], c, m);
+}
+
+static const NttKernels NTT_KERNELS_SCALAR = {
+    "scalar", ntt_forward_scalar, ntt_inverse_scalar, ntt_pointwise_scalar, ntt_scale_scalar
+};
+
+#if defined(__x86_64__)
+// The 32x32->64 multiply (pmuludq) only reads even lanes: odd lanes are
+// shifted down for a second multiply, and the high words of both halves
+// are blended back into one vector.
+
+///////////////// SSE4.2 /////////////////
+__attribute__((target("sse4.2")))
+static inline __m128i mont_mul_sse42(__m128i a, __m128i b, __m128i p, __m128i p_inv) {
+    __m128i t_even = _mm_mul_epu32(a, b);
+    __m128i t_odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    __m128i qp_even = _mm_mul_epu32(_mm_mul_epu32(t_even, p_inv), p);
+    __m128i qp_odd = _mm_mul_epu32(_mm_mul_epu32(t_odd, p_inv), p);
+    __m128i t_hi = _mm_blend_epi16(_mm_srli_epi64(t_even, 32), t_odd, 0xCC);
+    __m128i qp_hi = _mm_blend_epi16(_mm_srli_epi64(qp_even, 32), qp_odd, 0xCC);
+    __m128i r = _mm_sub_epi32(t_hi, qp_hi);
+    return _mm_min_epu32(r, _mm_add_epi32(r, p));
+}
+
+#define NTT_VEC __m128i
+#define NTT_LANES 4
+#define NTT_SUFFIX sse42
+#define NTT_TARGET __attribute__((target("sse4.2")))
+#define NTT_LOAD(ptr) _mm_loadu_si128((const __m128i *)(ptr))
+#define NTT_STORE(ptr, v) _mm_storeu_si128((__m128i *)(ptr), v)
+#define NTT_SET1(x) _mm_set1_epi32((int)(x))
+#define NTT_ADD(a, b) _mm_add_epi32(a, b)
+#define NTT_SUB(a, b) _mm_sub_epi32(a, b)
+#define NTT_MIN(a, b) _mm_min_epu32(a, b)
+#define NTT_MONT_MUL(a, b, p, p_inv) mont_mul_sse42(a, b, p, p_inv)
+#include "mp_ntt_simd.inc"
+
+///////////////// AVX2 /////////////////
+__attribute__((target("avx2")))
+static inline __m256i mont_mul_avx2(__m256i a, __m256i b, __m256i p, __m256i p_inv) {
+    __m256i t_even = _mm256_mul_epu32(a, b);
+    __m256i t_odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i qp_even = _mm256_mul_epu32(_mm256_mul_epu32(t_even, p_inv), p);
+    __m256i qp_odd = _mm256_mul_epu32(_mm256_mul_epu32(t_odd, p_inv), p);
+    __m256i t_hi = _mm256_blend_epi32(_mm256_srli_epi64(t_even, 32), t_odd, 0xAA);
+    __m256i qp_hi = _mm256_blend_epi32(_mm256_srli_epi64(qp_even, 32), qp_odd, 0xAA);
+    __m256i r = _mm256_sub_epi32(t_hi, qp_hi);
+    return _mm256_min_epu32(r, _mm256_add_epi32(r, p));
+}
+
+#define NTT_VEC __m256i
+#define NTT_LANES 8
+#define NTT_SUFFIX avx2
+#define NTT_TARGET __attribute__((target("avx2")))
+#define NTT_LOAD(ptr) _mm256_loadu_si256((const __m256i *)(ptr))
+#define NTT_STORE(ptr, v) _mm256_storeu_si256((__m256i *)(ptr), v)
+#define NTT_SET1(x) _mm256_set1_epi32((int)(x))
+#define NTT_ADD(a, b) _mm256_add_epi32(a, b)
+#define NTT_SUB(a, b) _mm256_sub_epi32(a, b)
+#define NTT_MIN(a, b) _mm256_min_epu32(a, b)
+#define NTT_MONT_MUL(a, b, p, p_inv) mont_mul_avx2(a, b, p, p_inv)
+#include "mp_ntt_simd.inc"
+
+///////////////// AVX-512 /////////////////
+__attribute__((target("avx512f")))
+static inline __m512i mont_mul_avx512(__m512i a, __m512i b, __m512i p, __m512i p_inv) {
+    __m512i t_even = _mm512_mul_epu32(a, b);
+    __m512i t_odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    __m512i qp_even = _mm512_mul_epu32(_mm512_mul_epu32(t_even, p_inv), p);
+    __m512i qp_odd = _mm512_mul_epu32(_mm512_mul_epu32(t_odd, p_inv), p);
+    __m512i t_hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(t_even, 32), t_odd);
+    __m512i qp_hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(qp_even, 32), qp_odd);
+    __m512i r = _mm512_sub_epi32(t_hi, qp_hi);
+    return _mm512_min_epu32(r, _mm512_add_epi32(r, p));
+}
+
+#define NTT_VEC __m512i
+#define NTT_LANES 16
+#define NTT_SUFFIX avx512
+#define NTT_TARGET __attribute__((target("avx512f")))
+#define NTT_LOAD(ptr) _mm512_loadu_si512((const void *)(ptr))
+#define NTT_STORE(ptr, v) _mm512_storeu_si512((void *)(ptr), v)
+#define NTT_SET1(x) _mm512_set1_epi32((int)(x))
+#define NTT_ADD(a, b) _mm512_add_epi32(a, b)
+#define NTT_SUB(a, b) _mm512_sub_epi32(a, b)
+#define NTT_MIN(a, b) _mm512_min_epu32(a, b)
+#define NTT_MONT_MUL(a, b, p, p_inv) mont_mul_avx512(a, b, p, p_inv)
+#include "mp_ntt_simd.inc"
+
+static const NttKernels NTT_KERNELS_SSE42 = {
+    "sse4.2", ntt_forward_sse42, ntt_inverse_sse42, ntt_pointwise_sse42, ntt_scale_sse42
+};
+static const NttKernels NTT_KERNELS_AVX2 = {
+    "avx2", ntt_forward_avx2, ntt_inverse_avx2, ntt_pointwise_avx2, ntt_scale_avx2
+};
+static const NttKernels NTT_KERNELS_AVX512 = {
+    "avx512", ntt_forward_avx512, ntt_inverse_avx512, ntt_pointwise_avx512, ntt_scale_avx512
+};
+#endif
+
+#if defined(__aarch64__)
+///////////////// NEON /////////////////
+// vmull widens two lanes at a time; uzp1/uzp2 gather the low and high words
+static inline uint32x4_t mont_mul_neon(uint32x4_t a, uint32x4_t b, uint32x4_t p, uint32x4_t p_inv) {
+    uint32x4_t t_lo = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(a), vget_low_u32(b)));
+    uint32x4_t t_hi = vreinterpretq_u32_u64(vmull_high_u32(a, b));
+    uint32x4_t q = vmulq_u32(vuzp1q_u32(t_lo, t_hi), p_inv);
+    uint32x4_t qp_lo = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(q), vget_low_u32(p)));
+    uint32x4_t qp_hi = vreinterpretq_u32_u64(vmull_high_u32(q, p));
+    uint32x4_t r = vsubq_u32(vuzp2q_u32(t_lo, t_hi), vuzp2q_u32(qp_lo, qp_hi));
+    return vminq_u32(r, vaddq_u32(r, p));
+}
+
+#define NTT_VEC uint32x4_t
+#define NTT_LANES 4
+#define NTT_SUFFIX neon
+#define NTT_TARGET
+#define NTT_LOAD(ptr) vld1q_u32(ptr)
+#define NTT_STORE(ptr, v) vst1q_u32(ptr, v)
+#define NTT_SET1(x) vdupq_n_u32(x)
+#define NTT_ADD(a, b) vaddq_u32(a, b)
+#define NTT_SUB(a, b) vsubq_u32(a, b)
+#define NTT_MIN(a, b) vminq_u32(a, b)
+#define NTT_MONT_MUL(a, b, p, p_inv) mont_mul_neon(a, b, p, p_inv)
+#include "mp_ntt_simd.inc"
+
+static const NttKernels NTT_KERNELS_NEON = {
+    "neon", ntt_forward_neon, ntt_inverse_neon, ntt_pointwise_neon, ntt_scale_neon
+};
+#endif
+
+///////////////// Dispatch /////////////////
+const NttKernels *ntt_kernels(CpuLevel level) {
+    switch (level) {
+#if defined(__x86_64__)
+        case CPU_LEVEL_AVX512: return &NTT_KERNELS_AVX512;
+        case CPU_LEVEL_AVX2: return &NTT_KERNELS_AVX2;
+        case CPU_LEVEL_SSE42: return &NTT_KERNELS_SSE42;
+#endif
+#if defined(__aarch64__)
+        case CPU_LEVEL_NEON: return &NTT_KERNELS_NEON;
+#endif
+        default: return &NTT_KERNELS_SCALAR;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef MP_NTT_KERNELS_H
+#define MP_NTT_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../cpu/cpu_features.h"
+
+// Montgomery arithmetic modulo an NTT-friendly prime p < 2^31 (R = 2^32)
+typedef struct {
+    uint32_t p;
+    uint32_t p_inv;  // p^-1 mod 2^32
+    uint32_t r2;     // 2^64 mod p, converts into Montgomery form
+    uint32_t root;   // primitive root mod p
+} NttPrime;
+
+static inline uint32_t mont_reduce(uint64_t t, const NttPrime *m) {
+    uint32_t q = (uint32_t)t * m->p_inv;
+    uint32_t hi = (uint32_t)(t >> 32);
+    uint32_t qp_hi = (uint32_t)(((uint64_t)q * m->p) >> 32);
+    return (hi >= qp_hi) ? hi - qp_hi : hi - qp_hi + m->p;
+}
+
+static inline uint32_t mont_mul(uint32_t a, uint32_t b, const NttPrime *m) {
+    return mont_reduce((uint64_t)a * b, m);
+}
+
+static inline uint32_t mod_add(uint32_t a, uint32_t b, uint32_t p) {
+    uint32_t s = a + b;
+    return s >= p ? s - p : s;
+}
+
+static inline uint32_t mod_sub(uint32_t a, uint32_t b, uint32_t p) {
+    return a >= b ? a - b : a + p - b;
+}
+
+// Butterfly passes for one instruction-set level. Twiddles are laid out per
+// stage: the stage with half-length len reads twiddles[len .. 2*len), the
+// powers of a primitive (2*len)-th root in Montgomery form.
+typedef struct {
+    const char *name;
+    // Decimation in frequency: natural order in, bit-reversed order out
+    void (*forward)(uint32_t *a, size_t n, const uint32_t *twiddles, const NttPrime *m);
+    // Decimation in time: bit-reversed order in, natural order out (unscaled)
+    void (*inverse)(uint32_t *a, size_t n, const uint32_t *twiddles, const NttPrime *m);
+    // a[i] = a[i] * b[i] (Montgomery); b may equal a
+    void (*pointwise)(uint32_t *a, const uint32_t *b, size_t n, const NttPrime *m);
+    // a[i] = a[i] * c (Montgomery); a[i] may be any 32-bit value, c < p
+    void (*scale)(uint32_t *a, size_t n, uint32_t c, const NttPrime *m);
+} NttKernels;
+
+// Variant for a level; levels not built for this architecture get scalar
+const NttKernels *ntt_kernels(CpuLevel level);
+
+#endif
@@ -0,0 +1,214 @@
+#include "pi_accel.h"
+#include <string.h>
+
+static const char *ACCEL_NAMES[ACCEL_COUNT] = {
+    "euler", "aitken", "richardson", "levin"
+};
+
+///////////////// Series /////////////////
+// A raw series as the transforms see it: terms from index `first` on, and
+// the map from their sum to pi
+typedef struct {
+    long long first;
+    long double (*term)(long long k);
+    long double (*finish)(long double sum);
+} AccelSeries;
+
+static long double leibniz_term(long long k) {
+    return ((k & 1) ? -1.0L : 1.0L) / (2 * k + 1);
+}
+
+static long double leibniz_finish(long double sum) {
+    return 4 * sum;
+}
+
+static long double nilakantha_term(long long k) {
+    return ((k & 1) ? 1.0L : -1.0L) / ((long double)(2 * k) * (2 * k + 1) * (2 * k + 2));
+}
+
+static long double nilakantha_finish(long double sum) {
+    return 4 * sum + 3;
+}
+
+static long double euler_term(long long k) {
+    return 1.0L / ((long double)k * k);
+}
+
+static long double euler_finish(long double sum) {
+    return sqrtl(6 * sum);
+}
+
+static const AccelSeries LEIBNIZ_SERIES = {0, leibniz_term, leibniz_finish};
+static const AccelSeries NILAKANTHA_SERIES = {1, nilakantha_term, nilakantha_finish};
+static const AccelSeries EULER_SERIES = {1, euler_term, euler_finish};
+
+// partial[i] = sum of the first i + 1 terms, for i < count
+static void partial_sums(const AccelSeries *series, long long count, long double *partial) {
+    long double sum = 0.0L;
+    for (long long i = 0; i < count; i++) {
+        sum += series->term(series->first + i);
+        partial[i] = sum;
+    }
+}
+
+///////////////// Transforms /////////////////
+// Averaging neighbouring partial sums until one is left applies binomial
+// weights, i.e. the Euler transform; each pass gains about a bit on an
+// alternating series, so ACCEL_EULER_TERMS passes reach long double
+static long double accel_euler(const AccelSeries *series, long long terms, long long *effective) {
+    long double partial[ACCEL_EULER_TERMS];
+    long long count = terms < ACCEL_EULER_TERMS ? terms : ACCEL_EULER_TERMS;
+    partial_sums(series, count, partial);
+    for (long long length = count; length > 1; length--) {
+        for (long long i = 0; i < length - 1; i++) {
+            partial[i] = (partial[i] + partial[i + 1]) / 2;
+        }
+    }
+    *effective = count;
+    return series->finish(partial[0]);
+}
+
+// Each Aitken pass turns three partial sums into one, cancelling the
+// dominant geometric error; passes repeat while three are left
+static long double accel_aitken(const AccelSeries *series, long long terms, long long *effective) {
+    long double partial[ACCEL_AITKEN_TERMS];
+    long long count = terms < ACCEL_AITKEN_TERMS ? terms : ACCEL_AITKEN_TERMS;
+    partial_sums(series, count, partial);
+    long long length = count;
+    while (length >= 3) {
+        for (long long i = 0; i < length - 2; i++) {
+            long double d1 = partial[i + 1] - partial[i];
+            long double d2 = partial[i + 2] - partial[i + 1];
+            long double curvature = d2 - d1;
+            // A flat difference means the sequence already settled
+            partial[i] = curvature != 0.0L ? partial[i + 2] - d2 * d2 / curvature : partial[i + 2];
+        }
+        length -= 2;
+    }
+    *effective = count;
+    return series->finish(partial[length - 1]);
+}
+
+// Partial sums at n0, 2 n0, 4 n0, ... form a Richardson table in h = 1/n.
+// n0 is kept even: alternating series only have a smooth expansion
+// within one parity.
+static long double accel_richardson(const AccelSeries *series, long long terms, long long *effective) {
+    int levels = 0;
+    while (levels < ACCEL_RICHARDSON_LEVELS && (terms >> (levels + 1)) >= 2) levels++;
+    long long base = (terms >> levels) & ~1LL;
+
+    long double table[ACCEL_RICHARDSON_LEVELS + 1];
+    long double sum = 0.0L;
+    if (base < 2) {
+        // Too few terms for a ladder: the plain partial sum
+        for (long long i = 0; i < terms; i++) sum += series->term(series->first + i);
+        *effective = terms;
+        return series->finish(sum);
+    }
+
+    long long end = base << levels;
+    long long checkpoint = base;
+    int rows = 0;
+    for (long long i = 0; i < end; i++) {
+        sum += series->term(series->first + i);
+        if (i + 1 == checkpoint) {
+            table[rows++] = sum;
+            checkpoint <<= 1;
+        }
+    }
+    // Column j removes the h^j error term; updated in place, bottom up
+    for (int j = 1; j < rows; j++) {
+        long double factor = ldexpl(1.0L, j);
+        for (int i = rows - 1; i >= j; i--) {
+            table[i] = (factor * table[i] - table[i - 1]) / (factor - 1);
+        }
+    }
+    *effective = end;
+    return series->finish(table[rows - 1]);
+}
+
+// Levin u-transform of order k over the first k + 1 partial sums, with
+// remainder estimates w_m = (m + 1) a_m:
+//   sum_j (-1)^j C(k,j) ((j+1)/(k+1))^(k-1) S_j / w_j
+//   -------------------------------------------------
+//   sum_j (-1)^j C(k,j) ((j+1)/(k+1))^(k-1) / w_j
+// The alternating binomial sums cancel about 2^k, which is what bounds
+// the order in long double
+static long double accel_levin(const AccelSeries *series, long long terms, long long *effective) {
+    long long count = terms < ACCEL_LEVIN_TERMS ? terms : ACCEL_LEVIN_TERMS;
+    *effective = count;
+    if (count < 2) {
+        return count < 1 ? 0.0L : series->finish(series->term(series->first));
+    }
+
+    int order = (int)count - 1;
+    long double sum = 0.0L, numerator = 0.0L, denominator = 0.0L;
+    long double binomial = 1.0L;
+    for (int j = 0; j <= order; j++) {
+        long double term = series->term(series->first + j);
+        sum += term;
+        long double remainder = (j + 1) * term;
+        long double weight = binomial * powl((long double)(j + 1) / (order + 1), order - 1);
+        if (j & 1) weight = -weight;
+        numerator += weight * sum / remainder;
+        denominator += weight / remainder;
+        binomial = binomial * (order - j) / (j + 1);
+    }
+    if (denominator == 0.0L) return series->finish(sum);
+    return series->finish(numerator / denominator);
+}
+
+static long double accelerate(const AccelSeries *series, PiAcceleration accel,
+                              long long terms, long long *effective) {
+    long long used = 0;
+    long double estimate = 0.0L;
+    if (terms > 0) {
+        switch (accel) {
+            case ACCEL_EULER: estimate = accel_euler(series, terms, &used); break;
+            case ACCEL_AITKEN: estimate = accel_aitken(series, terms, &used); break;
+            case ACCEL_RICHARDSON: estimate = accel_richardson(series, terms, &used); break;
+            case ACCEL_LEVIN: estimate = accel_levin(series, terms, &used); break;
+            default: break;
+        }
+    }
+    if (effective != NULL) *effective = used;
+    return estimate;
+}
+
+///////////////// Kernels /////////////////
+#define PI_DEFINE_ACCEL(base, SERIES) \
+    long double base##_accel_euler(long long terms, long long *effective) { \
+        return accelerate(&SERIES, ACCEL_EULER, terms, effective); \
+    } \
+    long double base##_accel_aitken(long long terms, long long *effective) { \
+        return accelerate(&SERIES, ACCEL_AITKEN, terms, effective); \
+    } \
+    long double base##_accel_richardson(long long terms, long long *effective) { \
+        return accelerate(&SERIES, ACCEL_RICHARDSON, terms, effective); \
+    } \
+    long double base##_accel_levin(long long terms, long long *effective) { \
+        return accelerate(&SERIES, ACCEL_LEVIN, terms, effective); \
+    }
+
+PI_DEFINE_ACCEL(leibniz, LEIBNIZ_SERIES)
+PI_DEFINE_ACCEL(nilakantha, NILAKANTHA_SERIES)
+PI_DEFINE_ACCEL(euler, EULER_SERIES)
+
+#undef PI_DEFINE_ACCEL
+
+///////////////// Names /////////////////
+int accel_from_name(const char *name, PiAcceleration *accel) {
+    if (name == NULL) return 0;
+    for (int i = 0; i < ACCEL_COUNT; i++) {
+        if (strcmp(name, ACCEL_NAMES[i]) == 0) {
+            *accel = (PiAcceleration)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *accel_name(PiAcceleration accel) {
+    if (accel < 0 || accel >= ACCEL_COUNT) return "unknown";
+    return ACCEL_NAMES[accel];
+}
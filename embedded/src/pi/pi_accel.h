@@ -0,0 +1,47 @@
+#ifndef PI_ACCEL_H
+#define PI_ACCEL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../constants.h"
+
+// Series acceleration: the slowly converging series (leibniz, nilakantha,
+// euler) are summed as usual, and a transform of their partial sums
+// estimates the limit. Selected by ?accel=
+//   euler       Euler-van Wijngaarden: repeated averaging, alternating series
+//   aitken      iterated Aitken delta^2, alternating series
+//   richardson  Richardson extrapolation in 1/n over doubling counts, any
+//               series with an error expansion in powers of 1/n
+//   levin       Levin u-transform, alternating and logarithmic series
+typedef enum {
+    ACCEL_EULER,
+    ACCEL_AITKEN,
+    ACCEL_RICHARDSON,
+    ACCEL_LEVIN,
+    ACCEL_COUNT
+} PiAcceleration;
+
+// Returns 1 and sets *accel for a known name; 0 otherwise
+int accel_from_name(const char *name, PiAcceleration *accel);
+const char *accel_name(PiAcceleration accel);
+
+// Accelerated kernels take the raw term count and report in *effective the
+// terms the transform actually used: Euler, Aitken and Levin saturate after
+// a fixed window (ACCEL_*_TERMS), Richardson uses the largest doubling
+// ladder that fits.
+#define PI_DECLARE_ACCEL(base) \
+    long double base##_accel_euler(long long terms, long long *effective); \
+    long double base##_accel_aitken(long long terms, long long *effective); \
+    long double base##_accel_richardson(long long terms, long long *effective); \
+    long double base##_accel_levin(long long terms, long long *effective);
+
+PI_DECLARE_ACCEL(leibniz)
+PI_DECLARE_ACCEL(nilakantha)
+PI_DECLARE_ACCEL(euler)
+
+// Accelerated entry points for one series in PiAcceleration order
+#define PI_ACCEL_KERNELS(base) { \
+    base##_accel_euler, base##_accel_aitken, base##_accel_richardson, base##_accel_levin }
+
+#endif
@@ -0,0 +1,160 @@
+#include "pi_bbp.h"
+
+typedef unsigned __int128 bbp_u128;
+
+// Fractions in [0, 1) are 128-bit fixed point; wrapping arithmetic is mod 1
+typedef struct {
+    uint64_t m;
+    uint64_t m_neg_inv;  // -m^-1 mod 2^64
+    uint64_t one;        // 2^64 mod m, i.e. 1 in Montgomery form
+} BbpModulus;
+
+///////////////// Montgomery arithmetic /////////////////
+// Odd m < 2^63, so t + q*m never overflows 128 bits
+static inline uint64_t mont_reduce(bbp_u128 t, const BbpModulus *mod) {
+    uint64_t q = (uint64_t)t * mod->m_neg_inv;
+    uint64_t r = (uint64_t)((t + (bbp_u128)q * mod->m) >> 64);
+    return r >= mod->m ? r - mod->m : r;
+}
+
+static void modulus_init(BbpModulus *mod, uint64_t m) {
+    uint64_t inv = m;  // Newton iteration, each step doubles the correct bits
+    for (int i = 0; i < 5; i++) inv *= 2 - m * inv;
+    mod->m = m;
+    mod->m_neg_inv = (uint64_t)0 - inv;
+    mod->one = ((uint64_t)0 - m) % m;
+}
+
+// 2^e mod m: square-and-double, doubling being a modular add in Montgomery form
+static uint64_t pow2_mod(uint64_t e, const BbpModulus *mod) {
+    if (mod->m == 1) return 0;
+    uint64_t x = mod->one;
+    int bit = 63;
+    while (bit >= 0 && !((e >> bit) & 1)) bit--;
+    for (; bit >= 0; bit--) {
+        x = mont_reduce((bbp_u128)x * x, mod);
+        if ((e >> bit) & 1) {
+            x += x;
+            if (x >= mod->m) x -= mod->m;
+        }
+    }
+    return mont_reduce(x, mod);
+}
+
+// floor(2^128 * r / m) for r < m
+static bbp_u128 fraction(uint64_t r, uint64_t m) {
+    bbp_u128 hi_num = (bbp_u128)r << 64;
+    uint64_t hi = (uint64_t)(hi_num / m);
+    uint64_t rem = (uint64_t)(hi_num % m);
+    uint64_t lo = (uint64_t)(((bbp_u128)rem << 64) / m);
+    return ((bbp_u128)hi << 64) | lo;
+}
+
+///////////////// Series /////////////////
+// {16^e / (8k + j)}: with 8k + j = 2^s * m', this is (2^(4e - s) mod m') / m'
+static bbp_u128 head_term(uint64_t e, uint64_t k, int j) {
+    uint64_t m = 8 * k + (uint64_t)j;
+    int s = (j == 4) ? 2 : (j == 6) ? 1 : 0;
+    if (4 * e < (uint64_t)s) return fraction(1, m);  // e == 0: plain 1/m
+    BbpModulus mod;
+    modulus_init(&mod, m >> s);
+    return fraction(pow2_mod(4 * e - (uint64_t)s, &mod), mod.m);
+}
+
+// sum_{k in [k0, k1)} of 4/(8k+1) - 2/(8k+4) - 1/(8k+5) - 1/(8k+6), each scaled by 16^(n-k)
+static bbp_u128 head_sum(uint64_t n, uint64_t k0, uint64_t k1) {
+    bbp_u128 sum = 0;
+    for (uint64_t k = k0; k < k1; k++) {
+        uint64_t e = n - k;
+        sum += head_term(e, k, 1) << 2;
+        sum -= head_term(e, k, 4) << 1;
+        sum -= head_term(e, k, 5);
+        sum -= head_term(e, k, 6);
+    }
+    return sum;
+}
+
+// Terms past k = n shrink by 16 each; after 32 they vanish at 128 bits
+static bbp_u128 tail_sum(uint64_t n) {
+    bbp_u128 sum = 0;
+    for (int d = 1; d < 32; d++) {
+        bbp_u128 scale = (bbp_u128)1 << (128 - 4 * d);
+        uint64_t k = n + (uint64_t)d;
+        sum += (scale / (8 * k + 1)) << 2;
+        sum -= (scale / (8 * k + 4)) << 1;
+        sum -= scale / (8 * k + 5);
+        sum -= scale / (8 * k + 6);
+    }
+    return sum;
+}
+
+typedef struct {
+    uint64_t n;
+    uint64_t k0;
+    uint64_t k1;
+    bbp_u128 sum;
+} BbpBlock;
+
+static void bbp_block_run(void *arg) {
+    BbpBlock *block = (BbpBlock *)arg;
+    block->sum = head_sum(block->n, block->k0, block->k1);
+}
+
+///////////////// Digit extraction /////////////////
+char *bbp_hex_digits(long long position, int count) {
+    if (position < 0 || position > BBP_MAX_POSITION) return NULL;
+    if (count < 1 || count > BBP_MAX_HEX_COUNT) return NULL;
+
+    // One evaluation per BBP_HEX_DIGITS_PER_EVAL digits; each splits its
+    // head sum into blocks so positions and terms both spread over the pool
+    int evals = (count + BBP_HEX_DIGITS_PER_EVAL - 1) / BBP_HEX_DIGITS_PER_EVAL;
+    uint64_t max_terms = (uint64_t)position + (uint64_t)(evals - 1) * BBP_HEX_DIGITS_PER_EVAL + 1;
+    uint64_t blocks_per_eval = (max_terms + BBP_MIN_TERMS_PER_TASK - 1) / BBP_MIN_TERMS_PER_TASK;
+    uint64_t max_blocks = (uint64_t)compute_pool_size() * 4;
+    if (blocks_per_eval > max_blocks) blocks_per_eval = max_blocks;
+
+    size_t total = (size_t)evals * blocks_per_eval;
+    BbpBlock *blocks = (BbpBlock *)malloc(total * sizeof(BbpBlock));
+    PoolTask *tasks = (PoolTask *)malloc(total * sizeof(PoolTask));
+    char *hex = (char *)malloc((size_t)count + 1);
+    if (blocks == NULL || tasks == NULL || hex == NULL) {
+        free(blocks);
+        free(tasks);
+        free(hex);
+        return NULL;
+    }
+
+    for (int i = 0; i < evals; i++) {
+        uint64_t n = (uint64_t)position + (uint64_t)i * BBP_HEX_DIGITS_PER_EVAL;
+        uint64_t terms = n + 1;
+        for (uint64_t b = 0; b < blocks_per_eval; b++) {
+            BbpBlock *block = &blocks[(size_t)i * blocks_per_eval + b];
+            block->n = n;
+            block->k0 = terms * b / blocks_per_eval;
+            block->k1 = terms * (b + 1) / blocks_per_eval;
+            block->sum = 0;
+        }
+    }
+    for (size_t t = 1; t < total; t++) pool_task_spawn(&tasks[t], bbp_block_run, &blocks[t]);
+    bbp_block_run(&blocks[0]);
+    for (size_t t = 1; t < total; t++) pool_task_wait(&tasks[t]);
+
+    static const char HEX[] = "0123456789ABCDEF";
+    for (int i = 0; i < evals; i++) {
+        bbp_u128 frac = tail_sum(blocks[(size_t)i * blocks_per_eval].n);
+        for (uint64_t b = 0; b < blocks_per_eval; b++) frac += blocks[(size_t)i * blocks_per_eval + b].sum;
+
+        // Leading nibbles are exact; the low 64 bits absorb rounding error
+        for (int d = 0; d < BBP_HEX_DIGITS_PER_EVAL; d++) {
+            int index = i * BBP_HEX_DIGITS_PER_EVAL + d;
+            if (index >= count) break;
+            hex[index] = HEX[(int)(frac >> 124)];
+            frac <<= 4;
+        }
+    }
+    hex[count] = '\0';
+
+    free(blocks);
+    free(tasks);
+    return hex;
+}
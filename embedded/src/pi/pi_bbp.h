@@ -0,0 +1,20 @@
+#ifndef PI_BBP_H
+#define PI_BBP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../pool/compute_pool.h"
+#include "../constants.h"
+
+// Bailey-Borwein-Plouffe digit extraction: the fractional part of 16^n * pi
+// from modular exponentiation alone, so hex digits at an arbitrary position
+// come out without computing any of the digits before them.
+
+// `count` hex digits of pi starting `position` places after the hexadecimal
+// point (position 0 -> "243F6A88..."); malloc'd uppercase string, or NULL
+// when position/count are out of range.
+char *bbp_hex_digits(long long position, int count);
+
+#endif
@@ -1,12 +1,45 @@
 #include "pi_calculations.h"
+#include <string.h>
 
 ///////////////// Probability /////////////////
+static __thread unsigned long long random_seed;
+static __thread int random_seeded;
+
+void pi_random_seed(unsigned long long seed) {
+    random_seed = seed;
+    random_seeded = 1;
+}
+
+// Generator state for one kernel call: splitmix64 of the thread's seed,
+// which moves on so back-to-back calls differ; never 0
+static unsigned long long random_state_for_call(void) {
+    if (!random_seeded) {
+        random_seed = (unsigned long long)time(NULL) ^ (unsigned long long)(size_t)&random_seed;
+        random_seeded = 1;
+    }
+    unsigned long long z = (random_seed += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z != 0 ? z : 1;
+}
+
+// xorshift64*: uniform in [0, 1) from the top 53 bits
+static inline double random_unit(unsigned long long *state) {
+    unsigned long long x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return (double)((x * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
 long double monte_carlo(long long iterations) {
     long long circle_points = 0;
-    srandom(time(NULL));
+    unsigned long long state = random_state_for_call();
     for(long long i = 0; i < iterations; i++) {
-        double rand_x = (double)rand() / RAND_MAX;
-        double rand_y = (double)rand() / RAND_MAX;
+        double rand_x = random_unit(&state);
+        double rand_y = random_unit(&state);
         
         double origin = rand_x * rand_x + rand_y * rand_y;
         
@@ -20,12 +53,11 @@ long double monte_carlo(long long iterations) {
 
 long double buffon(long long needles){
     long long crosses = 0;
-    
-    srandom(time(NULL));
+    unsigned long long state = random_state_for_call();
 
     for(long long i=0; i < needles; ++i){
-        long double center = (long double)rand() / RAND_MAX * 0.5L;
-        long double angle = (long double)rand() / RAND_MAX * (PI_REFERENCE/2.0L);
+        long double center = (long double)random_unit(&state) * 0.5L;
+        long double angle = (long double)random_unit(&state) * (PI_REFERENCE/2.0L);
         if(center <= 0.5L * sin(angle)){
             crosses++;
         }   
@@ -39,11 +71,11 @@ long double buffon(long long needles){
 
 long double pi_coprimes(long long pairs) {
     long long coprimes = 0;
-    srand(time(NULL));
+    unsigned long long state = random_state_for_call();
     
     for(long long i = 0; i < pairs; i++) {
-        long long a = rand() % 1000000 + 1;
-        long long b = rand() % 1000000 + 1;
+        long long a = (long long)(random_unit(&state) * 1000000.0) + 1;
+        long long b = (long long)(random_unit(&state) * 1000000.0) + 1;
         
         // Inline GCD calculation
         long long x = a, y = b;
@@ -58,28 +90,106 @@ long double pi_coprimes(long long pairs) {
     
     return sqrtl(6.0L / ((long double)coprimes / pairs));
 }
+///////////////// Incremental evaluation /////////////////
+// Each kernel below keeps its running values in a PiSeriesState; the
+// one-shot functions are init + advance + estimate, so both paths perform
+// the same operations in the same order and agree bit for bit.
+
+long double pi_evaluate(const PiIncremental *series, long long terms, long long *effective) {
+    PiSeriesState state;
+    series->init(&state);
+    series->advance(&state, terms);
+    if (effective != NULL) *effective = state.effective;
+    return series->estimate(&state);
+}
+
+static long double run_incremental(const PiIncremental *kernel, long long terms) {
+    return pi_evaluate(kernel, terms, NULL);
+}
+
+static void series_init(PiSeriesState *state) {
+    memset(state, 0, sizeof(*state));
+}
+
+// Once converged, further terms only move the count
+static int series_converged(PiSeriesState *state, long long terms) {
+    if (state->effective >= state->count) return 0;
+    if (terms > 0) state->count += terms;
+    return 1;
+}
+
+// Record where an advance ended: `stop` is the first term left out, or
+// `end` if every term was needed
+static void series_finish(PiSeriesState *state, long long terms, long long stop, long long end) {
+    if (terms <= 0) return;
+    state->count = end;
+    state->effective = stop;
+}
+
+// A perturbation of at most `bound` cannot move `value` by more than a
+// quarter ulp, so the rest of the series is below working precision. The
+// series pass the term they are about to add, so the check is a compare
+// and no extra division in the hot loop
+static int below_precision(long double bound, long double value) {
+    return fabsl(bound) <= fabsl(value) * LDBL_EPSILON * 0.25L;
+}
+
 ///////////////// Infinite series /////////////////
-long double leibniz(long long terms){
-    long double sum=0.0L;
-    for(long long k=0; k < terms; ++k){
+// No early exit: the first term left out, 4/(2k+1), only drops below
+// long double precision near k ~ 1e19, far beyond MAX_ITERATIONS, and the
+// check would cost a compare in the hot loop for nothing
+static void leibniz_advance(PiSeriesState *state, long long terms) {
+    long double sum = state->sum;
+    long long end = state->count + terms;
+    for(long long k = state->count; k < end; ++k){
         sum += powl(-1, k)/ (2*k+1); 
     }
-    return 4*sum;
+    state->sum = sum;
+    series_finish(state, terms, end, end);
 }
 
-long double euler(long long terms){
-    long double sum=0.0L;
-    for(long long k= 1; k < terms; ++k){
+static long double leibniz_estimate(const PiSeriesState *state) {
+    return 4*state->sum;
+}
+
+static const PiIncremental LEIBNIZ_INCREMENTAL = {series_init, leibniz_advance, leibniz_estimate};
+
+long double leibniz(long long terms){
+    return run_incremental(&LEIBNIZ_INCREMENTAL, terms);
+}
+
+// Sums k = 1 .. count-1, matching euler(count). No early exit: terms are
+// lost to rounding only past k ~ 4.7e9, beyond MAX_ITERATIONS, so the check
+// would only slow the hot loop
+static void euler_advance(PiSeriesState *state, long long terms) {
+    long double sum = state->sum;
+    long long end = state->count + terms;
+    for(long long k = state->count > 1 ? state->count : 1; k < end; ++k){
         sum += 1.0L/(k*k); 
     }
-    return sqrtl(6*sum);
+    state->sum = sum;
+    series_finish(state, terms, end, end);
 }
 
-long double euler_kahan(long long terms) {
-    long double sum = 0.0L;
-    long double compensation = 0.0L;
+static long double euler_estimate(const PiSeriesState *state) {
+    return sqrtl(6*state->sum);
+}
+
+static const PiIncremental EULER_INCREMENTAL = {series_init, euler_advance, euler_estimate};
+
+long double euler(long long terms){
+    return run_incremental(&EULER_INCREMENTAL, terms);
+}
+
+// Sums k = 1 .. count; aux[0] holds the Kahan compensation. No early exit:
+// the compensation keeps every term, and the tail (~1/count) stays above
+// long double precision far beyond MAX_ITERATIONS
+static void euler_kahan_advance(PiSeriesState *state, long long terms) {
+    long double sum = state->sum;
+    long double compensation = state->aux[0];
+    long long end = state->count + terms;
     
-    for(long long k = 1; k <= terms; ++k) {
+    for(long long k = state->count + 1; k <= end; ++k) {
         long double term = 1.0 / (k * k);
         long double y = term - compensation;
         long double t = sum + y;
@@ -87,88 +197,224 @@ long double euler_kahan(long long terms) {
         sum = t;
     }
     
-    return sqrtl(6.0 * sum);
+    state->sum = sum;
+    state->aux[0] = compensation;
+    series_finish(state, terms, end, end);
 }
 
-long double nilakantha(long long terms){
-    long double sum=0;
-    for(long long k=1; k < terms; ++k){
-        sum += powl(-1, k+1)/ ((2*k)*(2*k+1)*(2*k+2)); 
+static long double euler_kahan_estimate(const PiSeriesState *state) {
+    return sqrtl(6.0 * state->sum);
+}
+
+static const PiIncremental EULER_KAHAN_INCREMENTAL = {series_init, euler_kahan_advance, euler_kahan_estimate};
+
+long double euler_kahan(long long terms) {
+    return run_incremental(&EULER_KAHAN_INCREMENTAL, terms);
+}
+
+// Alternating: the tail is bounded by the first term left out. The
+// denominator is formed in long double, (2k)^3 overflows long long past
+// k ~ 1e6 (exact either way below that)
+static void nilakantha_advance(PiSeriesState *state, long long terms) {
+    if (series_converged(state, terms)) return;
+    long double sum = state->sum;
+    long long end = state->count + terms;
+    long long k;
+    for(k = state->count > 1 ? state->count : 1; k < end; ++k){
+        long double denominator = (long double)(2*k)*(2*k+1)*(2*k+2);
+        long double term = powl(-1, k+1)/ denominator;
+        if (below_precision(4*term, 4*sum + 3)) break;
+        sum += term;
     }
-    return 4*sum + 3;
+    state->sum = sum;
+    series_finish(state, terms, k > end ? end : k, end);
 }
 
-long double ramanujan_fast(long long terms) {
-    if (terms <= 0) return 0.0L;
-   
-    const long double constant_factor = (2.0L * sqrtl(2.0L)) / 9801.0L;
-    long double sum = 1103.0L;
-   
+static long double nilakantha_estimate(const PiSeriesState *state) {
+    return 4*state->sum + 3;
+}
+
+static const PiIncremental NILAKANTHA_INCREMENTAL = {series_init, nilakantha_advance, nilakantha_estimate};
+
+long double nilakantha(long long terms){
+    return run_incremental(&NILAKANTHA_INCREMENTAL, terms);
+}
+
+// aux[0] = (4k)! / (k!)^4, aux[1] = 396^(-4k)
+static void ramanujan_fast_init(PiSeriesState *state) {
+    series_init(state);
+    state->sum = 1103.0L;
+    state->aux[0] = 1.0L;
+    state->aux[1] = 1.0L;
+}
+
+static void ramanujan_fast_advance(PiSeriesState *state, long long terms) {
     const long double base_396_4 = 396.0L * 396.0L * 396.0L * 396.0L;
    
-    long double factorial_ratio = 1.0L;
-    long double inv_power_396 = 1.0L;
+    if (series_converged(state, terms)) return;
+    long double sum = state->sum;
+    long double factorial_ratio = state->aux[0];
+    long double inv_power_396 = state->aux[1];
+    long long end = state->count + terms;
+    long long k;
    
-    for (long long k = 1; k < terms; ++k) {
-        factorial_ratio *= (4*k - 3) * (4*k - 2) * (4*k - 1) * (4*k);
-        factorial_ratio /= (k * k * k * k);
+    // Terms shrink by ~396^-4 * 256: the tail is bounded by the next term
+    for (k = state->count > 1 ? state->count : 1; k < end; ++k) {
+        long double next_ratio = factorial_ratio * (4*k - 3) * (4*k - 2) * (4*k - 1) * (4*k);
+        next_ratio /= (k * k * k * k);
        
-        inv_power_396 /= base_396_4;
+        long double next_power = inv_power_396 / base_396_4;
        
-        long double term = factorial_ratio * inv_power_396 * (1103.0L + 26390.0L * k);
+        long double term = next_ratio * next_power * (1103.0L + 26390.0L * k);
+        if (below_precision(term, sum)) break;
+        factorial_ratio = next_ratio;
+        inv_power_396 = next_power;
         sum += term;
     }
    
-    sum *= constant_factor;
+    state->sum = sum;
+    state->aux[0] = factorial_ratio;
+    state->aux[1] = inv_power_396;
+    series_finish(state, terms, k > end ? end : k, end);
+}
+
+static long double ramanujan_fast_estimate(const PiSeriesState *state) {
+    if (state->count <= 0) return 0.0L;
+    const long double constant_factor = (2.0L * sqrtl(2.0L)) / 9801.0L;
+    long double sum = state->sum * constant_factor;
     return 1.0L / sum;
 }
 
-long double chudnovsky_fast(long long terms) {
-    if (terms <= 0) return 0.0L;
-    const long double C = 426880.0L * sqrtl(10005.0L);
-    long double sum = 0.0L;
+static const PiIncremental RAMANUJAN_FAST_INCREMENTAL = {
+    ramanujan_fast_init, ramanujan_fast_advance, ramanujan_fast_estimate
+};
+
+long double ramanujan_fast(long long terms) {
+    return run_incremental(&RAMANUJAN_FAST_INCREMENTAL, terms);
+}
+
+// aux[0] = (6k)! / ((3k)! (k!)^3), aux[1] = 640320^(-3k), sign = (-1)^k
+static void chudnovsky_fast_init(PiSeriesState *state) {
+    series_init(state);
+    state->aux[0] = 1.0L;
+    state->aux[1] = 1.0L;
+    state->sign = 1;
+}
+
+static void chudnovsky_fast_advance(PiSeriesState *state, long long terms) {
     const long double base_640320_3 = 640320.0L * 640320.0L * 640320.0L;
-    long double factorial_ratio = 1.0L;
-    long double inv_power = 1.0L;
-    long long sign = 1;
+    if (series_converged(state, terms)) return;
+    long double sum = state->sum;
+    long double factorial_ratio = state->aux[0];
+    long double inv_power = state->aux[1];
+    long long sign = state->sign;
+    long long end = state->count + terms;
+    long long k;
    
-    for (long long k = 0; k < terms; ++k) {
+    // Terms shrink by ~10^-14: the tail is bounded by the next term
+    for (k = state->count; k < end; ++k) {
+        long double next_ratio = factorial_ratio;
+        long double next_power = inv_power;
+        long long next_sign = sign;
         if (k > 0) {
-            factorial_ratio *= (6*k - 5) * (6*k - 4) * (6*k - 3) * (6*k - 2) * (6*k - 1) * (6*k);
-            factorial_ratio /= ((3*k - 2) * (3*k - 1) * (3*k) * k * k * k);
+            next_ratio *= (6*k - 5) * (6*k - 4) * (6*k - 3) * (6*k - 2) * (6*k - 1) * (6*k);
+            next_ratio /= ((3*k - 2) * (3*k - 1) * (3*k) * k * k * k);
            
-            inv_power /= base_640320_3;
-            sign = -sign;
+            next_power /= base_640320_3;
+            next_sign = -sign;
         }
-        long double term = sign * factorial_ratio * inv_power * (13591409.0L + 545140134.0L * k);
+        long double term = next_sign * next_ratio * next_power * (13591409.0L + 545140134.0L * k);
+        if (k > 0 && below_precision(term, sum)) break;
+        factorial_ratio = next_ratio;
+        inv_power = next_power;
+        sign = next_sign;
         sum += term;  
     }
-    return C / sum;
+    state->sum = sum;
+    state->aux[0] = factorial_ratio;
+    state->aux[1] = inv_power;
+    state->sign = sign;
+    series_finish(state, terms, k, end);
+}
+
+static long double chudnovsky_fast_estimate(const PiSeriesState *state) {
+    if (state->count <= 0) return 0.0L;
+    const long double C = 426880.0L * sqrtl(10005.0L);
+    return C / state->sum;
+}
+
+static const PiIncremental CHUDNOVSKY_FAST_INCREMENTAL = {
+    chudnovsky_fast_init, chudnovsky_fast_advance, chudnovsky_fast_estimate
+};
+
+long double chudnovsky_fast(long long terms) {
+    return run_incremental(&CHUDNOVSKY_FAST_INCREMENTAL, terms);
 }
 
 ///////////////// Numerical methods /////////////////
-long double gauss_legendre(long long iterations) {
-    long double a = 1.0L;
-    long double b = 1.0L / sqrtl(2.0L);
-    long double t = 0.25L;
-    long double p = 1.0L;
+// aux = {a, b, t, p}
+static void gauss_legendre_init(PiSeriesState *state) {
+    series_init(state);
+    state->aux[0] = 1.0L;
+    state->aux[1] = 1.0L / sqrtl(2.0L);
+    state->aux[2] = 0.25L;
+    state->aux[3] = 1.0L;
+}
+
+// Converged once the next correction to t is below precision; going on
+// would only double p until p * 0 turns into NaN
+static void gauss_legendre_advance(PiSeriesState *state, long long iterations) {
+    if (series_converged(state, iterations)) return;
+    long double a = state->aux[0];
+    long double b = state->aux[1];
+    long double t = state->aux[2];
+    long double p = state->aux[3];
     
-    for(long long i = 0; i < iterations; ++i) {
+    long long i;
+    for(i = 0; i < iterations; ++i) {
         long double a_next = (a + b) / 2.0L;
         long double b_next = sqrtl(a*b);
-        t = t - p * (a - a_next) * (a - a_next);  
+        long double correction = p * (a - a_next) * (a - a_next);
+        if (state->count + i > 0 && below_precision(correction, t)) break;
+        t = t - correction;  
         p *= 2.0L;
         a = a_next; 
         b = b_next; 
     }
-    long double sum=a+b;
-    return sum*sum/(4.0L * t);
+    state->aux[0] = a;
+    state->aux[1] = b;
+    state->aux[2] = t;
+    state->aux[3] = p;
+    series_finish(state, iterations, state->count + i, state->count + iterations);
 }
 
-long double bbp(long long iterations){
-    long double pi = 0.0L;
-    long double power_16 = 1.0L;
-    for(long long k = 0; k < iterations; ++k) {
+static long double gauss_legendre_estimate(const PiSeriesState *state) {
+    long double sum = state->aux[0] + state->aux[1];
+    return sum*sum/(4.0L * state->aux[2]);
+}
+
+static const PiIncremental GAUSS_LEGENDRE_INCREMENTAL = {
+    gauss_legendre_init, gauss_legendre_advance, gauss_legendre_estimate
+};
+
+long double gauss_legendre(long long iterations) {
+    return run_incremental(&GAUSS_LEGENDRE_INCREMENTAL, iterations);
+}
+
+// aux[0] = 16^-k
+static void bbp_init(PiSeriesState *state) {
+    series_init(state);
+    state->aux[0] = 1.0L;
+}
+
+// Terms shrink by 16: the tail is at most 16/15 of the next term
+static void bbp_advance(PiSeriesState *state, long long iterations) {
+    if (series_converged(state, iterations)) return;
+    long double pi = state->sum;
+    long double power_16 = state->aux[0];
+    long long end = state->count + iterations;
+    long long k;
+    for(k = state->count; k < end; ++k) {
         long double k8 = 8.0L * k;
         long double term = power_16 * (
             4.0L / (k8 + 1.0L) -
@@ -176,21 +422,79 @@ long double bbp(long long iterations){
             1.0L / (k8 + 5.0L) -
             1.0L / (k8 + 6.0L)
         );
+        if (k > 0 && below_precision(term * 16.0L / 15.0L, pi)) break;
         pi += term;
         power_16 /= 16.0L;
     }
-    return pi;
+    state->sum = pi;
+    state->aux[0] = power_16;
+    series_finish(state, iterations, k, end);
 }
 
-long double borwein(long long iterations){
-    long double y = sqrtl(2.0L) - 1.0L;
-    long double a = 6.0L - 4*sqrtl(2.0L);
+static long double bbp_estimate(const PiSeriesState *state) {
+    return state->sum;
+}
+
+static const PiIncremental BBP_INCREMENTAL = {bbp_init, bbp_advance, bbp_estimate};
+
+long double bbp(long long iterations){
+    return run_incremental(&BBP_INCREMENTAL, iterations);
+}
+
+// aux = {y, a, 2^(2n+3)}
+static void borwein_init(PiSeriesState *state) {
+    series_init(state);
+    state->aux[0] = sqrtl(2.0L) - 1.0L;
+    state->aux[1] = 6.0L - 4*sqrtl(2.0L);
+    state->aux[2] = 8.0L;
+}
 
-    for(long long n = 0; n < iterations; ++n) {
-        long double y_next = (1 - powl(1 - powl(y, 4), 0.25L)) / (1 + powl(1 - powl(y, 4), 0.25L));
-        long double a_next = a*powl(1 + y_next, 4.0L) - powl(2.0L, 2*n+3) * y_next*(1+y_next+y_next*y_next);
+// Converged once y is too small to move a: the update is a*(1+y)^4 minus
+// scale*y*(...), so (4|a| + 2 scale)|y| bounds it. Going on would grow
+// scale until scale * 0 turns into NaN
+static void borwein_advance(PiSeriesState *state, long long iterations) {
+    if (series_converged(state, iterations)) return;
+    long double y = state->aux[0];
+    long double a = state->aux[1];
+    long double scale = state->aux[2];
+
+    long long n;
+    for(n = 0; n < iterations; ++n) {
+        long double y2 = y * y;
+        long double root = sqrtl(sqrtl(1 - y2 * y2));
+        long double y_next = (1 - root) / (1 + root);
+        if (below_precision((4 * fabsl(a) + 2 * scale) * y_next, a)) break;
+        long double q = (1 + y_next) * (1 + y_next);
+        long double a_next = a * q * q - scale * y_next * (1 + y_next + y_next * y_next);
         y = y_next; 
         a = a_next; 
+        scale *= 4.0L;
     }
-    return 1.0L/a;
+    state->aux[0] = y;
+    state->aux[1] = a;
+    state->aux[2] = scale;
+    series_finish(state, iterations, state->count + n, state->count + iterations);
+}
+
+static long double borwein_estimate(const PiSeriesState *state) {
+    return 1.0L/state->aux[1];
+}
+
+static const PiIncremental BORWEIN_INCREMENTAL = {borwein_init, borwein_advance, borwein_estimate};
+
+long double borwein(long long iterations){
+    return run_incremental(&BORWEIN_INCREMENTAL, iterations);
+}
+
+const PiIncremental *pi_incremental_for(long double (*func)(long long)) {
+    if (func == leibniz) return &LEIBNIZ_INCREMENTAL;
+    if (func == euler) return &EULER_INCREMENTAL;
+    if (func == euler_kahan) return &EULER_KAHAN_INCREMENTAL;
+    if (func == nilakantha) return &NILAKANTHA_INCREMENTAL;
+    if (func == ramanujan_fast) return &RAMANUJAN_FAST_INCREMENTAL;
+    if (func == chudnovsky_fast) return &CHUDNOVSKY_FAST_INCREMENTAL;
+    if (func == gauss_legendre) return &GAUSS_LEGENDRE_INCREMENTAL;
+    if (func == bbp) return &BBP_INCREMENTAL;
+    if (func == borwein) return &BORWEIN_INCREMENTAL;
+    return NULL;
 }
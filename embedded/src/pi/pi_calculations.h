@@ -5,9 +5,47 @@
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include <float.h>
 #include "../constants.h"
 
+///////////////// Incremental evaluation /////////////////
+// Running state of a series or iteration, so a caller can keep adding
+// terms instead of starting over. After advancing by n in total, estimate()
+// equals the one-shot kernel called with n.
+// Kernels stop early once an a-priori bound on the rest of the series (or
+// the next iteration's correction) is below long double precision: count
+// keeps moving, effective stays at the terms that still mattered.
+typedef struct {
+    long long count;      // terms or iterations consumed
+    long long effective;  // terms that changed the estimate, <= count
+    long double sum;
+    long double aux[4];   // kernel-specific running values
+    long long sign;
+} PiSeriesState;
+
+typedef struct {
+    void (*init)(PiSeriesState *state);
+    void (*advance)(PiSeriesState *state, long long terms);
+    long double (*estimate)(const PiSeriesState *state);
+} PiIncremental;
+
+// Incremental form of a one-shot kernel, or NULL (the random methods)
+const PiIncremental *pi_incremental_for(long double (*func)(long long));
+
+// One-shot evaluation through the incremental form; *effective (if not
+// NULL) receives the terms that changed the estimate
+long double pi_evaluate(const PiIncremental *series, long long terms, long long *effective);
+
+// Kernel that may use fewer terms than asked for, reported in *effective
+typedef long double (*CalculatePiCounted)(long long, long long *effective);
+
 ///////////////// Probability /////////////////
+// The random methods draw from a generator local to each call instead of
+// rand(): concurrent calls on the pool neither reseed each other nor queue
+// on glibc's lock, which the thread CPU clock would not see. A call starts
+// from the calling thread's seed (time-based until set) and moves it on, so
+// seeding before a call makes that call reproducible.
+void pi_random_seed(unsigned long long seed);
 long double monte_carlo(long long iterations);
 long double buffon(long long needles);
 long long gcd(long long a, long long b);
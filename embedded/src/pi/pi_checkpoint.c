@@ -0,0 +1,225 @@
+#include "pi_checkpoint.h"
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CHECKPOINT_MAGIC "PICKPT"
+#define CHECKPOINT_VERSION 1
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+// Layout: magic, version, sizeof(CheckpointState), the state, then per
+// value its sign, limb count and limbs, then the FNV-1a checksum of all
+// bytes before it
+typedef struct {
+    FILE *file;
+    uint64_t checksum;
+    int failed;
+} CheckpointStream;
+
+static double elapsed_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void checksum_update(uint64_t *checksum, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t hash = *checksum;
+    for (size_t i = 0; i < length; i++) hash = (hash ^ bytes[i]) * FNV_PRIME;
+    *checksum = hash;
+}
+
+static void stream_write(CheckpointStream *stream, const void *data, size_t length) {
+    if (stream->failed) return;
+    checksum_update(&stream->checksum, data, length);
+    if (fwrite(data, 1, length, stream->file) != length) stream->failed = 1;
+}
+
+static void stream_read(CheckpointStream *stream, void *data, size_t length) {
+    if (stream->failed) return;
+    if (fread(data, 1, length, stream->file) != length) {
+        stream->failed = 1;
+        return;
+    }
+    checksum_update(&stream->checksum, data, length);
+}
+
+///////////////// Scheduling /////////////////
+void checkpoint_init(PiCheckpoint *checkpoint, const char *path, double interval_seconds) {
+    memset(checkpoint, 0, sizeof(*checkpoint));
+    snprintf(checkpoint->path, sizeof(checkpoint->path), "%s", path);
+    checkpoint->interval_seconds = interval_seconds;
+    checkpoint->max_overhead = CHECKPOINT_MAX_OVERHEAD;
+    clock_gettime(CLOCK_MONOTONIC, &checkpoint->last);
+}
+
+int checkpoint_due(PiCheckpoint *checkpoint) {
+    if (checkpoint_stop_requested(checkpoint)) return 1;
+    double spacing = checkpoint->interval_seconds;
+    // A slow disk stretches the interval rather than the runtime
+    if (checkpoint->max_overhead > 0.0) {
+        double minimum = checkpoint->last_write_seconds / checkpoint->max_overhead;
+        if (minimum > spacing) spacing = minimum;
+    }
+    return elapsed_since(&checkpoint->last) >= spacing;
+}
+
+void checkpoint_progress_set(PiCheckpoint *checkpoint, long long done, long long total) {
+    __atomic_store_n(&checkpoint->total, total, __ATOMIC_RELAXED);
+    __atomic_store_n(&checkpoint->done, done, __ATOMIC_RELAXED);
+}
+
+double checkpoint_progress(const PiCheckpoint *checkpoint) {
+    long long total = __atomic_load_n(&checkpoint->total, __ATOMIC_RELAXED);
+    long long done = __atomic_load_n(&checkpoint->done, __ATOMIC_RELAXED);
+    return total > 0 ? (double)done / (double)total : 0.0;
+}
+
+int checkpoint_stop_requested(const PiCheckpoint *checkpoint) {
+    return __atomic_load_n(&checkpoint->stop, __ATOMIC_ACQUIRE);
+}
+
+void checkpoint_request_stop(PiCheckpoint *checkpoint) {
+    __atomic_store_n(&checkpoint->stop, 1, __ATOMIC_RELEASE);
+}
+
+///////////////// Writing /////////////////
+// Make a rename durable: fsync the directory holding `path`
+static void sync_directory(const char *path) {
+    char directory[CHECKPOINT_PATH_LENGTH];
+    snprintf(directory, sizeof(directory), "%s", path);
+    char *slash = strrchr(directory, '/');
+    if (slash == NULL) snprintf(directory, sizeof(directory), ".");
+    else if (slash == directory) slash[1] = '\0';
+    else *slash = '\0';
+    int fd = open(directory, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+int checkpoint_save(PiCheckpoint *checkpoint, const CheckpointState *state, const MpInt *const *values) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    char temporary[CHECKPOINT_PATH_LENGTH + 8], previous[CHECKPOINT_PATH_LENGTH + 8];
+    snprintf(temporary, sizeof(temporary), "%s.tmp", checkpoint->path);
+    snprintf(previous, sizeof(previous), "%s.prev", checkpoint->path);
+
+    CheckpointStream stream = {fopen(temporary, "wb"), FNV_OFFSET, 0};
+    if (stream.file == NULL) return -1;
+    // Limbs go straight from the numbers into stdio's buffer
+    setvbuf(stream.file, NULL, _IOFBF, CHECKPOINT_BUFFER_BYTES);
+
+    int version = CHECKPOINT_VERSION;
+    int state_size = (int)sizeof(CheckpointState);
+    stream_write(&stream, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    stream_write(&stream, &version, sizeof(version));
+    stream_write(&stream, &state_size, sizeof(state_size));
+    stream_write(&stream, state, sizeof(*state));
+    for (int i = 0; i < state->count; i++) {
+        uint32_t negative = values[i]->negative ? 1 : 0;
+        uint64_t size = values[i]->size;
+        stream_write(&stream, &negative, sizeof(negative));
+        stream_write(&stream, &size, sizeof(size));
+        stream_write(&stream, values[i]->limbs, values[i]->size * sizeof(mp_limb_t));
+    }
+    uint64_t checksum = stream.checksum;
+    stream_write(&stream, &checksum, sizeof(checksum));
+
+    // One fsync per checkpoint, after everything is written
+    long long bytes = stream.failed ? 0 : (long long)ftell(stream.file);
+    if (fflush(stream.file) != 0 || fsync(fileno(stream.file)) != 0) stream.failed = 1;
+    if (fclose(stream.file) != 0) stream.failed = 1;
+    if (stream.failed) {
+        unlink(temporary);
+        return -1;
+    }
+    rename(checkpoint->path, previous);  // fails harmlessly on the first one
+    if (rename(temporary, checkpoint->path) != 0) {
+        unlink(temporary);
+        return -1;
+    }
+    sync_directory(checkpoint->path);
+
+    double seconds = elapsed_since(&start);
+    checkpoint->last_write_seconds = seconds;
+    // Only this thread writes them; job status reads them concurrently
+    double write_seconds = checkpoint->write_seconds + seconds;
+    __atomic_store(&checkpoint->write_seconds, &write_seconds, __ATOMIC_RELAXED);
+    __atomic_store_n(&checkpoint->bytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&checkpoint->checkpoints, 1, __ATOMIC_RELAXED);
+    clock_gettime(CLOCK_MONOTONIC, &checkpoint->last);
+    return 0;
+}
+
+///////////////// Reading /////////////////
+// Read one file, verifying its checksum; values may be NULL to only check
+static int load_file(const char *path, CheckpointState *state, MpInt *values, int max_values) {
+    CheckpointStream stream = {fopen(path, "rb"), FNV_OFFSET, 0};
+    if (stream.file == NULL) return -1;
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    int version = 0, state_size = 0;
+    stream_read(&stream, magic, sizeof(magic));
+    stream_read(&stream, &version, sizeof(version));
+    stream_read(&stream, &state_size, sizeof(state_size));
+    if (stream.failed || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 ||
+        version != CHECKPOINT_VERSION || state_size != (int)sizeof(CheckpointState)) {
+        fclose(stream.file);
+        return -1;
+    }
+    stream_read(&stream, state, sizeof(*state));
+    if (stream.failed || state->count < 0 || state->count > CHECKPOINT_MAX_VALUES ||
+        (values != NULL && state->count > max_values)) {
+        fclose(stream.file);
+        return -1;
+    }
+
+    MpInt scratch;
+    mp_init(&scratch);
+    for (int i = 0; i < state->count && !stream.failed; i++) {
+        MpInt *value = values != NULL ? &values[i] : &scratch;
+        uint32_t negative = 0;
+        uint64_t size = 0;
+        stream_read(&stream, &negative, sizeof(negative));
+        stream_read(&stream, &size, sizeof(size));
+        if (stream.failed || size > (uint64_t)CHECKPOINT_MAX_LIMBS) {
+            stream.failed = 1;
+            break;
+        }
+        mp_reserve(value, (size_t)size);
+        stream_read(&stream, value->limbs, (size_t)size * sizeof(mp_limb_t));
+        value->size = (size_t)size;
+        value->negative = negative != 0 && size > 0;
+    }
+    mp_clear(&scratch);
+
+    uint64_t expected = stream.checksum, checksum = 0;
+    if (!stream.failed && fread(&checksum, sizeof(checksum), 1, stream.file) != 1) stream.failed = 1;
+    fclose(stream.file);
+    return !stream.failed && checksum == expected ? 0 : -1;
+}
+
+int checkpoint_load(const char *path, CheckpointState *state, MpInt *values, int max_values) {
+    if (load_file(path, state, values, max_values) == 0) return 0;
+    char previous[CHECKPOINT_PATH_LENGTH + 8];
+    snprintf(previous, sizeof(previous), "%s.prev", path);
+    return load_file(previous, state, values, max_values);
+}
+
+int checkpoint_peek(const char *path, CheckpointState *state) {
+    return checkpoint_load(path, state, NULL, 0);
+}
+
+void checkpoint_remove(const char *path) {
+    char other[CHECKPOINT_PATH_LENGTH + 8];
+    unlink(path);
+    snprintf(other, sizeof(other), "%s.prev", path);
+    unlink(other);
+    snprintf(other, sizeof(other), "%s.tmp", path);
+    unlink(other);
+}
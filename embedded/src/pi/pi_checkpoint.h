@@ -0,0 +1,72 @@
+#ifndef PI_CHECKPOINT_H
+#define PI_CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../mp/mp_int.h"
+#include "../constants.h"
+
+// Checkpoints for long multiprecision runs: the intermediate big numbers
+// of a binary-splitting or AGM computation, streamed to disk through one
+// buffer with a running checksum, fsync'd once per checkpoint and renamed
+// into place. The checkpoint before it is kept as <path>.prev in case the
+// latest is damaged.
+
+// What a run saved: algorithm-defined progress plus one tag per value
+// (e.g. the term range a binary-splitting product covers)
+typedef struct {
+    char algorithm[CHECKPOINT_NAME_LENGTH];
+    long long digits;
+    long long done;                          // progress, in algorithm units
+    long long total;
+    int count;                               // big numbers that follow
+    long long tags[CHECKPOINT_MAX_VALUES];
+} CheckpointState;
+
+// A run's checkpointing: where, how often, and what it has cost so far.
+// Counters are read by other threads (job status) with __atomic loads.
+typedef struct {
+    char path[CHECKPOINT_PATH_LENGTH];
+    double interval_seconds;   // target spacing between checkpoints
+    double max_overhead;       // share of runtime checkpoint I/O may take
+    int stop;                  // set to checkpoint and stop at the next chance
+    long long done;            // progress mirrored from the run
+    long long total;
+    int checkpoints;
+    int resumed;               // 1 if the run started from a checkpoint
+    double write_seconds;      // total spent writing checkpoints
+    long long bytes;           // size of the latest checkpoint
+    struct timespec last;      // end of the latest checkpoint (or start)
+    double last_write_seconds;
+} PiCheckpoint;
+
+void checkpoint_init(PiCheckpoint *checkpoint, const char *path, double interval_seconds);
+
+// Whether to write now: the interval has passed, stretched as needed so
+// writing stays under max_overhead of the time between checkpoints, or a
+// stop was requested
+int checkpoint_due(PiCheckpoint *checkpoint);
+
+// Update progress; readers see it through checkpoint_progress
+void checkpoint_progress_set(PiCheckpoint *checkpoint, long long done, long long total);
+double checkpoint_progress(const PiCheckpoint *checkpoint);
+int checkpoint_stop_requested(const PiCheckpoint *checkpoint);
+void checkpoint_request_stop(PiCheckpoint *checkpoint);
+
+// Write `state` and its `state->count` values as the latest checkpoint;
+// 0 on success, -1 on an I/O error (the previous checkpoint survives)
+int checkpoint_save(PiCheckpoint *checkpoint, const CheckpointState *state, const MpInt *const *values);
+
+// Load the latest intact checkpoint at `path` (falling back to .prev) into
+// *state and values[0 .. state->count), which must be initialized;
+// 0 on success, -1 if none is readable
+int checkpoint_load(const char *path, CheckpointState *state, MpInt *values, int max_values);
+
+// Just the header of the latest intact checkpoint; 0 on success
+int checkpoint_peek(const char *path, CheckpointState *state);
+
+// Delete the checkpoint and its predecessor
+void checkpoint_remove(const char *path);
+
+#endif
@@ -0,0 +1,35 @@
+#include "pi_extended.h"
+
+///////////////// Double-double /////////////////
+#define PI_T dd_real
+#define PI_SUFFIX dd
+#define PI_FROM_D(d) dd_from_d(d)
+#define PI_ADD(a, b) dd_add(a, b)
+#define PI_SUB(a, b) dd_sub(a, b)
+#define PI_MUL(a, b) dd_mul(a, b)
+#define PI_DIV(a, b) dd_div(a, b)
+#define PI_ADD_D(a, d) dd_add_d(a, d)
+#define PI_MUL_D(a, d) dd_mul_d(a, d)
+#define PI_DIV_D(a, d) dd_div_d(a, d)
+#define PI_SQRT(a) dd_sqrt(a)
+#define PI_WIDEN(a) qd_from_dd(a)
+#define PI_TO_D(a) ((a).hi)
+#define PI_EPSILON 4.930380657631324e-32  // 2^-104
+#include "pi_generic.inc"
+
+///////////////// Quad-double /////////////////
+#define PI_T qd_real
+#define PI_SUFFIX qd
+#define PI_FROM_D(d) qd_from_d(d)
+#define PI_ADD(a, b) qd_add(a, b)
+#define PI_SUB(a, b) qd_sub(a, b)
+#define PI_MUL(a, b) qd_mul(a, b)
+#define PI_DIV(a, b) qd_div(a, b)
+#define PI_ADD_D(a, d) qd_add_d(a, d)
+#define PI_MUL_D(a, d) qd_mul_d(a, d)
+#define PI_DIV_D(a, d) qd_div_d(a, d)
+#define PI_SQRT(a) qd_sqrt(a)
+#define PI_WIDEN(a) (a)
+#define PI_TO_D(a) ((a).x[0])
+#define PI_EPSILON 1.215432671457254e-63  // 2^-209
+#include "pi_generic.inc"
@@ -0,0 +1,21 @@
+#ifndef PI_EXTENDED_H
+#define PI_EXTENDED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../dd/dd_real.h"
+#include "pi_generic.h"
+#include "../constants.h"
+
+// Series and AGM kernels in double-double and quad-double arithmetic,
+// instantiated from pi_generic.inc. The random methods are left out since
+// their error is statistical, not arithmetic.
+
+///////////////// Double-double /////////////////
+PI_DECLARE_KERNELS(dd_real, dd)
+
+///////////////// Quad-double /////////////////
+PI_DECLARE_KERNELS(qd_real, qd)
+
+#endif
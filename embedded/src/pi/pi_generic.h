@@ -0,0 +1,42 @@
+#ifndef PI_GENERIC_H
+#define PI_GENERIC_H
+
+#include "../dd/dd_real.h"
+#include "../pool/compute_pool.h"
+#include "pi_machin.h"
+
+// The series and AGM kernels are written once, in pi_generic.inc, against a
+// small set of arithmetic macros, and instantiated per number type by
+// including that file with the macros bound (see pi_precision.c and
+// pi_extended.c). Every instantiation also gets a `_wide` entry point that
+// widens its result to quad-double for the optimizer. Long double keeps the
+// incremental series of pi_calculations.c; its instantiation forwards to them.
+#define PI_DECLARE_KERNELS(T, suffix) \
+    T leibniz_##suffix(long long terms); \
+    T euler_##suffix(long long terms); \
+    T nilakantha_##suffix(long long terms); \
+    T ramanujan_##suffix(long long terms); \
+    T chudnovsky_##suffix(long long terms); \
+    T gauss_legendre_##suffix(long long iterations); \
+    T bbp_##suffix(long long iterations); \
+    T borwein_##suffix(long long iterations); \
+    T machin_like_##suffix(const MachinFormula *formula, long long terms, long long *effective); \
+    T machin_##suffix(long long terms); \
+    T takano_##suffix(long long terms); \
+    T stormer_##suffix(long long terms); \
+    qd_real leibniz_##suffix##_wide(long long terms); \
+    qd_real euler_##suffix##_wide(long long terms); \
+    qd_real nilakantha_##suffix##_wide(long long terms); \
+    qd_real ramanujan_##suffix##_wide(long long terms); \
+    qd_real chudnovsky_##suffix##_wide(long long terms); \
+    qd_real gauss_legendre_##suffix##_wide(long long iterations); \
+    qd_real bbp_##suffix##_wide(long long iterations); \
+    qd_real borwein_##suffix##_wide(long long iterations); \
+    qd_real machin_##suffix##_wide(long long terms); \
+    qd_real takano_##suffix##_wide(long long terms); \
+    qd_real stormer_##suffix##_wide(long long terms);
+
+#define PI_GENERIC_CONCAT_(a, b) a##_##b
+#define PI_GENERIC_CONCAT(a, b) PI_GENERIC_CONCAT_(a, b)
+
+#endif
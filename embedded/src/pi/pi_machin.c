@@ -0,0 +1,43 @@
+#include "pi_machin.h"
+#include "pi_precision.h"
+
+const MachinFormula MACHIN_FORMULA = {2, {{16.0, 5.0}, {-4.0, 239.0}}};
+const MachinFormula TAKANO_FORMULA = {4, {
+    {48.0, 49.0}, {128.0, 57.0}, {-20.0, 239.0}, {48.0, 110443.0}
+}};
+const MachinFormula STORMER_FORMULA = {4, {
+    {176.0, 57.0}, {28.0, 239.0}, {-48.0, 682.0}, {96.0, 12943.0}
+}};
+
+///////////////// Long double kernels /////////////////
+// The arctan series themselves are the type-generic ones in pi_generic.inc
+long double machin(long long terms) {
+    return machin_like_long_double(&MACHIN_FORMULA, terms, NULL);
+}
+
+long double takano(long long terms) {
+    return machin_like_long_double(&TAKANO_FORMULA, terms, NULL);
+}
+
+long double stormer(long long terms) {
+    return machin_like_long_double(&STORMER_FORMULA, terms, NULL);
+}
+
+static long double machin_counted(long long terms, long long *effective) {
+    return machin_like_long_double(&MACHIN_FORMULA, terms, effective);
+}
+
+static long double takano_counted(long long terms, long long *effective) {
+    return machin_like_long_double(&TAKANO_FORMULA, terms, effective);
+}
+
+static long double stormer_counted(long long terms, long long *effective) {
+    return machin_like_long_double(&STORMER_FORMULA, terms, effective);
+}
+
+CalculatePiCounted machin_counted_for(long double (*func)(long long)) {
+    if (func == machin) return machin_counted;
+    if (func == takano) return takano_counted;
+    if (func == stormer) return stormer_counted;
+    return NULL;
+}
@@ -0,0 +1,40 @@
+#ifndef PI_MACHIN_H
+#define PI_MACHIN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pi_calculations.h"
+#include "../constants.h"
+
+// Machin-like formulas, pi = sum coefficient * arctan(1/q). Each arctan
+// series is independent, so a formula runs them concurrently on the
+// compute pool; the slowest (smallest q) sets the term count.
+//   machin   16 atan(1/5) - 4 atan(1/239)
+//   takano   48 atan(1/49) + 128 atan(1/57) - 20 atan(1/239) + 48 atan(1/110443)
+//   stormer  176 atan(1/57) + 28 atan(1/239) - 48 atan(1/682) + 96 atan(1/12943)
+typedef struct {
+    double coefficient;
+    double q;
+} MachinArctan;
+
+typedef struct {
+    int count;
+    MachinArctan arctans[MACHIN_MAX_ARCTANS];
+} MachinFormula;
+
+extern const MachinFormula MACHIN_FORMULA;
+extern const MachinFormula TAKANO_FORMULA;
+extern const MachinFormula STORMER_FORMULA;
+
+///////////////// Long double kernels /////////////////
+// `terms` is the term count of each arctan series
+long double machin(long long terms);
+long double takano(long long terms);
+long double stormer(long long terms);
+
+// Counted form of a Machin-like kernel for the optimizer: the series stop
+// once below precision, *effective is the longest one. NULL for other kernels.
+CalculatePiCounted machin_counted_for(long double (*func)(long long));
+
+#endif
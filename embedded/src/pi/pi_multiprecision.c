@@ -0,0 +1,774 @@
+#include "pi_multiprecision.h"
+
+///////////////// Multiprecision kernels /////////////////
+// Term-by-term Chudnovsky in scaled integer arithmetic:
+// a_k = -a_{k-1} * (6k-5)(2k-1)(6k-1) / (k^3 * 640320^3 / 24)
+char *chudnovsky_digits(long long digits) {
+    if (digits < 0 || digits > MAX_MP_DIGITS) return NULL;
+
+    long long precision = digits + MP_GUARD_DIGITS;
+    long long terms = precision / 14 + 2;
+
+    MpInt scale, a, sum_a, sum_b, t, pi;
+    mp_init(&scale);
+    mp_init(&a);
+    mp_init(&sum_a);
+    mp_init(&sum_b);
+    mp_init(&t);
+    mp_init(&pi);
+
+    mp_pow_ui(&scale, 10, (uint64_t)precision);
+    mp_copy(&a, &scale);
+    mp_copy(&sum_a, &scale);
+    mp_set_ui(&sum_b, 0);
+
+    for (long long k = 1; k < terms; k++) {
+        mp_mul_ui(&a, &a, (uint32_t)(6 * k - 5));
+        mp_mul_ui(&a, &a, (uint32_t)(2 * k - 1));
+        mp_mul_ui(&a, &a, (uint32_t)(6 * k - 1));
+        mp_div_ui(&a, &a, (uint32_t)k);
+        mp_div_ui(&a, &a, (uint32_t)k);
+        mp_div_ui(&a, &a, (uint32_t)k);
+        // 640320^3 / 24 = 36864000 * 296740963
+        mp_div_ui(&a, &a, 36864000u);
+        mp_div_ui(&a, &a, 296740963u);
+        a.negative = !a.negative && a.size > 0;
+
+        mp_add(&sum_a, &sum_a, &a);
+        mp_mul_ui(&t, &a, (uint32_t)k);
+        mp_add(&sum_b, &sum_b, &t);
+    }
+
+    // total = 13591409 * sum_a + 545140134 * sum_b
+    mp_mul_ui(&sum_a, &sum_a, 13591409u);
+    mp_mul_ui(&sum_b, &sum_b, 545140134u);
+    mp_add(&sum_a, &sum_a, &sum_b);
+
+    // pi * scale = 426880 * sqrt(10005 * scale^2) * scale / total
+    mp_mul(&t, &scale, &scale);
+    mp_mul_ui(&t, &t, 10005u);
+    mp_sqrt(&pi, &t);
+    mp_mul_ui(&pi, &pi, 426880u);
+    mp_mul(&pi, &pi, &scale);
+    mp_divmod(&pi, NULL, &pi, &sum_a);
+
+    char *result = format_pi_digits(&pi, digits);
+
+    mp_clear(&scale);
+    mp_clear(&a);
+    mp_clear(&sum_a);
+    mp_clear(&sum_b);
+    mp_clear(&t);
+    mp_clear(&pi);
+    return result;
+}
+
+// Binary splitting over terms [a, b): P, Q, T with
+// P(a,b) = prod p(k), Q(a,b) = prod q(k), T(a,b) = sum of scaled terms.
+// P is skipped when the caller does not need it (right spine of the tree).
+typedef struct {
+    long long a;
+    long long b;
+    int depth;
+    MpInt *P;
+    MpInt *Q;
+    MpInt *T;
+} ChudnovskyRange;
+
+typedef struct {
+    MpInt *r;
+    const MpInt *x;
+    const MpInt *y;
+} MulJob;
+
+static void mul_job_run(void *arg) {
+    MulJob *job = (MulJob *)arg;
+    mp_mul(job->r, job->x, job->y);
+}
+
+// Join adjacent ranges: P = P1 P2, Q = Q1 Q2, T = T1 Q2 + P1 T2. Outputs
+// must not alias inputs; P may be NULL. With `parallel` the four products
+// are independent pool tasks.
+static void chudnovsky_merge(MpInt *P, MpInt *Q, MpInt *T,
+                             const MpInt *P1, const MpInt *Q1, const MpInt *T1,
+                             const MpInt *P2, const MpInt *Q2, const MpInt *T2, int parallel) {
+    MpInt tmp;
+    mp_init(&tmp);
+    if (parallel) {
+        MulJob jobs[4] = {
+            {&tmp, T1, Q2},
+            {T, P1, T2},
+            {Q, Q1, Q2},
+            {P, P1, P2},
+        };
+        int job_count = P ? 4 : 3;
+        PoolTask tasks[4];
+        for (int i = 1; i < job_count; i++) pool_task_spawn(&tasks[i], mul_job_run, &jobs[i]);
+        mul_job_run(&jobs[0]);
+        for (int i = 1; i < job_count; i++) pool_task_wait(&tasks[i]);
+    } else {
+        mp_mul(&tmp, T1, Q2);
+        mp_mul(T, P1, T2);
+        mp_mul(Q, Q1, Q2);
+        if (P != NULL) mp_mul(P, P1, P2);
+    }
+    mp_add(T, T, &tmp);
+    mp_clear(&tmp);
+}
+
+static void chudnovsky_bs(long long a, long long b, MpInt *P, MpInt *Q, MpInt *T, int depth);
+
+static void chudnovsky_bs_task(void *arg) {
+    ChudnovskyRange *range = (ChudnovskyRange *)arg;
+    chudnovsky_bs(range->a, range->b, range->P, range->Q, range->T, range->depth);
+}
+
+static void chudnovsky_bs(long long a, long long b, MpInt *P, MpInt *Q, MpInt *T, int depth) {
+    if (b - a == 1) {
+        if (a == 0) {
+            if (P != NULL) mp_set_ui(P, 1);
+            mp_set_ui(Q, 1);
+            mp_set_ui(T, 13591409u);
+            return;
+        }
+        // p(a) = (6a-5)(2a-1)(6a-1), q(a) = a^3 * 640320^3 / 24
+        MpInt p;
+        mp_init(&p);
+        mp_set_ui(&p, (uint64_t)(6 * a - 5) * (uint64_t)(2 * a - 1) * (uint64_t)(6 * a - 1));
+        mp_set_ui(Q, 10939058860032000ULL);
+        mp_mul_ui(Q, Q, (uint32_t)a);
+        mp_mul_ui(Q, Q, (uint32_t)a);
+        mp_mul_ui(Q, Q, (uint32_t)a);
+        mp_mul_si(T, &p, 13591409LL + 545140134LL * a);
+        if (a & 1) T->negative = !T->negative && T->size > 0;
+        if (P != NULL) mp_swap(P, &p);
+        mp_clear(&p);
+        return;
+    }
+
+    long long m = a + (b - a) / 2;
+    MpInt P1, Q1, T1, P2, Q2, T2;
+    mp_init(&P1);
+    mp_init(&Q1);
+    mp_init(&T1);
+    mp_init(&P2);
+    mp_init(&Q2);
+    mp_init(&T2);
+
+    int parallel = depth > 0 && b - a >= BS_PARALLEL_MIN_TERMS;
+    if (parallel) {
+        // Fork the left half, recurse into the right half on this thread
+        ChudnovskyRange left = {a, m, depth - 1, &P1, &Q1, &T1};
+        PoolTask task;
+        pool_task_spawn(&task, chudnovsky_bs_task, &left);
+        chudnovsky_bs(m, b, P ? &P2 : NULL, &Q2, &T2, depth - 1);
+        pool_task_wait(&task);
+    } else {
+        chudnovsky_bs(a, m, &P1, &Q1, &T1, 0);
+        chudnovsky_bs(m, b, P ? &P2 : NULL, &Q2, &T2, 0);
+    }
+    chudnovsky_merge(P, Q, T, &P1, &Q1, &T1, &P2, &Q2, &T2, parallel);
+
+    mp_clear(&P1);
+    mp_clear(&Q1);
+    mp_clear(&T1);
+    mp_clear(&P2);
+    mp_clear(&Q2);
+    mp_clear(&T2);
+}
+
+typedef struct {
+    MpInt *root;
+    const MpInt *value;
+} SqrtJob;
+
+static void sqrt_job_run(void *arg) {
+    SqrtJob *job = (SqrtJob *)arg;
+    mp_sqrt(job->root, job->value);
+}
+
+// sqrt(10005) * 10^precision, computed on the pool while the series runs
+typedef struct {
+    MpInt radicand;
+    MpInt root;
+    SqrtJob job;
+    PoolTask task;
+} ChudnovskyRoot;
+
+static void chudnovsky_root_start(ChudnovskyRoot *root, long long precision) {
+    MpInt scale;
+    mp_init(&scale);
+    mp_init(&root->radicand);
+    mp_init(&root->root);
+    mp_pow_ui(&scale, 10, (uint64_t)precision);
+    mp_mul(&root->radicand, &scale, &scale);
+    mp_mul_ui(&root->radicand, &root->radicand, 10005u);
+    mp_clear(&scale);
+    root->job.root = &root->root;
+    root->job.value = &root->radicand;
+    pool_task_spawn(&root->task, sqrt_job_run, &root->job);
+}
+
+static void chudnovsky_root_finish(ChudnovskyRoot *root) {
+    pool_task_wait(&root->task);
+    mp_clear(&root->radicand);
+}
+
+// pi * 10^precision = 426880 * root * Q(0,N) / T(0,N), formatted
+static char *chudnovsky_digits_from(ChudnovskyRoot *root, MpInt *Q, const MpInt *T, long long digits) {
+    MpInt pi;
+    mp_init(&pi);
+    chudnovsky_root_finish(root);
+    mp_mul_ui(Q, Q, 426880u);
+    mp_mul(&pi, &root->root, Q);
+    mp_divmod(&pi, NULL, &pi, T);
+    char *result = format_pi_digits(&pi, digits);
+    mp_clear(&pi);
+    mp_clear(&root->root);
+    return result;
+}
+
+// Top levels of the recursion to fork: a few beyond the core count, since
+// later terms are larger
+static int chudnovsky_parallel_depth(void) {
+    int depth = 2;
+    for (int workers = compute_pool_size(); workers > 1; workers >>= 1) depth++;
+    return depth;
+}
+
+// Each term adds log10(640320^3 / 1728) ~ 14.18 digits
+long long chudnovsky_bs_terms(long long digits) {
+    return (long long)((digits + MP_GUARD_DIGITS) / 14.181647462725477) + 2;
+}
+
+void chudnovsky_bs_range(long long a, long long b, MpInt *P, MpInt *Q, MpInt *T) {
+    chudnovsky_bs(a, b, P, Q, T, chudnovsky_parallel_depth());
+}
+
+void chudnovsky_bs_join(MpInt *P, MpInt *Q, MpInt *T,
+                        const MpInt *P1, const MpInt *Q1, const MpInt *T1,
+                        const MpInt *P2, const MpInt *Q2, const MpInt *T2) {
+    chudnovsky_merge(P, Q, T, P1, Q1, T1, P2, Q2, T2, 1);
+}
+
+char *chudnovsky_bs_finish(MpInt *Q, const MpInt *T, long long digits) {
+    if (digits < 0 || digits > MAX_MP_DIGITS) return NULL;
+    ChudnovskyRoot root;
+    chudnovsky_root_start(&root, digits + MP_GUARD_DIGITS);
+    return chudnovsky_digits_from(&root, Q, T, digits);
+}
+
+// Binary-splitting Chudnovsky, O(M(n) log^2 n), with the top of the
+// recursion tree fork-joined across the compute pool:
+// pi = 426880 * sqrt(10005) * Q(0,N) / T(0,N)
+char *chudnovsky_bs_digits(long long digits) {
+    if (digits < 0 || digits > MAX_MP_DIGITS) return NULL;
+
+    long long precision = digits + MP_GUARD_DIGITS;
+    long long terms = chudnovsky_bs_terms(digits);
+
+    MpInt Q, T;
+    mp_init(&Q);
+    mp_init(&T);
+    // The square root is independent of the series: overlap it
+    ChudnovskyRoot root;
+    chudnovsky_root_start(&root, precision);
+    chudnovsky_bs(0, terms, NULL, &Q, &T, chudnovsky_parallel_depth());
+    char *result = chudnovsky_digits_from(&root, &Q, &T, digits);
+
+    mp_clear(&Q);
+    mp_clear(&T);
+    return result;
+}
+
+// Checkpointed binary splitting: the terms are cut into
+// CHECKPOINT_SEGMENTS equal leaves, computed left to right, and completed
+// subtrees are kept on a stack, merging the top two whenever they cover
+// equal lengths (a binary counter). That reproduces the balanced tree,
+// and the stack - at most log2(segments) + 1 entries - is the whole state
+// to checkpoint. Entry i is values[3i .. 3i+2] = P, Q, T over
+// [tags[3i], tags[3i+1]).
+char *chudnovsky_bs_digits_checkpointed(long long digits, PiCheckpoint *checkpoint) {
+    if (digits < 0 || digits > MAX_MP_DIGITS || checkpoint == NULL) return NULL;
+
+    long long precision = digits + MP_GUARD_DIGITS;
+    long long terms = chudnovsky_bs_terms(digits);
+    long long segment = terms / CHECKPOINT_SEGMENTS > 0 ? terms / CHECKPOINT_SEGMENTS : 1;
+    int depth = chudnovsky_parallel_depth();
+
+    CheckpointState state;
+    MpInt values[CHECKPOINT_MAX_VALUES];
+    MpInt merged[3];
+    for (int i = 0; i < CHECKPOINT_MAX_VALUES; i++) mp_init(&values[i]);
+    for (int i = 0; i < 3; i++) mp_init(&merged[i]);
+
+    // Resume only a run of the same computation whose stack is contiguous
+    int height = 0;
+    long long next = 0;
+    if (checkpoint_load(checkpoint->path, &state, values, CHECKPOINT_MAX_VALUES) != 0 ||
+        strcmp(state.algorithm, "chudnovsky_bs") != 0 || state.digits != digits ||
+        state.total != terms || state.count % 3 != 0) {
+        state.count = 0;
+    }
+    for (int i = 0; i < state.count / 3; i++) {
+        if (state.tags[3 * i] != (i == 0 ? 0 : state.tags[3 * i - 2])) state.count = 0;
+    }
+    if (state.count > 0 && state.tags[state.count - 2] == state.done) {
+        height = state.count / 3;
+        next = state.done;
+        __atomic_store_n(&checkpoint->resumed, 1, __ATOMIC_RELAXED);
+    } else {
+        memset(&state, 0, sizeof(state));
+        snprintf(state.algorithm, sizeof(state.algorithm), "%s", "chudnovsky_bs");
+        state.digits = digits;
+        state.total = terms;
+    }
+    checkpoint_progress_set(checkpoint, next, terms);
+
+    ChudnovskyRoot root;
+    chudnovsky_root_start(&root, precision);
+    int stopped = 0;
+    while (next < terms && !stopped) {
+        long long end = next + segment < terms ? next + segment : terms;
+        MpInt *entry = &values[3 * height];
+        chudnovsky_bs(next, end, end < terms ? &entry[0] : NULL, &entry[1], &entry[2], depth);
+        state.tags[3 * height] = next;
+        state.tags[3 * height + 1] = end;
+        height++;
+        next = end;
+
+        // Merge the top two while they cover equal lengths, or to finish
+        while (height >= 2) {
+            long long *left = &state.tags[3 * (height - 2)];
+            long long *right = &state.tags[3 * (height - 1)];
+            if (right[1] - right[0] != left[1] - left[0] && next < terms) break;
+            MpInt *a = &values[3 * (height - 2)];
+            MpInt *b = &values[3 * (height - 1)];
+            int keep_p = right[1] < terms;
+            chudnovsky_merge(keep_p ? &merged[0] : NULL, &merged[1], &merged[2],
+                             &a[0], &a[1], &a[2], &b[0], &b[1], &b[2], 1);
+            for (int i = keep_p ? 0 : 1; i < 3; i++) mp_swap(&a[i], &merged[i]);
+            left[1] = right[1];
+            height--;
+        }
+        checkpoint_progress_set(checkpoint, next, terms);
+
+        if (next < terms && checkpoint_due(checkpoint)) {
+            const MpInt *saved[CHECKPOINT_MAX_VALUES];
+            for (int i = 0; i < 3 * height; i++) saved[i] = &values[i];
+            state.done = next;
+            state.count = 3 * height;
+            // A failed write keeps the previous checkpoint; the run goes on
+            checkpoint_save(checkpoint, &state, saved);
+            stopped = checkpoint_stop_requested(checkpoint);
+        }
+    }
+
+    char *result = NULL;
+    if (stopped) {
+        chudnovsky_root_finish(&root);
+        mp_clear(&root.root);
+    } else {
+        result = chudnovsky_digits_from(&root, &values[1], &values[2], digits);
+    }
+    for (int i = 0; i < CHECKPOINT_MAX_VALUES; i++) mp_clear(&values[i]);
+    for (int i = 0; i < 3; i++) mp_clear(&merged[i]);
+    return result;
+}
+
+// Working precision in bits for `digits` decimals plus the AGM guard bits
+static size_t agm_precision_bits(long long digits) {
+    return (size_t)((double)(digits + MP_GUARD_DIGITS) * 3.321928094887362) + MP_AGM_GUARD_BITS;
+}
+
+// Gauss-Legendre AGM in binary fixed point; correct digits double per step:
+// a' = (a+b)/2, b' = sqrt(ab), t' = t - p(a-a')^2, p' = 2p, pi ~ (a+b)^2 / 4t.
+// With a checkpoint, a, b and t are saved between iterations (the count
+// gives p) and a matching checkpoint is resumed.
+static char *gauss_legendre_run(long long digits, PiCheckpoint *checkpoint) {
+    if (digits < 0 || digits > MAX_MP_DIGITS) return NULL;
+
+    size_t bits = agm_precision_bits(digits);
+    MpInt values[3], a_next, diff, pi;
+    MpInt *a = &values[0], *b = &values[1], *t = &values[2];
+    for (int i = 0; i < 3; i++) mp_init(&values[i]);
+    mp_init(&a_next);
+    mp_init(&diff);
+    mp_init(&pi);
+
+    // Steps to converge, for progress only: digits double from about one
+    long long total = 2;
+    for (long long correct = 1; correct < digits + MP_GUARD_DIGITS; correct *= 2) total++;
+
+    CheckpointState state;
+    size_t p_shift = 0;  // p = 2^p_shift, also the iteration count
+    if (checkpoint != NULL && checkpoint_load(checkpoint->path, &state, values, 3) == 0 &&
+        strcmp(state.algorithm, "gauss_legendre") == 0 && state.digits == digits && state.count == 3 &&
+        state.done > 0 && state.done < MP_AGM_MAX_ITERATIONS) {
+        p_shift = (size_t)state.done;
+        __atomic_store_n(&checkpoint->resumed, 1, __ATOMIC_RELAXED);
+    } else {
+        mp_fixed_set_ui(a, 1, bits);
+        mp_fixed_set_ui(b, 2, bits);
+        mp_fixed_inv_root(b, b, 2, bits);  // 1/sqrt(2)
+        mp_fixed_set_ui(t, 1, bits - 2);   // 1/4
+    }
+    memset(&state, 0, sizeof(state));
+    snprintf(state.algorithm, sizeof(state.algorithm), "%s", "gauss_legendre");
+    state.digits = digits;
+    state.total = total;
+    state.count = 3;
+    if (checkpoint != NULL) checkpoint_progress_set(checkpoint, (long long)p_shift, total);
+
+    int stopped = 0;
+    for (int i = (int)p_shift; i < MP_AGM_MAX_ITERATIONS; i++) {
+        mp_add(&a_next, a, b);
+        mp_shr(&a_next, &a_next, 1);
+        mp_fixed_mul(b, a, b, bits);
+        mp_fixed_sqrt(b, b, bits);
+
+        mp_sub(&diff, a, &a_next);
+        mp_fixed_mul(&diff, &diff, &diff, bits);
+        mp_shl(&diff, &diff, p_shift);
+        mp_sub(t, t, &diff);
+        p_shift++;
+        mp_swap(a, &a_next);
+
+        // Once |a - b| < 2^(-bits/2) the remaining corrections vanish
+        mp_sub(&diff, a, b);
+        if (mp_bit_length(&diff) < bits / 2) break;
+
+        if (checkpoint != NULL) {
+            checkpoint_progress_set(checkpoint, (long long)p_shift < total ? (long long)p_shift : total - 1, total);
+            if (checkpoint_due(checkpoint)) {
+                const MpInt *saved[3] = {a, b, t};
+                state.done = (long long)p_shift;
+                checkpoint_save(checkpoint, &state, saved);
+                if (checkpoint_stop_requested(checkpoint)) {
+                    stopped = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    char *result = NULL;
+    if (!stopped) {
+        mp_add(&pi, a, b);
+        mp_fixed_mul(&pi, &pi, &pi, bits);
+        mp_shl(t, t, 2);
+        mp_fixed_div(&pi, &pi, t, bits);
+        mp_fixed_to_decimal_scaled(&pi, &pi, digits + MP_GUARD_DIGITS, bits);
+        result = format_pi_digits(&pi, digits);
+    }
+
+    for (int i = 0; i < 3; i++) mp_clear(&values[i]);
+    mp_clear(&a_next);
+    mp_clear(&diff);
+    mp_clear(&pi);
+    return result;
+}
+
+char *gauss_legendre_digits(long long digits) {
+    return gauss_legendre_run(digits, NULL);
+}
+
+char *gauss_legendre_digits_checkpointed(long long digits, PiCheckpoint *checkpoint) {
+    if (checkpoint == NULL) return NULL;
+    return gauss_legendre_run(digits, checkpoint);
+}
+
+// Borwein quartic iteration; correct digits quadruple per step:
+// y' = (1 - (1-y^4)^(1/4)) / (1 + (1-y^4)^(1/4))
+// a' = a(1+y')^4 - 2^(2k+3) y'(1 + y' + y'^2), pi ~ 1/a
+char *borwein_digits(long long digits) {
+    if (digits < 0 || digits > MAX_MP_DIGITS) return NULL;
+
+    size_t bits = agm_precision_bits(digits);
+    MpInt y, a, one, root, tmp, term, pi;
+    mp_init(&y);
+    mp_init(&a);
+    mp_init(&one);
+    mp_init(&root);
+    mp_init(&tmp);
+    mp_init(&term);
+    mp_init(&pi);
+
+    // y0 = sqrt(2) - 1, a0 = 6 - 4 sqrt(2)
+    mp_fixed_set_ui(&one, 1, bits);
+    mp_fixed_set_ui(&tmp, 2, bits);
+    mp_fixed_sqrt(&root, &tmp, bits);
+    mp_sub(&y, &root, &one);
+    mp_fixed_set_ui(&a, 6, bits);
+    mp_shl(&tmp, &root, 2);
+    mp_sub(&a, &a, &tmp);
+
+    for (int k = 0; k < MP_AGM_MAX_ITERATIONS && !mp_is_zero(&y); k++) {
+        // root = (1 - y^4)^(1/4)
+        mp_fixed_mul(&tmp, &y, &y, bits);
+        mp_fixed_mul(&tmp, &tmp, &tmp, bits);
+        mp_sub(&tmp, &one, &tmp);
+        mp_fixed_root4(&root, &tmp, bits);
+
+        mp_sub(&tmp, &one, &root);
+        mp_add(&root, &one, &root);
+        mp_fixed_div(&y, &tmp, &root, bits);
+
+        // a = a (1+y)^4 - 2^(2k+3) y (1 + y + y^2)
+        mp_add(&tmp, &one, &y);
+        mp_fixed_mul(&tmp, &tmp, &tmp, bits);
+        mp_fixed_mul(&tmp, &tmp, &tmp, bits);
+        mp_fixed_mul(&a, &a, &tmp, bits);
+        mp_fixed_mul(&term, &y, &y, bits);
+        mp_add(&term, &term, &y);
+        mp_add(&term, &term, &one);
+        mp_fixed_mul(&term, &term, &y, bits);
+        mp_shl(&term, &term, (size_t)(2 * k + 3));
+        mp_sub(&a, &a, &term);
+    }
+
+    mp_fixed_div(&pi, &one, &a, bits);
+    mp_fixed_to_decimal_scaled(&pi, &pi, digits + MP_GUARD_DIGITS, bits);
+
+    char *result = format_pi_digits(&pi, digits);
+
+    mp_clear(&y);
+    mp_clear(&a);
+    mp_clear(&one);
+    mp_clear(&root);
+    mp_clear(&tmp);
+    mp_clear(&term);
+    mp_clear(&pi);
+    return result;
+}
+
+// Binary splitting for arctan(1/x) in Euler's form, all terms positive:
+//   arctan(1/x) = x/(1+x^2) * sum_k prod_{j=1..k} 2j / ((2j+1)(1+x^2))
+// With p(j) = 2j, q(j) = (2j+1)(1+x^2) the sum over [a, b) is T/Q, merged
+// like Chudnovsky's: T = T1*Q2 + P1*T2. Each term gains log10(1+x^2) digits.
+typedef struct {
+    uint64_t x2p1;  // 1 + x^2
+    long long a;
+    long long b;
+    int depth;
+    MpInt *P;
+    MpInt *Q;
+    MpInt *T;
+} ArctanRange;
+
+static void arctan_bs(uint64_t x2p1, long long a, long long b, MpInt *P, MpInt *Q, MpInt *T,
+                      int depth);
+
+static void arctan_bs_task(void *arg) {
+    ArctanRange *range = (ArctanRange *)arg;
+    arctan_bs(range->x2p1, range->a, range->b, range->P, range->Q, range->T, range->depth);
+}
+
+static void arctan_bs(uint64_t x2p1, long long a, long long b, MpInt *P, MpInt *Q, MpInt *T,
+                      int depth) {
+    if (b - a == 1) {
+        if (a == 0) {
+            if (P != NULL) mp_set_ui(P, 1);
+            mp_set_ui(Q, 1);
+            mp_set_ui(T, 1);
+            return;
+        }
+        mp_set_ui(T, (uint64_t)(2 * a));
+        mp_set_ui(Q, (uint64_t)(2 * a + 1));
+        mp_mul_si(Q, Q, (int64_t)x2p1);
+        if (P != NULL) mp_copy(P, T);
+        return;
+    }
+
+    long long m = a + (b - a) / 2;
+    MpInt P1, Q1, T1, P2, Q2, T2, tmp;
+    mp_init(&P1);
+    mp_init(&Q1);
+    mp_init(&T1);
+    mp_init(&P2);
+    mp_init(&Q2);
+    mp_init(&T2);
+    mp_init(&tmp);
+
+    if (depth > 0 && b - a >= BS_PARALLEL_MIN_TERMS) {
+        ArctanRange left = {x2p1, a, m, depth - 1, &P1, &Q1, &T1};
+        PoolTask task;
+        pool_task_spawn(&task, arctan_bs_task, &left);
+        arctan_bs(x2p1, m, b, P ? &P2 : NULL, &Q2, &T2, depth - 1);
+        pool_task_wait(&task);
+
+        MulJob jobs[4] = {
+            {&tmp, &T1, &Q2},
+            {T, &P1, &T2},
+            {Q, &Q1, &Q2},
+            {P, &P1, &P2},
+        };
+        int job_count = P ? 4 : 3;
+        PoolTask tasks[4];
+        for (int i = 1; i < job_count; i++) pool_task_spawn(&tasks[i], mul_job_run, &jobs[i]);
+        mul_job_run(&jobs[0]);
+        for (int i = 1; i < job_count; i++) pool_task_wait(&tasks[i]);
+        mp_add(T, T, &tmp);
+    } else {
+        arctan_bs(x2p1, a, m, &P1, &Q1, &T1, 0);
+        arctan_bs(x2p1, m, b, P ? &P2 : NULL, &Q2, &T2, 0);
+        mp_mul(&tmp, &T1, &Q2);
+        mp_mul(T, &P1, &T2);
+        mp_add(T, T, &tmp);
+        mp_mul(Q, &Q1, &Q2);
+        if (P != NULL) mp_mul(P, &P1, &P2);
+    }
+
+    mp_clear(&P1);
+    mp_clear(&Q1);
+    mp_clear(&T1);
+    mp_clear(&P2);
+    mp_clear(&Q2);
+    mp_clear(&T2);
+    mp_clear(&tmp);
+}
+
+// One arctan of a formula: value = coefficient * arctan(1/x) * scale
+typedef struct {
+    uint32_t x;
+    int64_t coefficient;
+    long long precision;
+    const MpInt *scale;
+    int depth;
+    MpInt value;
+} ArctanSeriesJob;
+
+static void arctan_series_job(void *arg) {
+    ArctanSeriesJob *job = (ArctanSeriesJob *)arg;
+    uint64_t x2p1 = (uint64_t)job->x * job->x + 1;
+    long long terms = (long long)((double)job->precision / log10((double)x2p1)) + 2;
+
+    MpInt Q, T;
+    mp_init(&Q);
+    mp_init(&T);
+    arctan_bs(x2p1, 0, terms, NULL, &Q, &T, job->depth);
+
+    // scale * x * T / ((1 + x^2) Q)
+    mp_mul(&T, &T, job->scale);
+    mp_mul_ui(&T, &T, job->x);
+    mp_mul_si(&Q, &Q, (int64_t)x2p1);
+    mp_divmod(&job->value, NULL, &T, &Q);
+    mp_mul_si(&job->value, &job->value, job->coefficient);
+
+    mp_clear(&Q);
+    mp_clear(&T);
+}
+
+// Machin-like formula in scaled integers: the arctans run as concurrent
+// pool tasks, each splitting its own series across the cores left over.
+// Every arctan truncates by under one unit, times its coefficient; the
+// guard digits absorb that.
+static char *machin_like_digits(const MachinFormula *formula, long long digits) {
+    if (digits < 0 || digits > MAX_MP_DIGITS) return NULL;
+
+    long long precision = digits + MP_GUARD_DIGITS;
+    int depth = 2;
+    for (int workers = compute_pool_size() / formula->count; workers > 1; workers >>= 1) depth++;
+
+    MpInt scale, pi;
+    mp_init(&scale);
+    mp_init(&pi);
+    mp_pow_ui(&scale, 10, (uint64_t)precision);
+
+    ArctanSeriesJob jobs[MACHIN_MAX_ARCTANS];
+    PoolTask tasks[MACHIN_MAX_ARCTANS];
+    for (int i = 0; i < formula->count; i++) {
+        jobs[i].x = (uint32_t)formula->arctans[i].q;
+        jobs[i].coefficient = (int64_t)formula->arctans[i].coefficient;
+        jobs[i].precision = precision;
+        jobs[i].scale = &scale;
+        jobs[i].depth = depth;
+        mp_init(&jobs[i].value);
+    }
+    for (int i = 1; i < formula->count; i++) {
+        pool_task_spawn(&tasks[i], arctan_series_job, &jobs[i]);
+    }
+    arctan_series_job(&jobs[0]);
+    for (int i = 1; i < formula->count; i++) pool_task_wait(&tasks[i]);
+
+    mp_set_ui(&pi, 0);
+    for (int i = 0; i < formula->count; i++) {
+        mp_add(&pi, &pi, &jobs[i].value);
+        mp_clear(&jobs[i].value);
+    }
+
+    char *result = format_pi_digits(&pi, digits);
+
+    mp_clear(&scale);
+    mp_clear(&pi);
+    return result;
+}
+
+char *machin_digits(long long digits) {
+    return machin_like_digits(&MACHIN_FORMULA, digits);
+}
+
+char *takano_digits(long long digits) {
+    return machin_like_digits(&TAKANO_FORMULA, digits);
+}
+
+char *stormer_digits(long long digits) {
+    return machin_like_digits(&STORMER_FORMULA, digits);
+}
+
+///////////////// Utility functions /////////////////
+// Format pi * 10^(digits + guard) as "3.<digits decimals>"
+char *format_pi_digits(const MpInt *scaled, long long digits) {
+    char *decimal = mp_to_decimal(scaled);
+    if (decimal == NULL) return NULL;
+
+    size_t available = strlen(decimal);
+    if (scaled->negative || available < (size_t)digits + 1) {
+        free(decimal);
+        return NULL;
+    }
+
+    char *result = (char *)malloc((size_t)digits + 3);
+    if (result == NULL) {
+        free(decimal);
+        return NULL;
+    }
+    result[0] = decimal[0];
+    if (digits > 0) {
+        result[1] = '.';
+        memcpy(result + 2, decimal + 1, (size_t)digits);
+        result[digits + 2] = '\0';
+    } else {
+        result[1] = '\0';
+    }
+    free(decimal);
+    return result;
+}
+
+// Run a digit kernel and measure its wall-clock time and peak big-number
+// memory, the latter in an account of its own so overlapping runs do not
+// show up in it
+PiDigitsResult compute_pi_digits(CalculatePiDigits func, long long digits) {
+    struct timespec start, end;
+    MpMemoryAccount account = {0, 0};
+    MpMemoryAccount *previous = mp_memory_account_install(&account);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    char *text = func(digits);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    mp_memory_account_install(previous);
+
+    PiDigitsResult result;
+    result.digits = text;
+    result.digit_count = text ? digits : 0;
+    result.time_seconds = (double)(end.tv_sec - start.tv_sec) +
+                          (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    result.peak_memory_bytes = account.peak;
+    return result;
+}
+
+void free_pi_digits_result(PiDigitsResult *result) {
+    free(result->digits);
+    result->digits = NULL;
+    result->digit_count = 0;
+    result->peak_memory_bytes = 0;
+}
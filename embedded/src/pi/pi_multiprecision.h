@@ -0,0 +1,61 @@
+#ifndef PI_MULTIPRECISION_H
+#define PI_MULTIPRECISION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../mp/mp_int.h"
+#include "../mp/mp_fixed.h"
+#include "../pool/compute_pool.h"
+#include "pi_machin.h"
+#include "pi_checkpoint.h"
+#include "../constants.h"
+
+// Digit kernels return a malloc'd "3.1415..." string with exactly
+// `digits` decimals (truncated, not rounded), or NULL on bad input.
+typedef char *(*CalculatePiDigits)(long long digits);
+
+// Checkpointed kernels resume from checkpoint->path when it holds the same
+// run, and return NULL once a requested stop has been checkpointed
+typedef char *(*CalculatePiDigitsCheckpointed)(long long digits, PiCheckpoint *checkpoint);
+
+typedef struct {
+    char *digits;
+    long long digit_count;
+    double time_seconds;
+    size_t peak_memory_bytes;  // high-water mark of the run's own big-number storage
+} PiDigitsResult;
+
+///////////////// Multiprecision kernels /////////////////
+char *chudnovsky_digits(long long digits);
+char *chudnovsky_bs_digits(long long digits);
+char *gauss_legendre_digits(long long digits);
+char *borwein_digits(long long digits);
+// Machin-like formulas by binary splitting, arctans in parallel
+char *machin_digits(long long digits);
+char *takano_digits(long long digits);
+char *stormer_digits(long long digits);
+char *chudnovsky_bs_digits_checkpointed(long long digits, PiCheckpoint *checkpoint);
+char *gauss_legendre_digits_checkpointed(long long digits, PiCheckpoint *checkpoint);
+
+///////////////// Split binary splitting /////////////////
+// Pieces of chudnovsky_bs for computing term ranges elsewhere (other
+// threads, processes or machines) and combining them:
+// terms needed for `digits`, P/Q/T over [a, b), the join of adjacent
+// ranges (outputs must not alias inputs; P may be NULL for the last
+// range), and the digits from Q/T over [0, terms) (Q is overwritten)
+long long chudnovsky_bs_terms(long long digits);
+void chudnovsky_bs_range(long long a, long long b, MpInt *P, MpInt *Q, MpInt *T);
+void chudnovsky_bs_join(MpInt *P, MpInt *Q, MpInt *T,
+                        const MpInt *P1, const MpInt *Q1, const MpInt *T1,
+                        const MpInt *P2, const MpInt *Q2, const MpInt *T2);
+char *chudnovsky_bs_finish(MpInt *Q, const MpInt *T, long long digits);
+
+// Utility functions
+// `scaled` holds pi * 10^(digits + MP_GUARD_DIGITS); guard digits are dropped
+char *format_pi_digits(const MpInt *scaled, long long digits);
+PiDigitsResult compute_pi_digits(CalculatePiDigits func, long long digits);
+void free_pi_digits_result(PiDigitsResult *result);
+
+#endif
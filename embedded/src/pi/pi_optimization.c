@@ -1,4 +1,7 @@
 #include "pi_optimization.h"
+#include "../pool/compute_pool.h"
+#include <string.h>
+#include <unistd.h>
 
 
 // Count correct digits in pi estimate
@@ -17,22 +20,68 @@ int count_correct_digits(long double estimate) {
     return digits;
 }
 
-// Test a pi calculation function with iteration count and time limit
-ExecutionStatus test_execution(CalculatePi func, long long iterations, 
-                              double time_limit, TestResult *test_result) {
-    clock_t start = clock();
-    long double estimate = func(iterations);
-    clock_t end = clock();
-    
-    test_result->time_used = (long double)(end - start) / CLOCKS_PER_SEC;
+// Wrap a plain long double kernel for the optimizer
+static PiKernel long_double_kernel(CalculatePi func) {
+    PiKernel kernel = {
+        .func = func,
+        .wide = NULL,
+        .max_digits = MAX_PRECISION_DIGITS,
+        .incremental = pi_incremental_for(func),
+        .backend = "long_double",
+        .counted = machin_counted_for(func)
+    };
+    return kernel;
+}
+
+// CPU time of the calling thread: probes run concurrently (phase 3, other
+// requests), and process-wide clock() would charge each one for all of them
+static long double probe_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (long double)now.tv_sec + (long double)now.tv_nsec / 1e9L;
+}
+
+// Run one kernel evaluation with iteration count and time limit; finite
+// results are recorded in the predictor when one is given. Kernels with an
+// incremental form report the terms they actually used, which trails the
+// count asked for once they have converged. Random methods are seeded from
+// the count, so a probe gives the same estimate whichever thread runs it.
+static ExecutionStatus run_kernel(const PiKernel *kernel, IterationPredictor *predictor,
+                                  long long iterations, double time_limit,
+                                  TestResult *test_result) {
+    pi_random_seed((unsigned long long)iterations);
+    long double start = probe_seconds();
+    long double estimate;
+    long long effective = iterations;
+    if (kernel->wide != NULL) {
+        test_result->wide_estimate = kernel->wide(iterations);
+        estimate = qd_to_ld(test_result->wide_estimate);
+    } else if (kernel->incremental != NULL) {
+        estimate = pi_evaluate(kernel->incremental, iterations, &effective);
+    } else if (kernel->counted != NULL) {
+        estimate = kernel->counted(iterations, &effective);
+    } else {
+        estimate = kernel->func(iterations);
+    }
+    test_result->time_used = probe_seconds() - start;
     test_result->estimate = estimate;
-    test_result->iterations = iterations;
-    test_result->digits = count_correct_digits(estimate);
+    test_result->iterations = effective;
+    if (kernel->wide != NULL) {
+        test_result->digits = qd_correct_digits(test_result->wide_estimate, kernel->max_digits);
+    } else {
+        test_result->wide_estimate = qd_from_ld(estimate);
+        test_result->digits = count_correct_digits(estimate);
+    }
     
     if (isnan(estimate) || isinf(estimate)) {
         return EXEC_INVALID;
     }
     
+    if (predictor != NULL) {
+        predictor_observe(predictor, effective, (double)test_result->time_used,
+                          test_result->digits);
+    }
+    
     if (test_result->time_used > time_limit) {
         return EXEC_TIMEOUT;
     }
@@ -40,12 +89,20 @@ ExecutionStatus test_execution(CalculatePi func, long long iterations,
     return EXEC_VALID;
 }
 
+// Test a pi calculation function with iteration count and time limit
+ExecutionStatus test_execution(CalculatePi func, long long iterations, 
+                              double time_limit, TestResult *test_result) {
+    PiKernel kernel = long_double_kernel(func);
+    return run_kernel(&kernel, NULL, iterations, time_limit, test_result);
+}
+
 // Update best result with current result
 void update_best_result(TestResult *best, const TestResult *current) {
     best->iterations = current->iterations;
     best->estimate = current->estimate;
     best->time_used = current->time_used;
     best->digits = current->digits;
+    best->wide_estimate = current->wide_estimate;
 }
 
 // Check if maximum precision has been reached
@@ -66,13 +123,14 @@ long long calculate_next_iteration(long long current, double time_used, double t
 }
 
 // Phase 1: Test small fixed iteration values
-int phase1_initial_search(CalculatePi func, double time_limit, TestResult *best) {
+static int kernel_phase1(const PiKernel *kernel, IterationPredictor *predictor,
+                         double time_limit, TestResult *best) {
     long long test_values[] = {1, 2, 3, 4, 5, 10, 20, 50, 100, 200, 500, 1000};
     int num_tests = sizeof(test_values) / sizeof(test_values[0]);
     
     for (int i = 0; i < num_tests; i++) {
         TestResult current;
-        ExecutionStatus status = test_execution(func, test_values[i], time_limit, &current);
+        ExecutionStatus status = run_kernel(kernel, predictor, test_values[i], time_limit, &current);
         
         if (status == EXEC_INVALID || status == EXEC_TIMEOUT) {
             break;
@@ -80,7 +138,7 @@ int phase1_initial_search(CalculatePi func, double time_limit, TestResult *best)
         
         update_best_result(best, &current);
         
-        if (has_reached_max_precision(current.digits)) {
+        if (current.digits >= kernel->max_digits) {
             return 1;
         }
     }
@@ -88,15 +146,26 @@ int phase1_initial_search(CalculatePi func, double time_limit, TestResult *best)
     return 0;
 }
 
+// Next probe for the from-scratch search: the predictor's jump once its
+// models have enough probes, the fixed growth schedule until then
+static long long next_probe(const PiKernel *kernel, const IterationPredictor *predictor,
+                            long long current, double time_used, double time_limit) {
+    long long next = predictor_next_iterations(predictor, current, time_limit, kernel->max_digits);
+    if (next <= 0) {
+        next = calculate_next_iteration(current, time_used, time_limit);
+    }
+    return next;
+}
+
 // Phase 2: Exponential search for optimal iterations
-int phase2_exponential_search(CalculatePi func, double time_limit, 
-                             long long start_iter, TestResult *best) {
+static int kernel_phase2(const PiKernel *kernel, IterationPredictor *predictor,
+                         double time_limit, long long start_iter, TestResult *best) {
     long long current = start_iter * 2;
     int no_improvement = 0;
     
     while (no_improvement < NO_IMPROVEMENT_THRESHOLD) {
         TestResult current_result;
-        ExecutionStatus status = test_execution(func, current, time_limit, &current_result);
+        ExecutionStatus status = run_kernel(kernel, predictor, current, time_limit, &current_result);
         
         if (status == EXEC_INVALID || status == EXEC_TIMEOUT) {
             break;
@@ -106,15 +175,16 @@ int phase2_exponential_search(CalculatePi func, double time_limit,
             update_best_result(best, &current_result);
             no_improvement = 0;
             
-            if (has_reached_max_precision(current_result.digits)) {
+            if (current_result.digits >= kernel->max_digits) {
                 return 1;
             }
         } else {
             no_improvement++;
         }
         
-        long long next = calculate_next_iteration(current, current_result.time_used, time_limit);
-        if (next == current || next > MAX_ITERATIONS) {
+        long long next = next_probe(kernel, predictor, current,
+                                    (double)current_result.time_used, time_limit);
+        if (next <= current || next > MAX_ITERATIONS) {
             break;
         }
         current = next;
@@ -123,65 +193,583 @@ int phase2_exponential_search(CalculatePi func, double time_limit,
     return 0;
 }
 
-// Phase 3: Fine-tune around best iteration count
-void phase3_fine_refinement(CalculatePi func, double time_limit, TestResult *best) {
-    if (best->digits >= MAX_PRECISION_DIGITS - 3 || best->time_used >= time_limit * 0.7) {
+// Phase 3: Fine-tune around best iteration count. Candidates bracketing
+// (best, best + 2 * increment] run concurrently on the compute pool, so the
+// phase costs about one probe's wall time. A kernel call cannot be
+// interrupted, so cancelling means a candidate that has not started yet is
+// skipped once a larger count has succeeded or a smaller one timed out.
+typedef struct {
+    long long floor;    // largest count that kept best's digits in time
+    long long ceiling;  // smallest count that timed out
+    int digits;         // digits to keep
+} Phase3Bracket;
+
+typedef struct {
+    const PiKernel *kernel;
+    Phase3Bracket *bracket;
+    double time_limit;
+    long long iterations;
+    int ran;
+    ExecutionStatus status;
+    TestResult result;
+} Phase3Probe;
+
+static void bracket_raise_floor(Phase3Bracket *bracket, long long iterations) {
+    long long current = __atomic_load_n(&bracket->floor, __ATOMIC_ACQUIRE);
+    while (iterations > current &&
+           !__atomic_compare_exchange_n(&bracket->floor, &current, iterations, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void bracket_lower_ceiling(Phase3Bracket *bracket, long long iterations) {
+    long long current = __atomic_load_n(&bracket->ceiling, __ATOMIC_ACQUIRE);
+    while (iterations < current &&
+           !__atomic_compare_exchange_n(&bracket->ceiling, &current, iterations, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void phase3_probe_run(void *arg) {
+    Phase3Probe *probe = (Phase3Probe *)arg;
+    Phase3Bracket *bracket = probe->bracket;
+    if (probe->iterations <= __atomic_load_n(&bracket->floor, __ATOMIC_ACQUIRE) ||
+        probe->iterations >= __atomic_load_n(&bracket->ceiling, __ATOMIC_ACQUIRE)) {
         return;
     }
-    
-    long long increment = best->iterations / 4;
-    if (increment < 1) increment = 1;
-    
+    probe->status = run_kernel(probe->kernel, NULL, probe->iterations, probe->time_limit,
+                               &probe->result);
+    probe->ran = 1;
+    if (probe->status == EXEC_VALID && probe->result.digits >= bracket->digits) {
+        bracket_raise_floor(bracket, probe->iterations);
+    } else if (probe->status == EXEC_TIMEOUT) {
+        bracket_lower_ceiling(bracket, probe->iterations);
+    }
+}
+
+// Without a second core to run on, concurrent candidates only share one:
+// walk the same bracket one probe at a time, halving the step after a miss
+static void kernel_phase3_sequential(const PiKernel *kernel, IterationPredictor *predictor,
+                                     double time_limit, long long increment, TestResult *best) {
+    long long limit = best->iterations + 2 * increment;
+    if (limit > MAX_ITERATIONS) limit = MAX_ITERATIONS;
     for (int attempt = 0; attempt < 10; attempt++) {
         long long try_iter = best->iterations + increment;
+        if (try_iter > limit) try_iter = limit;
+        if (try_iter <= best->iterations) break;
         
         TestResult current;
-        ExecutionStatus status = test_execution(func, try_iter, time_limit, &current);
+        ExecutionStatus status = run_kernel(kernel, predictor, try_iter, time_limit, &current);
         
-        if (status != EXEC_VALID) {
+        if (status == EXEC_VALID && current.digits >= best->digits) {
+            update_best_result(best, &current);
+            if (current.digits >= kernel->max_digits) break;
+        } else {
             increment /= 2;
             if (increment == 0) break;
+        }
+    }
+}
+
+static void kernel_phase3(const PiKernel *kernel, IterationPredictor *predictor,
+                          double time_limit, TestResult *best) {
+    if (best->digits >= kernel->max_digits - 3 || best->time_used >= time_limit * 0.7) {
+        return;
+    }
+    
+    long long increment = best->iterations / 4;
+    if (increment < 1) increment = 1;
+
+    // One candidate per thread that can run one, the caller included
+    int count = compute_pool_size();
+    if (count > PHASE3_MAX_CANDIDATES) count = PHASE3_MAX_CANDIDATES;
+    if (count < 2 || sysconf(_SC_NPROCESSORS_ONLN) < 2) {
+        kernel_phase3_sequential(kernel, predictor, time_limit, increment, best);
+        return;
+    }
+
+    Phase3Bracket bracket = {best->iterations, MAX_ITERATIONS + 1, best->digits};
+    Phase3Probe probes[PHASE3_MAX_CANDIDATES];
+    PoolTask tasks[PHASE3_MAX_CANDIDATES];
+    int used = 0;
+    for (int i = 0; i < count; i++) {
+        long long try_iter = best->iterations + 2 * increment * (i + 1) / count;
+        if (try_iter > MAX_ITERATIONS) try_iter = MAX_ITERATIONS;
+        if (try_iter <= best->iterations || (used > 0 && try_iter == probes[used - 1].iterations)) {
             continue;
         }
-        
-        if (current.digits >= best->digits) {
-            update_best_result(best, &current);
-            
-            if (has_reached_max_precision(current.digits)) {
+        Phase3Probe *probe = &probes[used++];
+        probe->kernel = kernel;
+        probe->bracket = &bracket;
+        probe->time_limit = time_limit;
+        probe->iterations = try_iter;
+        probe->ran = 0;
+    }
+    if (used == 0) return;
+
+    // Largest candidates first: they decide the most about the others
+    for (int i = used - 1; i > 0; i--) pool_task_spawn(&tasks[i], phase3_probe_run, &probes[i]);
+    phase3_probe_run(&probes[0]);
+    for (int i = 1; i < used; i++) pool_task_wait(&tasks[i]);
+
+    // Best digits that finished in time, the larger count on ties
+    Phase3Probe *chosen = NULL;
+    for (int i = 0; i < used; i++) {
+        Phase3Probe *probe = &probes[i];
+        if (!probe->ran) continue;
+        predictor_observe(predictor, probe->iterations, (double)probe->result.time_used,
+                          probe->result.digits);
+        if (probe->status != EXEC_VALID || probe->result.digits < best->digits) continue;
+        if (chosen == NULL || probe->result.digits >= chosen->result.digits) chosen = probe;
+    }
+    if (chosen != NULL) {
+        update_best_result(best, &chosen->result);
+    }
+}
+
+// A series state's estimate as a probe result
+static void incremental_result(const PiIncremental *series, const PiSeriesState *state,
+                               long double time_used, TestResult *result) {
+    result->iterations = state->effective;
+    result->estimate = series->estimate(state);
+    result->time_used = time_used;
+    result->digits = count_correct_digits(result->estimate);
+    result->wide_estimate = qd_from_ld(result->estimate);
+}
+
+// Incremental search: one state is carried through the probe schedule, so
+// each probe only pays for its new terms and the search can use the whole
+// time limit. Probe times are cumulative, i.e. what the count cost to reach.
+// Every slice on the way is checked too: long double series peak and then
+// lose digits to rounding, and a predicted jump may cross the peak.
+static void kernel_incremental_search(const PiKernel *kernel, IterationPredictor *predictor,
+                                      double time_limit, TestResult *best) {
+    const PiIncremental *series = kernel->incremental;
+    PiSeriesState state;
+    series->init(&state);
+    long double time_used = 0.0L;
+    long double previous_estimate = NAN;
+    long long target = 1;
+    int no_improvement = 0;
+
+    while (target <= MAX_ITERATIONS && no_improvement < NO_IMPROVEMENT_THRESHOLD) {
+        // Advance in slices of ~1/16 of the work so far; a slice that would
+        // cross the limit is rolled back and ends the search
+        int timed_out = 0;
+        while (state.count < target) {
+            long long slice = state.count / 16;
+            if (slice < 1) slice = 1;
+            if (slice > target - state.count) slice = target - state.count;
+
+            PiSeriesState saved = state;
+            long double start = probe_seconds();
+            series->advance(&state, slice);
+            long double elapsed = probe_seconds() - start;
+            if (time_used + elapsed > time_limit) {
+                state = saved;
+                timed_out = 1;
                 break;
             }
+            time_used += elapsed;
+
+            TestResult passing;
+            incremental_result(series, &state, time_used, &passing);
+            if (passing.digits > best->digits && !isnan(passing.estimate) && !isinf(passing.estimate)) {
+                update_best_result(best, &passing);
+            }
+        }
+        if (state.count == 0) break;
+
+        TestResult current;
+        incremental_result(series, &state, time_used, &current);
+        if (isnan(current.estimate) || isinf(current.estimate)) break;
+        predictor_observe(predictor, current.iterations, (double)time_used, current.digits);
+
+        if (current.digits >= best->digits) {
+            update_best_result(best, &current);
+            no_improvement = 0;
+            if (current.digits >= kernel->max_digits) break;
         } else {
-            increment /= 2;
-            if (increment == 0) break;
+            no_improvement++;
         }
+
+        // A converged iteration (AGM fixed point, underflowed terms) stops changing
+        if (timed_out || current.estimate == previous_estimate) break;
+        previous_estimate = current.estimate;
+
+        // The predictor picks the next target once its models have enough
+        // probes; cumulative times fit the cost of reaching a count. The
+        // fixed growth rule only covers the first probes and never stalls,
+        // since late probes cost only their new terms.
+        long long next = target < 5 ? target + 1
+                                    : predictor_next_iterations(predictor, target, time_limit,
+                                                                kernel->max_digits);
+        if (next == target) break;  // precision floor, or the optimum is here
+        if (next <= 0) next = calculate_next_iteration(target, time_used, time_limit);
+        if (next <= target) next = target + target / 4;
+        if (next > MAX_ITERATIONS && target < MAX_ITERATIONS) next = MAX_ITERATIONS;
+        target = next;
     }
 }
 
+int phase1_initial_search(CalculatePi func, double time_limit, TestResult *best) {
+    PiKernel kernel = long_double_kernel(func);
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    return kernel_phase1(&kernel, &predictor, time_limit, best);
+}
+
+int phase2_exponential_search(CalculatePi func, double time_limit, 
+                             long long start_iter, TestResult *best) {
+    PiKernel kernel = long_double_kernel(func);
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    return kernel_phase2(&kernel, &predictor, time_limit, start_iter, best);
+}
+
+void phase3_fine_refinement(CalculatePi func, double time_limit, TestResult *best) {
+    PiKernel kernel = long_double_kernel(func);
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    kernel_phase3(&kernel, &predictor, time_limit, best);
+}
+
+// Convert a search's best run to the final result
+static PiResult to_pi_result(const PiKernel *kernel, const TestResult *best) {
+    PiResult result = {
+        .pi_estimate = best->estimate,
+        .iterations = best->iterations,
+        .cpu_time_used = best->time_used,
+        .correct_digits = best->digits,
+        .error = fabsl(best->estimate - PI_REFERENCE),
+        .wide_estimate = best->wide_estimate,
+        .max_digits = kernel->max_digits,
+        .target_digits = 0,
+        .target_reached = 0
+    };
+    return result;
+}
+
+///////////////// Calibration profiles /////////////////
+static const char *kernel_backend(const PiKernel *kernel) {
+    return kernel->backend != NULL ? kernel->backend : "long_double";
+}
+
+// Start from a stored profile: one verification probe at the remembered
+// optimum, or at the predicted one (then refined) for a different budget.
+// Returns 0 when the profile cannot be trusted and the search has to run
+// cold.
+static int kernel_warm_start(const PiKernel *kernel, const PiProfile *profile,
+                             IterationPredictor *predictor, double time_limit, TestResult *best) {
+    for (int i = 0; i < profile->probes; i++) {
+        predictor_observe(predictor, profile->iterations[i], profile->seconds[i], profile->digits[i]);
+    }
+
+    // The stored best carries over when the budget is the same, or when it
+    // was limited by precision rather than time
+    int precision_bound = profile->best_seconds < profile->time_limit * PROFILE_BUDGET_BOUND &&
+                          profile->best_seconds <= time_limit;
+    int remembered = fabs(profile->time_limit - time_limit) < 1e-9 || precision_bound;
+    long long target;
+    if (remembered) {
+        // A best found at the very edge of the budget may not fit twice
+        target = profile->best_iterations;
+        double budget = time_limit * PREDICTOR_BUDGET_FRACTION;
+        if (profile->best_seconds > budget) {
+            target = (long long)(target * (budget / profile->best_seconds));
+        }
+    } else {
+        target = predictor_optimum(predictor, time_limit, kernel->max_digits);
+    }
+    if (target <= 0) return 0;
+
+    TestResult verify;
+    if (run_kernel(kernel, predictor, target, time_limit, &verify) != EXEC_VALID) return 0;
+    // Fewer digits than remembered means the profile is stale
+    if (remembered && verify.digits < profile->best_digits - 1) return 0;
+
+    update_best_result(best, &verify);
+    if (!remembered && best->digits < kernel->max_digits) {
+        kernel_phase3(kernel, predictor, time_limit, best);
+    }
+    return 1;
+}
+
+static void kernel_record_profile(const PiKernel *kernel, const char *func_name,
+                                  const IterationPredictor *predictor, double time_limit,
+                                  const TestResult *best) {
+    PiProfile profile;
+    memset(&profile, 0, sizeof(profile));
+    snprintf(profile.algorithm, sizeof(profile.algorithm), "%s", func_name);
+    snprintf(profile.backend, sizeof(profile.backend), "%s", kernel_backend(kernel));
+    profile.time_limit = time_limit;
+    profile.best_iterations = best->iterations;
+    profile.best_seconds = (double)best->time_used;
+    profile.best_digits = best->digits;
+    profile.probes = predictor->probes;
+    memcpy(profile.iterations, predictor->iterations, sizeof(profile.iterations));
+    memcpy(profile.seconds, predictor->seconds, sizeof(profile.seconds));
+    memcpy(profile.digits, predictor->digits, sizeof(profile.digits));
+    profile_record(&profile);
+}
+
+// Find the best precision a kernel reaches within the time limit
+PiResult optimize_pi_kernel(const PiKernel *kernel, const char* func_name, double time_limit) {
+    TestResult best = {
+        .iterations = 1,
+        .estimate = 0.0L,
+        .time_used = 0.0L,
+        .digits = 0,
+        .wide_estimate = qd_from_ld(0.0L)
+    };
+
+    // One predictor sees every probe, so phase 2 can jump as soon as the
+    // cost and convergence models have enough points, and the probes can
+    // be stored as this kernel's calibration profile
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+
+    PiProfile profile;
+    int warm = func_name != NULL &&
+               profile_lookup(func_name, kernel_backend(kernel), &profile) &&
+               kernel_warm_start(kernel, &profile, &predictor, time_limit, &best);
+
+    if (warm) {
+        // Already refined from the profile
+    } else if (kernel->incremental != NULL && kernel->wide == NULL) {
+        kernel_incremental_search(kernel, &predictor, time_limit, &best);
+    } else {
+        // Phase 1: Initial search with small values
+        int early_complete = kernel_phase1(kernel, &predictor, time_limit, &best);
+        
+        // Phase 2: Exponential search
+        if (!early_complete) {
+            early_complete = kernel_phase2(kernel, &predictor, time_limit, best.iterations, &best);
+        }
+        
+        // Phase 3: Fine refinement
+        if (!early_complete) {
+            kernel_phase3(kernel, &predictor, time_limit, &best);
+        }
+    }
+
+    if (func_name != NULL && best.digits > 0) {
+        kernel_record_profile(kernel, func_name, &predictor, time_limit, &best);
+    }
+    
+    return to_pi_result(kernel, &best);
+}
+
 // Main optimization function - find best pi precision within time limit
 PiResult optimize_pi_precision(CalculatePi func, const char* func_name, double time_limit) {
-    TestResult best = {1, 0.0L, 0.0L, 0};
-    
-    // Phase 1: Initial search with small values
-    int early_complete = phase1_initial_search(func, time_limit, &best);
-    
-    // Phase 2: Exponential search
-    if (!early_complete) {
-        early_complete = phase2_exponential_search(func, time_limit, best.iterations, &best);
+    PiKernel kernel = long_double_kernel(func);
+    return optimize_pi_kernel(&kernel, func_name, time_limit);
+}
+
+///////////////// Target digits /////////////////
+typedef struct {
+    const char *name;
+    ConvergenceModel model;
+    double a, b;
+} ConvergenceRate;
+
+// Digits after n terms or iterations, measured in long double and matching
+// the textbook rates: error ~ 1/n (leibniz, euler), ~ 1/n^3 (nilakantha),
+// ~ 1/sqrt(n) (random methods), 8 and 14 digits per term (ramanujan,
+// chudnovsky), 1.2 per term (bbp), doubling and quadrupling (AGM, borwein)
+static const ConvergenceRate CONVERGENCE_RATES[] = {
+    {"leibniz", CONVERGENCE_LOGARITHMIC, 0.0, 1.0},
+    {"euler", CONVERGENCE_LOGARITHMIC, 0.0, 1.0},
+    {"euler_kahan", CONVERGENCE_LOGARITHMIC, 0.0, 1.0},
+    {"nilakantha", CONVERGENCE_LOGARITHMIC, 0.0, 3.0},
+    {"monte_carlo", CONVERGENCE_LOGARITHMIC, 0.0, 0.5},
+    {"buffon", CONVERGENCE_LOGARITHMIC, 0.0, 0.5},
+    {"pi_coprimes", CONVERGENCE_LOGARITHMIC, 0.0, 0.5},
+    {"ramanujan_fast", CONVERGENCE_LINEAR, 0.0, 8.0},
+    {"ramanujan", CONVERGENCE_LINEAR, 0.0, 8.0},
+    {"chudnovsky_fast", CONVERGENCE_LINEAR, 0.0, 14.0},
+    {"chudnovsky", CONVERGENCE_LINEAR, 0.0, 14.0},
+    {"bbp", CONVERGENCE_LINEAR, 1.0, 1.2},
+    {"gauss_legendre", CONVERGENCE_QUADRATIC, 1.0, 1.0},
+    {"borwein", CONVERGENCE_QUADRATIC, 1.0, 2.0},
+    // Set by the smallest q: 2 log10(q) digits per term
+    {"machin", CONVERGENCE_LINEAR, 0.0, 1.4},
+    {"takano", CONVERGENCE_LINEAR, 0.0, 3.4},
+    {"stormer", CONVERGENCE_LINEAR, 0.0, 3.5},
+    {NULL, CONVERGENCE_LINEAR, 0.0, 0.0}
+};
+
+int pi_convergence_rate(const char *name, ConvergenceModel *model, double *a, double *b) {
+    if (name == NULL) return 0;
+    for (int i = 0; CONVERGENCE_RATES[i].name != NULL; i++) {
+        if (strcmp(CONVERGENCE_RATES[i].name, name) == 0) {
+            *model = CONVERGENCE_RATES[i].model;
+            *a = CONVERGENCE_RATES[i].a;
+            *b = CONVERGENCE_RATES[i].b;
+            return 1;
+        }
     }
-    
-    // Phase 3: Fine refinement
-    if (!early_complete) {
-        phase3_fine_refinement(func, time_limit, &best);
+    return 0;
+}
+
+// Next count to try after `shortfall` fell short: the fitted model once it
+// has two points, the a-priori rate before that, and at least double
+static long long digits_next_guess(const IterationPredictor *predictor, const char *func_name,
+                                   int target_digits, long long shortfall) {
+    long long guess = predictor_iterations_for_digits(predictor, target_digits);
+    ConvergenceModel model;
+    double a, b;
+    if (guess <= 0 && pi_convergence_rate(func_name, &model, &a, &b)) {
+        guess = predictor_solve_convergence(model, a, b, target_digits);
     }
-    
-    // Convert to final result
-    PiResult result = {
-        .pi_estimate = best.estimate,
-        .iterations = best.iterations,
-        .cpu_time_used = best.time_used,
-        .correct_digits = best.digits,
-        .error = fabsl(best.estimate - PI_REFERENCE)
+    if (shortfall > 0) {
+        if (guess < shortfall * 2) guess = shortfall * 2;
+        if (guess > shortfall * PREDICTOR_MAX_GROWTH) guess = shortfall * PREDICTOR_MAX_GROWTH;
+    }
+    if (guess < 1) guess = 1;
+    if (guess > MAX_ITERATIONS) guess = MAX_ITERATIONS;
+    return guess;
+}
+
+// From-scratch kernels: jump to a count expected to reach the target, then
+// bisect down to the smallest one that does
+static int digits_probe_search(const PiKernel *kernel, const char *func_name, int target_digits,
+                               double time_limit, TestResult *best) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    long long shortfall = 0;
+    long long reached = 0;
+    TestResult current;
+
+    while (!reached) {
+        long long n = digits_next_guess(&predictor, func_name, target_digits, shortfall);
+        if (n <= shortfall) break;
+        if (run_kernel(kernel, &predictor, n, time_limit, &current) != EXEC_VALID) break;
+        if (current.digits >= best->digits) update_best_result(best, &current);
+        if (current.digits >= target_digits) {
+            reached = n;
+        } else {
+            shortfall = n;
+        }
+    }
+    if (!reached) return 0;
+
+    while (reached - shortfall > 1) {
+        long long mid = shortfall + (reached - shortfall) / 2;
+        if (run_kernel(kernel, NULL, mid, time_limit, &current) == EXEC_VALID &&
+            current.digits >= target_digits) {
+            reached = mid;
+            update_best_result(best, &current);
+        } else {
+            shortfall = mid;
+        }
+    }
+    return 1;
+}
+
+// Advance `state` towards `limit` in steps of `step`, stopping at the first
+// step that reaches the target; times are accumulated into *elapsed.
+// Returns 1 on reaching it, 0 if it is not reached by `limit`, -1 when the
+// time limit runs out.
+static int digits_step(const PiIncremental *series, PiSeriesState *state, long long limit,
+                       long long step, int target_digits, double time_limit,
+                       long double *elapsed, PiSeriesState *before, long double *before_elapsed) {
+    while (state->count < limit) {
+        long long slice = step;
+        if (slice < 1) slice = state->count / 16 > 1 ? state->count / 16 : 1;
+        if (slice > limit - state->count) slice = limit - state->count;
+
+        *before = *state;
+        *before_elapsed = *elapsed;
+        long double start = probe_seconds();
+        series->advance(state, slice);
+        *elapsed += probe_seconds() - start;
+        if (*elapsed > time_limit) return -1;
+        if (count_correct_digits(series->estimate(state)) >= target_digits) return 1;
+    }
+    return 0;
+}
+
+// Incremental kernels: walk one state forward until the target is reached,
+// then narrow the last slice down by sixteenths from the state before it.
+// The walk costs about as much as one run at the answer.
+static int digits_incremental_search(const PiKernel *kernel, int target_digits,
+                                     double time_limit, TestResult *best) {
+    const PiIncremental *series = kernel->incremental;
+    PiSeriesState state, before;
+    long double elapsed = 0.0L, before_elapsed = 0.0L;
+    series->init(&state);
+
+    // step 0: growing slices of 1/16 of the count so far
+    int status = digits_step(series, &state, MAX_ITERATIONS, 0, target_digits, time_limit,
+                             &elapsed, &before, &before_elapsed);
+    if (status != 1) {
+        // Report the furthest state that fit in the time limit
+        if (status < 0) {
+            state = before;
+            elapsed = before_elapsed;
+        }
+        long double estimate = series->estimate(&state);
+        TestResult current = {
+            .iterations = state.effective,
+            .estimate = estimate,
+            .time_used = elapsed,
+            .digits = count_correct_digits(estimate),
+            .wide_estimate = qd_from_ld(estimate)
+        };
+        if (state.count > 0) update_best_result(best, &current);
+        return 0;
+    }
+
+    while (state.count - before.count > 1) {
+        PiSeriesState reached = state;
+        long double reached_elapsed = elapsed;
+        long long step = (state.count - before.count + 15) / 16;
+        state = before;
+        elapsed = before_elapsed;
+        if (digits_step(series, &state, reached.count, step, target_digits, time_limit,
+                        &elapsed, &before, &before_elapsed) != 1) {
+            state = reached;
+            elapsed = reached_elapsed;
+            break;
+        }
+    }
+
+    TestResult current;
+    current.iterations = state.effective;
+    current.estimate = series->estimate(&state);
+    current.time_used = elapsed;
+    current.digits = count_correct_digits(current.estimate);
+    current.wide_estimate = qd_from_ld(current.estimate);
+    update_best_result(best, &current);
+    return 1;
+}
+
+PiResult optimize_pi_kernel_digits(const PiKernel *kernel, const char* func_name,
+                                   int target_digits, double time_limit) {
+    TestResult best = {
+        .iterations = 1,
+        .estimate = 0.0L,
+        .time_used = 0.0L,
+        .digits = 0,
+        .wide_estimate = qd_from_ld(0.0L)
     };
-    
+    int reached = 0;
+    if (target_digits < 1 || target_digits > kernel->max_digits) {
+        // Out of the kernel's reach: nothing to search for
+    } else if (kernel->incremental != NULL && kernel->wide == NULL) {
+        reached = digits_incremental_search(kernel, target_digits, time_limit, &best);
+    } else {
+        reached = digits_probe_search(kernel, func_name, target_digits, time_limit, &best);
+    }
+
+    PiResult result = to_pi_result(kernel, &best);
+    result.target_digits = target_digits;
+    result.target_reached = reached;
     return result;
-}
\ No newline at end of file
+}
+
+PiResult optimize_pi_digits(CalculatePi func, const char* func_name, int target_digits, double time_limit) {
+    PiKernel kernel = long_double_kernel(func);
+    return optimize_pi_kernel_digits(&kernel, func_name, target_digits, time_limit);
+}
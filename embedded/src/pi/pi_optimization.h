@@ -2,6 +2,10 @@
 #define PI_OPTIMIZATION_H
 
 #include "pi_calculations.h"
+#include "pi_machin.h"
+#include "pi_predictor.h"
+#include "pi_profile.h"
+#include "../dd/dd_real.h"
 #include "../constants.h"
 #include <float.h>
 #include <time.h>
@@ -9,12 +13,34 @@
 
 typedef long double (*CalculatePi)(long long);
 
+// Kernel evaluated beyond long double, result widened to quad-double
+typedef qd_real (*CalculatePiWide)(long long);
+
+// What the optimizer drives: a long double kernel, or a wide one when
+// `wide` is set, or a counted one (series acceleration) when `counted` is
+// set, plus the digit count at which its precision saturates.
+// With `incremental` set the search extends one running state instead of
+// re-evaluating func from scratch for every probe. `backend` names the
+// precision or acceleration for calibration profiles; NULL means long double.
+typedef struct {
+    CalculatePi func;
+    CalculatePiWide wide;
+    int max_digits;
+    const PiIncremental *incremental;
+    const char *backend;
+    CalculatePiCounted counted;
+} PiKernel;
+
 typedef struct {
     long double pi_estimate;
     long long iterations;
     long double cpu_time_used;
     int correct_digits;
     long double error;
+    qd_real wide_estimate;  // full estimate for wide kernels
+    int max_digits;
+    int target_digits;      // target-digits mode: digits asked for, else 0
+    int target_reached;
 } PiResult;
 
 typedef enum {
@@ -28,6 +54,7 @@ typedef struct {
     long double estimate;
     long double time_used;
     int digits;
+    qd_real wide_estimate;
 } TestResult;
 
 // Utility functions
@@ -40,5 +67,17 @@ int phase1_initial_search(CalculatePi func, double time_limit, TestResult *best)
 int phase2_exponential_search(CalculatePi func, double time_limit, long long start_iter, TestResult *best);
 void phase3_fine_refinement(CalculatePi func, double time_limit, TestResult *best);
 PiResult optimize_pi_precision(CalculatePi func, const char* func_name, double time_limit);
+PiResult optimize_pi_kernel(const PiKernel *kernel, const char* func_name, double time_limit);
+
+// Target-digits mode: the smallest iteration count reaching target_digits,
+// with cpu_time_used the time it takes. Gives up (target_reached = 0,
+// best run so far) once a run would exceed time_limit or MAX_ITERATIONS.
+PiResult optimize_pi_digits(CalculatePi func, const char* func_name, int target_digits, double time_limit);
+PiResult optimize_pi_kernel_digits(const PiKernel *kernel, const char* func_name,
+                                   int target_digits, double time_limit);
+
+// A-priori convergence of a named algorithm, digits(n) in the predictor's
+// model terms; 0 for unknown names
+int pi_convergence_rate(const char *name, ConvergenceModel *model, double *a, double *b);
 
 #endif
\ No newline at end of file
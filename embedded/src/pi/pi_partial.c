@@ -0,0 +1,86 @@
+#include "pi_partial.h"
+#include <string.h>
+#include <stdint.h>
+
+#define PARTIAL_MAGIC "PIPART"
+#define PARTIAL_MAGIC_LENGTH 6
+#define PARTIAL_VERSION 1
+#define PARTIAL_HEADER_BYTES (PARTIAL_MAGIC_LENGTH + 2 + 16)
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+static uint64_t fnv1a(const unsigned char *data, size_t length) {
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < length; i++) hash = (hash ^ data[i]) * FNV_PRIME;
+    return hash;
+}
+
+static unsigned char *put_le(unsigned char *out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out[i] = (unsigned char)(value >> (8 * i));
+    return out + bytes;
+}
+
+static uint64_t get_le(const unsigned char *in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+unsigned char *partial_encode(long long start, long long end, const MpInt *const *values, int count,
+                              size_t *length) {
+    if (count < 0 || count > PARTIAL_MAX_VALUES || start < 0 || end <= start) return NULL;
+    size_t total = PARTIAL_HEADER_BYTES + sizeof(uint64_t);
+    for (int i = 0; i < count; i++) total += 1 + sizeof(uint64_t) + values[i]->size * sizeof(uint32_t);
+    unsigned char *data = (unsigned char *)malloc(total);
+    if (data == NULL) return NULL;
+
+    unsigned char *out = data;
+    memcpy(out, PARTIAL_MAGIC, PARTIAL_MAGIC_LENGTH);
+    out += PARTIAL_MAGIC_LENGTH;
+    *out++ = PARTIAL_VERSION;
+    *out++ = (unsigned char)count;
+    out = put_le(out, (uint64_t)start, 8);
+    out = put_le(out, (uint64_t)end, 8);
+    for (int i = 0; i < count; i++) {
+        *out++ = values[i]->negative ? 1 : 0;
+        out = put_le(out, values[i]->size, 8);
+        for (size_t j = 0; j < values[i]->size; j++) out = put_le(out, values[i]->limbs[j], 4);
+    }
+    out = put_le(out, fnv1a(data, (size_t)(out - data)), 8);
+    *length = total;
+    return data;
+}
+
+int partial_decode(const unsigned char *data, size_t length, long long *start, long long *end,
+                   MpInt *values, int max_values) {
+    if (length < PARTIAL_HEADER_BYTES + sizeof(uint64_t) ||
+        memcmp(data, PARTIAL_MAGIC, PARTIAL_MAGIC_LENGTH) != 0 ||
+        data[PARTIAL_MAGIC_LENGTH] != PARTIAL_VERSION) {
+        return -1;
+    }
+    size_t body = length - sizeof(uint64_t);
+    if (get_le(data + body, 8) != fnv1a(data, body)) return -1;
+
+    int count = data[PARTIAL_MAGIC_LENGTH + 1];
+    if (count > max_values || count > PARTIAL_MAX_VALUES) return -1;
+    *start = (long long)get_le(data + PARTIAL_MAGIC_LENGTH + 2, 8);
+    *end = (long long)get_le(data + PARTIAL_MAGIC_LENGTH + 10, 8);
+    if (*start < 0 || *end <= *start) return -1;
+
+    size_t offset = PARTIAL_HEADER_BYTES;
+    for (int i = 0; i < count; i++) {
+        if (body - offset < 1 + sizeof(uint64_t)) return -1;
+        int negative = data[offset] != 0;
+        uint64_t size = get_le(data + offset + 1, 8);
+        offset += 1 + sizeof(uint64_t);
+        if (size > (body - offset) / sizeof(uint32_t)) return -1;
+        mp_reserve(&values[i], (size_t)size);
+        for (size_t j = 0; j < size; j++) values[i].limbs[j] = (mp_limb_t)get_le(data + offset + 4 * j, 4);
+        values[i].size = (size_t)size;
+        // Keep the representation canonical even if the sender's was not
+        while (values[i].size > 0 && values[i].limbs[values[i].size - 1] == 0) values[i].size--;
+        values[i].negative = negative && values[i].size > 0;
+        offset += (size_t)size * sizeof(uint32_t);
+    }
+    return offset == body ? count : -1;
+}
@@ -0,0 +1,26 @@
+#ifndef PI_PARTIAL_H
+#define PI_PARTIAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../mp/mp_int.h"
+#include "../constants.h"
+
+// Exact binary encoding of a term range's big numbers (P, Q, T for binary
+// splitting), for moving partial results between nodes:
+//   "PIPART" | version u8 | count u8 | start i64 | end i64
+//   count x (negative u8 | limb count u64 | limbs u32...)
+//   FNV-1a 64 of all bytes before it
+// Integers are little-endian regardless of the host.
+
+// Encode `count` values for a non-empty [start, end); a malloc'd buffer of
+// *length bytes, or NULL on bad input or allocation failure
+unsigned char *partial_encode(long long start, long long end, const MpInt *const *values, int count,
+                              size_t *length);
+
+// Decode into values[0 .. count), which must be initialized; returns count,
+// or -1 if the data is malformed, truncated, or has more than max_values
+int partial_decode(const unsigned char *data, size_t length, long long *start, long long *end,
+                   MpInt *values, int max_values);
+
+#endif
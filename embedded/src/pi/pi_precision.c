@@ -0,0 +1,147 @@
+#include "pi_precision.h"
+#include <string.h>
+
+static const char *PRECISION_NAMES[PRECISION_COUNT] = {
+    "float", "double", "long_double", "float128", "dd", "qd"
+};
+
+///////////////// Float /////////////////
+#define PI_T float
+#define PI_SUFFIX float
+#define PI_FROM_D(d) ((float)(d))
+#define PI_ADD(a, b) ((a) + (b))
+#define PI_SUB(a, b) ((a) - (b))
+#define PI_MUL(a, b) ((a) * (b))
+#define PI_DIV(a, b) ((a) / (b))
+#define PI_ADD_D(a, d) ((a) + (float)(d))
+#define PI_MUL_D(a, d) ((a) * (float)(d))
+#define PI_DIV_D(a, d) ((a) / (float)(d))
+#define PI_SQRT(a) sqrtf(a)
+#define PI_WIDEN(a) qd_from_d((double)(a))
+#define PI_TO_D(a) ((double)(a))
+#define PI_EPSILON FLT_EPSILON
+#include "pi_generic.inc"
+
+///////////////// Double /////////////////
+#define PI_T double
+#define PI_SUFFIX double
+#define PI_FROM_D(d) ((double)(d))
+#define PI_ADD(a, b) ((a) + (b))
+#define PI_SUB(a, b) ((a) - (b))
+#define PI_MUL(a, b) ((a) * (b))
+#define PI_DIV(a, b) ((a) / (b))
+#define PI_ADD_D(a, d) ((a) + (d))
+#define PI_MUL_D(a, d) ((a) * (d))
+#define PI_DIV_D(a, d) ((a) / (d))
+#define PI_SQRT(a) sqrt(a)
+#define PI_WIDEN(a) qd_from_d(a)
+#define PI_TO_D(a) (a)
+#define PI_EPSILON DBL_EPSILON
+#include "pi_generic.inc"
+
+///////////////// Long double /////////////////
+// The series and AGM kernels are the incremental ones in pi_calculations.c,
+// which the optimizer resumes across probes; only the Machin-like formulas
+// and the wide entry points come from pi_generic.inc
+long double leibniz_long_double(long long terms) { return leibniz(terms); }
+long double euler_long_double(long long terms) { return euler(terms); }
+long double nilakantha_long_double(long long terms) { return nilakantha(terms); }
+long double ramanujan_long_double(long long terms) { return ramanujan_fast(terms); }
+long double chudnovsky_long_double(long long terms) { return chudnovsky_fast(terms); }
+long double gauss_legendre_long_double(long long iterations) { return gauss_legendre(iterations); }
+long double bbp_long_double(long long iterations) { return bbp(iterations); }
+long double borwein_long_double(long long iterations) { return borwein(iterations); }
+
+#define PI_SERIES_DEFINED
+#define PI_T long double
+#define PI_SUFFIX long_double
+#define PI_FROM_D(d) ((long double)(d))
+#define PI_ADD(a, b) ((a) + (b))
+#define PI_SUB(a, b) ((a) - (b))
+#define PI_MUL(a, b) ((a) * (b))
+#define PI_DIV(a, b) ((a) / (b))
+#define PI_ADD_D(a, d) ((a) + (long double)(d))
+#define PI_MUL_D(a, d) ((a) * (long double)(d))
+#define PI_DIV_D(a, d) ((a) / (long double)(d))
+#define PI_SQRT(a) sqrtl(a)
+#define PI_WIDEN(a) qd_from_ld(a)
+#define PI_TO_D(a) ((double)(a))
+#define PI_EPSILON ((double)LDBL_EPSILON)
+#include "pi_generic.inc"
+
+///////////////// Binary128 /////////////////
+#if PI_HAVE_FLOAT128
+// Newton step from the long double root; avoids a libquadmath dependency
+static pi_float128 sqrt_float128(pi_float128 a) {
+    if (a <= 0) return 0;
+    pi_float128 x = (pi_float128)sqrtl((long double)a);
+    return (x + a / x) * (pi_float128)0.5;
+}
+
+static qd_real qd_from_float128(pi_float128 a) {
+    double c[4];
+    for (int i = 0; i < 4; i++) {
+        c[i] = (double)a;
+        a -= (pi_float128)c[i];
+    }
+    return qd_renorm(c[0], c[1], c[2], c[3], 0.0);
+}
+
+#define PI_T pi_float128
+#define PI_SUFFIX float128
+#define PI_FROM_D(d) ((pi_float128)(d))
+#define PI_ADD(a, b) ((a) + (b))
+#define PI_SUB(a, b) ((a) - (b))
+#define PI_MUL(a, b) ((a) * (b))
+#define PI_DIV(a, b) ((a) / (b))
+#define PI_ADD_D(a, d) ((a) + (pi_float128)(d))
+#define PI_MUL_D(a, d) ((a) * (pi_float128)(d))
+#define PI_DIV_D(a, d) ((a) / (pi_float128)(d))
+#define PI_SQRT(a) sqrt_float128(a)
+#define PI_WIDEN(a) qd_from_float128(a)
+#define PI_TO_D(a) ((double)(a))
+#define PI_EPSILON 1.925929944387236e-34  // 2^-112
+#include "pi_generic.inc"
+#endif
+
+///////////////// Precision names /////////////////
+int precision_from_name(const char *name, PiPrecision *precision) {
+    if (name == NULL) return 0;
+    for (int i = 0; i < PRECISION_COUNT; i++) {
+        if (strcmp(name, PRECISION_NAMES[i]) == 0) {
+            if (i == PRECISION_FLOAT128 && !PI_HAVE_FLOAT128) return 0;
+            *precision = (PiPrecision)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *precision_name(PiPrecision precision) {
+    if (precision < 0 || precision >= PRECISION_COUNT) return "unknown";
+    return PRECISION_NAMES[precision];
+}
+
+int precision_max_digits(PiPrecision precision) {
+    switch (precision) {
+        case PRECISION_FLOAT:
+            return qd_correct_digits(qd_from_d((float)QD_PI.x[0]), QD_MAX_DIGITS);
+        case PRECISION_DOUBLE:
+            return qd_correct_digits(qd_from_d(QD_PI.x[0]), QD_MAX_DIGITS);
+        case PRECISION_LONG_DOUBLE:
+            return qd_correct_digits(qd_from_ld(qd_to_ld(QD_PI)), QD_MAX_DIGITS);
+#if PI_HAVE_FLOAT128
+        case PRECISION_FLOAT128: {
+            pi_float128 pi = (pi_float128)QD_PI.x[0] + (pi_float128)QD_PI.x[1]
+                           + (pi_float128)QD_PI.x[2];
+            return qd_correct_digits(qd_from_float128(pi), QD_MAX_DIGITS);
+        }
+#endif
+        case PRECISION_DD:
+            return DD_MAX_DIGITS;
+        case PRECISION_QD:
+            return QD_MAX_DIGITS;
+        default:
+            return 0;
+    }
+}
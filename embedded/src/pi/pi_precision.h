@@ -0,0 +1,59 @@
+#ifndef PI_PRECISION_H
+#define PI_PRECISION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include "pi_generic.h"
+#include "pi_extended.h"
+#include "../constants.h"
+
+// Binary128: __float128 where the compiler has it (x86-64), otherwise
+// long double when that is already IEEE quad (aarch64 Linux)
+#if defined(__SIZEOF_FLOAT128__)
+typedef __float128 pi_float128;
+#define PI_HAVE_FLOAT128 1
+#elif LDBL_MANT_DIG == 113
+typedef long double pi_float128;
+#define PI_HAVE_FLOAT128 1
+#else
+#define PI_HAVE_FLOAT128 0
+#endif
+
+// Number types a kernel can be evaluated in, selected by ?precision=
+typedef enum {
+    PRECISION_FLOAT,
+    PRECISION_DOUBLE,
+    PRECISION_LONG_DOUBLE,
+    PRECISION_FLOAT128,
+    PRECISION_DD,
+    PRECISION_QD,
+    PRECISION_COUNT
+} PiPrecision;
+
+///////////////// Instantiations /////////////////
+PI_DECLARE_KERNELS(float, float)
+PI_DECLARE_KERNELS(double, double)
+PI_DECLARE_KERNELS(long double, long_double)
+#if PI_HAVE_FLOAT128
+PI_DECLARE_KERNELS(pi_float128, float128)
+#define PI_FLOAT128_KERNEL(base) base##_float128_wide
+#else
+#define PI_FLOAT128_KERNEL(base) NULL
+#endif
+
+// Wide entry points for one kernel in PiPrecision order, for lookup tables
+#define PI_PRECISION_KERNELS(base) { \
+    base##_float_wide, base##_double_wide, base##_long_double_wide, \
+    PI_FLOAT128_KERNEL(base), base##_dd_wide, base##_qd_wide }
+
+///////////////// Precision names /////////////////
+// Returns 1 and sets *precision for a known, available name; 0 otherwise
+int precision_from_name(const char *name, PiPrecision *precision);
+const char *precision_name(PiPrecision precision);
+
+// Correct digits of pi rounded to this type: where a kernel saturates
+int precision_max_digits(PiPrecision precision);
+
+#endif
@@ -0,0 +1,256 @@
+#include "pi_predictor.h"
+#include <string.h>
+
+void predictor_init(IterationPredictor *predictor) {
+    memset(predictor, 0, sizeof(*predictor));
+}
+
+void predictor_observe(IterationPredictor *predictor, long long iterations,
+                       double seconds, int digits) {
+    if (iterations <= 0) return;
+    if (predictor->probes == PREDICTOR_MAX_PROBES) {
+        int keep = PREDICTOR_MAX_PROBES - 1;
+        memmove(predictor->iterations, predictor->iterations + 1, keep * sizeof(long long));
+        memmove(predictor->seconds, predictor->seconds + 1, keep * sizeof(double));
+        memmove(predictor->digits, predictor->digits + 1, keep * sizeof(int));
+        predictor->probes = keep;
+    }
+    predictor->iterations[predictor->probes] = iterations;
+    predictor->seconds[predictor->probes] = seconds;
+    predictor->digits[predictor->probes] = digits;
+    predictor->probes++;
+}
+
+///////////////// Cost model /////////////////
+static double time_basis(TimeModel model, double n) {
+    return model == TIME_MODEL_NLOGN ? n * log2(n > 2.0 ? n : 2.0) : n;
+}
+
+// Least squares through the origin, t = c f(n); error measured relative to t
+// so the long probes do not drown out the short ones
+static double fit_time_model(const IterationPredictor *predictor, TimeModel model,
+                             double *coefficient) {
+    double sff = 0.0, sft = 0.0;
+    for (int i = 0; i < predictor->probes; i++) {
+        double t = predictor->seconds[i];
+        if (t < PREDICTOR_MIN_PROBE_SECONDS) continue;
+        double f = time_basis(model, (double)predictor->iterations[i]) / t;
+        sff += f * f;
+        sft += f;
+    }
+    *coefficient = sff > 0.0 ? sft / sff : 0.0;
+    double residual = 0.0;
+    for (int i = 0; i < predictor->probes; i++) {
+        double t = predictor->seconds[i];
+        if (t < PREDICTOR_MIN_PROBE_SECONDS) continue;
+        double r = *coefficient * time_basis(model, (double)predictor->iterations[i]) / t - 1.0;
+        residual += r * r;
+    }
+    return residual;
+}
+
+int predictor_fit_time(const IterationPredictor *predictor, TimeModel *model, double *coefficient) {
+    int usable = 0;
+    for (int i = 0; i < predictor->probes; i++) {
+        if (predictor->seconds[i] >= PREDICTOR_MIN_PROBE_SECONDS) usable++;
+    }
+    if (usable < 2) return 0;
+
+    double linear_c, nlogn_c;
+    double linear_r = fit_time_model(predictor, TIME_MODEL_LINEAR, &linear_c);
+    double nlogn_r = fit_time_model(predictor, TIME_MODEL_NLOGN, &nlogn_c);
+    // n log n has to earn its place: with three or more probes and a clearly better fit
+    if (usable >= 3 && nlogn_r < 0.5 * linear_r) {
+        *model = TIME_MODEL_NLOGN;
+        *coefficient = nlogn_c;
+    } else {
+        *model = TIME_MODEL_LINEAR;
+        *coefficient = linear_c;
+    }
+    return *coefficient > 0.0;
+}
+
+///////////////// Convergence model /////////////////
+// Points the convergence fit uses: the first probe reaching each digit count.
+// Later probes on the same count are a precision floor, not convergence.
+static int convergence_points(const IterationPredictor *predictor, double *n, double *d) {
+    int count = 0;
+    for (int i = 0; i < predictor->probes; i++) {
+        int digits = predictor->digits[i];
+        if (digits <= 0) continue;
+        int seen = 0;
+        for (int j = 0; j < predictor->probes; j++) {
+            if (predictor->digits[j] == digits &&
+                (predictor->iterations[j] < predictor->iterations[i] ||
+                 (predictor->iterations[j] == predictor->iterations[i] && j < i))) {
+                seen = 1;
+                break;
+            }
+        }
+        if (seen) continue;
+        n[count] = (double)predictor->iterations[i];
+        d[count] = (double)digits;
+        count++;
+    }
+    return count;
+}
+
+static double convergence_x(ConvergenceModel model, double n) {
+    return model == CONVERGENCE_LOGARITHMIC ? log10(n) : n;
+}
+
+static double convergence_predict(ConvergenceModel model, double a, double b, double n) {
+    double y = a + b * convergence_x(model, n);
+    return model == CONVERGENCE_QUADRATIC ? pow(2.0, y) : y;
+}
+
+// Ordinary least squares in the model's linearised coordinates; the
+// returned residual is in digits so the models compare fairly
+static double fit_convergence_model(ConvergenceModel model, const double *n, const double *d,
+                                    int count, double *a, double *b) {
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    for (int i = 0; i < count; i++) {
+        double x = convergence_x(model, n[i]);
+        double y = model == CONVERGENCE_QUADRATIC ? log2(d[i]) : d[i];
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double denominator = count * sxx - sx * sx;
+    if (fabs(denominator) < 1e-12) return INFINITY;
+    *b = (count * sxy - sx * sy) / denominator;
+    *a = (sy - *b * sx) / count;
+
+    double residual = 0.0;
+    for (int i = 0; i < count; i++) {
+        double r = convergence_predict(model, *a, *b, n[i]) - d[i];
+        residual += r * r;
+    }
+    return residual;
+}
+
+int predictor_fit_convergence(const IterationPredictor *predictor, ConvergenceModel *model,
+                              double *a, double *b) {
+    double n[PREDICTOR_MAX_PROBES], d[PREDICTOR_MAX_PROBES];
+    int count = convergence_points(predictor, n, d);
+    if (count < 2) return 0;
+
+    // Ordered slowest-converging first: a faster model must fit clearly
+    // better, so two points never justify an optimistic jump
+    const ConvergenceModel order[3] = {
+        CONVERGENCE_LOGARITHMIC, CONVERGENCE_LINEAR, CONVERGENCE_QUADRATIC
+    };
+    double best_residual = INFINITY;
+    int found = 0;
+    for (int i = 0; i < 3; i++) {
+        double fa, fb;
+        double residual = fit_convergence_model(order[i], n, d, count, &fa, &fb);
+        if (!isfinite(residual)) continue;
+        if (!found || residual < 0.5 * best_residual - 1e-9) {
+            best_residual = residual;
+            *model = order[i];
+            *a = fa;
+            *b = fb;
+            found = 1;
+        }
+    }
+    return found;
+}
+
+// Smallest n the model says reaches `digits`, or -1 if it never does
+static double convergence_solve(ConvergenceModel model, double a, double b, double digits) {
+    if (b <= 0.0) return -1.0;
+    switch (model) {
+        case CONVERGENCE_LINEAR: return (digits - a) / b;
+        case CONVERGENCE_LOGARITHMIC: return pow(10.0, (digits - a) / b);
+        case CONVERGENCE_QUADRATIC: return (log2(digits) - a) / b;
+    }
+    return -1.0;
+}
+
+long long predictor_solve_convergence(ConvergenceModel model, double a, double b, int digits) {
+    double n = ceil(convergence_solve(model, a, b, (double)digits));
+    if (!(n > 0.0)) return 0;
+    if (n > (double)MAX_ITERATIONS) return MAX_ITERATIONS;
+    return n < 1.0 ? 1 : (long long)n;
+}
+
+long long predictor_iterations_for_digits(const IterationPredictor *predictor, int digits) {
+    ConvergenceModel model;
+    double a, b;
+    if (!predictor_fit_convergence(predictor, &model, &a, &b)) return 0;
+    return predictor_solve_convergence(model, a, b, digits);
+}
+
+///////////////// Prediction /////////////////
+// Largest n whose predicted time fits the budget
+static double time_solve(TimeModel model, double coefficient, double budget) {
+    double n = budget / coefficient;
+    if (model == TIME_MODEL_NLOGN) {
+        // t grows monotonically: bisect on [1, budget / c]
+        double lo = 1.0, hi = n;
+        for (int i = 0; i < 100 && hi - lo > 0.5; i++) {
+            double mid = 0.5 * (lo + hi);
+            if (coefficient * time_basis(model, mid) <= budget) lo = mid; else hi = mid;
+        }
+        n = lo;
+    }
+    return n;
+}
+
+// Number of latest probes that gained no digits over the probe before them
+static int stalled_probes(const IterationPredictor *predictor) {
+    int stalled = 0;
+    for (int i = predictor->probes - 1; i > 0; i--) {
+        if (predictor->digits[i] > predictor->digits[i - 1]) break;
+        stalled++;
+    }
+    return stalled;
+}
+
+// Precision floor: repeated probes stuck well below the fitted curve mean
+// rounding, not convergence, limits the kernel and more iterations cannot
+// help. Logarithmic kernels gain a digit per decade (and the random methods
+// look logarithmic), so for them a few flat probes prove nothing.
+static int at_precision_floor(const IterationPredictor *predictor, int max_digits) {
+    ConvergenceModel convergence;
+    double a, b;
+    if (!predictor_fit_convergence(predictor, &convergence, &a, &b)) return 0;
+    int last = predictor->probes - 1;
+    double expected = convergence_predict(convergence, a, b, (double)predictor->iterations[last]);
+    return convergence != CONVERGENCE_LOGARITHMIC && predictor->digits[last] < max_digits &&
+           stalled_probes(predictor) >= NO_IMPROVEMENT_THRESHOLD &&
+           expected - predictor->digits[last] > 1.5;
+}
+
+long long predictor_optimum(const IterationPredictor *predictor, double time_budget, int max_digits) {
+    TimeModel time_model;
+    double coefficient;
+    if (!predictor_fit_time(predictor, &time_model, &coefficient)) return 0;
+
+    double target = time_solve(time_model, coefficient, time_budget * PREDICTOR_BUDGET_FRACTION);
+    ConvergenceModel convergence;
+    double a, b;
+    if (predictor_fit_convergence(predictor, &convergence, &a, &b)) {
+        double saturation = convergence_solve(convergence, a, b, (double)max_digits);
+        if (saturation > 0.0 && saturation < target) target = ceil(saturation);
+    }
+    if (target > (double)MAX_ITERATIONS) target = (double)MAX_ITERATIONS;
+    return target < 1.0 ? 1 : (long long)target;
+}
+
+long long predictor_next_iterations(const IterationPredictor *predictor, long long current,
+                                    double time_budget, int max_digits) {
+    if (at_precision_floor(predictor, max_digits)) return current;
+
+    long long optimum = predictor_optimum(predictor, time_budget, max_digits);
+    if (optimum == 0) return 0;
+
+    double target = (double)optimum;
+    double ceiling = (double)current * PREDICTOR_MAX_GROWTH;
+    if (target > ceiling) target = ceiling;
+    // A refit that only nudges the count is noise, not a better probe
+    if (target < (double)current * PREDICTOR_MIN_GROWTH) return current;
+    return (long long)target;
+}
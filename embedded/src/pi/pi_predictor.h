@@ -0,0 +1,62 @@
+#ifndef PI_PREDICTOR_H
+#define PI_PREDICTOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../constants.h"
+
+// Fits cost and convergence models to the probes an optimizer search has
+// made so far and predicts the iteration count worth probing next:
+//   time   t(n) = c n            or  c n log2 n
+//   digits d(n) = a + b n        (linear: geometric series)
+//          d(n) = a + b log10 n  (logarithmic: alternating / p-series)
+//          d(n) = 2^(a + b n)    (quadratic: AGM iterations)
+
+typedef enum {
+    TIME_MODEL_LINEAR,
+    TIME_MODEL_NLOGN
+} TimeModel;
+
+typedef enum {
+    CONVERGENCE_LINEAR,
+    CONVERGENCE_LOGARITHMIC,
+    CONVERGENCE_QUADRATIC
+} ConvergenceModel;
+
+typedef struct {
+    int probes;
+    long long iterations[PREDICTOR_MAX_PROBES];
+    double seconds[PREDICTOR_MAX_PROBES];
+    int digits[PREDICTOR_MAX_PROBES];
+} IterationPredictor;
+
+void predictor_init(IterationPredictor *predictor);
+
+// Record one probe; the oldest is dropped once PREDICTOR_MAX_PROBES are held
+void predictor_observe(IterationPredictor *predictor, long long iterations,
+                       double seconds, int digits);
+
+// Best-fitting models; return 0 when too few probes are usable
+int predictor_fit_time(const IterationPredictor *predictor, TimeModel *model, double *coefficient);
+int predictor_fit_convergence(const IterationPredictor *predictor, ConvergenceModel *model,
+                              double *a, double *b);
+
+// Smallest count a convergence model says reaches `digits`, clamped to
+// MAX_ITERATIONS; 0 if the model never gets there
+long long predictor_solve_convergence(ConvergenceModel model, double a, double b, int digits);
+
+// Same, for the model fitted to the probes so far; 0 without a fit
+long long predictor_iterations_for_digits(const IterationPredictor *predictor, int digits);
+
+// Iteration count that reaches max_digits, or the most the time budget
+// allows if it cannot; 0 when there is not enough data to predict
+long long predictor_optimum(const IterationPredictor *predictor, double time_budget, int max_digits);
+
+// Next probe for a search at `current`: the optimum, at most
+// PREDICTOR_MAX_GROWTH times further; `current` when the models say nothing
+// more is to be gained, 0 when there is not enough data to predict
+long long predictor_next_iterations(const IterationPredictor *predictor, long long current,
+                                    double time_budget, int max_digits);
+
+#endif
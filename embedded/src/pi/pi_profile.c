@@ -0,0 +1,151 @@
+#include "pi_profile.h"
+#include "../cpu/cpu_features.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Overridable from the build, e.g. -DPI_BUILD_ID=\"$(git rev-parse HEAD)\"
+#ifndef PI_BUILD_ID
+#define PI_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+#define PROFILE_MAGIC "PIPROF"
+#define PROFILE_VERSION 1
+
+typedef struct {
+    char magic[8];
+    int version;
+    int count;
+    char cpu_model[PROFILE_MODEL_LENGTH];
+    char build_id[PROFILE_MODEL_LENGTH];
+    unsigned long long clock;
+    PiProfile entries[PROFILE_MAX_ENTRIES];
+} ProfileFile;
+
+static pthread_mutex_t store_mutex = PTHREAD_MUTEX_INITIALIZER;
+static ProfileFile *store = NULL;
+
+const char *profile_build_id(void) {
+    return PI_BUILD_ID;
+}
+
+// Header for this machine and build
+static void store_header(ProfileFile *file) {
+    memset(file, 0, sizeof(*file));
+    memcpy(file->magic, PROFILE_MAGIC, sizeof(PROFILE_MAGIC));
+    file->version = PROFILE_VERSION;
+    snprintf(file->cpu_model, sizeof(file->cpu_model), "%s", cpu_model_name());
+    snprintf(file->build_id, sizeof(file->build_id), "%s", profile_build_id());
+}
+
+static int store_matches(const ProfileFile *file) {
+    ProfileFile *expected = (ProfileFile *)malloc(sizeof(ProfileFile));
+    if (expected == NULL) {
+        fprintf(stderr, "Out of memory checking profile file\n");
+        abort();
+    }
+    store_header(expected);
+    int matches = memcmp(file->magic, expected->magic, sizeof(file->magic)) == 0 &&
+                  file->version == expected->version &&
+                  strcmp(file->cpu_model, expected->cpu_model) == 0 &&
+                  strcmp(file->build_id, expected->build_id) == 0 &&
+                  file->count >= 0 && file->count <= PROFILE_MAX_ENTRIES;
+    free(expected);
+    return matches;
+}
+
+int profile_store_open(const char *path) {
+    profile_store_close();
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return -1;
+    struct stat info;
+    int sized = fstat(fd, &info) == 0 && info.st_size == (off_t)sizeof(ProfileFile);
+    if (!sized && ftruncate(fd, sizeof(ProfileFile)) != 0) {
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(ProfileFile), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    ProfileFile *file = (ProfileFile *)map;
+    if (!sized || !store_matches(file)) {
+        // Timings from another machine or build would mislead the search
+        store_header(file);
+        msync(file, sizeof(ProfileFile), MS_ASYNC);
+    }
+
+    pthread_mutex_lock(&store_mutex);
+    store = file;
+    int count = file->count;
+    pthread_mutex_unlock(&store_mutex);
+    return count;
+}
+
+void profile_store_close(void) {
+    pthread_mutex_lock(&store_mutex);
+    if (store != NULL) {
+        msync(store, sizeof(ProfileFile), MS_SYNC);
+        munmap(store, sizeof(ProfileFile));
+        store = NULL;
+    }
+    pthread_mutex_unlock(&store_mutex);
+}
+
+int profile_store_count(void) {
+    pthread_mutex_lock(&store_mutex);
+    int count = store != NULL ? store->count : 0;
+    pthread_mutex_unlock(&store_mutex);
+    return count;
+}
+
+// Index of the entry for the key, or -1; caller holds store_mutex
+static int find_entry(const char *algorithm, const char *backend) {
+    for (int i = 0; i < store->count; i++) {
+        if (strcmp(store->entries[i].algorithm, algorithm) == 0 &&
+            strcmp(store->entries[i].backend, backend) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int profile_lookup(const char *algorithm, const char *backend, PiProfile *profile) {
+    if (algorithm == NULL || backend == NULL) return 0;
+    pthread_mutex_lock(&store_mutex);
+    int found = 0;
+    if (store != NULL) {
+        int index = find_entry(algorithm, backend);
+        if (index >= 0) {
+            *profile = store->entries[index];
+            found = 1;
+        }
+    }
+    pthread_mutex_unlock(&store_mutex);
+    return found;
+}
+
+void profile_record(const PiProfile *profile) {
+    pthread_mutex_lock(&store_mutex);
+    if (store == NULL) {
+        pthread_mutex_unlock(&store_mutex);
+        return;
+    }
+    int index = find_entry(profile->algorithm, profile->backend);
+    if (index < 0 && store->count < PROFILE_MAX_ENTRIES) {
+        index = store->count++;
+    } else if (index < 0) {
+        index = 0;
+        for (int i = 1; i < store->count; i++) {
+            if (store->entries[i].updated < store->entries[index].updated) index = i;
+        }
+    }
+    store->entries[index] = *profile;
+    store->entries[index].updated = ++store->clock;
+    msync(store, sizeof(ProfileFile), MS_ASYNC);
+    pthread_mutex_unlock(&store_mutex);
+}
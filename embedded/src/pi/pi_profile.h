@@ -0,0 +1,43 @@
+#ifndef PI_PROFILE_H
+#define PI_PROFILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../constants.h"
+
+// Calibration profiles: what the optimizer learned about each kernel on
+// this machine, kept in a small memory-mapped file so a restarted server
+// can start its search at the known optimum. A file written by another CPU
+// model or another build is discarded on open.
+
+typedef struct {
+    char algorithm[PROFILE_NAME_LENGTH];
+    char backend[PROFILE_NAME_LENGTH];    // precision the kernel ran in
+    double time_limit;                    // budget the best result was found under
+    long long best_iterations;
+    double best_seconds;
+    int best_digits;
+    int probes;                           // predictor samples, oldest first
+    long long iterations[PREDICTOR_MAX_PROBES];
+    double seconds[PREDICTOR_MAX_PROBES];
+    int digits[PREDICTOR_MAX_PROBES];
+    unsigned long long updated;           // recency, for eviction
+} PiProfile;
+
+// Map the profile file at `path`, creating or resetting it as needed.
+// Returns the number of profiles loaded, -1 if the file cannot be mapped
+// (the optimizer then simply runs cold).
+int profile_store_open(const char *path);
+void profile_store_close(void);
+int profile_store_count(void);
+
+// Identity profiles are keyed by besides algorithm and backend
+const char *profile_build_id(void);
+
+// Copy the stored profile for the key into *profile; 0 if there is none
+int profile_lookup(const char *algorithm, const char *backend, PiProfile *profile);
+
+// Insert or replace the profile for its key, evicting the stalest when full
+void profile_record(const PiProfile *profile);
+
+#endif
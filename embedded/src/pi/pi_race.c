@@ -0,0 +1,187 @@
+#include "pi_race.h"
+#include <string.h>
+#include <time.h>
+
+static const char *RACE_STATUS_NAMES[RACE_STATUS_COUNT] = {
+    "running", "finished", "saturated", "cancelled"
+};
+
+// One runner's place in the race between rounds
+typedef struct {
+    const PiKernel *kernel;
+    RaceRunner *runner;
+    int target_digits;
+    double slice;           // compute seconds for this round
+    PiSeriesState state;    // incremental kernels
+    long long next;         // others: the count to run next
+    double last_run;        // others: compute seconds of the last run
+    PoolTask task;
+} RaceLane;
+
+const char *race_status_name(RaceStatus status) {
+    return status >= 0 && status < RACE_STATUS_COUNT ? RACE_STATUS_NAMES[status] : "unknown";
+}
+
+static double thread_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static double seconds_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// Record a result; the target wins over saturation reached at the same time
+static void lane_record(RaceLane *lane, int digits, long long iterations, int converged) {
+    RaceRunner *runner = lane->runner;
+    if (digits > runner->digits) {
+        runner->digits = digits;
+        runner->iterations = iterations;
+    }
+    if (runner->digits >= lane->target_digits) {
+        runner->status = RACE_FINISHED;
+    } else if (converged) {
+        runner->status = RACE_SATURATED;
+    }
+}
+
+// Pool task: one slice of compute for one runner
+static void race_slice(void *arg) {
+    RaceLane *lane = (RaceLane *)arg;
+    const PiKernel *kernel = lane->kernel;
+    double start = thread_seconds(), spent = 0.0;
+
+    int runs = 0;
+    while (lane->runner->status == RACE_RUNNING && spent < lane->slice) {
+        if (kernel->incremental != NULL && kernel->wide == NULL) {
+            // Sixteenths of the count so far, as in the target-digits search
+            PiSeriesState *state = &lane->state;
+            long long step = state->count / 16 > 1 ? state->count / 16 : 1;
+            if (step > MAX_ITERATIONS - state->count) step = MAX_ITERATIONS - state->count;
+            kernel->incremental->advance(state, step);
+            int digits = count_correct_digits(kernel->incremental->estimate(state));
+            // effective trails count once the kernel has converged
+            lane_record(lane, digits, state->effective,
+                        state->effective < state->count || state->count >= MAX_ITERATIONS);
+        } else {
+            // Runs are expected to take twice the last one; a first run
+            // that does not fit is one the deadline leaves no room for
+            if (lane->last_run * 2.0 > lane->slice - spent) {
+                if (runs == 0) lane->runner->status = RACE_CANCELLED;
+                break;
+            }
+            runs++;
+            long long n = lane->next, effective = n;
+            // Random methods run on their own generator, seeded as the
+            // optimizer does: no shared rand() lock for the CPU clock to miss
+            pi_random_seed((unsigned long long)n);
+            double run_start = thread_seconds();
+            int digits;
+            if (kernel->wide != NULL) {
+                digits = qd_correct_digits(kernel->wide(n), kernel->max_digits);
+            } else if (kernel->counted != NULL) {
+                digits = count_correct_digits(kernel->counted(n, &effective));
+            } else {
+                digits = count_correct_digits(kernel->func(n));
+            }
+            lane->last_run = thread_seconds() - run_start;
+            lane->next = n < MAX_ITERATIONS / 2 ? n * 2 : MAX_ITERATIONS;
+            lane_record(lane, digits, effective, effective < n || n >= MAX_ITERATIONS);
+        }
+        spent = thread_seconds() - start;
+    }
+    lane->runner->compute_seconds += spent;
+}
+
+// Finishers first, then saturated, then cancelled; least compute first
+static int leaves_before(const RaceRunner *a, const RaceRunner *b) {
+    if (a->status != b->status) return a->status < b->status;
+    return a->compute_seconds < b->compute_seconds;
+}
+
+int race_run(const RaceEntrant *entrants, int count, int target_digits, double deadline_seconds,
+             RaceSink sink, void *context, RaceRunner *runners) {
+    if (count < 1 || count > RACE_MAX_ENTRANTS || target_digits < 1 || !(deadline_seconds > 0.0)) return -1;
+    for (int i = 0; i < count; i++) {
+        if (target_digits > entrants[i].kernel.max_digits) return -1;
+    }
+
+    RaceLane lanes[RACE_MAX_ENTRANTS];
+    int reported[RACE_MAX_ENTRANTS];
+    for (int i = 0; i < count; i++) {
+        memset(&runners[i], 0, sizeof(runners[i]));
+        runners[i].name = entrants[i].name;
+        runners[i].status = RACE_RUNNING;
+        memset(&lanes[i], 0, sizeof(lanes[i]));
+        lanes[i].kernel = &entrants[i].kernel;
+        lanes[i].runner = &runners[i];
+        lanes[i].target_digits = target_digits;
+        lanes[i].next = 1;
+        if (entrants[i].kernel.incremental != NULL) entrants[i].kernel.incremental->init(&lanes[i].state);
+        reported[i] = 0;
+    }
+
+    compute_pool_start(0);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int active = count, places = 0, listening = 1;
+    while (active > 0) {
+        double elapsed = seconds_since(&start);
+        if (listening && elapsed < deadline_seconds) {
+            // Everyone gets the same compute per round, enough for the
+            // longest expected re-run, but no more than the pool can fit
+            // in before the deadline
+            double slice = RACE_SLICE_SECONDS;
+            int running = 0;
+            for (int i = 0; i < count; i++) {
+                if (runners[i].status != RACE_RUNNING) continue;
+                running++;
+                if (lanes[i].last_run * 2.0 > slice) slice = lanes[i].last_run * 2.0;
+            }
+            double room = (deadline_seconds - elapsed) * (double)compute_pool_size() / (double)running;
+            if (slice > room) slice = room;
+
+            int spawned[RACE_MAX_ENTRANTS];
+            for (int i = 0; i < count; i++) {
+                spawned[i] = runners[i].status == RACE_RUNNING;
+                if (!spawned[i]) continue;
+                lanes[i].slice = slice;
+                pool_task_spawn(&lanes[i].task, race_slice, &lanes[i]);
+            }
+            for (int i = 0; i < count; i++) {
+                if (spawned[i]) pool_task_wait(&lanes[i].task);
+            }
+        }
+        // Out of time (or nobody listening): whoever is left is cancelled
+        if (!listening || seconds_since(&start) >= deadline_seconds) {
+            for (int i = 0; i < count; i++) {
+                if (runners[i].status == RACE_RUNNING) runners[i].status = RACE_CANCELLED;
+            }
+        }
+
+        // This round's leavers, in the order they are ranked
+        int order[RACE_MAX_ENTRANTS], leavers = 0;
+        for (int i = 0; i < count; i++) {
+            if (reported[i] || runners[i].status == RACE_RUNNING) continue;
+            int j = leavers++;
+            while (j > 0 && leaves_before(&runners[i], &runners[order[j - 1]])) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+        double left_at = seconds_since(&start);
+        for (int k = 0; k < leavers; k++) {
+            RaceRunner *runner = &runners[order[k]];
+            reported[order[k]] = 1;
+            active--;
+            runner->elapsed_seconds = left_at;
+            if (runner->status == RACE_FINISHED) runner->place = ++places;
+            if (listening && sink != NULL && !sink(runner, context)) listening = 0;
+        }
+    }
+    return places;
+}
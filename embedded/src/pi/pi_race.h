@@ -0,0 +1,55 @@
+#ifndef PI_RACE_H
+#define PI_RACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pi_optimization.h"
+#include "../pool/compute_pool.h"
+#include "../constants.h"
+
+// Several kernels racing to the same digit count on the compute pool.
+// The race runs in rounds: every runner still in it gets one pool task
+// with the same compute slice (at least RACE_SLICE_SECONDS, longer when a
+// re-run needs it), then the leavers of the round are reported.
+// Incremental kernels keep one running state and are checked every
+// sixteenth of their count; the others are re-run at twice the count each
+// time. Compute time is thread CPU time, so runners sharing cores are not
+// charged for each other.
+
+typedef enum {
+    RACE_RUNNING,
+    RACE_FINISHED,   // reached the target
+    RACE_SATURATED,  // converged (or hit MAX_ITERATIONS) short of it
+    RACE_CANCELLED,  // still short of it at the deadline
+    RACE_STATUS_COUNT
+} RaceStatus;
+
+typedef struct {
+    const char *name;
+    PiKernel kernel;
+} RaceEntrant;
+
+typedef struct {
+    const char *name;
+    RaceStatus status;
+    int place;                // 1 for the winner; 0 unless finished
+    int digits;               // best reached
+    long long iterations;     // terms or iterations behind `digits`
+    double compute_seconds;
+    double elapsed_seconds;   // wall clock from the start to leaving
+} RaceRunner;
+
+// Told about each runner as it leaves the race, finishers in place order;
+// returning 0 cancels the rest without telling
+typedef int (*RaceSink)(const RaceRunner *runner, void *context);
+
+// Race `count` entrants to `target_digits` for at most deadline_seconds;
+// runners[i] ends up describing entrants[i]. Returns the number of
+// finishers, or -1 on bad input (including a target past a kernel's
+// max_digits).
+int race_run(const RaceEntrant *entrants, int count, int target_digits, double deadline_seconds,
+             RaceSink sink, void *context, RaceRunner *runners);
+
+const char *race_status_name(RaceStatus status);
+
+#endif
@@ -0,0 +1,363 @@
+#include "pi_reference.h"
+#include "pi_multiprecision.h"
+#include "../cpu/cpu_features.h"
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define REFERENCE_MAGIC "PIREF"
+#define REFERENCE_VERSION 1
+#define REFERENCE_MAX_LEVELS 48
+
+// File layout: the header, then the decimals, then the hex digits, both
+// as characters after the point
+typedef struct {
+    char magic[8];
+    int version;
+    long long decimal_digits;
+    long long hex_digits;
+} ReferenceHeader;
+
+static const ReferenceHeader *reference = NULL;
+static size_t reference_size = 0;
+
+///////////////// Mismatch kernels /////////////////
+typedef size_t (*MismatchKernel)(const char *a, const char *b, size_t length);
+
+// Eight bytes per compare; the lowest set bit of the XOR is the first
+// differing byte on little-endian machines
+static size_t mismatch_scalar(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; i + 8 <= length; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if (x != y) return i + (size_t)(__builtin_ctzll(x ^ y) / 8);
+    }
+#endif
+    for (; i < length; i++) {
+        if (a[i] != b[i]) return i;
+    }
+    return length;
+}
+
+#if defined(__x86_64__)
+///////////////// SSE4.2 /////////////////
+__attribute__((target("sse4.2")))
+static size_t mismatch_sse42(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        unsigned equal = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFu) return i + (size_t)__builtin_ctz(~equal);
+    }
+    return i + mismatch_scalar(a + i, b + i, length - i);
+}
+
+///////////////// AVX2 /////////////////
+__attribute__((target("avx2")))
+static size_t mismatch_avx2(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        unsigned equal = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~equal);
+    }
+    return i + mismatch_scalar(a + i, b + i, length - i);
+}
+
+///////////////// AVX-512 /////////////////
+// Byte compares need AVX-512BW, which the level does not promise: 32-bit
+// lanes find the differing word, the scalar path the byte within it
+__attribute__((target("avx512f")))
+static size_t mismatch_avx512(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m512i x = _mm512_loadu_si512((const void *)(a + i));
+        __m512i y = _mm512_loadu_si512((const void *)(b + i));
+        unsigned differ = (unsigned)_mm512_cmpneq_epi32_mask(x, y);
+        if (differ != 0) {
+            size_t word = i + 4 * (size_t)__builtin_ctz(differ);
+            return word + mismatch_scalar(a + word, b + word, 4);
+        }
+    }
+    return i + mismatch_scalar(a + i, b + i, length - i);
+}
+#endif
+
+#if defined(__aarch64__)
+///////////////// NEON /////////////////
+static size_t mismatch_neon(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t equal = vceqq_u8(vld1q_u8((const uint8_t *)(a + i)),
+                                    vld1q_u8((const uint8_t *)(b + i)));
+        if (vminvq_u8(equal) != 0xFF) return i + mismatch_scalar(a + i, b + i, 16);
+    }
+    return i + mismatch_scalar(a + i, b + i, length - i);
+}
+#endif
+
+static MismatchKernel mismatch_kernel(CpuLevel level, const char **name) {
+    switch (level) {
+#if defined(__x86_64__)
+        case CPU_LEVEL_AVX512: *name = "avx512"; return mismatch_avx512;
+        case CPU_LEVEL_AVX2: *name = "avx2"; return mismatch_avx2;
+        case CPU_LEVEL_SSE42: *name = "sse4.2"; return mismatch_sse42;
+#endif
+#if defined(__aarch64__)
+        case CPU_LEVEL_NEON: *name = "neon"; return mismatch_neon;
+#endif
+        default: *name = "scalar"; return mismatch_scalar;
+    }
+}
+
+size_t reference_mismatch(const char *a, const char *b, size_t length) {
+    const char *name;
+    return mismatch_kernel(cpu_level(), &name)(a, b, length);
+}
+
+const char *reference_mismatch_kernel_name(void) {
+    const char *name;
+    mismatch_kernel(cpu_level(), &name);
+    return name;
+}
+
+///////////////// Generation /////////////////
+// Decimal string to integer by halves, hi * 10^len(lo) + lo, so the cost
+// follows multiplication rather than growing quadratically. powers[j] is
+// 10^(REFERENCE_PARSE_DIGITS << j).
+static void parse_decimal(MpInt *x, const char *digits, long long length, const MpInt *powers) {
+    if (length <= REFERENCE_PARSE_DIGITS) {
+        char block[REFERENCE_PARSE_DIGITS + 1];
+        memcpy(block, digits, (size_t)length);
+        block[length] = '\0';
+        mp_set_decimal(x, block);
+        return;
+    }
+    int level = 0;
+    while (((long long)REFERENCE_PARSE_DIGITS << (level + 1)) < length) level++;
+    long long low_length = (long long)REFERENCE_PARSE_DIGITS << level;
+
+    MpInt low;
+    mp_init(&low);
+    parse_decimal(x, digits, length - low_length, powers);
+    parse_decimal(&low, digits + length - low_length, low_length, powers);
+    mp_mul(x, x, &powers[level]);
+    mp_add(x, x, &low);
+    mp_clear(&low);
+}
+
+// floor(pi * 16^hex_digits) from pi * 10^precision, written as hex digits
+// after the leading 3, uppercase like bbp_hex_digits
+static char *hex_from_decimal(const char *integer_digits, long long precision, long long hex_digits) {
+    MpInt powers[REFERENCE_MAX_LEVELS];
+    int levels = 0;
+    mp_init(&powers[0]);
+    mp_pow_ui(&powers[0], 10, REFERENCE_PARSE_DIGITS);
+    while (levels + 1 < REFERENCE_MAX_LEVELS &&
+           ((long long)REFERENCE_PARSE_DIGITS << (levels + 1)) < precision + 1) {
+        levels++;
+        mp_init(&powers[levels]);
+        mp_mul(&powers[levels], &powers[levels - 1], &powers[levels - 1]);
+    }
+
+    MpInt scaled, shifted, denominator, quotient, remainder;
+    mp_init(&scaled);
+    mp_init(&shifted);
+    mp_init(&denominator);
+    mp_init(&quotient);
+    mp_init(&remainder);
+    parse_decimal(&scaled, integer_digits, precision + 1, powers);
+    mp_shl(&shifted, &scaled, (size_t)(4 * hex_digits));
+    mp_pow_ui(&denominator, 10, (uint64_t)precision);
+    mp_divmod(&quotient, &remainder, &shifted, &denominator);
+
+    char *hex = (char *)malloc((size_t)hex_digits + 1);
+    if (hex != NULL) {
+        static const char HEX[] = "0123456789ABCDEF";
+        for (long long k = 0; k < hex_digits; k++) {
+            size_t limb = (size_t)(k / 8);
+            uint32_t value = limb < quotient.size ? quotient.limbs[limb] : 0;
+            hex[hex_digits - 1 - k] = HEX[(value >> (4 * (k % 8))) & 15];
+        }
+        hex[hex_digits] = '\0';
+    }
+
+    for (int i = 0; i <= levels; i++) mp_clear(&powers[i]);
+    mp_clear(&scaled);
+    mp_clear(&shifted);
+    mp_clear(&denominator);
+    mp_clear(&quotient);
+    mp_clear(&remainder);
+    return hex;
+}
+
+static int write_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written <= 0) return -1;
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+// Compute the digits and replace the file at `path` atomically
+static int reference_write(const char *path, long long decimal_digits) {
+    long long precision = decimal_digits;
+    // 4/5 hex digit per decimal stays under log16(10) ~ 0.83, and the guard
+    // keeps the truncated decimals from reaching the last hex digits
+    long long hex_digits = decimal_digits * 4 / 5 - REFERENCE_GUARD_DIGITS;
+    if (hex_digits < 0) hex_digits = 0;
+    char *pi = chudnovsky_bs_digits(precision);
+    if (pi == NULL) return -1;
+    memmove(pi + 1, pi + 2, (size_t)precision + 1);  // "3.1415..." -> "31415..."
+    char *hex = hex_from_decimal(pi, precision, hex_digits);
+    if (hex == NULL) {
+        free(pi);
+        return -1;
+    }
+
+    ReferenceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REFERENCE_MAGIC, sizeof(REFERENCE_MAGIC));
+    header.version = REFERENCE_VERSION;
+    header.decimal_digits = decimal_digits;
+    header.hex_digits = hex_digits;
+
+    size_t temp_length = strlen(path) + 5;
+    char *temp_path = (char *)malloc(temp_length);
+    int status = -1;
+    if (temp_path != NULL) {
+        snprintf(temp_path, temp_length, "%s.tmp", path);
+        int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            status = write_all(fd, (const char *)&header, sizeof(header)) == 0 &&
+                     write_all(fd, pi + 1, (size_t)decimal_digits) == 0 &&
+                     write_all(fd, hex, (size_t)hex_digits) == 0 ? 0 : -1;
+            if (close(fd) != 0) status = -1;
+            if (status == 0 && rename(temp_path, path) != 0) status = -1;
+            if (status != 0) unlink(temp_path);
+        }
+        free(temp_path);
+    }
+    free(pi);
+    free(hex);
+    return status;
+}
+
+///////////////// Store /////////////////
+static const char *decimal_data(const ReferenceHeader *header) {
+    return (const char *)(header + 1);
+}
+
+static const char *hex_data(const ReferenceHeader *header) {
+    return decimal_data(header) + header->decimal_digits;
+}
+
+static int reference_valid(const ReferenceHeader *header, size_t size, long long decimal_digits) {
+    if (size < sizeof(ReferenceHeader)) return 0;
+    if (memcmp(header->magic, REFERENCE_MAGIC, sizeof(REFERENCE_MAGIC)) != 0) return 0;
+    if (header->version != REFERENCE_VERSION) return 0;
+    if (header->decimal_digits < decimal_digits || header->hex_digits < 0) return 0;
+    if (size != sizeof(ReferenceHeader) + (size_t)header->decimal_digits + (size_t)header->hex_digits) {
+        return 0;
+    }
+    // A truncated or foreign file fails on its first digits
+    long long decimals = header->decimal_digits < 8 ? header->decimal_digits : 8;
+    long long hexes = header->hex_digits < 8 ? header->hex_digits : 8;
+    return memcmp(decimal_data(header), "14159265", (size_t)decimals) == 0 &&
+           memcmp(hex_data(header), "243F6A88", (size_t)hexes) == 0;
+}
+
+// Map an existing file holding at least `decimal_digits`; 0 on success
+static int reference_map(const char *path, long long decimal_digits) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(ReferenceHeader)) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)info.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    if (!reference_valid((const ReferenceHeader *)map, size, decimal_digits)) {
+        munmap(map, size);
+        return -1;
+    }
+    reference = (const ReferenceHeader *)map;
+    reference_size = size;
+    return 0;
+}
+
+long long reference_store_open(const char *path, long long decimal_digits) {
+    reference_store_close();
+    if (decimal_digits < 1 || decimal_digits > MAX_MP_DIGITS) return -1;
+    if (reference_map(path, decimal_digits) != 0) {
+        if (reference_write(path, decimal_digits) != 0) return -1;
+        if (reference_map(path, decimal_digits) != 0) return -1;
+    }
+    return reference->decimal_digits;
+}
+
+void reference_store_close(void) {
+    if (reference != NULL) {
+        munmap((void *)reference, reference_size);
+        reference = NULL;
+        reference_size = 0;
+    }
+}
+
+long long reference_decimal_digits(void) {
+    return reference != NULL ? reference->decimal_digits : 0;
+}
+
+long long reference_hex_digits(void) {
+    return reference != NULL ? reference->hex_digits : 0;
+}
+
+const char *reference_decimal(void) {
+    return reference != NULL ? decimal_data(reference) : NULL;
+}
+
+const char *reference_hex(void) {
+    return reference != NULL ? hex_data(reference) : NULL;
+}
+
+///////////////// Checking /////////////////
+long long reference_check_decimal(const char *digits, long long *checked) {
+    *checked = 0;
+    if (reference == NULL || digits == NULL || digits[0] != '3') return -1;
+    if (digits[1] == '\0') return 0;
+    if (digits[1] != '.') return -1;
+
+    long long length = (long long)strlen(digits + 2);
+    if (length > reference->decimal_digits) length = reference->decimal_digits;
+    *checked = length;
+    return (long long)reference_mismatch(digits + 2, decimal_data(reference), (size_t)length);
+}
+
+long long reference_check_hex(long long position, const char *hex, long long *checked) {
+    *checked = 0;
+    if (reference == NULL || hex == NULL || position < 0) return -1;
+    if (position >= reference->hex_digits) return 0;
+
+    long long length = (long long)strlen(hex);
+    if (length > reference->hex_digits - position) length = reference->hex_digits - position;
+    *checked = length;
+    return (long long)reference_mismatch(hex, hex_data(reference) + position, (size_t)length);
+}
@@ -0,0 +1,42 @@
+#ifndef PI_REFERENCE_H
+#define PI_REFERENCE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../constants.h"
+
+// Reference digits of pi, decimal and hexadecimal, for checking results
+// beyond what PI_REFERENCE (a long double) can. They are generated once by
+// the Chudnovsky binary-splitting engine, written to a file and memory
+// mapped read-only afterwards. Open and close happen at startup and
+// shutdown; lookups in between need no locking.
+
+// Map the reference file at `path`, regenerating it when it is missing,
+// damaged or holds fewer than `decimal_digits` decimals. Returns the
+// decimals available, -1 if the file can neither be read nor written.
+long long reference_store_open(const char *path, long long decimal_digits);
+void reference_store_close(void);
+
+// Digits after the point (not NUL-terminated); 0 / NULL without a store
+long long reference_decimal_digits(void);
+long long reference_hex_digits(void);
+const char *reference_decimal(void);
+const char *reference_hex(void);
+
+// Leading decimals of `digits` ("3.1415...", as the digit kernels return
+// them) that match the reference. *checked is how many were compared: the
+// shorter of the result and the reference. -1 without a store or if the
+// result does not start with "3.".
+long long reference_check_decimal(const char *digits, long long *checked);
+
+// Leading hex digits of `hex`, starting `position` places after the point,
+// that match the reference (uppercase, as bbp_hex_digits returns them);
+// same conventions
+long long reference_check_hex(long long position, const char *hex, long long *checked);
+
+// Index of the first differing byte of a and b, or length if none; the
+// widest variant the CPU level allows
+size_t reference_mismatch(const char *a, const char *b, size_t length);
+const char *reference_mismatch_kernel_name(void);
+
+#endif
@@ -0,0 +1,266 @@
+#include "pi_spigot.h"
+#include <pthread.h>
+
+static const char *SPIGOT_VARIANT_NAMES[SPIGOT_COUNT] = {
+    "gibbons", "rabinowitz_wagon"
+};
+
+static pthread_mutex_t last_run_lock = PTHREAD_MUTEX_INITIALIZER;
+static SpigotStats last_runs[SPIGOT_COUNT];
+static int has_run[SPIGOT_COUNT];
+
+///////////////// Output /////////////////
+// Digits are batched into chunks before they reach the sink; the point
+// goes in after the leading 3
+typedef struct {
+    char chunk[SPIGOT_CHUNK_DIGITS + 2];
+    size_t fill;
+    long long produced;  // digits emitted, the leading 3 included
+    long long wanted;
+    SpigotSink sink;
+    void *context;
+    int failed;
+} SpigotOutput;
+
+static void output_flush(SpigotOutput *out) {
+    if (out->fill > 0 && !out->failed && !out->sink(out->chunk, out->fill, out->context)) {
+        out->failed = 1;
+    }
+    out->fill = 0;
+}
+
+// Queue one digit; returns 1 while more are wanted
+static int output_digit(SpigotOutput *out, int digit) {
+    if (out->failed || out->produced >= out->wanted) return 0;
+    out->chunk[out->fill++] = (char)('0' + digit);
+    if (out->produced == 0 && out->wanted > 1) out->chunk[out->fill++] = '.';
+    out->produced++;
+    if (out->fill >= SPIGOT_CHUNK_DIGITS) output_flush(out);
+    return !out->failed && out->produced < out->wanted;
+}
+
+static int output_repeat(SpigotOutput *out, int digit, long long count) {
+    int more = !out->failed && out->produced < out->wanted;
+    for (long long i = 0; i < count && more; i++) more = output_digit(out, digit);
+    return more;
+}
+
+///////////////// Gibbons /////////////////
+// floor(a / b) for a quotient known to be small: estimated from the
+// leading limbs, then corrected against b * q. Avoids a full big-integer
+// division per digit.
+static uint32_t small_quotient(const MpInt *a, const MpInt *b, MpInt *scratch) {
+    size_t top = a->size > b->size ? a->size : b->size;
+    double lead_a = 0.0, lead_b = 0.0;
+    for (size_t i = top; i > 0 && i + 3 > top; i--) {
+        lead_a = lead_a * 4294967296.0 + (i - 1 < a->size ? a->limbs[i - 1] : 0);
+        lead_b = lead_b * 4294967296.0 + (i - 1 < b->size ? b->limbs[i - 1] : 0);
+    }
+    uint32_t quotient = lead_b > 0.0 ? (uint32_t)(lead_a / lead_b) : 0;
+
+    mp_mul_ui(scratch, b, quotient);
+    while (quotient > 0 && mp_cmp(scratch, a) > 0) {
+        quotient--;
+        mp_sub(scratch, scratch, b);
+    }
+    mp_add(scratch, scratch, b);
+    while (mp_cmp(scratch, a) <= 0) {
+        quotient++;
+        mp_add(scratch, scratch, b);
+    }
+    return quotient;
+}
+
+// Gibbons (2006): pi as the composition of the transformations
+// (k, 4k+2; 0, 2k+1), held as the matrix (q, r; 0, t). The candidate digit
+// m is safe once the state maps both 3 and 4 into [m, m+1); it is then
+// shifted out by (10, -10m; 0, 1). All buffers are allocated once and only
+// grow.
+static int gibbons_stream(SpigotOutput *out, size_t *memory) {
+    MpInt q, r, t, u, v, scratch;
+    MpInt *buffers[] = {&q, &r, &t, &u, &v, &scratch};
+    for (int i = 0; i < 6; i++) mp_init(buffers[i]);
+    mp_set_ui(&q, 1);
+    mp_set_ui(&r, 0);
+    mp_set_ui(&t, 1);
+    int64_t k = 1, x = 3;
+    uint32_t m = 3;
+
+    for (;;) {
+        // Safe when 4q + r < (m + 1) t
+        mp_mul_ui(&u, &q, 4);
+        mp_add(&u, &u, &r);
+        mp_mul_ui(&v, &t, m + 1);
+        if (mp_cmp(&u, &v) < 0) {
+            if (!output_digit(out, (int)m)) break;
+            // m' = floor(10 (3q + r) / t) - 10m; q = 10q; r = 10 (r - mt)
+            mp_mul_ui(&u, &q, 3);
+            mp_add(&u, &u, &r);
+            mp_mul_ui(&u, &u, 10);
+            uint32_t next = small_quotient(&u, &t, &scratch) - 10 * m;
+            mp_mul_ui(&v, &t, m);
+            mp_sub(&r, &r, &v);
+            mp_mul_ui(&r, &r, 10);
+            mp_mul_ui(&q, &q, 10);
+            m = next;
+        } else {
+            // Absorb term k: m = floor((q (7k + 2) + r x) / (t x));
+            // q = qk; r = (2q + r) x; t = tx
+            mp_mul_si(&u, &q, 7 * k + 2);
+            mp_mul_si(&v, &r, x);
+            mp_add(&u, &u, &v);
+            mp_mul_ui(&v, &q, 2);
+            mp_add(&v, &v, &r);
+            mp_mul_si(&r, &v, x);
+            mp_mul_si(&q, &q, k);
+            mp_mul_si(&t, &t, x);
+            m = small_quotient(&u, &t, &scratch);
+            k++;
+            x += 2;
+        }
+    }
+
+    *memory = 0;
+    for (int i = 0; i < 6; i++) {
+        *memory += buffers[i]->capacity * sizeof(mp_limb_t);
+        mp_clear(buffers[i]);
+    }
+    return 0;
+}
+
+///////////////// Rabinowitz-Wagon /////////////////
+// pi = 2 + 1/3 (2 + 2/5 (2 + 3/7 (2 + ...))) in a mixed-radix array of
+// 10n/3 entries. Each pass multiplies by 10 and carries right to left; the
+// integer part is the next digit, except that 9s are held until the
+// following digit shows whether a carry (a 10) turns them into 0s.
+// After j digits the last 10j/3 entries no longer matter and are skipped.
+static int rabinowitz_wagon_stream(SpigotOutput *out, size_t *memory) {
+    long long n = out->wanted + SPIGOT_GUARD_DIGITS;
+    size_t length = (size_t)(10 * n / 3) + 1;
+    uint32_t *a = (uint32_t *)malloc(length * sizeof(uint32_t));
+    if (a == NULL) return -1;
+    for (size_t i = 0; i < length; i++) a[i] = 2;
+    *memory = length * sizeof(uint32_t);
+
+    int predigit = -1;  // held digit, none before the first
+    long long nines = 0;
+    int more = 1;
+    for (long long j = 0; j < n && more; j++) {
+        size_t active = length - (size_t)(10 * j / 3);
+        uint64_t carry = 0;
+        for (size_t i = active; i > 0; i--) {
+            uint64_t value = 10 * (uint64_t)a[i - 1] + carry * i;
+            uint64_t base = 2 * i - 1;
+            a[i - 1] = (uint32_t)(value % base);
+            carry = value / base;
+        }
+        a[0] = (uint32_t)(carry % 10);
+        int digit = (int)(carry / 10);
+
+        if (digit == 9) {
+            nines++;
+        } else if (digit == 10) {
+            more = output_digit(out, predigit + 1) && output_repeat(out, 0, nines);
+            predigit = 0;
+            nines = 0;
+        } else {
+            if (predigit >= 0) more = output_digit(out, predigit);
+            more = more && output_repeat(out, 9, nines);
+            predigit = digit;
+            nines = 0;
+        }
+    }
+    if (more && predigit >= 0 && output_digit(out, predigit)) output_repeat(out, 9, nines);
+
+    free(a);
+    return 0;
+}
+
+///////////////// Streaming /////////////////
+int spigot_stream(SpigotVariant variant, long long digits, SpigotSink sink, void *context,
+                  SpigotStats *stats) {
+    if (digits < 0 || digits > SPIGOT_MAX_DIGITS || sink == NULL) return -1;
+    if (variant < 0 || variant >= SPIGOT_COUNT) return -1;
+
+    SpigotOutput out;
+    out.fill = 0;
+    out.produced = 0;
+    out.wanted = digits + 1;
+    out.sink = sink;
+    out.context = context;
+    out.failed = 0;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size_t memory = 0;
+    int status = variant == SPIGOT_GIBBONS ? gibbons_stream(&out, &memory)
+                                           : rabinowitz_wagon_stream(&out, &memory);
+    output_flush(&out);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    SpigotStats run;
+    run.digits = out.produced > 0 ? out.produced - 1 : 0;
+    run.time_seconds = (double)(end.tv_sec - start.tv_sec) +
+                       (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    run.memory_bytes = memory;
+    if (stats != NULL) *stats = run;
+    if (status < 0 || out.failed || out.produced < out.wanted) return -1;
+
+    pthread_mutex_lock(&last_run_lock);
+    last_runs[variant] = run;
+    has_run[variant] = 1;
+    pthread_mutex_unlock(&last_run_lock);
+    return 0;
+}
+
+typedef struct {
+    char *text;
+    size_t length;
+} SpigotString;
+
+static int append_to_string(const char *text, size_t length, void *context) {
+    SpigotString *string = (SpigotString *)context;
+    memcpy(string->text + string->length, text, length);
+    string->length += length;
+    return 1;
+}
+
+char *spigot_digits(SpigotVariant variant, long long digits) {
+    if (digits < 0 || digits > SPIGOT_MAX_DIGITS) return NULL;
+    SpigotString string;
+    string.text = (char *)malloc((size_t)digits + 3);
+    string.length = 0;
+    if (string.text == NULL) return NULL;
+    if (spigot_stream(variant, digits, append_to_string, &string, NULL) != 0) {
+        free(string.text);
+        return NULL;
+    }
+    string.text[string.length] = '\0';
+    return string.text;
+}
+
+///////////////// Names and benchmark /////////////////
+int spigot_variant_from_name(const char *name, SpigotVariant *variant) {
+    if (name == NULL) return 0;
+    for (int i = 0; i < SPIGOT_COUNT; i++) {
+        if (strcmp(name, SPIGOT_VARIANT_NAMES[i]) == 0) {
+            *variant = (SpigotVariant)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *spigot_variant_name(SpigotVariant variant) {
+    if (variant < 0 || variant >= SPIGOT_COUNT) return "unknown";
+    return SPIGOT_VARIANT_NAMES[variant];
+}
+
+int spigot_last_run(SpigotVariant variant, SpigotStats *stats) {
+    if (variant < 0 || variant >= SPIGOT_COUNT) return 0;
+    pthread_mutex_lock(&last_run_lock);
+    int found = has_run[variant];
+    if (found) *stats = last_runs[variant];
+    pthread_mutex_unlock(&last_run_lock);
+    return found;
+}
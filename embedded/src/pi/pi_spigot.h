@@ -0,0 +1,50 @@
+#ifndef PI_SPIGOT_H
+#define PI_SPIGOT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../mp/mp_int.h"
+#include "../constants.h"
+
+// Spigot algorithms produce pi digit by digit, so digits can leave as
+// they are found instead of after the whole computation.
+//   gibbons           Gibbons' unbounded streaming spigot: a linear
+//                     fractional transformation in four big integers,
+//                     no digit count needed up front
+//   rabinowitz_wagon  the bounded Rabinowitz-Wagon spigot: a mixed-radix
+//                     array of 10n/3 small integers sized for n digits
+typedef enum {
+    SPIGOT_GIBBONS,
+    SPIGOT_RABINOWITZ_WAGON,
+    SPIGOT_COUNT
+} SpigotVariant;
+
+// Receives the next piece of "3.1415..."; returning 0 stops the spigot
+typedef int (*SpigotSink)(const char *text, size_t length, void *context);
+
+typedef struct {
+    long long digits;         // decimals produced
+    double time_seconds;
+    size_t memory_bytes;      // spigot state at its largest
+} SpigotStats;
+
+// Stream "3." and `digits` decimals (truncated) to `sink` in pieces of up
+// to SPIGOT_CHUNK_DIGITS. Returns 0 when complete, -1 on bad input or if
+// the sink stopped early; *stats (if not NULL) covers what was produced.
+int spigot_stream(SpigotVariant variant, long long digits, SpigotSink sink, void *context,
+                  SpigotStats *stats);
+
+// The whole "3.1415..." string, malloc'd, like the multiprecision kernels
+char *spigot_digits(SpigotVariant variant, long long digits);
+
+// Returns 1 and sets *variant for a known name; 0 otherwise
+int spigot_variant_from_name(const char *name, SpigotVariant *variant);
+const char *spigot_variant_name(SpigotVariant variant);
+
+// Last completed run of each variant, the spigot's own benchmark;
+// returns 0 if the variant has not run yet
+int spigot_last_run(SpigotVariant variant, SpigotStats *stats);
+
+#endif
@@ -0,0 +1,248 @@
+#include "compute_pool.h"
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+    pthread_mutex_t lock;
+    PoolTask **tasks;
+    size_t head;      // thieves take from here
+    size_t tail;      // owner pushes and pops here
+    size_t capacity;
+} PoolDeque;
+
+typedef struct {
+    pthread_t *threads;
+    int worker_count;
+    PoolDeque *deques;        // one per worker plus the injection queue
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+    pthread_cond_t done_cond; // a task finished or was queued, for blocked joins
+    int pending;              // queued tasks not yet taken (guarded by idle_lock)
+    int joiners;              // threads blocked in pool_task_wait (guarded by idle_lock)
+    int running;
+} ComputePool;
+
+static ComputePool pool;
+static pthread_mutex_t pool_start_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread int worker_index = -1;
+static __thread void *task_context;
+
+///////////////// Deques /////////////////
+static void deque_init(PoolDeque *d) {
+    pthread_mutex_init(&d->lock, NULL);
+    d->tasks = NULL;
+    d->head = 0;
+    d->tail = 0;
+    d->capacity = 0;
+}
+
+static void deque_destroy(PoolDeque *d) {
+    pthread_mutex_destroy(&d->lock);
+    free(d->tasks);
+}
+
+static void deque_push(PoolDeque *d, PoolTask *task) {
+    pthread_mutex_lock(&d->lock);
+    if (d->tail == d->capacity) {
+        if (d->head > 0) {
+            memmove(d->tasks, d->tasks + d->head, (d->tail - d->head) * sizeof(PoolTask *));
+            d->tail -= d->head;
+            d->head = 0;
+        } else {
+            size_t capacity = d->capacity ? d->capacity * 2 : 64;
+            PoolTask **tasks = (PoolTask **)realloc(d->tasks, capacity * sizeof(PoolTask *));
+            if (tasks == NULL) {
+                fprintf(stderr, "compute_pool: out of memory growing deque\n");
+                abort();
+            }
+            d->tasks = tasks;
+            d->capacity = capacity;
+        }
+    }
+    d->tasks[d->tail++] = task;
+    pthread_mutex_unlock(&d->lock);
+}
+
+static PoolTask *deque_pop(PoolDeque *d) {
+    PoolTask *task = NULL;
+    pthread_mutex_lock(&d->lock);
+    if (d->tail > d->head) {
+        task = d->tasks[--d->tail];
+        if (d->tail == d->head) d->head = d->tail = 0;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return task;
+}
+
+static PoolTask *deque_steal(PoolDeque *d) {
+    PoolTask *task = NULL;
+    pthread_mutex_lock(&d->lock);
+    if (d->tail > d->head) {
+        task = d->tasks[d->head++];
+        if (d->tail == d->head) d->head = d->tail = 0;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return task;
+}
+
+///////////////// Scheduling /////////////////
+// Own deque first (LIFO keeps the working set hot), then steal round-robin
+static PoolTask *find_task(int self) {
+    int queues = pool.worker_count + 1;
+    if (self >= 0) {
+        PoolTask *task = deque_pop(&pool.deques[self]);
+        if (task != NULL) return task;
+    }
+    int start = self >= 0 ? self + 1 : 0;
+    for (int i = 0; i < queues; i++) {
+        int victim = (start + i) % queues;
+        if (victim == self) continue;
+        PoolTask *task = deque_steal(&pool.deques[victim]);
+        if (task != NULL) return task;
+    }
+    return NULL;
+}
+
+static void run_task(PoolTask *task) {
+    pthread_mutex_lock(&pool.idle_lock);
+    pool.pending--;
+    pthread_mutex_unlock(&pool.idle_lock);
+
+    // A helping thread may pick up another run's task: lend it that context
+    void *saved = task_context;
+    task_context = task->context;
+    task->func(task->arg);
+    task_context = saved;
+
+    // Set under idle_lock so a join cannot miss it between check and wait;
+    // task is not touched after this, its waiter may free it
+    pthread_mutex_lock(&pool.idle_lock);
+    __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+    if (pool.joiners > 0) pthread_cond_broadcast(&pool.done_cond);
+    pthread_mutex_unlock(&pool.idle_lock);
+}
+
+static void *worker_main(void *arg) {
+    worker_index = (int)(size_t)arg;
+    for (;;) {
+        PoolTask *task = find_task(worker_index);
+        if (task != NULL) {
+            run_task(task);
+            continue;
+        }
+        pthread_mutex_lock(&pool.idle_lock);
+        while (pool.pending == 0 && pool.running) {
+            pthread_cond_wait(&pool.idle_cond, &pool.idle_lock);
+        }
+        int exit_now = !pool.running && pool.pending == 0;
+        pthread_mutex_unlock(&pool.idle_lock);
+        if (exit_now) break;
+    }
+    return NULL;
+}
+
+///////////////// Public API /////////////////
+void compute_pool_start(int threads) {
+    pthread_mutex_lock(&pool_start_lock);
+    if (__atomic_load_n(&pool.running, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_unlock(&pool_start_lock);
+        return;
+    }
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads > COMPUTE_POOL_MAX_THREADS) threads = COMPUTE_POOL_MAX_THREADS;
+
+    // The thread waiting on a fork-join helps, so one core is left for it
+    int workers = threads > 1 ? threads - 1 : 1;
+    pool.worker_count = workers;
+    pool.deques = (PoolDeque *)malloc((size_t)(workers + 1) * sizeof(PoolDeque));
+    pool.threads = (pthread_t *)malloc((size_t)workers * sizeof(pthread_t));
+    if (pool.deques == NULL || pool.threads == NULL) {
+        fprintf(stderr, "compute_pool: out of memory starting %d workers\n", workers);
+        abort();
+    }
+    for (int i = 0; i <= workers; i++) deque_init(&pool.deques[i]);
+    pthread_mutex_init(&pool.idle_lock, NULL);
+    pthread_cond_init(&pool.idle_cond, NULL);
+    pthread_cond_init(&pool.done_cond, NULL);
+    pool.pending = 0;
+    pool.joiners = 0;
+    __atomic_store_n(&pool.running, 1, __ATOMIC_RELEASE);
+
+    for (int i = 0; i < workers; i++) {
+        pthread_create(&pool.threads[i], NULL, worker_main, (void *)(size_t)i);
+    }
+    pthread_mutex_unlock(&pool_start_lock);
+}
+
+void compute_pool_shutdown(void) {
+    pthread_mutex_lock(&pool_start_lock);
+    if (!__atomic_load_n(&pool.running, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_unlock(&pool_start_lock);
+        return;
+    }
+    pthread_mutex_lock(&pool.idle_lock);
+    __atomic_store_n(&pool.running, 0, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool.idle_cond);
+    pthread_mutex_unlock(&pool.idle_lock);
+
+    for (int i = 0; i < pool.worker_count; i++) pthread_join(pool.threads[i], NULL);
+    for (int i = 0; i <= pool.worker_count; i++) deque_destroy(&pool.deques[i]);
+    pthread_mutex_destroy(&pool.idle_lock);
+    pthread_cond_destroy(&pool.idle_cond);
+    pthread_cond_destroy(&pool.done_cond);
+    free(pool.deques);
+    free(pool.threads);
+    pool.deques = NULL;
+    pool.threads = NULL;
+    pool.worker_count = 0;
+    pthread_mutex_unlock(&pool_start_lock);
+}
+
+void compute_pool_set_context(void *context) {
+    task_context = context;
+}
+
+void *compute_pool_context(void) {
+    return task_context;
+}
+
+int compute_pool_size(void) {
+    if (!__atomic_load_n(&pool.running, __ATOMIC_ACQUIRE)) compute_pool_start(0);
+    return pool.worker_count + 1;
+}
+
+void pool_task_spawn(PoolTask *task, PoolTaskFunc func, void *arg) {
+    if (!__atomic_load_n(&pool.running, __ATOMIC_ACQUIRE)) compute_pool_start(0);
+    task->func = func;
+    task->arg = arg;
+    task->context = task_context;
+    task->done = 0;
+
+    int queue = worker_index >= 0 ? worker_index : pool.worker_count;
+    deque_push(&pool.deques[queue], task);
+
+    pthread_mutex_lock(&pool.idle_lock);
+    pool.pending++;
+    pthread_cond_signal(&pool.idle_cond);
+    // Every worker may be blocked in a join; one of them has to pick it up
+    if (pool.joiners > 0) pthread_cond_broadcast(&pool.done_cond);
+    pthread_mutex_unlock(&pool.idle_lock);
+}
+
+void pool_task_wait(PoolTask *task) {
+    while (!__atomic_load_n(&task->done, __ATOMIC_ACQUIRE)) {
+        PoolTask *other = find_task(worker_index);
+        if (other != NULL) {
+            run_task(other);
+            continue;
+        }
+        // Nothing to steal: sleep until a task finishes or more are queued
+        pthread_mutex_lock(&pool.idle_lock);
+        pool.joiners++;
+        while (!__atomic_load_n(&task->done, __ATOMIC_ACQUIRE) && pool.pending == 0) {
+            pthread_cond_wait(&pool.done_cond, &pool.idle_lock);
+        }
+        pool.joiners--;
+        pthread_mutex_unlock(&pool.idle_lock);
+    }
+}
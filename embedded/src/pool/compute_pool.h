@@ -0,0 +1,40 @@
+#ifndef COMPUTE_POOL_H
+#define COMPUTE_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../constants.h"
+
+// Fork-join work-stealing pool shared by all compute kernels.
+// Each worker owns a deque: it pushes and pops at the tail, idle workers
+// steal from the head. Threads outside the pool submit to an injection
+// queue and help run tasks while they wait.
+typedef void (*PoolTaskFunc)(void *arg);
+
+typedef struct {
+    PoolTaskFunc func;
+    void *arg;
+    void *context;  // spawner's context, installed while the task runs
+    int done;
+} PoolTask;
+
+// Start the pool (idempotent); threads <= 0 means one per online CPU
+void compute_pool_start(int threads);
+void compute_pool_shutdown(void);
+int compute_pool_size(void);
+
+// Queue task for execution; the task must stay alive until pool_task_wait returns
+void pool_task_spawn(PoolTask *task, PoolTaskFunc func, void *arg);
+
+// Block until task has run, executing other queued tasks meanwhile and
+// sleeping when there are none
+void pool_task_wait(PoolTask *task);
+
+// Per-thread context that tasks inherit from the thread spawning them, so
+// per-run state follows a run's work onto the workers; in practice the
+// multiprecision memory account (mp_memory_account_install)
+void compute_pool_set_context(void *context);
+void *compute_pool_context(void);
+
+#endif
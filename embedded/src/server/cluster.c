@@ -0,0 +1,280 @@
+#include "cluster.h"
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+static const char NODE_CHARACTERS[] =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.-_:[]";
+
+typedef struct {
+    ClusterPart *part;
+    MpMemoryAccount *account;  // the caller's, for local parts
+    MpInt values[3];  // P, Q, T
+} ClusterWork;
+
+static double seconds_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int cluster_parse_nodes(const char *list, char nodes[][CLUSTER_NODE_LENGTH], int max_nodes) {
+    int count = 0;
+    const char *p = list;
+    while (p != NULL && *p != '\0' && count < max_nodes) {
+        const char *end = strchr(p, ',');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        // Names end up in JSON and the Host header: nothing to escape
+        if (len > 0 && len < CLUSTER_NODE_LENGTH && strspn(p, NODE_CHARACTERS) >= len) {
+            memcpy(nodes[count], p, len);
+            nodes[count][len] = '\0';
+            count++;
+        }
+        p = end ? end + 1 : NULL;
+    }
+    return count;
+}
+
+int cluster_first_unknown_node(char nodes[][CLUSTER_NODE_LENGTH], int node_count,
+                               char allowed[][CLUSTER_NODE_LENGTH], int allowed_count) {
+    for (int i = 0; i < node_count; i++) {
+        int known = strcmp(nodes[i], "local") == 0;
+        for (int j = 0; j < allowed_count && !known; j++) known = strcmp(nodes[i], allowed[j]) == 0;
+        if (!known) return i;
+    }
+    return -1;
+}
+
+static int loopback_host(const char *host) {
+    return strcmp(host, "localhost") == 0 || strncmp(host, "127.", 4) == 0 ||
+           strcmp(host, "[::1]") == 0;
+}
+
+int cluster_localize_nodes(char nodes[][CLUSTER_NODE_LENGTH], int node_count,
+                           const char *address, int port) {
+    int rewritten = 0;
+    for (int i = 0; i < node_count; i++) {
+        char host[CLUSTER_NODE_LENGTH];
+        snprintf(host, sizeof(host), "%s", nodes[i]);
+        char *colon = strrchr(host, ':');
+        if (colon == NULL || atoi(colon + 1) != port) continue;
+        *colon = '\0';
+        int self = strcmp(host, address) == 0 ||
+                   (loopback_host(host) && (loopback_host(address) || strcmp(address, "0.0.0.0") == 0));
+        if (self) {
+            snprintf(nodes[i], CLUSTER_NODE_LENGTH, "local");
+            rewritten++;
+        }
+    }
+    return rewritten;
+}
+
+///////////////// HTTP client /////////////////
+static int connect_node(const char *node) {
+    char host[CLUSTER_NODE_LENGTH];
+    snprintf(host, sizeof(host), "%s", node);
+    char *colon = strrchr(host, ':');
+    if (colon == NULL) return -1;
+    *colon = '\0';
+    const char *port = colon + 1;
+
+    struct addrinfo hints, *addresses;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, port, &hints, &addresses) != 0) return -1;
+    int fd = -1;
+    for (struct addrinfo *a = addresses; a != NULL && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        // A node computing a large range is slow to answer, not dead
+        struct timeval timeout = {CLUSTER_TIMEOUT_SECONDS, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if (connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+int cluster_http_get(const char *node, const char *path, unsigned char **body, size_t *length) {
+    *body = NULL;
+    *length = 0;
+    int fd = connect_node(node);
+    if (fd < 0) return -1;
+
+    char request[BUFFER_SIZE];
+    int request_length = snprintf(request, sizeof(request),
+        "GET %s HTTP/1.1\r\n"
+        "Host: %s\r\n"
+        "Connection: close\r\n"
+        "\r\n",
+        path, node
+    );
+    for (int sent = 0; sent < request_length;) {
+        ssize_t n = send(fd, request + sent, (size_t)(request_length - sent), MSG_NOSIGNAL);
+        if (n <= 0) {
+            close(fd);
+            return -1;
+        }
+        sent += (int)n;
+    }
+
+    // The server closes the connection after one response: read to EOF
+    size_t capacity = 65536, used = 0;
+    char *response = (char *)malloc(capacity + 1);
+    int failed = response == NULL;
+    while (!failed) {
+        if (used == capacity) {
+            if (capacity >= CLUSTER_MAX_RESPONSE_BYTES) {
+                failed = 1;
+                break;
+            }
+            char *grown = (char *)realloc(response, capacity * 2 + 1);
+            if (grown == NULL) {
+                failed = 1;
+                break;
+            }
+            response = grown;
+            capacity *= 2;
+        }
+        ssize_t n = recv(fd, response + used, capacity - used, 0);
+        if (n < 0) failed = 1;
+        if (n <= 0) break;
+        used += (size_t)n;
+    }
+    close(fd);
+    if (failed) {
+        free(response);
+        return -1;
+    }
+    response[used] = '\0';
+
+    int status = 0;
+    char *header_end = strstr(response, "\r\n\r\n");
+    if (sscanf(response, "HTTP/%*d.%*d %d", &status) != 1 || header_end == NULL) {
+        free(response);
+        return -1;
+    }
+    size_t header_length = (size_t)(header_end + 4 - response);
+    size_t body_length = used - header_length;
+    // A short body means the node went away mid-response
+    const char *content_length = strstr(response, "Content-Length:");
+    if (content_length != NULL && content_length < header_end &&
+        strtoull(content_length + 15, NULL, 10) != body_length) {
+        free(response);
+        return -1;
+    }
+    memmove(response, response + header_length, body_length);
+    *body = (unsigned char *)response;
+    *length = body_length;
+    return status;
+}
+
+///////////////// Coordinator /////////////////
+// Fetch one part from its node; 0 if it arrived intact and matches
+static int fetch_part(ClusterWork *work) {
+    ClusterPart *part = work->part;
+    char path[256];
+    snprintf(path, sizeof(path), "/api/pi/chudnovsky_bs/partial?start=%lld&end=%lld", part->start, part->end);
+    unsigned char *body;
+    size_t length;
+    int status = cluster_http_get(part->node, path, &body, &length);
+    if (status != 200) {
+        snprintf(part->error, sizeof(part->error), status < 0 ? "no response" : "HTTP status %d", status);
+        free(body);
+        return -1;
+    }
+    long long start = -1, end = -1;
+    int count = partial_decode(body, length, &start, &end, work->values, 3);
+    free(body);
+    if (count != 3 || start != part->start || end != part->end) {
+        snprintf(part->error, sizeof(part->error), "malformed partial result");
+        return -1;
+    }
+    part->bytes = length;
+    return 0;
+}
+
+static void *part_thread(void *arg) {
+    ClusterWork *work = (ClusterWork *)arg;
+    ClusterPart *part = work->part;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    mp_memory_account_install(work->account);
+    part->remote = strcmp(part->node, "local") != 0 && fetch_part(work) == 0;
+    if (!part->remote) {
+        chudnovsky_bs_range(part->start, part->end, &work->values[0], &work->values[1], &work->values[2]);
+    }
+    part->seconds = seconds_since(&start);
+    return NULL;
+}
+
+char *cluster_chudnovsky_digits(long long digits, char nodes[][CLUSTER_NODE_LENGTH], int node_count,
+                                ClusterPart *parts) {
+    if (digits < 1 || digits > MAX_MP_DIGITS || node_count < 1 || node_count > CLUSTER_MAX_NODES) return NULL;
+    long long terms = chudnovsky_bs_terms(digits);
+    if (node_count > terms) return NULL;
+
+    ClusterWork *work = (ClusterWork *)malloc((size_t)node_count * sizeof(ClusterWork));
+    pthread_t *threads = (pthread_t *)malloc((size_t)node_count * sizeof(pthread_t));
+    if (work == NULL || threads == NULL) {
+        free(work);
+        free(threads);
+        return NULL;
+    }
+    for (int i = 0; i < node_count; i++) {
+        ClusterPart *part = &parts[i];
+        memset(part, 0, sizeof(*part));
+        snprintf(part->node, sizeof(part->node), "%s", nodes[i]);
+        part->start = terms * i / node_count;
+        part->end = terms * (i + 1) / node_count;
+        work[i].part = part;
+        work[i].account = mp_memory_account();
+        for (int v = 0; v < 3; v++) mp_init(&work[i].values[v]);
+    }
+    // Network waits block, so every part gets a thread of its own rather
+    // than a compute-pool task; local parts still use the pool inside
+    for (int i = 0; i < node_count; i++) {
+        if (pthread_create(&threads[i], NULL, part_thread, &work[i]) != 0) {
+            part_thread(&work[i]);
+            threads[i] = pthread_self();
+        }
+    }
+    for (int i = 0; i < node_count; i++) {
+        if (!pthread_equal(threads[i], pthread_self())) pthread_join(threads[i], NULL);
+    }
+
+    // Join neighbours pairwise, keeping the tree balanced; the range that
+    // ends at `terms` never needs its P
+    MpInt joined[3];
+    for (int v = 0; v < 3; v++) mp_init(&joined[v]);
+    for (int count = node_count; count > 1; count = (count + 1) / 2) {
+        for (int i = 0; i + 1 < count; i += 2) {
+            MpInt *left = work[i].values, *right = work[i + 1].values;
+            int last = i + 2 >= count;
+            chudnovsky_bs_join(last ? NULL : &joined[0], &joined[1], &joined[2],
+                               &left[0], &left[1], &left[2], &right[0], &right[1], &right[2]);
+            for (int v = last ? 1 : 0; v < 3; v++) mp_swap(&left[v], &joined[v]);
+        }
+        for (int i = 2; i < count; i += 2) {
+            for (int v = 0; v < 3; v++) mp_swap(&work[i / 2].values[v], &work[i].values[v]);
+        }
+    }
+    char *result = chudnovsky_bs_finish(&work[0].values[1], &work[0].values[2], digits);
+
+    for (int v = 0; v < 3; v++) mp_clear(&joined[v]);
+    for (int i = 0; i < node_count; i++) {
+        for (int v = 0; v < 3; v++) mp_clear(&work[i].values[v]);
+    }
+    free(work);
+    free(threads);
+    return result;
+}
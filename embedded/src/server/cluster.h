@@ -0,0 +1,53 @@
+#ifndef CLUSTER_H
+#define CLUSTER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../pi/pi_multiprecision.h"
+#include "../pi/pi_partial.h"
+#include "../constants.h"
+
+// Coordinator for spreading one binary-splitting Chudnovsky run across
+// several C servers: the terms are cut into one contiguous range per
+// node, each node returns its P/Q/T from /api/pi/chudnovsky_bs/partial,
+// and the parts are joined here. "local" as a node computes its range
+// in-process; a node that fails has its range computed locally instead.
+
+typedef struct {
+    char node[CLUSTER_NODE_LENGTH];  // "host:port" or "local"
+    long long start;                 // terms [start, end)
+    long long end;
+    double seconds;
+    size_t bytes;                    // encoded size received
+    int remote;                      // 1 if the node delivered its part
+    char error[96];                  // why it did not, if it did not
+} ClusterPart;
+
+// Split "host:port,host:port,local" into nodes[], skipping names that are
+// empty, too long or hold anything but host characters; returns the count
+int cluster_parse_nodes(const char *list, char nodes[][CLUSTER_NODE_LENGTH], int max_nodes);
+
+// Index of the first node that is neither "local" nor one of the allowed
+// (configured) nodes, or -1 if all of them are; requests may pick among
+// the configured nodes, never name new hosts for the server to connect to
+int cluster_first_unknown_node(char nodes[][CLUSTER_NODE_LENGTH], int node_count,
+                               char allowed[][CLUSTER_NODE_LENGTH], int allowed_count);
+
+// Rewrite to "local" every node that names this server, bound to
+// `address`:`port` (a loopback name counts when bound to loopback or any
+// address). Its own accept loop would only answer once the run is over.
+// Returns how many were rewritten.
+int cluster_localize_nodes(char nodes[][CLUSTER_NODE_LENGTH], int node_count,
+                           const char *address, int port);
+
+// Digits of pi from `node_count` nodes, one part each, described in
+// parts[0 .. node_count); NULL on bad input, including more nodes than
+// terms
+char *cluster_chudnovsky_digits(long long digits, char nodes[][CLUSTER_NODE_LENGTH], int node_count,
+                                ClusterPart *parts);
+
+// GET `path` from "host:port" over HTTP/1.1; the malloc'd body goes to
+// *body. Returns the status code, or -1 if there was no valid response.
+int cluster_http_get(const char *node, const char *path, unsigned char **body, size_t *length);
+
+#endif
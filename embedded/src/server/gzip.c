@@ -0,0 +1,236 @@
+#include "gzip.h"
+#include <string.h>
+#include <unistd.h>
+
+#define GZIP_LITERALS 257        // byte values and end-of-block
+#define GZIP_END_OF_BLOCK 256
+#define GZIP_MAX_BITS 15
+#define GZIP_LENGTH_CODES 19
+#define GZIP_MAX_LENGTH_BITS 7
+#define GZIP_BUFFER_BYTES 65536
+
+// Order code length code lengths are sent in (RFC 1951, 3.2.7)
+static const int LENGTH_CODE_ORDER[GZIP_LENGTH_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+///////////////// CRC-32 /////////////////
+uint32_t gzip_crc32(uint32_t crc, const char *data, size_t length) {
+    uint32_t table[256];
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+///////////////// Bit output /////////////////
+// Deflate packs bits LSB first; Huffman codes are stored pre-reversed so
+// they go through the same path
+typedef struct {
+    int fd;
+    unsigned char buffer[GZIP_BUFFER_BYTES];
+    size_t fill;
+    uint64_t bits;
+    int count;
+    int failed;
+} BitWriter;
+
+static void writer_flush(BitWriter *w) {
+    size_t done = 0;
+    while (!w->failed && done < w->fill) {
+        ssize_t written = write(w->fd, w->buffer + done, w->fill - done);
+        if (written <= 0) w->failed = 1;
+        else done += (size_t)written;
+    }
+    w->fill = 0;
+}
+
+static void writer_byte(BitWriter *w, unsigned char byte) {
+    w->buffer[w->fill++] = byte;
+    if (w->fill == GZIP_BUFFER_BYTES) writer_flush(w);
+}
+
+static void writer_bits(BitWriter *w, uint32_t value, int count) {
+    w->bits |= (uint64_t)value << w->count;
+    w->count += count;
+    while (w->count >= 8) {
+        writer_byte(w, (unsigned char)w->bits);
+        w->bits >>= 8;
+        w->count -= 8;
+    }
+}
+
+static void writer_align(BitWriter *w) {
+    if (w->count > 0) writer_bits(w, 0, 8 - w->count);
+}
+
+static void writer_le32(BitWriter *w, uint32_t value) {
+    for (int i = 0; i < 4; i++) writer_byte(w, (unsigned char)(value >> (8 * i)));
+}
+
+///////////////// Huffman codes /////////////////
+// Code lengths for `count` symbols, at most max_bits long. Frequencies are
+// halved until the tree fits, which only costs anything on skewed input.
+static void huffman_lengths(const uint64_t *frequencies, int count, int max_bits, uint8_t *lengths) {
+    uint64_t scaled[GZIP_LITERALS];
+    memcpy(scaled, frequencies, (size_t)count * sizeof(uint64_t));
+    for (;;) {
+        uint64_t weight[2 * GZIP_LITERALS];
+        int parent[2 * GZIP_LITERALS];
+        int active[GZIP_LITERALS];
+        int symbol_node[GZIP_LITERALS];
+        int nodes = 0, live = 0;
+        for (int s = 0; s < count; s++) {
+            lengths[s] = 0;
+            symbol_node[s] = -1;
+            if (scaled[s] == 0) continue;
+            symbol_node[s] = nodes;
+            weight[nodes] = scaled[s];
+            parent[nodes] = -1;
+            active[live++] = nodes++;
+        }
+        if (live == 1) {
+            // A lone symbol still needs a one-bit code
+            for (int s = 0; s < count; s++) if (symbol_node[s] >= 0) lengths[s] = 1;
+            return;
+        }
+        // Merge the two lightest until one tree is left; n is small
+        while (live > 1) {
+            int first = 0, second = 1;
+            if (weight[active[second]] < weight[active[first]]) { first = 1; second = 0; }
+            for (int i = 2; i < live; i++) {
+                if (weight[active[i]] < weight[active[first]]) {
+                    second = first;
+                    first = i;
+                } else if (weight[active[i]] < weight[active[second]]) {
+                    second = i;
+                }
+            }
+            weight[nodes] = weight[active[first]] + weight[active[second]];
+            parent[nodes] = -1;
+            parent[active[first]] = nodes;
+            parent[active[second]] = nodes;
+            int low = first < second ? first : second;
+            int high = first < second ? second : first;
+            active[low] = nodes++;
+            active[high] = active[--live];
+        }
+
+        int longest = 0;
+        for (int s = 0; s < count; s++) {
+            if (symbol_node[s] < 0) continue;
+            int depth = 0;
+            for (int node = symbol_node[s]; parent[node] >= 0; node = parent[node]) depth++;
+            lengths[s] = (uint8_t)depth;
+            if (depth > longest) longest = depth;
+        }
+        if (longest <= max_bits) return;
+        for (int s = 0; s < count; s++) {
+            if (scaled[s] > 0) scaled[s] = (scaled[s] + 1) / 2;
+        }
+    }
+}
+
+// Canonical codes (RFC 1951, 3.2.2), bit-reversed for LSB-first output
+static void canonical_codes(const uint8_t *lengths, int count, uint16_t *codes) {
+    int length_count[GZIP_MAX_BITS + 1] = {0};
+    for (int s = 0; s < count; s++) length_count[lengths[s]]++;
+    length_count[0] = 0;
+    int next[GZIP_MAX_BITS + 1];
+    int code = 0;
+    for (int bits = 1; bits <= GZIP_MAX_BITS; bits++) {
+        code = (code + length_count[bits - 1]) << 1;
+        next[bits] = code;
+    }
+    for (int s = 0; s < count; s++) {
+        codes[s] = 0;
+        if (lengths[s] == 0) continue;
+        int value = next[lengths[s]]++;
+        uint16_t reversed = 0;
+        for (int b = 0; b < lengths[s]; b++) reversed = (uint16_t)((reversed << 1) | ((value >> b) & 1));
+        codes[s] = reversed;
+    }
+}
+
+///////////////// Block /////////////////
+int gzip_write(int fd, const char *data, size_t length) {
+    BitWriter *w = (BitWriter *)malloc(sizeof(BitWriter));
+    if (w == NULL) return -1;
+    w->fd = fd;
+    w->fill = 0;
+    w->bits = 0;
+    w->count = 0;
+    w->failed = 0;
+
+    uint64_t frequencies[GZIP_LITERALS] = {0};
+    for (size_t i = 0; i < length; i++) frequencies[(unsigned char)data[i]]++;
+    frequencies[GZIP_END_OF_BLOCK] = 1;
+    uint8_t lengths[GZIP_LITERALS];
+    uint16_t codes[GZIP_LITERALS];
+    huffman_lengths(frequencies, GZIP_LITERALS, GZIP_MAX_BITS, lengths);
+    canonical_codes(lengths, GZIP_LITERALS, codes);
+
+    // The 257 literal lengths and one zero-length distance code (none are
+    // used), as code length symbols: zero runs become 17 (3-10) or 18 (11-138)
+    uint8_t sequence[GZIP_LITERALS + 1];
+    memcpy(sequence, lengths, GZIP_LITERALS);
+    sequence[GZIP_LITERALS] = 0;
+    uint8_t tokens[GZIP_LITERALS + 1], extras[GZIP_LITERALS + 1];
+    int token_count = 0;
+    uint64_t length_frequencies[GZIP_LENGTH_CODES] = {0};
+    for (int i = 0; i < GZIP_LITERALS + 1;) {
+        int run = 1;
+        while (sequence[i] == 0 && i + run < GZIP_LITERALS + 1 && sequence[i + run] == 0 && run < 138) run++;
+        if (sequence[i] == 0 && run >= 3) {
+            tokens[token_count] = (uint8_t)(run >= 11 ? 18 : 17);
+            extras[token_count] = (uint8_t)(run >= 11 ? run - 11 : run - 3);
+            i += run;
+        } else {
+            tokens[token_count] = sequence[i];
+            extras[token_count] = 0;
+            i++;
+        }
+        length_frequencies[tokens[token_count++]]++;
+    }
+    uint8_t length_lengths[GZIP_LENGTH_CODES];
+    uint16_t length_codes[GZIP_LENGTH_CODES];
+    huffman_lengths(length_frequencies, GZIP_LENGTH_CODES, GZIP_MAX_LENGTH_BITS, length_lengths);
+    canonical_codes(length_lengths, GZIP_LENGTH_CODES, length_codes);
+    int sent_lengths = GZIP_LENGTH_CODES;
+    while (sent_lengths > 4 && length_lengths[LENGTH_CODE_ORDER[sent_lengths - 1]] == 0) sent_lengths--;
+
+    // Member header: deflate, no name, unknown OS
+    static const unsigned char HEADER[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+    for (int i = 0; i < 10; i++) writer_byte(w, HEADER[i]);
+
+    writer_bits(w, 1, 1);                  // final block
+    writer_bits(w, 2, 2);                  // dynamic Huffman
+    writer_bits(w, GZIP_LITERALS - 257, 5);
+    writer_bits(w, 0, 5);                  // one distance code
+    writer_bits(w, (uint32_t)(sent_lengths - 4), 4);
+    for (int i = 0; i < sent_lengths; i++) writer_bits(w, length_lengths[LENGTH_CODE_ORDER[i]], 3);
+    for (int i = 0; i < token_count; i++) {
+        writer_bits(w, length_codes[tokens[i]], length_lengths[tokens[i]]);
+        if (tokens[i] == 17) writer_bits(w, extras[i], 3);
+        if (tokens[i] == 18) writer_bits(w, extras[i], 7);
+    }
+    for (size_t i = 0; i < length; i++) {
+        unsigned char byte = (unsigned char)data[i];
+        writer_bits(w, codes[byte], lengths[byte]);
+    }
+    writer_bits(w, codes[GZIP_END_OF_BLOCK], lengths[GZIP_END_OF_BLOCK]);
+    writer_align(w);
+
+    writer_le32(w, gzip_crc32(0, data, length));
+    writer_le32(w, (uint32_t)length);
+    writer_flush(w);
+    int status = w->failed ? -1 : 0;
+    free(w);
+    return status;
+}
@@ -0,0 +1,19 @@
+#ifndef GZIP_H
+#define GZIP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Minimal gzip writer for digit files. Digits repeat nothing LZ77 could
+// use, so the deflate stream is one dynamic-Huffman block of literals:
+// about 3.4 bits per decimal digit, 4 per hex digit, no zlib needed.
+
+// Write `data` to `fd` as a complete gzip member; 0 on success, -1 on a
+// write error
+int gzip_write(int fd, const char *data, size_t length);
+
+// CRC-32 (IEEE) as used by the gzip trailer; `crc` chains calls, start at 0
+uint32_t gzip_crc32(uint32_t crc, const char *data, size_t length);
+
+#endif
@@ -0,0 +1,285 @@
+#include "jobs.h"
+#include "results.h"
+#include "../pi/pi_reference.h"
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
+
+static const char *JOB_STATUS_NAMES[JOB_STATUS_COUNT] = {
+    "running", "done", "failed", "stopped", "interrupted"
+};
+
+typedef struct {
+    int used;
+    char id[RESULTS_ID_LENGTH];
+    char algorithm[CHECKPOINT_NAME_LENGTH];
+    CalculatePiDigitsCheckpointed func;
+    long long digits;
+    JobStatus status;
+    PiCheckpoint checkpoint;
+    struct timespec started;
+    double elapsed_seconds;
+    long long correct_digits;
+    long long checked_digits;
+    char result_id[RESULTS_ID_LENGTH];
+    unsigned long long order;  // start sequence, to evict the oldest
+} Job;
+
+// The table and everything in it except the running job's checkpoint
+// counters, which the job thread updates and readers load atomically
+static pthread_mutex_t jobs_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobs_idle = PTHREAD_COND_INITIALIZER;
+static Job jobs[JOBS_MAX_ENTRIES];
+static char *jobs_directory = NULL;
+static int jobs_running = 0;
+static unsigned long long jobs_sequence = 0;
+
+const char *job_status_name(JobStatus status) {
+    return status >= 0 && status < JOB_STATUS_COUNT ? JOB_STATUS_NAMES[status] : "unknown";
+}
+
+static double seconds_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static CalculatePiDigitsCheckpointed find_job_algorithm(const char *algorithm) {
+    for (int i = 0; JOB_ALGORITHMS[i].name != NULL; i++) {
+        if (strcmp(JOB_ALGORITHMS[i].name, algorithm) == 0) return JOB_ALGORITHMS[i].func;
+    }
+    return NULL;
+}
+
+// <directory>/<id>.ckpt; caller holds jobs_mutex
+static void checkpoint_path(char *path, size_t size, const char *id) {
+    snprintf(path, size, "%s/%s.ckpt", jobs_directory, id);
+}
+
+// caller holds jobs_mutex
+static Job *find_job(const char *id) {
+    for (int i = 0; i < JOBS_MAX_ENTRIES; i++) {
+        if (jobs[i].used && strcmp(jobs[i].id, id) == 0) return &jobs[i];
+    }
+    return NULL;
+}
+
+// A free slot, else the oldest finished job's; NULL if all are running.
+// caller holds jobs_mutex
+static Job *free_slot(void) {
+    Job *oldest = NULL;
+    for (int i = 0; i < JOBS_MAX_ENTRIES; i++) {
+        if (!jobs[i].used) return &jobs[i];
+        if (jobs[i].status == JOB_RUNNING) continue;
+        if (oldest == NULL || jobs[i].order < oldest->order) oldest = &jobs[i];
+    }
+    return oldest;
+}
+
+int jobs_open(const char *directory) {
+    jobs_close();
+    if (directory == NULL || directory[0] == '\0') return -1;
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST) return -1;
+    struct stat info;
+    if (stat(directory, &info) != 0 || !S_ISDIR(info.st_mode)) return -1;
+
+    char *copy = strdup(directory);
+    if (copy == NULL) return -1;
+    pthread_mutex_lock(&jobs_mutex);
+    jobs_directory = copy;
+    memset(jobs, 0, sizeof(jobs));
+    pthread_mutex_unlock(&jobs_mutex);
+    return 0;
+}
+
+void jobs_close(void) {
+    pthread_mutex_lock(&jobs_mutex);
+    for (int i = 0; i < JOBS_MAX_ENTRIES; i++) {
+        if (jobs[i].used && jobs[i].status == JOB_RUNNING) checkpoint_request_stop(&jobs[i].checkpoint);
+    }
+    while (jobs_running > 0) pthread_cond_wait(&jobs_idle, &jobs_mutex);
+    free(jobs_directory);
+    jobs_directory = NULL;
+    pthread_mutex_unlock(&jobs_mutex);
+}
+
+///////////////// Running /////////////////
+static void *job_thread(void *arg) {
+    Job *job = (Job *)arg;
+    char *digits = job->func(job->digits, &job->checkpoint);
+
+    long long checked = 0, correct = 0;
+    char result_id[RESULTS_ID_LENGTH] = "";
+    int saved = -1;
+    if (digits != NULL) {
+        correct = reference_check_decimal(digits, &checked);
+        saved = results_store_save(digits, strlen(digits), result_id);
+        free(digits);
+    }
+
+    pthread_mutex_lock(&jobs_mutex);
+    job->elapsed_seconds += seconds_since(&job->started);
+    if (saved == 0) {
+        job->status = JOB_DONE;
+        job->correct_digits = correct;
+        job->checked_digits = checked;
+        snprintf(job->result_id, sizeof(job->result_id), "%s", result_id);
+        checkpoint_remove(job->checkpoint.path);
+    } else if (digits == NULL && checkpoint_stop_requested(&job->checkpoint)) {
+        job->status = JOB_STOPPED;
+    } else {
+        // Keep the checkpoint: a finished run whose result could not be
+        // stored is resumed at its last checkpoint rather than from scratch
+        job->status = JOB_FAILED;
+    }
+    jobs_running--;
+    pthread_cond_broadcast(&jobs_idle);
+    pthread_mutex_unlock(&jobs_mutex);
+    return NULL;
+}
+
+// Fill `job` and start its thread; caller holds jobs_mutex
+static int launch_job(Job *job, const char *id, const char *algorithm,
+                      CalculatePiDigitsCheckpointed func, long long digits) {
+    char path[CHECKPOINT_PATH_LENGTH];
+    checkpoint_path(path, sizeof(path), id);
+    memset(job, 0, sizeof(*job));
+    job->used = 1;
+    snprintf(job->id, sizeof(job->id), "%s", id);
+    snprintf(job->algorithm, sizeof(job->algorithm), "%s", algorithm);
+    job->func = func;
+    job->digits = digits;
+    job->status = JOB_RUNNING;
+    job->order = ++jobs_sequence;
+    checkpoint_init(&job->checkpoint, path, CHECKPOINT_INTERVAL_SECONDS);
+    clock_gettime(CLOCK_MONOTONIC, &job->started);
+
+    pthread_t thread;
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    int failed = pthread_create(&thread, &attributes, job_thread, job);
+    pthread_attr_destroy(&attributes);
+    if (failed) {
+        job->used = 0;
+        return -2;
+    }
+    jobs_running++;
+    return 0;
+}
+
+int jobs_start(const char *algorithm, long long digits, char *id) {
+    CalculatePiDigitsCheckpointed func = find_job_algorithm(algorithm);
+    if (func == NULL || digits < 1 || digits > MAX_MP_DIGITS) return -1;
+
+    pthread_mutex_lock(&jobs_mutex);
+    Job *job = jobs_directory != NULL ? free_slot() : NULL;
+    if (job == NULL) {
+        pthread_mutex_unlock(&jobs_mutex);
+        return -2;
+    }
+    // Clock and sequence, mixed (splitmix64) like result ids
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    unsigned long long x = ((unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec) ^
+                           ((jobs_sequence + 1) << 48) ^ ((unsigned long long)getpid() << 32);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    char new_id[RESULTS_ID_LENGTH];
+    snprintf(new_id, sizeof(new_id), "%016llx", x);
+
+    int status = launch_job(job, new_id, algorithm, func, digits);
+    if (status == 0) snprintf(id, RESULTS_ID_LENGTH, "%s", new_id);
+    pthread_mutex_unlock(&jobs_mutex);
+    return status;
+}
+
+int jobs_stop(const char *id) {
+    pthread_mutex_lock(&jobs_mutex);
+    Job *job = results_id_valid(id) ? find_job(id) : NULL;
+    int status = -1;
+    if (job != NULL && job->status == JOB_RUNNING) {
+        checkpoint_request_stop(&job->checkpoint);
+        status = 0;
+    }
+    pthread_mutex_unlock(&jobs_mutex);
+    return status;
+}
+
+int jobs_resume(const char *id) {
+    if (!results_id_valid(id)) return -1;
+    pthread_mutex_lock(&jobs_mutex);
+    if (jobs_directory == NULL) {
+        pthread_mutex_unlock(&jobs_mutex);
+        return -1;
+    }
+    Job *job = find_job(id);
+    if (job != NULL && job->status == JOB_RUNNING) {
+        pthread_mutex_unlock(&jobs_mutex);
+        return -2;
+    }
+
+    // The checkpoint says what was running; the kernel picks up from it
+    char path[CHECKPOINT_PATH_LENGTH];
+    checkpoint_path(path, sizeof(path), id);
+    CheckpointState state;
+    CalculatePiDigitsCheckpointed func = NULL;
+    if (checkpoint_peek(path, &state) == 0) func = find_job_algorithm(state.algorithm);
+    if (func == NULL || state.digits < 1 || state.digits > MAX_MP_DIGITS) {
+        pthread_mutex_unlock(&jobs_mutex);
+        return -1;
+    }
+    if (job == NULL) job = free_slot();
+    int status = job != NULL ? launch_job(job, id, state.algorithm, func, state.digits) : -2;
+    pthread_mutex_unlock(&jobs_mutex);
+    return status;
+}
+
+int jobs_info(const char *id, JobInfo *info) {
+    if (!results_id_valid(id)) return -1;
+    memset(info, 0, sizeof(*info));
+    snprintf(info->id, sizeof(info->id), "%s", id);
+
+    pthread_mutex_lock(&jobs_mutex);
+    if (jobs_directory == NULL) {
+        pthread_mutex_unlock(&jobs_mutex);
+        return -1;
+    }
+    Job *job = find_job(id);
+    if (job == NULL) {
+        // Left behind by an earlier process
+        char path[CHECKPOINT_PATH_LENGTH];
+        checkpoint_path(path, sizeof(path), id);
+        pthread_mutex_unlock(&jobs_mutex);
+        CheckpointState state;
+        if (checkpoint_peek(path, &state) != 0) return -1;
+        snprintf(info->algorithm, sizeof(info->algorithm), "%s", state.algorithm);
+        info->digits = state.digits;
+        info->status = JOB_INTERRUPTED;
+        info->progress = state.total > 0 ? (double)state.done / (double)state.total : 0.0;
+        return 0;
+    }
+
+    snprintf(info->algorithm, sizeof(info->algorithm), "%s", job->algorithm);
+    info->digits = job->digits;
+    info->status = job->status;
+    info->progress = job->status == JOB_DONE ? 1.0 : checkpoint_progress(&job->checkpoint);
+    info->elapsed_seconds = job->elapsed_seconds;
+    if (job->status == JOB_RUNNING) info->elapsed_seconds += seconds_since(&job->started);
+    // Written by the job thread: each is read atomically, but while the run
+    // goes on they may be one checkpoint apart
+    info->checkpoints = __atomic_load_n(&job->checkpoint.checkpoints, __ATOMIC_RELAXED);
+    info->resumed = __atomic_load_n(&job->checkpoint.resumed, __ATOMIC_RELAXED);
+    info->checkpoint_bytes = __atomic_load_n(&job->checkpoint.bytes, __ATOMIC_RELAXED);
+    __atomic_load(&job->checkpoint.write_seconds, &info->checkpoint_seconds, __ATOMIC_RELAXED);
+    info->correct_digits = job->correct_digits;
+    info->checked_digits = job->checked_digits;
+    snprintf(info->result_id, sizeof(info->result_id), "%s", job->result_id);
+    pthread_mutex_unlock(&jobs_mutex);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../pi/pi_multiprecision.h"
+#include "../constants.h"
+
+// Background digit computations that outlive a request: each job runs on
+// its own thread, checkpoints to <directory>/<id>.ckpt, and stores its
+// digits in the results directory when done. A job stopped on purpose or
+// cut off by a restart is resumed from its latest checkpoint.
+
+typedef enum {
+    JOB_RUNNING,
+    JOB_DONE,
+    JOB_FAILED,
+    JOB_STOPPED,      // stopped on request, checkpoint kept
+    JOB_INTERRUPTED,  // unknown to this process, checkpoint on disk
+    JOB_STATUS_COUNT
+} JobStatus;
+
+// Checkpointed kernels, started at POST /api/jobs?algorithm={name}&digits=N
+typedef struct {
+    const char *name;
+    CalculatePiDigitsCheckpointed func;
+} JobAlgorithmEntry;
+
+static const JobAlgorithmEntry JOB_ALGORITHMS[] = {
+    {"chudnovsky_bs", chudnovsky_bs_digits_checkpointed},
+    {"gauss_legendre", gauss_legendre_digits_checkpointed},
+    {NULL, NULL}  // Sentinel
+};
+
+// A snapshot of one job for status responses
+typedef struct {
+    char id[RESULTS_ID_LENGTH];
+    char algorithm[CHECKPOINT_NAME_LENGTH];
+    long long digits;
+    JobStatus status;
+    double progress;               // 0..1
+    double elapsed_seconds;        // this process's share of the run
+    int checkpoints;
+    int resumed;
+    long long checkpoint_bytes;
+    double checkpoint_seconds;     // spent writing checkpoints
+    long long correct_digits;      // against the reference, once done
+    long long checked_digits;
+    char result_id[RESULTS_ID_LENGTH];
+} JobInfo;
+
+// Use `directory` for checkpoints (created if needed); 0 on success
+int jobs_open(const char *directory);
+
+// Ask running jobs to checkpoint and stop, and wait until they have
+void jobs_close(void);
+
+// Start `algorithm` for `digits`; the new id goes to id[]. 0 on success,
+// -1 for an unknown algorithm or bad digits, -2 if no slot is free or the
+// store is closed.
+int jobs_start(const char *algorithm, long long digits, char *id);
+
+// Stop a running job at its next checkpoint; 0 if it was running
+int jobs_stop(const char *id);
+
+// Continue a stopped or interrupted job from its checkpoint. 0 on success,
+// -1 without a usable checkpoint, -2 if it is running or no slot is free.
+int jobs_resume(const char *id);
+
+// Fill *info; 0 for a known or interrupted job, -1 otherwise
+int jobs_info(const char *id, JobInfo *info);
+
+const char *job_status_name(JobStatus status);
+
+#endif
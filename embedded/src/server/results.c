@@ -0,0 +1,246 @@
+#include "results.h"
+#include "gzip.h"
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+static pthread_mutex_t results_mutex = PTHREAD_MUTEX_INITIALIZER;
+static char *results_directory = NULL;
+// Ids kept in the directory, oldest at `recent_first`
+static char recent[RESULTS_MAX_FILES][RESULTS_ID_LENGTH];
+static int recent_first = 0;
+static int recent_count = 0;
+static unsigned long long results_sequence = 0;
+
+static void adopt_results(void);
+
+int results_store_open(const char *directory) {
+    results_store_close();
+    if (directory == NULL || directory[0] == '\0') return -1;
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST) return -1;
+    struct stat info;
+    if (stat(directory, &info) != 0 || !S_ISDIR(info.st_mode)) return -1;
+
+    char *copy = strdup(directory);
+    if (copy == NULL) return -1;
+    pthread_mutex_lock(&results_mutex);
+    results_directory = copy;
+    recent_first = 0;
+    recent_count = 0;
+    adopt_results();
+    pthread_mutex_unlock(&results_mutex);
+    return 0;
+}
+
+void results_store_close(void) {
+    pthread_mutex_lock(&results_mutex);
+    free(results_directory);
+    results_directory = NULL;
+    pthread_mutex_unlock(&results_mutex);
+}
+
+int results_store_available(void) {
+    pthread_mutex_lock(&results_mutex);
+    int available = results_directory != NULL;
+    pthread_mutex_unlock(&results_mutex);
+    return available;
+}
+
+int results_id_valid(const char *id) {
+    if (id == NULL || strlen(id) != RESULTS_ID_LENGTH - 1) return 0;
+    for (const char *c = id; *c; c++) {
+        if (!isdigit((unsigned char)*c) && (*c < 'a' || *c > 'f')) return 0;
+    }
+    return 1;
+}
+
+// <directory>/<id>.txt[.gz][.tmp]; caller holds results_mutex
+static void result_path(char *path, size_t size, const char *id, int gzip, int temporary) {
+    snprintf(path, size, "%s/%s.txt%s%s", results_directory, id,
+             gzip ? ".gz" : "", temporary ? ".tmp" : "");
+}
+
+// Write through a temporary name so readers never see a partial file
+static int write_result_file(const char *id, int gzip, const char *text, size_t length) {
+    char temporary[RESULTS_PATH_LENGTH], final_path[RESULTS_PATH_LENGTH];
+    result_path(temporary, sizeof(temporary), id, gzip, 1);
+    result_path(final_path, sizeof(final_path), id, gzip, 0);
+    int fd = open(temporary, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+
+    int status = 0;
+    if (gzip) {
+        status = gzip_write(fd, text, length);
+    } else {
+        size_t done = 0;
+        while (status == 0 && done < length) {
+            ssize_t written = write(fd, text + done, length - done);
+            if (written <= 0) status = -1;
+            else done += (size_t)written;
+        }
+    }
+    if (close(fd) != 0) status = -1;
+    if (status == 0 && rename(temporary, final_path) != 0) status = -1;
+    if (status != 0) unlink(temporary);
+    return status;
+}
+
+// Delete the oldest result once RESULTS_MAX_FILES are kept; caller holds
+// results_mutex
+static void remember_result(const char *id) {
+    if (recent_count == RESULTS_MAX_FILES) {
+        char path[RESULTS_PATH_LENGTH];
+        for (int gzip = 0; gzip <= 1; gzip++) {
+            result_path(path, sizeof(path), recent[recent_first], gzip, 0);
+            unlink(path);
+        }
+        recent_first = (recent_first + 1) % RESULTS_MAX_FILES;
+        recent_count--;
+    }
+    int slot = (recent_first + recent_count) % RESULTS_MAX_FILES;
+    snprintf(recent[slot], RESULTS_ID_LENGTH, "%s", id);
+    recent_count++;
+}
+
+typedef struct {
+    char id[RESULTS_ID_LENGTH];
+    struct timespec modified;
+} StoredResult;
+
+static int older_result(const void *a, const void *b) {
+    const struct timespec *x = &((const StoredResult *)a)->modified;
+    const struct timespec *y = &((const StoredResult *)b)->modified;
+    if (x->tv_sec != y->tv_sec) return x->tv_sec < y->tv_sec ? -1 : 1;
+    if (x->tv_nsec != y->tv_nsec) return x->tv_nsec < y->tv_nsec ? -1 : 1;
+    return 0;
+}
+
+// Remember the <id>.txt files already in the directory, oldest first, so
+// results from earlier runs count against RESULTS_MAX_FILES too; past the
+// cap the oldest are deleted. Caller holds results_mutex.
+static void adopt_results(void) {
+    DIR *dir = opendir(results_directory);
+    if (dir == NULL) return;
+    StoredResult *found = NULL;
+    size_t count = 0, capacity = 0;
+    const size_t id_length = RESULTS_ID_LENGTH - 1;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char *name = entry->d_name;
+        if (strlen(name) != id_length + 4 || strcmp(name + id_length, ".txt") != 0) continue;
+        StoredResult result;
+        memcpy(result.id, name, id_length);
+        result.id[id_length] = '\0';
+        if (!results_id_valid(result.id)) continue;
+
+        char path[RESULTS_PATH_LENGTH];
+        result_path(path, sizeof(path), result.id, 0, 0);
+        struct stat info;
+        if (stat(path, &info) != 0 || !S_ISREG(info.st_mode)) continue;
+        result.modified = info.st_mtim;
+        if (count == capacity) {
+            size_t grown = capacity ? capacity * 2 : 64;
+            StoredResult *larger = (StoredResult *)realloc(found, grown * sizeof(StoredResult));
+            if (larger == NULL) break;
+            found = larger;
+            capacity = grown;
+        }
+        found[count++] = result;
+    }
+    closedir(dir);
+
+    if (count > 0) qsort(found, count, sizeof(StoredResult), older_result);
+    for (size_t i = 0; i < count; i++) remember_result(found[i].id);
+    free(found);
+}
+
+int results_store_save(const char *text, size_t length, char *id) {
+    pthread_mutex_lock(&results_mutex);
+    if (results_directory == NULL) {
+        pthread_mutex_unlock(&results_mutex);
+        return -1;
+    }
+    // Clock and sequence, mixed (splitmix64) so ids do not sort by time
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    unsigned long long x = ((unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec) ^
+                           (++results_sequence << 48) ^ ((unsigned long long)getpid() << 32);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    snprintf(id, RESULTS_ID_LENGTH, "%016llx", x);
+
+    int status = write_result_file(id, 0, text, length);
+    if (status == 0) {
+        // The compressed copy is optional: downloads fall back to plain text
+        write_result_file(id, 1, text, length);
+        remember_result(id);
+    }
+    pthread_mutex_unlock(&results_mutex);
+    return status;
+}
+
+int results_store_open_file(const char *id, int gzip, size_t *size) {
+    if (!results_id_valid(id)) return -1;
+    pthread_mutex_lock(&results_mutex);
+    if (results_directory == NULL) {
+        pthread_mutex_unlock(&results_mutex);
+        return -1;
+    }
+    char path[RESULTS_PATH_LENGTH];
+    result_path(path, sizeof(path), id, gzip, 0);
+    pthread_mutex_unlock(&results_mutex);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return -1;
+    }
+    *size = (size_t)info.st_size;
+    return fd;
+}
+
+///////////////// Range /////////////////
+// Digits only, no sign or spaces: strtoull alone would accept both
+static int parse_offset(const char **cursor, unsigned long long *value) {
+    if (!isdigit((unsigned char)**cursor)) return 0;
+    errno = 0;
+    char *end;
+    *value = strtoull(*cursor, &end, 10);
+    if (errno != 0) return 0;
+    *cursor = end;
+    return 1;
+}
+
+int results_parse_range(const char *header, size_t size, size_t *first, size_t *last) {
+    if (strncmp(header, "bytes=", 6) != 0) return -1;
+    const char *cursor = header + 6;
+    unsigned long long start = 0, end = 0;
+    int has_start = parse_offset(&cursor, &start);
+    if (*cursor++ != '-') return -1;
+    int has_end = parse_offset(&cursor, &end);
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+    if (*cursor != '\0' || (!has_start && !has_end)) return -1;  // also multiple ranges
+    if (has_start && has_end && end < start) return -1;
+
+    if (!has_start) {
+        // Suffix range: the last `end` bytes
+        if (end == 0 || size == 0) return 0;
+        *first = end >= size ? 0 : size - (size_t)end;
+        *last = size - 1;
+        return 1;
+    }
+    if (start >= size) return 0;
+    *first = (size_t)start;
+    *last = has_end && end < size ? (size_t)end : size - 1;
+    return 1;
+}
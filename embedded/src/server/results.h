@@ -0,0 +1,35 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../constants.h"
+
+// Results too large for an inline JSON response are written to a results
+// directory as <id>.txt, plus <id>.txt.gz compressed once up front, and
+// downloaded from /api/results/<id>/digits. The newest RESULTS_MAX_FILES
+// are kept, counting those left by earlier runs; older ones are deleted.
+
+// Create (if needed) and use `directory`, adopting the results already in
+// it by modification time; 0 on success, -1 otherwise
+int results_store_open(const char *directory);
+void results_store_close(void);
+int results_store_available(void);
+
+// Write `length` bytes of text as a new result; its id goes to id[]
+// (RESULTS_ID_LENGTH bytes). 0 on success, -1 on failure.
+int results_store_save(const char *text, size_t length, char *id);
+
+// Open the stored text (or its gzip copy) for reading; returns the fd and
+// sets *size, or -1 for an unknown id or missing file
+int results_store_open_file(const char *id, int gzip, size_t *size);
+
+// Ids are lowercase hex of fixed length, so they are safe as file names
+int results_id_valid(const char *id);
+
+// Parse a "bytes=" Range header against a file of `size` bytes. Returns 1
+// and sets [*first, *last] for one satisfiable range, 0 if unsatisfiable,
+// -1 if the header is not a single byte range (then it is ignored).
+int results_parse_range(const char *header, size_t size, size_t *first, size_t *last);
+
+#endif
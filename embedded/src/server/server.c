@@ -1,4 +1,7 @@
 #include "server.h"
+#include <strings.h>
+#include <sys/sendfile.h>
+#include <sys/time.h>
 
 // Find algorithm function by name
 static CalculatePi find_algorithm(const char *algorithm) {
@@ -10,6 +13,55 @@ static CalculatePi find_algorithm(const char *algorithm) {
     return NULL;
 }
 
+// Find multiprecision digit kernel by name
+static CalculatePiDigits find_digits_algorithm(const char *algorithm) {
+    for (int i = 0; DIGITS_ALGORITHMS[i].name != NULL; i++) {
+        if (strcmp(algorithm, DIGITS_ALGORITHMS[i].name) == 0) {
+            return DIGITS_ALGORITHMS[i].func;
+        }
+    }
+    return NULL;
+}
+
+// Find the type-generic instantiation of an algorithm for a precision
+static CalculatePiWide find_precision_algorithm(const char *algorithm, PiPrecision precision) {
+    for (int i = 0; PRECISION_ALGORITHMS[i].name != NULL; i++) {
+        if (strcmp(algorithm, PRECISION_ALGORITHMS[i].name) == 0) {
+            return PRECISION_ALGORITHMS[i].kernels[precision];
+        }
+    }
+    return NULL;
+}
+
+// Find the accelerated form of a series
+static CalculatePiCounted find_accel_algorithm(const char *algorithm, PiAcceleration accel) {
+    for (int i = 0; ACCEL_ALGORITHMS[i].name != NULL; i++) {
+        if (strcmp(algorithm, ACCEL_ALGORITHMS[i].name) == 0) {
+            return ACCEL_ALGORITHMS[i].kernels[accel];
+        }
+    }
+    return NULL;
+}
+
+// Copy the value of `key` from a "a=1&b=2" query string; returns 1 if found
+static int get_query_param(const char *query, const char *key, char *value, size_t value_size) {
+    size_t key_len = strlen(key);
+    const char *p = query;
+    while (p != NULL && *p != '\0') {
+        const char *end = strchr(p, '&');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        if (len > key_len && strncmp(p, key, key_len) == 0 && p[key_len] == '=') {
+            size_t value_len = len - key_len - 1;
+            if (value_len >= value_size) value_len = value_size - 1;
+            memcpy(value, p + key_len + 1, value_len);
+            value[value_len] = '\0';
+            return 1;
+        }
+        p = end ? end + 1 : NULL;
+    }
+    return 0;
+}
+
 // Send error response for unknown algorithm
 static void send_algorithm_error(int client_fd, const char *algorithm) {
     char json_error[256];
@@ -20,6 +72,28 @@ static void send_algorithm_error(int client_fd, const char *algorithm) {
     server_send_json(client_fd, json_error, 400);
 }
 
+// Target-digits mode: append the target to a finished result object
+static void append_target_json(char *buffer, size_t size, const PiResult *result) {
+    size_t length = strlen(buffer);
+    if (result->target_digits <= 0 || length == 0 || buffer[length - 1] != '}') return;
+    length--;
+    while (length > 0 && buffer[length - 1] == ' ') length--;
+    snprintf(buffer + length, size - length,
+        ", \"target_digits\": %d, \"target_reached\": %s}",
+        result->target_digits,
+        result->target_reached ? "true" : "false"
+    );
+}
+
+// ?accel= runs: append the transform to a finished result object
+static void append_accel_json(char *buffer, size_t size, const char *accel) {
+    size_t length = strlen(buffer);
+    if (accel == NULL || length == 0 || buffer[length - 1] != '}') return;
+    length--;
+    while (length > 0 && buffer[length - 1] == ' ') length--;
+    snprintf(buffer + length, size - length, ", \"acceleration\": \"%s\"}", accel);
+}
+
 // Build JSON response from PiResult
 static void build_result_json(char *buffer, size_t size, 
                                const PiResult *result, 
@@ -52,19 +126,72 @@ static void build_result_json(char *buffer, size_t size,
         algorithm,
         result->iterations,
         result->cpu_time_used,
-        (long double) result->iterations / result->cpu_time_used,
+        result->cpu_time_used > 0 ? (long double) result->iterations / result->cpu_time_used : 0.0L,
         result->correct_digits,
         perfect_decimal ? "true" : "false",
         display_error,
         display_rel_error,
         PI_REFERENCE
     );
+    append_target_json(buffer, size, result);
 }
 
+// Build JSON response for a ?precision= run; digits printed to the type's ceiling
+static void build_wide_result_json(char *buffer, size_t size,
+                                   const PiResult *result,
+                                   const char *algorithm,
+                                   const char *precision) {
+    char estimate[QD_MAX_DIGITS + 8];
+    char actual[QD_MAX_DIGITS + 8];
+    qd_to_string(result->wide_estimate, result->max_digits, estimate, sizeof(estimate));
+    qd_to_string(QD_PI, result->max_digits, actual, sizeof(actual));
+    double error = fabs(qd_sub(result->wide_estimate, QD_PI).x[0]);
+
+    snprintf(buffer, size,
+        "{"
+        "\"pi_estimate\": \"%s\", "
+        "\"algorithm\": \"%s\", "
+        "\"precision\": \"%s\", "
+        "\"iterations\": %lld, "
+        "\"time_seconds\": %.6Lf, "
+        "\"iterations_per_second\": %.0Lf, "
+        "\"correct_digits\": %d, "
+        "\"max_decimal_digits\": %d, "
+        "\"perfect_decimal_precision\": %s, "
+        "\"absolute_error\": %.2e, "
+        "\"relative_error\": %.2e, "
+        "\"actual_pi\": \"%s\" "
+        "}",
+        estimate,
+        algorithm,
+        precision,
+        result->iterations,
+        result->cpu_time_used,
+        result->cpu_time_used > 0 ? (long double) result->iterations / result->cpu_time_used : 0.0L,
+        result->correct_digits,
+        result->max_digits,
+        result->correct_digits >= result->max_digits ? "true" : "false",
+        error,
+        error / QD_PI.x[0],
+        actual
+    );
+    append_target_json(buffer, size, result);
+}
+
+// Where this server listens, so a distributed run can tell itself apart
+// from the other nodes
+static const char *self_address = IP_ADDRESS;
+static int self_port = PORT;
+
 // Initialize server on specified port
 int server_init(Server *srv, int port) {
     srv->port = port;
     srv->running = 0;
+    // Overridable so several servers can share a host as cluster nodes
+    const char *bind_address = getenv("PI_BIND_ADDRESS");
+    srv->address = bind_address != NULL ? bind_address : IP_ADDRESS;
+    self_address = srv->address;
+    self_port = port;
     
     // Create socket
     srv->socket_fd = socket(AF_INET, SOCK_STREAM, 0);
@@ -84,7 +211,7 @@ int server_init(Server *srv, int port) {
     // Configure server address
     struct sockaddr_in address;
     address.sin_family = AF_INET;
-    address.sin_addr.s_addr = inet_addr(IP_ADDRESS);
+    address.sin_addr.s_addr = inet_addr(srv->address);
     address.sin_port = htons(port);
     
     // Bind
@@ -102,30 +229,221 @@ int server_init(Server *srv, int port) {
     }
     
     printf("Server initialized on port %d\n", port);
+
+    // Pick kernel variants once, before the first request
+    cpu_features_init();
+    printf("CPU level: %s (detected %s)\n", cpu_level_name(cpu_level()),
+           cpu_level_name(cpu_detected_level()));
+
+    // Calibration from earlier runs on this machine and build
+    const char *profile_path = getenv("PI_PROFILE_PATH");
+    if (profile_path == NULL) profile_path = PROFILE_PATH;
+    int profiles = profile_store_open(profile_path);
+    if (profiles < 0) {
+        printf("Calibration profiles unavailable at %s, optimizing cold\n", profile_path);
+    } else {
+        printf("Calibration profiles: %d loaded from %s\n", profiles, profile_path);
+    }
+
+    // Reference digits for checking results; generated on first start
+    const char *reference_path = getenv("PI_REFERENCE_PATH");
+    if (reference_path == NULL) reference_path = REFERENCE_PATH;
+    long long reference_digits = reference_store_open(reference_path, REFERENCE_DIGITS);
+    if (reference_digits < 0) {
+        printf("Reference digits unavailable at %s, results are not checked\n", reference_path);
+    } else {
+        printf("Reference digits: %lld decimal, %lld hex from %s\n",
+               reference_digits, reference_hex_digits(), reference_path);
+    }
+
+    // Large digit results are served from files instead of inline JSON
+    const char *results_directory = getenv("PI_RESULTS_DIR");
+    if (results_directory == NULL) results_directory = RESULTS_DIRECTORY;
+    if (results_store_open(results_directory) != 0) {
+        printf("Results directory %s unavailable, large results are sent inline\n", results_directory);
+    }
+
+    // Past the memory limit, large numbers spill to files here
+    const char *spill_directory = getenv("PI_SPILL_DIR");
+    if (spill_directory == NULL) spill_directory = MP_SPILL_DIRECTORY;
+    const char *memory_limit = getenv("PI_MP_MEMORY_LIMIT");
+    if (mp_out_of_core_configure(memory_limit ? strtoull(memory_limit, NULL, 10) : 0, spill_directory) != 0) {
+        printf("Spill directory %s unavailable, numbers are kept in memory\n", spill_directory);
+    } else {
+        printf("Out-of-core above %zu bytes, spilling to %s\n", mp_memory_limit(), spill_directory);
+    }
+
+    // Background jobs checkpoint here and can be resumed after a restart
+    const char *jobs_directory = getenv("PI_JOBS_DIR");
+    if (jobs_directory == NULL) jobs_directory = JOBS_DIRECTORY;
+    if (jobs_open(jobs_directory) != 0) {
+        printf("Jobs directory %s unavailable, background jobs are disabled\n", jobs_directory);
+    }
+    return 0;
+}
+
+// Send all bytes, retrying on partial writes; -1 once the client is gone.
+// MSG_NOSIGNAL keeps a closed connection from raising SIGPIPE.
+static int send_all(int client_fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(client_fd, data, length, MSG_NOSIGNAL);
+        if (sent <= 0) return -1;
+        data += sent;
+        length -= (size_t)sent;
+    }
     return 0;
 }
 
+// One chunk of a chunked-transfer body; a zero length ends the body
+static int send_chunk(int client_fd, const char *data, size_t length) {
+    char size_line[32];
+    int size_length = snprintf(size_line, sizeof(size_line), "%zx\r\n", length);
+    if (send_all(client_fd, size_line, (size_t)size_length) < 0) return -1;
+    if (length > 0 && send_all(client_fd, data, length) < 0) return -1;
+    return send_all(client_fd, "\r\n", 2);
+}
+
 // Send JSON response to client
 void server_send_json(int client_fd, const char *json_body, int status_code) {
-    char response[BUFFER_SIZE];
-    const char *status_text = (status_code == 200) ? "OK" : "Error";
+    char header[BUFFER_SIZE];
+    const char *status_text = (status_code == 200) ? "OK" : (status_code == 202) ? "Accepted" : "Error";
+    size_t body_length = strlen(json_body);
     
-    snprintf(response, sizeof(response),
+    int header_length = snprintf(header, sizeof(header),
         "HTTP/1.1 %d %s\r\n"
         "Content-Type: application/json\r\n"
-        "Content-Length: %ld\r\n"
+        "Content-Length: %zu\r\n"
         "Connection: close\r\n"
         "Access-Control-Allow-Origin: *\r\n"
-        "\r\n"
-        "%s",
-        status_code, status_text, strlen(json_body), json_body
+        "\r\n",
+        status_code, status_text, body_length
     );
     
-    send(client_fd, response, strlen(response), 0);
+    // Header and body go out separately so large bodies are never truncated
+    send_all(client_fd, header, (size_t)header_length);
+    send_all(client_fd, json_body, body_length);
+}
+
+// Parse ?digits= for target-digits mode: 0 if absent, -1 (and a 400 sent)
+// if outside 1..max_digits
+static int parse_target_digits(int client_fd, const char *query, int max_digits) {
+    char value[32];
+    if (query == NULL || !get_query_param(query, "digits", value, sizeof(value))) return 0;
+    int digits = atoi(value);
+    if (digits < 1 || digits > max_digits) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"digits must be between 1 and %d\", \"digits\": \"%s\"}",
+            max_digits, value
+        );
+        server_send_json(client_fd, json_error, 400);
+        return -1;
+    }
+    return digits;
+}
+
+// ?accel=: the series summed through a transform of its partial sums, so
+// the response compares directly with the raw run of the same algorithm
+static void handle_accelerated(int client_fd, const char *algorithm, const char *accel_param,
+                               const char *query) {
+    PiAcceleration accel;
+    if (!accel_from_name(accel_param, &accel)) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"Unknown acceleration\", \"accel\": \"%s\"}",
+            accel_param
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+    char precision_param[32];
+    CalculatePiCounted counted = find_accel_algorithm(algorithm, accel);
+    if (counted == NULL ||
+        get_query_param(query, "precision", precision_param, sizeof(precision_param))) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"Acceleration not available for algorithm\", "
+            "\"algorithm\": \"%s\", \"accel\": \"%s\"}",
+            algorithm, accel_param
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+
+    PiKernel kernel = {
+        .func = NULL,
+        .wide = NULL,
+        .max_digits = MAX_PRECISION_DIGITS,
+        .incremental = NULL,
+        .backend = accel_name(accel),
+        .counted = counted
+    };
+    int target_digits = parse_target_digits(client_fd, query, kernel.max_digits);
+    if (target_digits < 0) return;
+    PiResult result = target_digits > 0
+        ? optimize_pi_kernel_digits(&kernel, algorithm, target_digits, TARGET_DIGITS_TIME_LIMIT)
+        : optimize_pi_kernel(&kernel, algorithm, 1.0);
+
+    char json_response[1024];
+    build_result_json(json_response, sizeof(json_response), &result, algorithm);
+    append_accel_json(json_response, sizeof(json_response), accel_name(accel));
+    server_send_json(client_fd, json_response, 200);
 }
 
-// Handle algorithm calculation request
-void server_handle_algorithm(int client_fd, const char *algorithm) {
+// Handle algorithm calculation request; ?digits=N asks for the cheapest
+// run reaching N digits instead of the most digits in one second, ?accel=
+// sums the series through a convergence accelerator
+void server_handle_algorithm(int client_fd, const char *algorithm, const char *query) {
+    char accel_param[32];
+    if (query != NULL && get_query_param(query, "accel", accel_param, sizeof(accel_param))) {
+        handle_accelerated(client_fd, algorithm, accel_param, query);
+        return;
+    }
+
+    char precision_param[32];
+    if (query != NULL && get_query_param(query, "precision", precision_param, sizeof(precision_param))) {
+        PiPrecision precision;
+        if (!precision_from_name(precision_param, &precision)) {
+            char json_error[256];
+            snprintf(json_error, sizeof(json_error),
+                "{\"error\": \"Unknown or unsupported precision\", \"precision\": \"%s\"}",
+                precision_param
+            );
+            server_send_json(client_fd, json_error, 400);
+            return;
+        }
+        CalculatePiWide wide = find_precision_algorithm(algorithm, precision);
+        if (wide == NULL) {
+            char json_error[256];
+            snprintf(json_error, sizeof(json_error),
+                "{\"error\": \"Precision not available for algorithm\", "
+                "\"algorithm\": \"%s\", \"precision\": \"%s\"}",
+                algorithm, precision_param
+            );
+            server_send_json(client_fd, json_error, 400);
+            return;
+        }
+        PiKernel kernel = {
+            .func = NULL,
+            .wide = wide,
+            .max_digits = precision_max_digits(precision),
+            .incremental = NULL,
+            .backend = precision_name(precision),
+            .counted = NULL
+        };
+        int target_digits = parse_target_digits(client_fd, query, kernel.max_digits);
+        if (target_digits < 0) return;
+        PiResult result = target_digits > 0
+            ? optimize_pi_kernel_digits(&kernel, algorithm, target_digits, TARGET_DIGITS_TIME_LIMIT)
+            : optimize_pi_kernel(&kernel, algorithm, 1.0);
+
+        char json_response[1024];
+        build_wide_result_json(json_response, sizeof(json_response), &result,
+                               algorithm, precision_name(precision));
+        server_send_json(client_fd, json_response, 200);
+        return;
+    }
+
     // Find algorithm function
     CalculatePi func = find_algorithm(algorithm);
     if (func == NULL) {
@@ -133,8 +451,13 @@ void server_handle_algorithm(int client_fd, const char *algorithm) {
         return;
     }
    
+    int target_digits = parse_target_digits(client_fd, query, MAX_PRECISION_DIGITS);
+    if (target_digits < 0) return;
+
     // Run calculation
-    PiResult result = optimize_pi_precision(func, algorithm, 1.0);
+    PiResult result = target_digits > 0
+        ? optimize_pi_digits(func, algorithm, target_digits, TARGET_DIGITS_TIME_LIMIT)
+        : optimize_pi_precision(func, algorithm, 1.0);
    
     // Build and send response
     char json_response[1024];
@@ -142,6 +465,1003 @@ void server_handle_algorithm(int client_fd, const char *algorithm) {
     server_send_json(client_fd, json_response, 200);
 }
 
+// Parse ?digits= for a multiprecision run (default 1000): -1 (and a 400
+// sent) if outside 1..MAX_MP_DIGITS
+static long long parse_mp_digits(int client_fd, const char *query) {
+    char value[32];
+    long long digits = 1000;
+    if (query != NULL && get_query_param(query, "digits", value, sizeof(value))) {
+        digits = atoll(value);
+    }
+    if (digits < 1 || digits > MAX_MP_DIGITS) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"digits must be between 1 and %lld\", \"digits\": %lld}",
+            MAX_MP_DIGITS, digits
+        );
+        server_send_json(client_fd, json_error, 400);
+        return -1;
+    }
+    return digits;
+}
+
+// Send a finished digit run: checked against the reference, inline or
+// stored for download. `extra` is spliced in as more "key": value pairs,
+// each followed by ", ".
+static void send_digits_json(int client_fd, const char *algorithm, const PiDigitsResult *result,
+                             const char *extra) {
+    long long checked = 0;
+    long long correct = reference_check_decimal(result->digits, &checked);
+
+    // Above the inline limit the digits go to the results directory and
+    // the response points at the download instead
+    size_t digits_length = strlen(result->digits);
+    char result_id[RESULTS_ID_LENGTH];
+    int stored = result->digit_count > RESULTS_INLINE_DIGITS &&
+                 results_store_save(result->digits, digits_length, result_id) == 0;
+
+    size_t size = (stored ? 0 : digits_length) + strlen(extra) + 512;
+    char *json_response = (char *)malloc(size);
+    if (json_response == NULL) {
+        server_send_json(client_fd, "{\"error\": \"Out of memory\"}", 500);
+        return;
+    }
+    int length = snprintf(json_response, size,
+        "{"
+        "\"algorithm\": \"%s\", "
+        "\"digits\": %lld, "
+        "\"time_seconds\": %.6f, "
+        "\"digits_per_second\": %.0f, "
+        "\"threads\": %d, "
+        "\"peak_memory_bytes\": %zu, "
+        "\"correct_digits\": %lld, "
+        "\"checked_digits\": %lld, "
+        "%s",
+        algorithm,
+        result->digit_count,
+        result->time_seconds,
+        result->time_seconds > 0.0 ? (double)result->digit_count / result->time_seconds : 0.0,
+        compute_pool_size(),
+        result->peak_memory_bytes,
+        correct,
+        checked,
+        extra
+    );
+    if (stored) {
+        snprintf(json_response + length, size - (size_t)length,
+            "\"result_id\": \"%s\", "
+            "\"download\": \"/api/results/%s/digits\", "
+            "\"bytes\": %zu"
+            "}",
+            result_id, result_id, digits_length
+        );
+    } else {
+        snprintf(json_response + length, size - (size_t)length, "\"pi\": \"%s\"}", result->digits);
+    }
+    server_send_json(client_fd, json_response, 200);
+    free(json_response);
+}
+
+// Handle multiprecision digits request
+void server_handle_digits(int client_fd, const char *algorithm, const char *query) {
+    CalculatePiDigits func = find_digits_algorithm(algorithm);
+    if (func == NULL) {
+        send_algorithm_error(client_fd, algorithm);
+        return;
+    }
+
+    long long digits = parse_mp_digits(client_fd, query);
+    if (digits < 0) return;
+
+    PiDigitsResult result = compute_pi_digits(func, digits);
+    if (result.digits == NULL) {
+        server_send_json(client_fd, "{\"error\": \"Digit computation failed\"}", 500);
+        return;
+    }
+
+    send_digits_json(client_fd, algorithm, &result, "");
+    free_pi_digits_result(&result);
+}
+
+// Handle a term range for a coordinator: P, Q and T in the binary
+// encoding of pi_partial.h, not JSON
+void server_handle_partial(int client_fd, const char *algorithm, const char *query) {
+    if (strcmp(algorithm, "chudnovsky_bs") != 0) {
+        server_send_json(client_fd, "{\"error\": \"Partial results are only available for chudnovsky_bs\"}", 400);
+        return;
+    }
+    char value[32];
+    long long start = -1, end = -1;
+    long long terms = chudnovsky_bs_terms(MAX_MP_DIGITS);
+    if (query != NULL && get_query_param(query, "start", value, sizeof(value))) start = atoll(value);
+    if (query != NULL && get_query_param(query, "end", value, sizeof(value))) end = atoll(value);
+    if (start < 0 || end <= start || end > terms) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"start and end must satisfy 0 <= start < end <= %lld\"}",
+            terms
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+
+    MpInt P, Q, T;
+    mp_init(&P);
+    mp_init(&Q);
+    mp_init(&T);
+    chudnovsky_bs_range(start, end, &P, &Q, &T);
+    const MpInt *values[3] = {&P, &Q, &T};
+    size_t length;
+    unsigned char *data = partial_encode(start, end, values, 3, &length);
+    mp_clear(&P);
+    mp_clear(&Q);
+    mp_clear(&T);
+    if (data == NULL) {
+        server_send_json(client_fd, "{\"error\": \"Out of memory\"}", 500);
+        return;
+    }
+
+    char header[BUFFER_SIZE];
+    int header_length = snprintf(header, sizeof(header),
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/octet-stream\r\n"
+        "Content-Length: %zu\r\n"
+        "Connection: close\r\n"
+        "\r\n",
+        length
+    );
+    if (send_all(client_fd, header, (size_t)header_length) == 0) {
+        send_all(client_fd, (const char *)data, length);
+    }
+    free(data);
+}
+
+// Hand long work (a stream, a download, a distributed run) to a detached
+// thread, as jobs do, so the accept loop keeps serving (/api/health
+// included). The loop closes client_fd on return; the thread gets its own
+// copy in *stream_fd and closes that when done. 0 on success.
+static int start_stream_thread(int client_fd, int *stream_fd, void *(*run)(void *), void *work) {
+    *stream_fd = dup(client_fd);
+    if (*stream_fd < 0) return -1;
+    pthread_t thread;
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    int failed = pthread_create(&thread, &attributes, run, work) != 0;
+    pthread_attr_destroy(&attributes);
+    if (failed) {
+        close(*stream_fd);
+        *stream_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+typedef struct {
+    int client_fd;  // the run's own descriptor, closed when it is done
+    long long digits;
+    char nodes[CLUSTER_MAX_NODES][CLUSTER_NODE_LENGTH];
+    int node_count;
+} DistributedWork;
+
+static int distributed_runs_running;
+
+static void run_distributed(int client_fd, long long digits, char nodes[][CLUSTER_NODE_LENGTH],
+                            int node_count) {
+    ClusterPart parts[CLUSTER_MAX_NODES];
+    struct timespec start, end;
+    MpMemoryAccount account = {0, 0};
+    MpMemoryAccount *previous = mp_memory_account_install(&account);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PiDigitsResult result;
+    result.digits = cluster_chudnovsky_digits(digits, nodes, node_count, parts);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    mp_memory_account_install(previous);
+    if (result.digits == NULL) {
+        server_send_json(client_fd, "{\"error\": \"Digit computation failed\"}", 500);
+        return;
+    }
+    result.digit_count = digits;
+    result.time_seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    result.peak_memory_bytes = account.peak;
+
+    // One entry per node, in term order
+    char extra[CLUSTER_MAX_NODES * (CLUSTER_NODE_LENGTH + 256) + 32];
+    int length = snprintf(extra, sizeof(extra), "\"nodes\": [");
+    for (int i = 0; i < node_count; i++) {
+        length += snprintf(extra + length, sizeof(extra) - (size_t)length,
+            "%s{\"node\": \"%s\", \"start\": %lld, \"end\": %lld, \"seconds\": %.6f, "
+            "\"bytes\": %zu, \"remote\": %s, \"error\": \"%s\"}",
+            i > 0 ? ", " : "", parts[i].node, parts[i].start, parts[i].end, parts[i].seconds,
+            parts[i].bytes, parts[i].remote ? "true" : "false", parts[i].error
+        );
+    }
+    snprintf(extra + length, sizeof(extra) - (size_t)length, "], ");
+    send_digits_json(client_fd, "chudnovsky_bs", &result, extra);
+    free_pi_digits_result(&result);
+}
+
+// The coordinator waits on remote nodes for up to CLUSTER_TIMEOUT_SECONDS
+// each: it runs off the accept loop, which keeps serving meanwhile
+static void *distributed_thread(void *arg) {
+    DistributedWork *work = (DistributedWork *)arg;
+    run_distributed(work->client_fd, work->digits, work->nodes, work->node_count);
+    close(work->client_fd);
+    free(work);
+    __atomic_sub_fetch(&distributed_runs_running, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+// Handle a binary-splitting run spread over other servers. Errors found
+// before the run starts are answered here; the run itself has its own
+// thread, at most CLUSTER_MAX_RUNS at a time.
+void server_handle_distributed(int client_fd, const char *query) {
+    long long digits = parse_mp_digits(client_fd, query);
+    if (digits < 0) return;
+
+    // Only configured nodes are contacted: ?nodes= picks among them
+    const char *nodes_env = getenv("PI_NODES");
+    char configured[CLUSTER_MAX_NODES][CLUSTER_NODE_LENGTH];
+    int configured_count = cluster_parse_nodes(nodes_env != NULL ? nodes_env : "", configured,
+                                               CLUSTER_MAX_NODES);
+    char list[CLUSTER_MAX_NODES * CLUSTER_NODE_LENGTH];
+    if (query == NULL || !get_query_param(query, "nodes", list, sizeof(list))) {
+        snprintf(list, sizeof(list), "%s", nodes_env != NULL ? nodes_env : "");
+    }
+    DistributedWork *work = (DistributedWork *)malloc(sizeof(DistributedWork));
+    if (work == NULL) {
+        server_send_json(client_fd, "{\"error\": \"Out of memory\"}", 500);
+        return;
+    }
+    work->digits = digits;
+    work->node_count = cluster_parse_nodes(list, work->nodes, CLUSTER_MAX_NODES);
+    if (work->node_count == 0) {
+        free(work);
+        server_send_json(client_fd,
+            "{\"error\": \"No nodes: set PI_NODES (?nodes= picks among them)\"}", 400);
+        return;
+    }
+    int unknown = cluster_first_unknown_node(work->nodes, work->node_count, configured, configured_count);
+    if (unknown >= 0) {
+        char json_error[CLUSTER_NODE_LENGTH + 128];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"Node is not in PI_NODES\", \"node\": \"%s\"}",
+            work->nodes[unknown]
+        );
+        free(work);
+        server_send_json(client_fd, json_error, 403);
+        return;
+    }
+    if (work->node_count > chudnovsky_bs_terms(digits)) {
+        free(work);
+        server_send_json(client_fd, "{\"error\": \"More nodes than terms for these digits\"}", 400);
+        return;
+    }
+    // PI_NODES may list this server itself
+    cluster_localize_nodes(work->nodes, work->node_count, self_address, self_port);
+
+    if (__atomic_add_fetch(&distributed_runs_running, 1, __ATOMIC_ACQ_REL) > CLUSTER_MAX_RUNS) {
+        __atomic_sub_fetch(&distributed_runs_running, 1, __ATOMIC_ACQ_REL);
+        free(work);
+        server_send_json(client_fd, "{\"error\": \"Too many distributed runs, try again later\"}", 503);
+        return;
+    }
+    if (start_stream_thread(client_fd, &work->client_fd, distributed_thread, work) != 0) {
+        free(work);
+        __atomic_sub_fetch(&distributed_runs_running, 1, __ATOMIC_ACQ_REL);
+        server_send_json(client_fd, "{\"error\": \"Could not start the distributed run\"}", 503);
+    }
+}
+
+// Handle BBP hex digit extraction request
+void server_handle_bbp_hex(int client_fd, const char *query) {
+    char value[32];
+    long long position = 0;
+    long long count = BBP_HEX_DIGITS_PER_EVAL;
+    if (query != NULL && get_query_param(query, "position", value, sizeof(value))) {
+        position = atoll(value);
+    }
+    if (query != NULL && get_query_param(query, "count", value, sizeof(value))) {
+        count = atoll(value);
+    }
+    if (position < 0 || position > BBP_MAX_POSITION || count < 1 || count > BBP_MAX_HEX_COUNT) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"position must be between 0 and %lld, count between 1 and %d\", "
+            "\"position\": %lld, \"count\": %lld}",
+            BBP_MAX_POSITION, BBP_MAX_HEX_COUNT, position, count
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+    // Each evaluation is ~position modular exponentiations
+    long long evaluations = (count + BBP_HEX_DIGITS_PER_EVAL - 1) / BBP_HEX_DIGITS_PER_EVAL;
+    if (position * evaluations > BBP_MAX_WORK) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"position * ceil(count / %d) must be at most %lld\", "
+            "\"position\": %lld, \"count\": %lld}",
+            BBP_HEX_DIGITS_PER_EVAL, BBP_MAX_WORK, position, count
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    char *hex = bbp_hex_digits(position, (int)count);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (hex == NULL) {
+        server_send_json(client_fd, "{\"error\": \"Hex digit extraction failed\"}", 500);
+        return;
+    }
+    double time_seconds = (double)(end.tv_sec - start.tv_sec) +
+                          (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    long long checked = 0;
+    long long correct = reference_check_hex(position, hex, &checked);
+
+    char json_response[BBP_MAX_HEX_COUNT + 256];
+    snprintf(json_response, sizeof(json_response),
+        "{"
+        "\"algorithm\": \"bbp\", "
+        "\"position\": %lld, "
+        "\"count\": %lld, "
+        "\"time_seconds\": %.6f, "
+        "\"threads\": %d, "
+        "\"correct_hex\": %lld, "
+        "\"checked_hex\": %lld, "
+        "\"hex\": \"%s\""
+        "}",
+        position,
+        count,
+        time_seconds,
+        compute_pool_size(),
+        correct,
+        checked,
+        hex
+    );
+    free(hex);
+    server_send_json(client_fd, json_response, 200);
+}
+
+// Close the health "spigot" object with each variant's last run, the
+// spigot's digits/second benchmark; null until a variant has run
+static void append_spigot_json(char *buffer, size_t size) {
+    for (int i = 0; i < SPIGOT_COUNT; i++) {
+        size_t used = strlen(buffer);
+        SpigotStats stats;
+        const char *separator = i + 1 < SPIGOT_COUNT ? ", " : "}}";
+        if (spigot_last_run((SpigotVariant)i, &stats)) {
+            snprintf(buffer + used, size - used,
+                "\"%s\": {\"digits\": %lld, \"time_seconds\": %.6f, "
+                "\"digits_per_second\": %.0f, \"memory_bytes\": %zu}%s",
+                spigot_variant_name((SpigotVariant)i), stats.digits, stats.time_seconds,
+                stats.time_seconds > 0.0 ? (double)stats.digits / stats.time_seconds : 0.0,
+                stats.memory_bytes, separator
+            );
+        } else {
+            snprintf(buffer + used, size - used, "\"%s\": null%s",
+                     spigot_variant_name((SpigotVariant)i), separator);
+        }
+    }
+}
+
+static int send_spigot_chunk(const char *text, size_t length, void *context) {
+    return send_chunk(*(int *)context, text, length) == 0;
+}
+
+typedef struct {
+    int client_fd;  // the stream's own descriptor, closed when it is done
+    SpigotVariant variant;
+    long long digits;
+} SpigotStreamWork;
+
+static int spigot_streams_running;
+
+// The body is one JSON object whose "pi" string arrives chunk by chunk, so
+// memory stays bounded by the spigot state
+static void stream_spigot(int client_fd, SpigotVariant variant, long long digits) {
+    const char *header =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "Connection: close\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "\r\n";
+    char json_part[256];
+    int part_length = snprintf(json_part, sizeof(json_part),
+        "{\"algorithm\": \"spigot\", \"variant\": \"%s\", \"digits\": %lld, \"pi\": \"",
+        spigot_variant_name(variant), digits
+    );
+    if (send_all(client_fd, header, strlen(header)) < 0 ||
+        send_chunk(client_fd, json_part, (size_t)part_length) < 0) {
+        return;
+    }
+
+    SpigotStats stats;
+    if (spigot_stream(variant, digits, send_spigot_chunk, &client_fd, &stats) != 0) {
+        // The client left (or the run failed mid-body): nothing to close cleanly
+        printf("Spigot stream aborted after %lld digits\n", stats.digits);
+        return;
+    }
+
+    part_length = snprintf(json_part, sizeof(json_part),
+        "\", "
+        "\"time_seconds\": %.6f, "
+        "\"digits_per_second\": %.0f, "
+        "\"memory_bytes\": %zu"
+        "}",
+        stats.time_seconds,
+        stats.time_seconds > 0.0 ? (double)stats.digits / stats.time_seconds : 0.0,
+        stats.memory_bytes
+    );
+    if (send_chunk(client_fd, json_part, (size_t)part_length) == 0) {
+        send_chunk(client_fd, NULL, 0);
+    }
+}
+
+// Both spigots are quadratic in digits: streams run off the accept loop
+static void *spigot_stream_thread(void *arg) {
+    SpigotStreamWork *work = (SpigotStreamWork *)arg;
+    stream_spigot(work->client_fd, work->variant, work->digits);
+    close(work->client_fd);
+    free(work);
+    __atomic_sub_fetch(&spigot_streams_running, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+// Handle spigot streaming request. Errors found before streaming starts
+// are plain JSON; the stream itself runs on its own thread, at most
+// SPIGOT_MAX_STREAMS at a time.
+void server_handle_spigot_stream(int client_fd, const char *query) {
+    char value[32];
+    long long digits = SPIGOT_DEFAULT_DIGITS;
+    SpigotVariant variant = SPIGOT_GIBBONS;
+    if (query != NULL && get_query_param(query, "digits", value, sizeof(value))) {
+        digits = atoll(value);
+    }
+    if (digits < 1 || digits > SPIGOT_MAX_DIGITS) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"digits must be between 1 and %lld\", \"digits\": %lld}",
+            SPIGOT_MAX_DIGITS, digits
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+    if (query != NULL && get_query_param(query, "variant", value, sizeof(value)) &&
+        !spigot_variant_from_name(value, &variant)) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"Unknown spigot variant\", \"variant\": \"%s\"}",
+            value
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+
+    if (__atomic_add_fetch(&spigot_streams_running, 1, __ATOMIC_ACQ_REL) > SPIGOT_MAX_STREAMS) {
+        __atomic_sub_fetch(&spigot_streams_running, 1, __ATOMIC_ACQ_REL);
+        server_send_json(client_fd, "{\"error\": \"Too many spigot streams running, try again later\"}", 503);
+        return;
+    }
+    SpigotStreamWork *work = (SpigotStreamWork *)malloc(sizeof(SpigotStreamWork));
+    if (work != NULL) {
+        work->variant = variant;
+        work->digits = digits;
+    }
+    if (work == NULL || start_stream_thread(client_fd, &work->client_fd, spigot_stream_thread, work) != 0) {
+        free(work);
+        __atomic_sub_fetch(&spigot_streams_running, 1, __ATOMIC_ACQ_REL);
+        server_send_json(client_fd, "{\"error\": \"Could not start the spigot stream\"}", 503);
+    }
+}
+
+typedef struct {
+    int client_fd;
+    int sent;  // results so far
+} RaceStream;
+
+typedef struct {
+    int client_fd;  // the race's own descriptor, closed when it is done
+    RaceEntrant entrants[RACE_MAX_ENTRANTS];
+    int count;
+    int digits;
+    double deadline;
+    const char *precision;
+} RaceStreamWork;
+
+static int race_streams_running;
+
+// One finished, saturated or cancelled runner as a "results" element
+static int send_race_runner(const RaceRunner *runner, void *context) {
+    RaceStream *stream = (RaceStream *)context;
+    char json_part[512];
+    char place[16] = "null";
+    if (runner->place > 0) snprintf(place, sizeof(place), "%d", runner->place);
+    int part_length = snprintf(json_part, sizeof(json_part),
+        "%s{\"place\": %s, "
+        "\"algorithm\": \"%s\", "
+        "\"status\": \"%s\", "
+        "\"digits\": %d, "
+        "\"iterations\": %lld, "
+        "\"compute_seconds\": %.6f, "
+        "\"elapsed_seconds\": %.6f}",
+        stream->sent > 0 ? ", " : "",
+        place, runner->name, race_status_name(runner->status), runner->digits,
+        runner->iterations, runner->compute_seconds, runner->elapsed_seconds
+    );
+    stream->sent++;
+    return send_chunk(stream->client_fd, json_part, (size_t)part_length) == 0;
+}
+
+// Enter `name` (or table entry `index` when name is NULL) into the race;
+// 0 if it exists at this precision
+static int add_race_entrant(RaceEntrant *entrants, int *count, const char *name, int index,
+                            const PiPrecision *precision) {
+    if (*count >= RACE_MAX_ENTRANTS) return -1;
+    RaceEntrant *entrant = &entrants[*count];
+    if (precision != NULL) {
+        for (int i = 0; PRECISION_ALGORITHMS[i].name != NULL; i++) {
+            if (name != NULL ? strcmp(name, PRECISION_ALGORITHMS[i].name) != 0 : i != index) continue;
+            CalculatePiWide wide = PRECISION_ALGORITHMS[i].kernels[*precision];
+            if (wide == NULL) return -1;
+            PiKernel kernel = {
+                .func = NULL,
+                .wide = wide,
+                .max_digits = precision_max_digits(*precision),
+                .incremental = NULL,
+                .backend = precision_name(*precision),
+                .counted = NULL
+            };
+            entrant->name = PRECISION_ALGORITHMS[i].name;
+            entrant->kernel = kernel;
+            (*count)++;
+            return 0;
+        }
+        return -1;
+    }
+    for (int i = 0; ALGORITHMS[i].name != NULL; i++) {
+        if (name != NULL ? strcmp(name, ALGORITHMS[i].name) != 0 : i != index) continue;
+        CalculatePi func = ALGORITHMS[i].func;
+        PiKernel kernel = {
+            .func = func,
+            .wide = NULL,
+            .max_digits = MAX_PRECISION_DIGITS,
+            .incremental = pi_incremental_for(func),
+            .backend = "long_double",
+            .counted = machin_counted_for(func)
+        };
+        entrant->name = ALGORITHMS[i].name;
+        entrant->kernel = kernel;
+        (*count)++;
+        return 0;
+    }
+    return -1;
+}
+
+// The race itself: results go out as runners leave it
+static void stream_race(const RaceStreamWork *work) {
+    const char *header =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "Connection: close\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "\r\n";
+    char json_part[512];
+    int part_length = snprintf(json_part, sizeof(json_part),
+        "{\"race\": {\"digits\": %d, \"deadline_seconds\": %.3f, \"precision\": \"%s\", "
+        "\"entrants\": %d, \"threads\": %d}, "
+        "\"results\": [",
+        work->digits, work->deadline, work->precision, work->count, compute_pool_size()
+    );
+    if (send_all(work->client_fd, header, strlen(header)) < 0 ||
+        send_chunk(work->client_fd, json_part, (size_t)part_length) < 0) {
+        return;
+    }
+
+    RaceRunner runners[RACE_MAX_ENTRANTS];
+    RaceStream stream = {work->client_fd, 0};
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int finishers = race_run(work->entrants, work->count, work->digits, work->deadline,
+                             send_race_runner, &stream, runners);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (stream.sent < work->count) {
+        // The client left: the rest of the race was called off
+        printf("Race abandoned after %d of %d results\n", stream.sent, work->count);
+        return;
+    }
+
+    const char *winner = NULL;
+    for (int i = 0; i < work->count; i++) {
+        if (runners[i].place == 1) winner = runners[i].name;
+    }
+    char winner_json[64] = "null";
+    if (winner != NULL) snprintf(winner_json, sizeof(winner_json), "\"%s\"", winner);
+    part_length = snprintf(json_part, sizeof(json_part),
+        "], \"finishers\": %d, \"winner\": %s, \"time_seconds\": %.6f}",
+        finishers, winner_json,
+        (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9
+    );
+    if (send_chunk(work->client_fd, json_part, (size_t)part_length) == 0) {
+        send_chunk(work->client_fd, NULL, 0);
+    }
+}
+
+// A race takes up to its deadline: races run off the accept loop
+static void *race_stream_thread(void *arg) {
+    RaceStreamWork *work = (RaceStreamWork *)arg;
+    stream_race(work);
+    close(work->client_fd);
+    free(work);
+    __atomic_sub_fetch(&race_streams_running, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+// Handle /api/race?algorithms=a,b&digits=N&deadline=S[&precision=P]:
+// the algorithms race to N digits on the compute pool and each one is
+// sent, with chunked transfer, as it finishes or drops out. Errors found
+// first are plain JSON; the race runs on its own thread, at most
+// RACE_MAX_STREAMS at a time.
+void server_handle_race(int client_fd, const char *query) {
+    char value[32];
+    PiPrecision precision_value;
+    const PiPrecision *precision = NULL;
+    if (query != NULL && get_query_param(query, "precision", value, sizeof(value))) {
+        if (!precision_from_name(value, &precision_value)) {
+            char json_error[256];
+            snprintf(json_error, sizeof(json_error),
+                "{\"error\": \"Unknown or unsupported precision\", \"precision\": \"%s\"}",
+                value
+            );
+            server_send_json(client_fd, json_error, 400);
+            return;
+        }
+        precision = &precision_value;
+    }
+    int max_digits = precision != NULL ? precision_max_digits(*precision) : MAX_PRECISION_DIGITS;
+
+    int digits = RACE_DEFAULT_DIGITS;
+    if (query != NULL && get_query_param(query, "digits", value, sizeof(value))) digits = atoi(value);
+    if (digits < 1 || digits > max_digits) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"digits must be between 1 and %d\", \"digits\": %d}",
+            max_digits, digits
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+    double deadline = RACE_DEADLINE_SECONDS;
+    if (query != NULL && get_query_param(query, "deadline", value, sizeof(value))) deadline = atof(value);
+    if (!(deadline > 0.0) || deadline > RACE_MAX_DEADLINE_SECONDS) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"deadline must be above 0 and at most %.0f seconds\"}",
+            RACE_MAX_DEADLINE_SECONDS
+        );
+        server_send_json(client_fd, json_error, 400);
+        return;
+    }
+
+    // The listed algorithms, or every one available
+    RaceEntrant entrants[RACE_MAX_ENTRANTS];
+    int count = 0;
+    char list[256];
+    if (query != NULL && get_query_param(query, "algorithms", list, sizeof(list))) {
+        for (char *name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+            if (add_race_entrant(entrants, &count, name, -1, precision) != 0) {
+                char json_error[256];
+                snprintf(json_error, sizeof(json_error),
+                    "{\"error\": \"Unknown algorithm, not available at this precision, or too many\", "
+                    "\"algorithm\": \"%s\"}",
+                    name
+                );
+                server_send_json(client_fd, json_error, 400);
+                return;
+            }
+        }
+    } else {
+        for (int i = 0; count < RACE_MAX_ENTRANTS; i++) {
+            const char *name = precision != NULL ? PRECISION_ALGORITHMS[i].name : ALGORITHMS[i].name;
+            if (name == NULL) break;
+            add_race_entrant(entrants, &count, NULL, i, precision);
+        }
+    }
+    if (count == 0) {
+        server_send_json(client_fd, "{\"error\": \"No algorithms to race\"}", 400);
+        return;
+    }
+
+    if (__atomic_add_fetch(&race_streams_running, 1, __ATOMIC_ACQ_REL) > RACE_MAX_STREAMS) {
+        __atomic_sub_fetch(&race_streams_running, 1, __ATOMIC_ACQ_REL);
+        server_send_json(client_fd, "{\"error\": \"Too many races running, try again later\"}", 503);
+        return;
+    }
+    RaceStreamWork *work = (RaceStreamWork *)malloc(sizeof(RaceStreamWork));
+    if (work != NULL) {
+        memcpy(work->entrants, entrants, (size_t)count * sizeof(RaceEntrant));
+        work->count = count;
+        work->digits = digits;
+        work->deadline = deadline;
+        work->precision = precision != NULL ? precision_name(*precision) : "long_double";
+    }
+    if (work == NULL || start_stream_thread(client_fd, &work->client_fd, race_stream_thread, work) != 0) {
+        free(work);
+        __atomic_sub_fetch(&race_streams_running, 1, __ATOMIC_ACQ_REL);
+        server_send_json(client_fd, "{\"error\": \"Could not start the race\"}", 503);
+    }
+}
+
+// Value of request header `name` (case-insensitive); 0 if absent
+static int get_header(const char *request, const char *name, char *value, size_t value_size) {
+    size_t name_length = strlen(name);
+    const char *line = strstr(request, "\r\n");
+    while (line != NULL && line[2] != '\r' && line[2] != '\0') {
+        line += 2;
+        if (strncasecmp(line, name, name_length) == 0 && line[name_length] == ':') {
+            const char *start = line + name_length + 1;
+            while (*start == ' ' || *start == '\t') start++;
+            const char *end = strstr(start, "\r\n");
+            size_t length = end != NULL ? (size_t)(end - start) : strlen(start);
+            if (length >= value_size) length = value_size - 1;
+            memcpy(value, start, length);
+            value[length] = '\0';
+            return 1;
+        }
+        line = strstr(line, "\r\n");
+    }
+    return 0;
+}
+
+// Send [first, first + length) of fd; the kernel copies file to socket
+static int send_file_range(int client_fd, int fd, size_t first, size_t length) {
+    off_t offset = (off_t)first;
+    while (length > 0) {
+        ssize_t sent = sendfile(client_fd, fd, &offset, length);
+        if (sent <= 0) return -1;
+        length -= (size_t)sent;
+    }
+    return 0;
+}
+
+typedef struct {
+    int client_fd;  // the download's own descriptor, closed when it is done
+    int fd;         // the result file
+    size_t first;
+    size_t length;
+    size_t header_length;
+    char header[BUFFER_SIZE];
+} DownloadWork;
+
+static int downloads_running;
+
+// A stalled client times out its own send instead of holding the thread
+static void *download_thread(void *arg) {
+    DownloadWork *work = (DownloadWork *)arg;
+    struct timeval timeout = {RESULTS_SEND_TIMEOUT_SECONDS, 0};
+    setsockopt(work->client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    if (send_all(work->client_fd, work->header, work->header_length) == 0) {
+        send_file_range(work->client_fd, work->fd, work->first, work->length);
+    }
+    close(work->fd);
+    close(work->client_fd);
+    free(work);
+    __atomic_sub_fetch(&downloads_running, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+// Handle download of a stored result. A Range request gets that slice of
+// the plain text; otherwise a client accepting gzip gets the compressed copy.
+// The body goes out on its own thread, at most RESULTS_MAX_DOWNLOADS at a
+// time, so a slow client does not hold up the accept loop.
+void server_handle_result_download(int client_fd, const char *request, const char *id) {
+    char range[128], encoding[256];
+    int has_range = get_header(request, "Range", range, sizeof(range));
+    int wants_gzip = !has_range && get_header(request, "Accept-Encoding", encoding, sizeof(encoding)) &&
+                     strstr(encoding, "gzip") != NULL;
+
+    size_t size = 0;
+    int fd = wants_gzip ? results_store_open_file(id, 1, &size) : -1;
+    int gzip = fd >= 0;
+    if (!gzip) fd = results_store_open_file(id, 0, &size);
+    if (fd < 0) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"Result not found\", \"id\": \"%.*s\"}",
+            RESULTS_ID_LENGTH - 1, id
+        );
+        server_send_json(client_fd, json_error, 404);
+        return;
+    }
+
+    size_t first = 0, last = size > 0 ? size - 1 : 0;
+    int ranged = has_range ? results_parse_range(range, size, &first, &last) : -1;
+    char header[BUFFER_SIZE];
+    int header_length;
+    if (ranged == 0) {
+        header_length = snprintf(header, sizeof(header),
+            "HTTP/1.1 416 Range Not Satisfiable\r\n"
+            "Content-Range: bytes */%zu\r\n"
+            "Content-Length: 0\r\n"
+            "Connection: close\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "\r\n",
+            size
+        );
+        send_all(client_fd, header, (size_t)header_length);
+        close(fd);
+        return;
+    }
+
+    size_t length = size > 0 ? last - first + 1 : 0;
+    char content_range[96] = "";
+    if (ranged == 1) {
+        snprintf(content_range, sizeof(content_range), "Content-Range: bytes %zu-%zu/%zu\r\n",
+                 first, last, size);
+    }
+    header_length = snprintf(header, sizeof(header),
+        "HTTP/1.1 %s\r\n"
+        "Content-Type: text/plain\r\n"
+        "%s"
+        "%s"
+        "Content-Length: %zu\r\n"
+        "Accept-Ranges: bytes\r\n"
+        "Vary: Accept-Encoding\r\n"
+        "Connection: close\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "\r\n",
+        ranged == 1 ? "206 Partial Content" : "200 OK",
+        gzip ? "Content-Encoding: gzip\r\n" : "",
+        content_range,
+        length
+    );
+    if (strncmp(request, "HEAD ", 5) == 0) {
+        send_all(client_fd, header, (size_t)header_length);
+        close(fd);
+        return;
+    }
+
+    if (__atomic_add_fetch(&downloads_running, 1, __ATOMIC_ACQ_REL) > RESULTS_MAX_DOWNLOADS) {
+        __atomic_sub_fetch(&downloads_running, 1, __ATOMIC_ACQ_REL);
+        close(fd);
+        server_send_json(client_fd, "{\"error\": \"Too many downloads running, try again later\"}", 503);
+        return;
+    }
+    DownloadWork *work = (DownloadWork *)malloc(sizeof(DownloadWork));
+    if (work != NULL) {
+        work->fd = fd;
+        work->first = first;
+        work->length = length;
+        work->header_length = (size_t)header_length;
+        memcpy(work->header, header, (size_t)header_length);
+    }
+    if (work == NULL || start_stream_thread(client_fd, &work->client_fd, download_thread, work) != 0) {
+        free(work);
+        close(fd);
+        __atomic_sub_fetch(&downloads_running, 1, __ATOMIC_ACQ_REL);
+        server_send_json(client_fd, "{\"error\": \"Could not start the download\"}", 503);
+    }
+}
+
+///////////////// Jobs /////////////////
+static void send_job_json(int client_fd, const char *id, int status_code) {
+    JobInfo info;
+    if (jobs_info(id, &info) != 0) {
+        char json_error[256];
+        snprintf(json_error, sizeof(json_error),
+            "{\"error\": \"Job not found\", \"id\": \"%.*s\"}",
+            RESULTS_ID_LENGTH - 1, id
+        );
+        server_send_json(client_fd, json_error, 404);
+        return;
+    }
+    char json_response[1024];
+    int length = snprintf(json_response, sizeof(json_response),
+        "{"
+        "\"job_id\": \"%s\", "
+        "\"algorithm\": \"%s\", "
+        "\"digits\": %lld, "
+        "\"status\": \"%s\", "
+        "\"progress\": %.4f, "
+        "\"elapsed_seconds\": %.3f, "
+        "\"resumed\": %s, "
+        "\"checkpoints\": %d, "
+        "\"checkpoint_bytes\": %lld, "
+        "\"checkpoint_seconds\": %.6f, "
+        "\"checkpoint_overhead\": %.6f",
+        info.id,
+        info.algorithm,
+        info.digits,
+        job_status_name(info.status),
+        info.progress,
+        info.elapsed_seconds,
+        info.resumed ? "true" : "false",
+        info.checkpoints,
+        info.checkpoint_bytes,
+        info.checkpoint_seconds,
+        info.elapsed_seconds > 0.0 ? info.checkpoint_seconds / info.elapsed_seconds : 0.0
+    );
+    if (info.status == JOB_DONE) {
+        snprintf(json_response + length, sizeof(json_response) - (size_t)length,
+            ", "
+            "\"correct_digits\": %lld, "
+            "\"checked_digits\": %lld, "
+            "\"result_id\": \"%s\", "
+            "\"download\": \"/api/results/%s/digits\""
+            "}",
+            info.correct_digits, info.checked_digits, info.result_id, info.result_id
+        );
+    } else {
+        snprintf(json_response + length, sizeof(json_response) - (size_t)length, "}");
+    }
+    server_send_json(client_fd, json_response, status_code);
+}
+
+void server_handle_jobs(int client_fd, const char *method, char *path) {
+    // Split "/api/jobs[/<id>[/<action>]][?<query>]"
+    char *query = strchr(path, '?');
+    if (query != NULL) *query++ = '\0';
+    char *id = path[9] == '/' ? path + 10 : NULL;  // Skip "/api/jobs/"
+    char *action = id != NULL ? strchr(id, '/') : NULL;
+    if (action != NULL) *action++ = '\0';
+    int post = strcmp(method, "POST") == 0;
+
+    if (id == NULL || id[0] == '\0') {
+        if (!post) {
+            server_send_json(client_fd, "{\"error\": \"Method not allowed\", \"allow\": \"POST\"}", 405);
+            return;
+        }
+        char algorithm[CHECKPOINT_NAME_LENGTH] = "chudnovsky_bs", value[32];
+        long long digits = 1000;
+        if (query != NULL) {
+            get_query_param(query, "algorithm", algorithm, sizeof(algorithm));
+            if (get_query_param(query, "digits", value, sizeof(value))) digits = atoll(value);
+        }
+        char job_id[RESULTS_ID_LENGTH];
+        int status = jobs_start(algorithm, digits, job_id);
+        if (status == -1) {
+            char json_error[256];
+            snprintf(json_error, sizeof(json_error),
+                "{\"error\": \"Unknown algorithm or digits outside 1..%lld\", "
+                "\"algorithm\": \"%s\", \"digits\": %lld}",
+                MAX_MP_DIGITS, algorithm, digits
+            );
+            server_send_json(client_fd, json_error, 400);
+        } else if (status != 0) {
+            server_send_json(client_fd, "{\"error\": \"No job slot available\"}", 503);
+        } else {
+            send_job_json(client_fd, job_id, 202);
+        }
+        return;
+    }
+
+    if (action == NULL) {
+        send_job_json(client_fd, id, 200);
+    } else if (!post && (strcmp(action, "stop") == 0 || strcmp(action, "resume") == 0)) {
+        server_send_json(client_fd, "{\"error\": \"Method not allowed\", \"allow\": \"POST\"}", 405);
+    } else if (strcmp(action, "stop") == 0) {
+        if (jobs_stop(id) != 0) {
+            server_send_json(client_fd, "{\"error\": \"Job is not running\"}", 409);
+        } else {
+            send_job_json(client_fd, id, 202);
+        }
+    } else if (strcmp(action, "resume") == 0) {
+        int status = jobs_resume(id);
+        if (status == -1) {
+            server_send_json(client_fd, "{\"error\": \"No checkpoint to resume\"}", 404);
+        } else if (status != 0) {
+            server_send_json(client_fd, "{\"error\": \"Job is running or no slot is available\"}", 409);
+        } else {
+            send_job_json(client_fd, id, 202);
+        }
+    } else {
+        server_send_json(client_fd, "{\"error\": \"Route not found\"}", 404);
+    }
+}
+
 // Handle client connection
 void server_handle_client(int client_fd) {
     char buffer[BUFFER_SIZE] = {0};
@@ -175,21 +1495,81 @@ void server_handle_client(int client_fd) {
     }
     else if (strcmp(path, "/api/health") == 0) {
         // 🆕 NUEVO ENDPOINT DE HEALTH CHECK
-        char json_response[256];
+        char json_response[2048];
         snprintf(json_response, sizeof(json_response),
             "{\"status\": \"ok\", "
             "\"service\": \"Pi Calculator C Server\", "
             "\"timestamp\": %ld, "
-            "\"algorithms_available\": %zu}",
+            "\"algorithms_available\": %zu, "
+            "\"cpu_level\": \"%s\", "
+            "\"cpu_detected_level\": \"%s\", "
+            "\"kernel_variants\": {\"ntt\": \"%s\", \"mismatch\": \"%s\"}, "
+            "\"calibration_profiles\": %d, "
+            "\"reference_digits\": {\"decimal\": %lld, \"hex\": %lld}, "
+            "\"out_of_core\": {\"memory_limit\": %zu, \"spilled_bytes\": %zu, \"spilled_peak\": %zu}, "
+            "\"spigot\": {",
             time(NULL),
-            sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]) - 1
+            sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]) - 1,
+            cpu_level_name(cpu_level()),
+            cpu_level_name(cpu_detected_level()),
+            mp_ntt_kernel_name(),
+            reference_mismatch_kernel_name(),
+            profile_store_count(),
+            reference_decimal_digits(),
+            reference_hex_digits(),
+            mp_memory_limit(),
+            mp_spilled_bytes(),
+            mp_spilled_peak()
         );
+        append_spigot_json(json_response, sizeof(json_response));
         server_send_json(client_fd, json_response, 200);
     }
     else if (strncmp(path, "/api/pi/", 8) == 0) {
-        // Extract algorithm name from path
-        const char *algorithm = path + 8;  // Skip "/api/pi/"
-        server_handle_algorithm(client_fd, algorithm);
+        // Split "/api/pi/<algorithm>[/<action>][?<query>]"
+        char *query = strchr(path, '?');
+        if (query != NULL) *query++ = '\0';
+        char *algorithm = path + 8;  // Skip "/api/pi/"
+        char *action = strchr(algorithm, '/');
+        if (action != NULL) *action++ = '\0';
+
+        if (action == NULL) {
+            server_handle_algorithm(client_fd, algorithm, query);
+        } else if (strcmp(action, "digits") == 0) {
+            server_handle_digits(client_fd, algorithm, query);
+        } else if (strcmp(action, "partial") == 0) {
+            server_handle_partial(client_fd, algorithm, query);
+        } else if (strcmp(action, "distributed") == 0 && strcmp(algorithm, "chudnovsky_bs") == 0) {
+            server_handle_distributed(client_fd, query);
+        } else if (strcmp(action, "hex") == 0 && strcmp(algorithm, "bbp") == 0) {
+            server_handle_bbp_hex(client_fd, query);
+        } else if (strcmp(action, "stream") == 0 && strcmp(algorithm, "spigot") == 0) {
+            server_handle_spigot_stream(client_fd, query);
+        } else {
+            char json_error[512];
+            snprintf(json_error, sizeof(json_error),
+                "{\"error\": \"Route not found\", \"action\": \"%s\"}",
+                action
+            );
+            server_send_json(client_fd, json_error, 404);
+        }
+    }
+    else if (strncmp(path, "/api/race", 9) == 0 && (path[9] == '\0' || path[9] == '?')) {
+        server_handle_race(client_fd, path[9] == '?' ? path + 10 : NULL);
+    }
+    else if (strncmp(path, "/api/jobs", 9) == 0 &&
+             (path[9] == '\0' || path[9] == '/' || path[9] == '?')) {
+        server_handle_jobs(client_fd, method, path);
+    }
+    else if (strncmp(path, "/api/results/", 13) == 0) {
+        // "/api/results/<id>/digits"
+        char *id = path + 13;
+        char *action = strchr(id, '/');
+        if (action != NULL) *action++ = '\0';
+        if (action != NULL && strcmp(action, "digits") == 0) {
+            server_handle_result_download(client_fd, buffer, id);
+        } else {
+            server_send_json(client_fd, "{\"error\": \"Route not found\"}", 404);
+        }
     }
     else {
         char json_error[512];
@@ -206,7 +1586,7 @@ void server_handle_client(int client_fd) {
 // Start server main loop
 void server_start(Server *srv) {
     srv->running = 1;
-    printf("Server listening on http://%s:%d\n", IP_ADDRESS, srv->port);
+    printf("Server listening on http://%s:%d\n", srv->address, srv->port);
     printf("Press Ctrl+C to stop\n\n");
     
     struct sockaddr_in client_addr;
@@ -236,4 +1616,9 @@ void server_cleanup(Server *srv) {
         close(srv->socket_fd);
         printf("\nServer closed successfully\n");
     }
+    profile_store_close();
+    // Running jobs checkpoint before their results store goes away
+    jobs_close();
+    reference_store_close();
+    results_store_close();
 }
\ No newline at end of file
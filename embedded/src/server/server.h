@@ -12,10 +12,23 @@
 #include <math.h>
 
 #include "../pi/pi_optimization.h"
+#include "../pi/pi_multiprecision.h"
+#include "../pi/pi_bbp.h"
+#include "../pi/pi_precision.h"
+#include "../pi/pi_accel.h"
+#include "../pi/pi_spigot.h"
+#include "../pi/pi_reference.h"
+#include "../pi/pi_race.h"
+#include "results.h"
+#include "jobs.h"
+#include "cluster.h"
+#include "../mp/mp_ntt.h"
+#include "../cpu/cpu_features.h"
 #include "../constants.h"
 // Struct for server configuration
 typedef struct {
     int socket_fd;
+    const char *address;  // IPv4 address to bind
     int port;
     int running;
 } Server;
@@ -39,6 +52,62 @@ static const AlgorithmEntry ALGORITHMS[] = {
     {"gauss_legendre", gauss_legendre},
     {"bbp", bbp},
     {"borwein", borwein},
+    {"machin", machin},
+    {"takano", takano},
+    {"stormer", stormer},
+    {NULL, NULL}  // Sentinel
+};
+
+// Type-generic kernels, served at /api/pi/{name}?precision=float|double|
+// long_double|float128|dd|qd; without ?precision= the table above is used
+typedef struct {
+    const char *name;
+    CalculatePiWide kernels[PRECISION_COUNT];  // indexed by PiPrecision
+} PrecisionAlgorithmEntry;
+
+static const PrecisionAlgorithmEntry PRECISION_ALGORITHMS[] = {
+    {"leibniz", PI_PRECISION_KERNELS(leibniz)},
+    {"euler", PI_PRECISION_KERNELS(euler)},
+    {"nilakantha", PI_PRECISION_KERNELS(nilakantha)},
+    {"ramanujan_fast", PI_PRECISION_KERNELS(ramanujan)},
+    {"chudnovsky_fast", PI_PRECISION_KERNELS(chudnovsky)},
+    {"gauss_legendre", PI_PRECISION_KERNELS(gauss_legendre)},
+    {"bbp", PI_PRECISION_KERNELS(bbp)},
+    {"borwein", PI_PRECISION_KERNELS(borwein)},
+    {"machin", PI_PRECISION_KERNELS(machin)},
+    {"takano", PI_PRECISION_KERNELS(takano)},
+    {"stormer", PI_PRECISION_KERNELS(stormer)},
+    {NULL, {NULL}}  // Sentinel
+};
+
+// Accelerated series, served at /api/pi/{name}?accel=euler|aitken|
+// richardson|levin
+typedef struct {
+    const char *name;
+    CalculatePiCounted kernels[ACCEL_COUNT];  // indexed by PiAcceleration
+} AccelAlgorithmEntry;
+
+static const AccelAlgorithmEntry ACCEL_ALGORITHMS[] = {
+    {"leibniz", PI_ACCEL_KERNELS(leibniz)},
+    {"nilakantha", PI_ACCEL_KERNELS(nilakantha)},
+    {"euler", PI_ACCEL_KERNELS(euler)},
+    {NULL, {NULL}}  // Sentinel
+};
+
+// Multiprecision digit kernels, served at /api/pi/{name}/digits?digits=N
+typedef struct {
+    const char *name;
+    CalculatePiDigits func;
+} DigitsAlgorithmEntry;
+
+static const DigitsAlgorithmEntry DIGITS_ALGORITHMS[] = {
+    {"chudnovsky", chudnovsky_digits},
+    {"chudnovsky_bs", chudnovsky_bs_digits},
+    {"gauss_legendre", gauss_legendre_digits},
+    {"borwein", borwein_digits},
+    {"machin", machin_digits},
+    {"takano", takano_digits},
+    {"stormer", stormer_digits},
     {NULL, NULL}  // Sentinel
 };
 
@@ -53,7 +122,43 @@ void server_start(Server *srv);
 void server_handle_client(int client_fd);
 
 // Handle algorithm calculation request
-void server_handle_algorithm(int client_fd, const char *algorithm);
+void server_handle_algorithm(int client_fd, const char *algorithm, const char *query);
+
+// Handle multiprecision digits request
+void server_handle_digits(int client_fd, const char *algorithm, const char *query);
+
+// Handle a binary-splitting term range for a coordinator at
+// /api/pi/chudnovsky_bs/partial?start=A&end=B, sent as binary P/Q/T
+void server_handle_partial(int client_fd, const char *algorithm, const char *query);
+
+// Handle /api/pi/chudnovsky_bs/distributed?digits=N&nodes=host:port,...,
+// with the term ranges farmed out to the nodes (default: PI_NODES). Nodes
+// other than "local" must be in PI_NODES, so clients cannot point the
+// server at arbitrary hosts; a node naming this server runs as "local".
+// The coordinator runs on its own thread, at most CLUSTER_MAX_RUNS.
+void server_handle_distributed(int client_fd, const char *query);
+
+// Handle BBP hex digit extraction at /api/pi/bbp/hex?position=N&count=K.
+// It runs on the accept loop, so position * ceil(K / 16) is capped at
+// BBP_MAX_WORK.
+void server_handle_bbp_hex(int client_fd, const char *query);
+
+// Handle spigot streaming at /api/pi/spigot/stream?digits=N&variant=V,
+// sent with chunked transfer as the digits are found
+void server_handle_spigot_stream(int client_fd, const char *query);
+
+// Handle a race at /api/race?algorithms=a,b&digits=N&deadline=S: each
+// runner is streamed (chunked) as it finishes, saturates or is cancelled
+void server_handle_race(int client_fd, const char *query);
+
+// Handle download of a stored result at /api/results/<id>/digits, with
+// Range and gzip taken from the request headers. The body is sent on its
+// own thread (at most RESULTS_MAX_DOWNLOADS), with a send timeout.
+void server_handle_result_download(int client_fd, const char *request, const char *id);
+
+// Handle background jobs: POST /api/jobs?algorithm=A&digits=N starts one,
+// GET /api/jobs/<id> reports it, POST /api/jobs/<id>/stop|resume
+void server_handle_jobs(int client_fd, const char *method, char *path);
 
 // Send JSON response
 void server_send_json(int client_fd, const char *json_body, int status_code);
@@ -0,0 +1,204 @@
+#include "test_cluster.h"
+#include <string.h>
+#include <pthread.h>
+
+// ============= Partial Encoding Tests =============
+
+void test_partial_round_trip(void) {
+    MpInt in[3], out[3];
+    for (int i = 0; i < 3; i++) {
+        mp_init(&in[i]);
+        mp_init(&out[i]);
+    }
+    mp_set_decimal(&in[0], "123456789012345678901234567890123456789");
+    mp_set_si(&in[1], 0);
+    mp_set_decimal(&in[2], "-98765432109876543210");
+    const MpInt *values[3] = {&in[0], &in[1], &in[2]};
+    size_t length = 0;
+    unsigned char *data = partial_encode(7, 19, values, 3, &length);
+    TEST_ASSERT_NOT_NULL(data);
+
+    long long start = 0, end = 0;
+    TEST_ASSERT_EQUAL_INT(3, partial_decode(data, length, &start, &end, out, 3));
+    TEST_ASSERT_EQUAL_INT64(7, start);
+    TEST_ASSERT_EQUAL_INT64(19, end);
+    for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_INT(0, mp_cmp(&in[i], &out[i]));
+
+    free(data);
+    for (int i = 0; i < 3; i++) {
+        mp_clear(&in[i]);
+        mp_clear(&out[i]);
+    }
+}
+
+void test_partial_rejects_damage(void) {
+    MpInt in, out[2];
+    mp_init(&in);
+    mp_init(&out[0]);
+    mp_init(&out[1]);
+    mp_set_decimal(&in, "31415926535897932384626433832795");
+    const MpInt *values[2] = {&in, &in};
+    size_t length = 0;
+    unsigned char *data = partial_encode(0, 4, values, 2, &length);
+    TEST_ASSERT_NOT_NULL(data);
+
+    long long start, end;
+    TEST_ASSERT_EQUAL_INT(-1, partial_decode(data, length - 1, &start, &end, out, 2));
+    TEST_ASSERT_EQUAL_INT(-1, partial_decode(data, length, &start, &end, out, 1));
+    data[length / 2] ^= 0x10;
+    TEST_ASSERT_EQUAL_INT(-1, partial_decode(data, length, &start, &end, out, 2));
+    data[length / 2] ^= 0x10;
+    data[0] = 'X';
+    TEST_ASSERT_EQUAL_INT(-1, partial_decode(data, length, &start, &end, out, 2));
+    TEST_ASSERT_NULL(partial_encode(4, 4, values, 2, &length));
+
+    free(data);
+    mp_clear(&in);
+    mp_clear(&out[0]);
+    mp_clear(&out[1]);
+}
+
+// ============= Coordinator Tests =============
+
+void test_cluster_parse_nodes(void) {
+    char nodes[3][CLUSTER_NODE_LENGTH];
+    TEST_ASSERT_EQUAL_INT(2, cluster_parse_nodes("10.0.0.1:8080,,local", nodes, 3));
+    TEST_ASSERT_EQUAL_STRING("10.0.0.1:8080", nodes[0]);
+    TEST_ASSERT_EQUAL_STRING("local", nodes[1]);
+    TEST_ASSERT_EQUAL_INT(1, cluster_parse_nodes("a\"b:1,host:2", nodes, 3));
+    TEST_ASSERT_EQUAL_STRING("host:2", nodes[0]);
+    TEST_ASSERT_EQUAL_INT(3, cluster_parse_nodes("a:1,b:2,c:3,d:4", nodes, 3));
+    TEST_ASSERT_EQUAL_INT(0, cluster_parse_nodes("", nodes, 3));
+}
+
+void test_cluster_only_configured_nodes(void) {
+    char allowed[2][CLUSTER_NODE_LENGTH] = {"10.0.0.1:8080", "10.0.0.2:8080"};
+    char nodes[3][CLUSTER_NODE_LENGTH] = {"10.0.0.2:8080", "local", "10.0.0.2:8080"};
+    TEST_ASSERT_EQUAL_INT(-1, cluster_first_unknown_node(nodes, 3, allowed, 2));
+    snprintf(nodes[2], CLUSTER_NODE_LENGTH, "169.254.169.254:80");
+    TEST_ASSERT_EQUAL_INT(2, cluster_first_unknown_node(nodes, 3, allowed, 2));
+    TEST_ASSERT_EQUAL_INT(0, cluster_first_unknown_node(nodes, 3, allowed, 0));
+    snprintf(nodes[0], CLUSTER_NODE_LENGTH, "local");
+    TEST_ASSERT_EQUAL_INT(-1, cluster_first_unknown_node(nodes, 2, allowed, 0));
+}
+
+void test_cluster_localize_self_nodes(void) {
+    char nodes[5][CLUSTER_NODE_LENGTH] = {
+        "10.0.0.1:8080", "10.0.0.1:8081", "localhost:8080", "10.0.0.2:8080", "local"
+    };
+    TEST_ASSERT_EQUAL_INT(1, cluster_localize_nodes(nodes, 5, "10.0.0.1", 8080));
+    TEST_ASSERT_EQUAL_STRING("local", nodes[0]);
+    TEST_ASSERT_EQUAL_STRING("10.0.0.1:8081", nodes[1]);
+    TEST_ASSERT_EQUAL_STRING("localhost:8080", nodes[2]);
+    TEST_ASSERT_EQUAL_STRING("10.0.0.2:8080", nodes[3]);
+
+    // Bound to any address, loopback names are this server too
+    TEST_ASSERT_EQUAL_INT(1, cluster_localize_nodes(nodes, 5, "0.0.0.0", 8080));
+    TEST_ASSERT_EQUAL_STRING("local", nodes[2]);
+    TEST_ASSERT_EQUAL_STRING("10.0.0.2:8080", nodes[3]);
+}
+
+void test_cluster_unreachable_node_falls_back(void) {
+    char nodes[3][CLUSTER_NODE_LENGTH] = {"local", "127.0.0.1:1", "local"};
+    ClusterPart parts[3];
+    char *expected = chudnovsky_bs_digits(3000);
+    char *digits = cluster_chudnovsky_digits(3000, nodes, 3, parts);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(expected, digits);
+
+    TEST_ASSERT_EQUAL_INT64(0, parts[0].start);
+    TEST_ASSERT_EQUAL_INT64(parts[0].end, parts[1].start);
+    TEST_ASSERT_EQUAL_INT64(parts[1].end, parts[2].start);
+    TEST_ASSERT_EQUAL_INT64(chudnovsky_bs_terms(3000), parts[2].end);
+    TEST_ASSERT_EQUAL_INT(0, parts[1].remote);
+    TEST_ASSERT_EQUAL_STRING("no response", parts[1].error);
+    TEST_ASSERT_NULL(cluster_chudnovsky_digits(3, nodes, 3, parts));
+    free(expected);
+    free(digits);
+}
+
+typedef struct {
+    int listen_fd;
+    int connections;
+} LoopbackServer;
+
+static void *loopback_thread(void *arg) {
+    LoopbackServer *server = (LoopbackServer *)arg;
+    for (int i = 0; i < server->connections; i++) {
+        int client_fd = accept(server->listen_fd, NULL, NULL);
+        if (client_fd < 0) break;
+        server_handle_client(client_fd);
+    }
+    return NULL;
+}
+
+void test_cluster_remote_parts_over_loopback(void) {
+    LoopbackServer server = {socket(AF_INET, SOCK_STREAM, 0), 3};
+    TEST_ASSERT_TRUE(server.listen_fd >= 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;  // any free port
+    TEST_ASSERT_EQUAL_INT(0, bind(server.listen_fd, (struct sockaddr *)&address, sizeof(address)));
+    TEST_ASSERT_EQUAL_INT(0, listen(server.listen_fd, 4));
+    socklen_t address_length = sizeof(address);
+    getsockname(server.listen_fd, (struct sockaddr *)&address, &address_length);
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, loopback_thread, &server));
+
+    char nodes[3][CLUSTER_NODE_LENGTH];
+    snprintf(nodes[0], CLUSTER_NODE_LENGTH, "127.0.0.1:%d", ntohs(address.sin_port));
+    snprintf(nodes[1], CLUSTER_NODE_LENGTH, "local");
+    snprintf(nodes[2], CLUSTER_NODE_LENGTH, "127.0.0.1:%d", ntohs(address.sin_port));
+    ClusterPart parts[3];
+    char *expected = chudnovsky_bs_digits(5000);
+    char *digits = cluster_chudnovsky_digits(5000, nodes, 3, parts);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(expected, digits);
+    TEST_ASSERT_EQUAL_INT(1, parts[0].remote);
+    TEST_ASSERT_EQUAL_INT(0, parts[1].remote);
+    TEST_ASSERT_EQUAL_INT(1, parts[2].remote);
+    TEST_ASSERT_TRUE(parts[2].bytes > 0);
+
+    // Ranges past the largest run are refused, not computed
+    unsigned char *body;
+    size_t length;
+    TEST_ASSERT_EQUAL_INT(400, cluster_http_get(nodes[0], "/api/pi/chudnovsky_bs/partial?start=5&end=5",
+                                                &body, &length));
+    free(body);
+
+    pthread_join(thread, NULL);
+    close(server.listen_fd);
+    free(expected);
+    free(digits);
+}
+
+void test_distributed_runs_off_the_accept_loop(void) {
+    int fds[2];
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    server_handle_distributed(fds[0], "digits=3000&nodes=local,local");
+    close(fds[0]);  // the run has its own copy
+
+    static char response[16384];
+    size_t used = 0;
+    ssize_t n;
+    while ((n = read(fds[1], response + used, sizeof(response) - 1 - used)) > 0) used += (size_t)n;
+    response[used] = '\0';
+    close(fds[1]);
+
+    TEST_ASSERT_NOT_NULL(strstr(response, "HTTP/1.1 200 OK"));
+    TEST_ASSERT_NOT_NULL(strstr(response, "3.14159265358979323846"));
+    TEST_ASSERT_NOT_NULL(strstr(response, "\"node\": \"local\""));
+}
+
+void run_cluster_tests(void) {
+    RUN_TEST(test_partial_round_trip);
+    RUN_TEST(test_partial_rejects_damage);
+    RUN_TEST(test_cluster_parse_nodes);
+    RUN_TEST(test_cluster_only_configured_nodes);
+    RUN_TEST(test_cluster_localize_self_nodes);
+    RUN_TEST(test_cluster_unreachable_node_falls_back);
+    RUN_TEST(test_cluster_remote_parts_over_loopback);
+    RUN_TEST(test_distributed_runs_off_the_accept_loop);
+}
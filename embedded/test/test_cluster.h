@@ -0,0 +1,10 @@
+#ifndef TEST_CLUSTER_H
+#define TEST_CLUSTER_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/server/cluster.h"
+#include "../src/server/server.h"
+
+void run_cluster_tests(void);
+
+#endif
@@ -0,0 +1,89 @@
+#include "test_compute_pool.h"
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    long long lo;
+    long long hi;
+    long long sum;
+} SumRange;
+
+// Recursive fork-join sum of [lo, hi), forking the left half
+static void sum_range(void *arg) {
+    SumRange *range = (SumRange *)arg;
+    if (range->hi - range->lo <= 16) {
+        range->sum = 0;
+        for (long long i = range->lo; i < range->hi; i++) range->sum += i;
+        return;
+    }
+    long long mid = range->lo + (range->hi - range->lo) / 2;
+    SumRange left = {range->lo, mid, 0};
+    SumRange right = {mid, range->hi, 0};
+    PoolTask task;
+    pool_task_spawn(&task, sum_range, &left);
+    sum_range(&right);
+    pool_task_wait(&task);
+    range->sum = left.sum + right.sum;
+}
+
+static void set_flag(void *arg) {
+    *(int *)arg = 1;
+}
+
+static void sleep_200ms(void *arg) {
+    (void)arg;
+    usleep(200000);
+}
+
+static double thread_cpu_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// ============= Compute Pool Tests =============
+
+void test_compute_pool_size_positive(void) {
+    TEST_ASSERT_TRUE(compute_pool_size() >= 1);
+}
+
+void test_pool_task_runs_once_waited(void) {
+    int flag = 0;
+    PoolTask task;
+    pool_task_spawn(&task, set_flag, &flag);
+    pool_task_wait(&task);
+    TEST_ASSERT_EQUAL_INT(1, flag);
+}
+
+void test_pool_nested_fork_join_sum(void) {
+    SumRange range = {0, 100000, 0};
+    sum_range(&range);
+    TEST_ASSERT_TRUE(range.sum == 100000LL * 99999LL / 2);
+}
+
+void test_pool_wait_sleeps_when_nothing_to_steal(void) {
+    PoolTask task;
+    pool_task_spawn(&task, sleep_200ms, NULL);
+    usleep(20000);  // let a worker take it, leaving nothing to steal
+    double start = thread_cpu_seconds();
+    pool_task_wait(&task);
+    TEST_ASSERT_TRUE(thread_cpu_seconds() - start < 0.05);
+}
+
+void test_pool_restart_after_shutdown(void) {
+    compute_pool_shutdown();
+    compute_pool_start(2);
+    TEST_ASSERT_EQUAL_INT(2, compute_pool_size());
+    SumRange range = {0, 5000, 0};
+    sum_range(&range);
+    TEST_ASSERT_TRUE(range.sum == 5000LL * 4999LL / 2);
+    compute_pool_shutdown();
+}
+
+void run_compute_pool_tests(void) {
+    RUN_TEST(test_compute_pool_size_positive);
+    RUN_TEST(test_pool_task_runs_once_waited);
+    RUN_TEST(test_pool_nested_fork_join_sum);
+    RUN_TEST(test_pool_wait_sleeps_when_nothing_to_steal);
+    RUN_TEST(test_pool_restart_after_shutdown);
+}
@@ -0,0 +1,9 @@
+#ifndef TEST_COMPUTE_POOL_H
+#define TEST_COMPUTE_POOL_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pool/compute_pool.h"
+
+void run_compute_pool_tests(void);
+
+#endif
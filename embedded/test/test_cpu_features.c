@@ -0,0 +1,95 @@
+#include "test_cpu_features.h"
+
+// ============= Detection Tests =============
+
+void test_cpu_level_names_roundtrip(void) {
+    for (int i = 0; i < CPU_LEVEL_COUNT; i++) {
+        CpuLevel parsed;
+        TEST_ASSERT_EQUAL_INT(1, cpu_level_from_name(cpu_level_name((CpuLevel)i), &parsed));
+        TEST_ASSERT_EQUAL_INT(i, parsed);
+    }
+    CpuLevel parsed;
+    TEST_ASSERT_EQUAL_INT(0, cpu_level_from_name("mmx", &parsed));
+}
+
+void test_cpu_level_detected(void) {
+    CpuLevel level = cpu_detected_level();
+    TEST_ASSERT_TRUE(level >= CPU_LEVEL_SCALAR && level < CPU_LEVEL_COUNT);
+#if defined(__aarch64__)
+    TEST_ASSERT_EQUAL_INT(CPU_LEVEL_NEON, level);
+#endif
+}
+
+void test_cpu_level_override_rejects_other_architecture(void) {
+#if defined(__x86_64__)
+    TEST_ASSERT_EQUAL_INT(0, cpu_level_override(CPU_LEVEL_NEON));
+#else
+    TEST_ASSERT_EQUAL_INT(0, cpu_level_override(CPU_LEVEL_AVX2));
+#endif
+    TEST_ASSERT_EQUAL_INT(1, cpu_level_override(CPU_LEVEL_SCALAR));
+    TEST_ASSERT_EQUAL_STRING("scalar", mp_ntt_kernel_name());
+    TEST_ASSERT_EQUAL_INT(1, cpu_level_override(cpu_detected_level()));
+}
+
+// ============= Variant Tests =============
+
+static uint32_t test_rng_state = 88675123u;
+
+static uint32_t next_random(void) {
+    test_rng_state ^= test_rng_state << 13;
+    test_rng_state ^= test_rng_state >> 17;
+    test_rng_state ^= test_rng_state << 5;
+    return test_rng_state;
+}
+
+// Every NTT variant the CPU supports must give the scalar product bit for bit
+static void check_variants_match(size_t an, size_t bn, int square) {
+    mp_limb_t *a = (mp_limb_t *)malloc(an * sizeof(mp_limb_t));
+    mp_limb_t *b = square ? a : (mp_limb_t *)malloc(bn * sizeof(mp_limb_t));
+    mp_limb_t *expected = (mp_limb_t *)malloc((an + bn) * sizeof(mp_limb_t));
+    mp_limb_t *actual = (mp_limb_t *)malloc((an + bn) * sizeof(mp_limb_t));
+    for (size_t i = 0; i < an; i++) a[i] = next_random();
+    if (!square) {
+        for (size_t i = 0; i < bn; i++) b[i] = next_random();
+    }
+    // All-ones limbs exercise the inputs above p
+    a[0] = 0xFFFFFFFFu;
+
+    TEST_ASSERT_EQUAL_INT(1, cpu_level_override(CPU_LEVEL_SCALAR));
+    mpn_mul_ntt(expected, a, an, b, bn);
+
+    for (int level = CPU_LEVEL_SSE42; level < CPU_LEVEL_COUNT; level++) {
+        if (!cpu_level_override((CpuLevel)level)) continue;
+        memset(actual, 0, (an + bn) * sizeof(mp_limb_t));
+        mpn_mul_ntt(actual, a, an, b, bn);
+        TEST_ASSERT_EQUAL_MEMORY(expected, actual, (an + bn) * sizeof(mp_limb_t));
+    }
+    cpu_level_override(cpu_detected_level());
+
+    free(a);
+    if (!square) free(b);
+    free(expected);
+    free(actual);
+}
+
+void test_ntt_variants_match_scalar(void) {
+    check_variants_match(3000, 2500, 0);
+}
+
+void test_ntt_variants_match_scalar_square(void) {
+    check_variants_match(4096, 4096, 1);
+}
+
+void test_ntt_variants_match_scalar_small(void) {
+    // n = 16: every stage but the first is narrower than an AVX-512 vector
+    check_variants_match(9, 7, 0);
+}
+
+void run_cpu_features_tests(void) {
+    RUN_TEST(test_cpu_level_names_roundtrip);
+    RUN_TEST(test_cpu_level_detected);
+    RUN_TEST(test_cpu_level_override_rejects_other_architecture);
+    RUN_TEST(test_ntt_variants_match_scalar);
+    RUN_TEST(test_ntt_variants_match_scalar_square);
+    RUN_TEST(test_ntt_variants_match_scalar_small);
+}
@@ -0,0 +1,10 @@
+#ifndef TEST_CPU_FEATURES_H
+#define TEST_CPU_FEATURES_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/cpu/cpu_features.h"
+#include "../src/mp/mp_ntt.h"
+
+void run_cpu_features_tests(void);
+
+#endif
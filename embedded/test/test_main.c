@@ -1,7 +1,25 @@
 #include "../libs/Unity/src/unity.h"
 #include "test_pi_calculations.h"
 #include "test_pi_optimization.h"
+#include "test_pi_predictor.h"
+#include "test_pi_profile.h"
+#include "test_pi_extended.h"
+#include "test_pi_precision.h"
+#include "test_pi_accel.h"
+#include "test_pi_machin.h"
+#include "test_pi_spigot.h"
+#include "test_pi_reference.h"
+#include "test_pi_checkpoint.h"
+#include "test_compute_pool.h"
+#include "test_cpu_features.h"
+#include "test_mp_alloc.h"
+#include "test_mp_int.h"
+#include "test_pi_multiprecision.h"
+#include "test_pi_bbp.h"
 #include "test_server.h"
+#include "test_results.h"
+#include "test_cluster.h"
+#include "test_pi_race.h"
 #include <stdio.h>
 
 
@@ -14,8 +32,44 @@ int main(void) {
     run_pi_calculations_tests();
     printf("\n=== PI OPTIMIZATION TESTS ===\n");
     run_pi_optimization_tests();
+    printf("\n=== PI ITERATION PREDICTOR TESTS ===\n");
+    run_pi_predictor_tests();
+    printf("\n=== PI CALIBRATION PROFILE TESTS ===\n");
+    run_pi_profile_tests();
+    printf("\n=== PI EXTENDED PRECISION TESTS ===\n");
+    run_pi_extended_tests();
+    printf("\n=== PI PRECISION TESTS ===\n");
+    run_pi_precision_tests();
+    printf("\n=== PI SERIES ACCELERATION TESTS ===\n");
+    run_pi_accel_tests();
+    printf("\n=== PI MACHIN-LIKE FORMULA TESTS ===\n");
+    run_pi_machin_tests();
+    printf("\n=== PI SPIGOT TESTS ===\n");
+    run_pi_spigot_tests();
+    printf("\n=== PI REFERENCE DIGITS TESTS ===\n");
+    run_pi_reference_tests();
+    printf("\n=== PI CHECKPOINT TESTS ===\n");
+    run_pi_checkpoint_tests();
+    printf("\n=== COMPUTE POOL TESTS ===\n");
+    run_compute_pool_tests();
+    printf("\n=== CPU FEATURE DISPATCH TESTS ===\n");
+    run_cpu_features_tests();
+    printf("\n=== MULTIPRECISION ALLOCATOR TESTS ===\n");
+    run_mp_alloc_tests();
+    printf("\n=== MULTIPRECISION INTEGER TESTS ===\n");
+    run_mp_int_tests();
+    printf("\n=== PI MULTIPRECISION TESTS ===\n");
+    run_pi_multiprecision_tests();
+    printf("\n=== PI BBP TESTS ===\n");
+    run_pi_bbp_tests();
     printf("\n=== SERVER TESTS ===\n");
     run_server_tests();
+    printf("\n=== RESULTS DOWNLOAD TESTS ===\n");
+    run_results_tests();
+    printf("\n=== CLUSTER TESTS ===\n");
+    run_cluster_tests();
+    printf("\n=== PI RACE TESTS ===\n");
+    run_pi_race_tests();
     printf("\n=== ALL TESTS COMPLETED ===\n");
     return UNITY_END();
 }
\ No newline at end of file
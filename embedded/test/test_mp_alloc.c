@@ -0,0 +1,182 @@
+#include "test_mp_alloc.h"
+
+// ============= Limb Pool Tests =============
+
+void test_mp_pool_rounds_to_size_class(void) {
+    size_t capacity = 0;
+    uint32_t *p = mp_pool_alloc(100, &capacity);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL_INT(128, (int)capacity);
+    p[capacity - 1] = 7;
+    mp_pool_free(p);
+}
+
+void test_mp_pool_reuses_freed_buffer(void) {
+    size_t capacity;
+    uint32_t *first = mp_pool_alloc(40, &capacity);
+    mp_pool_free(first);
+    uint32_t *second = mp_pool_alloc(60, &capacity);
+    TEST_ASSERT_TRUE(first == second);
+    mp_pool_free(second);
+}
+
+void test_mp_pool_tracks_memory_in_use(void) {
+    size_t before = mp_memory_in_use();
+    size_t capacity;
+    uint32_t *p = mp_pool_alloc(1000, &capacity);
+    TEST_ASSERT_EQUAL_INT64((long long)(before + capacity * sizeof(uint32_t)), (long long)mp_memory_in_use());
+    mp_pool_free(p);
+    TEST_ASSERT_EQUAL_INT64((long long)before, (long long)mp_memory_in_use());
+}
+
+// ============= Scratch Arena Tests =============
+
+void test_mp_arena_scope_release_rewinds(void) {
+    MpArenaMark outer = mp_arena_mark();
+    unsigned char *a = (unsigned char *)mp_arena_alloc(24);
+    TEST_ASSERT_EQUAL_INT(0, (int)((uintptr_t)a % 16));
+
+    MpArenaMark inner = mp_arena_mark();
+    unsigned char *b = (unsigned char *)mp_arena_alloc(100);
+    mp_arena_release(inner);
+    unsigned char *c = (unsigned char *)mp_arena_alloc(100);
+    TEST_ASSERT_TRUE(b == c);
+
+    mp_arena_release(outer);
+    TEST_ASSERT_TRUE(mp_arena_alloc(24) == a);
+    mp_arena_release(outer);
+}
+
+void test_mp_arena_large_allocation_spans_chunks(void) {
+    size_t before = mp_memory_in_use();
+    MpArenaMark scope = mp_arena_mark();
+    mp_arena_alloc(16);
+    unsigned char *big = (unsigned char *)mp_arena_alloc(MP_ARENA_CHUNK_BYTES * 2);
+    big[MP_ARENA_CHUNK_BYTES * 2 - 1] = 1;
+    TEST_ASSERT_TRUE(mp_memory_in_use() >= before + MP_ARENA_CHUNK_BYTES * 2);
+    mp_arena_release(scope);
+    TEST_ASSERT_EQUAL_INT64((long long)before, (long long)mp_memory_in_use());
+}
+
+void test_mp_memory_peak_survives_release(void) {
+    MpMemoryAccount account = {0, 0};
+    MpMemoryAccount *previous = mp_memory_account_install(&account);
+    MpArenaMark scope = mp_arena_mark();
+    mp_arena_alloc(4096);
+    mp_arena_release(scope);
+    mp_memory_account_install(previous);
+    TEST_ASSERT_EQUAL_INT64(0, (long long)account.in_use);
+    TEST_ASSERT_EQUAL_INT64(4096, (long long)account.peak);
+    TEST_ASSERT_TRUE(mp_memory_peak() >= mp_memory_in_use() + 4096);
+}
+
+typedef struct {
+    uint32_t *buffer;
+} PoolAllocation;
+
+static void allocate_task(void *arg) {
+    PoolAllocation *allocation = (PoolAllocation *)arg;
+    allocation->buffer = mp_pool_alloc(1000, NULL);
+}
+
+static void *allocate_unaccounted(void *arg) {
+    PoolAllocation *allocation = (PoolAllocation *)arg;
+    allocation->buffer = mp_pool_alloc(1 << 16, NULL);
+    return NULL;
+}
+
+void test_mp_memory_account_follows_pool_tasks(void) {
+    // Charged on a worker, credited back from here
+    MpMemoryAccount account = {0, 0};
+    MpMemoryAccount *previous = mp_memory_account_install(&account);
+    PoolAllocation allocations[4];
+    PoolTask tasks[4];
+    for (int i = 0; i < 4; i++) pool_task_spawn(&tasks[i], allocate_task, &allocations[i]);
+    for (int i = 0; i < 4; i++) pool_task_wait(&tasks[i]);
+    TEST_ASSERT_EQUAL_INT64(4 * 1024 * sizeof(uint32_t), (long long)account.in_use);
+    mp_memory_account_install(previous);
+    for (int i = 0; i < 4; i++) mp_pool_free(allocations[i].buffer);
+    TEST_ASSERT_EQUAL_INT64(0, (long long)account.in_use);
+    TEST_ASSERT_EQUAL_INT64(4 * 1024 * sizeof(uint32_t), (long long)account.peak);
+}
+
+void test_mp_memory_accounts_ignore_other_runs(void) {
+    MpMemoryAccount account = {0, 0};
+    MpMemoryAccount *previous = mp_memory_account_install(&account);
+    PoolAllocation other;
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, allocate_unaccounted, &other));
+    pthread_join(thread, NULL);
+    uint32_t *mine = mp_pool_alloc(16, NULL);
+    mp_memory_account_install(previous);
+
+    TEST_ASSERT_EQUAL_INT64(16 * sizeof(uint32_t), (long long)account.peak);
+    mp_pool_free(mine);
+    mp_pool_free(other.buffer);
+    TEST_ASSERT_EQUAL_INT64(0, (long long)account.in_use);
+}
+
+// ============= Out-of-core Tests =============
+
+void test_mp_pool_spills_past_memory_limit(void) {
+    size_t n = MP_SPILL_MIN_BYTES / sizeof(uint32_t) * 2;
+    uint32_t *in_memory = mp_pool_alloc(n, NULL);
+    TEST_ASSERT_FALSE(mp_pool_on_disk(in_memory));
+
+    TEST_ASSERT_EQUAL_INT(0, mp_out_of_core_configure(1, "/tmp/test_mp_spill"));
+    TEST_ASSERT_EQUAL_INT(1, (int)mp_memory_limit());
+    size_t ram_before = mp_memory_in_use();
+    size_t capacity = 0;
+    uint32_t *spilled = mp_pool_alloc(n, &capacity);
+    TEST_ASSERT_TRUE(mp_pool_on_disk(spilled));
+    TEST_ASSERT_EQUAL_INT((int)n, (int)capacity);
+    TEST_ASSERT_EQUAL_INT(0, (int)((uintptr_t)spilled % 16));
+    TEST_ASSERT_EQUAL_INT64((long long)ram_before, (long long)mp_memory_in_use());
+    TEST_ASSERT_TRUE(mp_spilled_bytes() >= n * sizeof(uint32_t));
+
+    // Small buffers never spill
+    uint32_t *small = mp_pool_alloc(100, NULL);
+    TEST_ASSERT_FALSE(mp_pool_on_disk(small));
+    mp_pool_free(small);
+
+    // Evicted pages come back from the file intact
+    for (size_t i = 0; i < n; i++) spilled[i] = (uint32_t)(i * 2654435761u);
+    mp_pool_evict(spilled, 0, n);
+    mp_pool_prefetch(spilled, 0, n);
+    size_t wrong = 0;
+    for (size_t i = 0; i < n; i++) wrong += spilled[i] != (uint32_t)(i * 2654435761u);
+    TEST_ASSERT_EQUAL_INT(0, (int)wrong);
+
+    size_t spilled_bytes = mp_spilled_bytes();
+    mp_pool_free(spilled);
+    TEST_ASSERT_EQUAL_INT64((long long)(spilled_bytes - n * sizeof(uint32_t)), (long long)mp_spilled_bytes());
+
+    // Off again: large buffers stay in RAM
+    TEST_ASSERT_EQUAL_INT(0, mp_out_of_core_configure(0, NULL));
+    TEST_ASSERT_EQUAL_INT(0, (int)mp_memory_limit());
+    uint32_t *again = mp_pool_alloc(n, NULL);
+    TEST_ASSERT_FALSE(mp_pool_on_disk(again));
+    mp_pool_free(again);
+    mp_pool_free(in_memory);
+}
+
+void test_mp_out_of_core_default_limit(void) {
+    TEST_ASSERT_EQUAL_INT(0, mp_out_of_core_configure(0, "/tmp/test_mp_spill"));
+    TEST_ASSERT_TRUE(mp_memory_limit() > 0);
+    // A directory that cannot be created leaves the mode off
+    TEST_ASSERT_EQUAL_INT(-1, mp_out_of_core_configure(0, "/proc/no_such_dir/spill"));
+    TEST_ASSERT_EQUAL_INT(0, (int)mp_memory_limit());
+}
+
+void run_mp_alloc_tests(void) {
+    RUN_TEST(test_mp_pool_rounds_to_size_class);
+    RUN_TEST(test_mp_pool_reuses_freed_buffer);
+    RUN_TEST(test_mp_pool_tracks_memory_in_use);
+    RUN_TEST(test_mp_arena_scope_release_rewinds);
+    RUN_TEST(test_mp_arena_large_allocation_spans_chunks);
+    RUN_TEST(test_mp_memory_peak_survives_release);
+    RUN_TEST(test_mp_memory_account_follows_pool_tasks);
+    RUN_TEST(test_mp_memory_accounts_ignore_other_runs);
+    RUN_TEST(test_mp_pool_spills_past_memory_limit);
+    RUN_TEST(test_mp_out_of_core_default_limit);
+}
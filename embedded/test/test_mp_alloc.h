@@ -0,0 +1,9 @@
+#ifndef TEST_MP_ALLOC_H
+#define TEST_MP_ALLOC_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/mp/mp_alloc.h"
+
+void run_mp_alloc_tests(void);
+
+#endif
@@ -0,0 +1,344 @@
+#include "test_mp_int.h"
+
+// Deterministic xorshift generator for reproducible operands
+static uint32_t test_rng_state = 2463534242u;
+
+static uint32_t next_random(void) {
+    test_rng_state ^= test_rng_state << 13;
+    test_rng_state ^= test_rng_state >> 17;
+    test_rng_state ^= test_rng_state << 5;
+    return test_rng_state;
+}
+
+static void random_mp(MpInt *x, size_t limbs) {
+    mp_set_ui(x, 0);
+    for (size_t i = 0; i < limbs; i++) {
+        mp_shl(x, x, MP_LIMB_BITS);
+        mp_add_ui(x, x, next_random() | (i == 0 ? 1u : 0u));
+    }
+}
+
+// Assert that x prints as the expected decimal string
+static void assert_decimal(const char *expected, const MpInt *x) {
+    char *text = mp_to_decimal(x);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL_STRING(expected, text);
+    free(text);
+}
+
+// ============= Conversion Tests =============
+
+void test_mp_decimal_roundtrip(void) {
+    MpInt x;
+    mp_init(&x);
+    const char *values[] = {"0", "7", "-42", "4294967296", "-123456789012345678901234567890"};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(0, mp_set_decimal(&x, values[i]));
+        assert_decimal(values[i], &x);
+    }
+    mp_clear(&x);
+}
+
+void test_mp_set_decimal_rejects_garbage(void) {
+    MpInt x;
+    mp_init(&x);
+    TEST_ASSERT_EQUAL_INT(-1, mp_set_decimal(&x, "12a4"));
+    TEST_ASSERT_EQUAL_INT(-1, mp_set_decimal(&x, ""));
+    mp_clear(&x);
+}
+
+void test_mp_to_decimal_large_power_of_ten(void) {
+    MpInt x;
+    mp_init(&x);
+    mp_pow_ui(&x, 10, 5000);
+    char *text = mp_to_decimal(&x);
+    TEST_ASSERT_EQUAL_INT(5001, (int)strlen(text));
+    TEST_ASSERT_EQUAL_INT('1', text[0]);
+    int zeros = 1;
+    for (int i = 1; i < 5001; i++) {
+        if (text[i] != '0') zeros = 0;
+    }
+    TEST_ASSERT_TRUE(zeros);
+    free(text);
+    mp_clear(&x);
+}
+
+// ============= Arithmetic Tests =============
+
+void test_mp_add_carry_propagation(void) {
+    MpInt a, b, r;
+    mp_init(&a);
+    mp_init(&b);
+    mp_init(&r);
+    mp_set_decimal(&a, "18446744073709551615");
+    mp_set_ui(&b, 1);
+    mp_add(&r, &a, &b);
+    assert_decimal("18446744073709551616", &r);
+    mp_sub(&r, &r, &a);
+    assert_decimal("1", &r);
+    mp_sub(&r, &b, &a);
+    assert_decimal("-18446744073709551614", &r);
+    mp_clear(&a);
+    mp_clear(&b);
+    mp_clear(&r);
+}
+
+void test_mp_mul_small(void) {
+    MpInt a, b, r;
+    mp_init(&a);
+    mp_init(&b);
+    mp_init(&r);
+    mp_set_ui(&a, 123456789);
+    mp_set_si(&b, -987654321);
+    mp_mul(&r, &a, &b);
+    assert_decimal("-121932631112635269", &r);
+    mp_mul_si(&r, &r, -10000000000LL);
+    assert_decimal("1219326311126352690000000000", &r);
+    mp_clear(&a);
+    mp_clear(&b);
+    mp_clear(&r);
+}
+
+// Check a*b against residues modulo small primes and exact division
+static void check_large_product(size_t an, size_t bn) {
+    const uint32_t primes[] = {4294967291u, 4294967279u, 1000000007u};
+    MpInt a, b, r, q, rem;
+    mp_init(&a);
+    mp_init(&b);
+    mp_init(&r);
+    mp_init(&q);
+    mp_init(&rem);
+    random_mp(&a, an);
+    random_mp(&b, bn);
+    mp_mul(&r, &a, &b);
+
+    for (size_t i = 0; i < sizeof(primes) / sizeof(primes[0]); i++) {
+        uint64_t ra = mp_div_ui(NULL, &a, primes[i]);
+        uint64_t rb = mp_div_ui(NULL, &b, primes[i]);
+        uint64_t rr = mp_div_ui(NULL, &r, primes[i]);
+        TEST_ASSERT_EQUAL_UINT64((ra * rb) % primes[i], rr);
+    }
+
+    mp_divmod(&q, &rem, &r, &b);
+    TEST_ASSERT_TRUE(mp_is_zero(&rem));
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&q, &a));
+
+    mp_clear(&a);
+    mp_clear(&b);
+    mp_clear(&r);
+    mp_clear(&q);
+    mp_clear(&rem);
+}
+
+void test_mp_mul_karatsuba_range(void) {
+    check_large_product(MP_KARATSUBA_THRESHOLD * 2, MP_KARATSUBA_THRESHOLD * 2);
+}
+
+void test_mp_mul_toom3_range(void) {
+    check_large_product(MP_TOOM3_THRESHOLD * 2 + 7, MP_TOOM3_THRESHOLD * 2 + 7);
+}
+
+void test_mp_mul_unbalanced(void) {
+    check_large_product(MP_TOOM3_THRESHOLD * 5, MP_KARATSUBA_THRESHOLD + 3);
+}
+
+void test_mp_mul_ntt_range(void) {
+    check_large_product(MP_NTT_THRESHOLD + 100, MP_NTT_THRESHOLD + 100);
+}
+
+void test_mp_mul_ntt_unbalanced(void) {
+    check_large_product(MP_NTT_THRESHOLD * 3, MP_NTT_THRESHOLD);
+}
+
+void test_mp_mul_ntt_square(void) {
+    MpInt a, sq, q, rem;
+    mp_init(&a);
+    mp_init(&sq);
+    mp_init(&q);
+    mp_init(&rem);
+    random_mp(&a, MP_NTT_THRESHOLD + 1);
+    mp_mul(&sq, &a, &a);
+    mp_sqrt(&q, &sq);
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&q, &a));
+    mp_divmod(&q, &rem, &sq, &a);
+    TEST_ASSERT_TRUE(mp_is_zero(&rem));
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&q, &a));
+    mp_clear(&a);
+    mp_clear(&sq);
+    mp_clear(&q);
+    mp_clear(&rem);
+}
+
+// Past the memory limit products spill to disk and take the blocked
+// transform; they must match the in-memory ones (odd and even log2 n)
+void test_mp_mul_out_of_core_matches(void) {
+    const size_t sizes[2] = {150000, 300000};
+    for (int i = 0; i < 2; i++) {
+        MpInt a, b, in_memory, spilled, square, spilled_square;
+        mp_init(&a);
+        mp_init(&b);
+        mp_init(&in_memory);
+        mp_init(&spilled);
+        mp_init(&square);
+        mp_init(&spilled_square);
+        random_mp(&a, sizes[i]);
+        random_mp(&b, sizes[i] - 1000);
+        mp_mul(&in_memory, &a, &b);
+        mp_mul(&square, &a, &a);
+
+        TEST_ASSERT_EQUAL_INT(0, mp_out_of_core_configure(1, "/tmp/test_mp_spill"));
+        size_t spilled_before = mp_spilled_bytes();
+        mp_mul(&spilled, &a, &b);
+        mp_mul(&spilled_square, &a, &a);
+        TEST_ASSERT_TRUE(mp_spilled_peak() > 0);
+        TEST_ASSERT_TRUE(mp_pool_on_disk(spilled.limbs));
+        TEST_ASSERT_EQUAL_INT(0, mp_cmp(&in_memory, &spilled));
+        TEST_ASSERT_EQUAL_INT(0, mp_cmp(&square, &spilled_square));
+        mp_clear(&spilled);
+        mp_clear(&spilled_square);
+        TEST_ASSERT_EQUAL_INT64((long long)spilled_before, (long long)mp_spilled_bytes());
+        mp_out_of_core_configure(0, NULL);
+
+        mp_clear(&a);
+        mp_clear(&b);
+        mp_clear(&in_memory);
+        mp_clear(&square);
+    }
+}
+
+// ============= Division Tests =============
+
+void test_mp_divmod_truncates_toward_zero(void) {
+    MpInt a, b, q, r;
+    mp_init(&a);
+    mp_init(&b);
+    mp_init(&q);
+    mp_init(&r);
+    mp_set_si(&a, -7);
+    mp_set_si(&b, 2);
+    mp_divmod(&q, &r, &a, &b);
+    assert_decimal("-3", &q);
+    assert_decimal("-1", &r);
+    mp_clear(&a);
+    mp_clear(&b);
+    mp_clear(&q);
+    mp_clear(&r);
+}
+
+void test_mp_divmod_newton_identity(void) {
+    MpInt a, b, q, r, check;
+    mp_init(&a);
+    mp_init(&b);
+    mp_init(&q);
+    mp_init(&r);
+    mp_init(&check);
+    random_mp(&a, MP_NEWTON_DIV_THRESHOLD * 6);
+    random_mp(&b, MP_NEWTON_DIV_THRESHOLD * 2 + 5);
+    mp_divmod(&q, &r, &a, &b);
+
+    // a == q*b + r with 0 <= r < b
+    mp_mul(&check, &q, &b);
+    mp_add(&check, &check, &r);
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&check, &a));
+    TEST_ASSERT_FALSE(r.negative);
+    TEST_ASSERT_TRUE(mp_cmp(&r, &b) < 0);
+
+    mp_clear(&a);
+    mp_clear(&b);
+    mp_clear(&q);
+    mp_clear(&r);
+    mp_clear(&check);
+}
+
+void test_mp_div_ui_remainder(void) {
+    MpInt a, q;
+    mp_init(&a);
+    mp_init(&q);
+    mp_set_decimal(&a, "1000000000000000000007");
+    uint32_t rem = mp_div_ui(&q, &a, 10);
+    TEST_ASSERT_EQUAL_INT(7, rem);
+    assert_decimal("100000000000000000000", &q);
+    mp_clear(&a);
+    mp_clear(&q);
+}
+
+// ============= Shift, Power and Root Tests =============
+
+void test_mp_shift_roundtrip(void) {
+    MpInt a, r;
+    mp_init(&a);
+    mp_init(&r);
+    mp_set_decimal(&a, "987654321987654321987654321");
+    mp_shl(&r, &a, 77);
+    mp_shr(&r, &r, 77);
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&r, &a));
+    mp_clear(&a);
+    mp_clear(&r);
+}
+
+void test_mp_pow_ui(void) {
+    MpInt r;
+    mp_init(&r);
+    mp_pow_ui(&r, 10, 20);
+    assert_decimal("100000000000000000000", &r);
+    mp_pow_ui(&r, 2, 0);
+    assert_decimal("1", &r);
+    mp_clear(&r);
+}
+
+void test_mp_sqrt_small(void) {
+    MpInt a, r;
+    mp_init(&a);
+    mp_init(&r);
+    mp_set_ui(&a, 99);
+    mp_sqrt(&r, &a);
+    assert_decimal("9", &r);
+    mp_set_ui(&a, 100);
+    mp_sqrt(&r, &a);
+    assert_decimal("10", &r);
+    mp_clear(&a);
+    mp_clear(&r);
+}
+
+void test_mp_sqrt_large_boundaries(void) {
+    MpInt x, sq, r;
+    mp_init(&x);
+    mp_init(&sq);
+    mp_init(&r);
+    random_mp(&x, 150);
+    mp_mul(&sq, &x, &x);
+
+    mp_sqrt(&r, &sq);
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&r, &x));
+
+    mp_sub_ui(&sq, &sq, 1);
+    mp_sqrt(&r, &sq);
+    mp_add_ui(&r, &r, 1);
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&r, &x));
+
+    mp_clear(&x);
+    mp_clear(&sq);
+    mp_clear(&r);
+}
+
+void run_mp_int_tests(void) {
+    RUN_TEST(test_mp_decimal_roundtrip);
+    RUN_TEST(test_mp_set_decimal_rejects_garbage);
+    RUN_TEST(test_mp_to_decimal_large_power_of_ten);
+    RUN_TEST(test_mp_add_carry_propagation);
+    RUN_TEST(test_mp_mul_small);
+    RUN_TEST(test_mp_mul_karatsuba_range);
+    RUN_TEST(test_mp_mul_toom3_range);
+    RUN_TEST(test_mp_mul_unbalanced);
+    RUN_TEST(test_mp_mul_ntt_range);
+    RUN_TEST(test_mp_mul_ntt_unbalanced);
+    RUN_TEST(test_mp_mul_ntt_square);
+    RUN_TEST(test_mp_mul_out_of_core_matches);
+    RUN_TEST(test_mp_divmod_truncates_toward_zero);
+    RUN_TEST(test_mp_divmod_newton_identity);
+    RUN_TEST(test_mp_div_ui_remainder);
+    RUN_TEST(test_mp_shift_roundtrip);
+    RUN_TEST(test_mp_pow_ui);
+    RUN_TEST(test_mp_sqrt_small);
+    RUN_TEST(test_mp_sqrt_large_boundaries);
+}
@@ -0,0 +1,9 @@
+#ifndef TEST_MP_INT_H
+#define TEST_MP_INT_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/mp/mp_int.h"
+
+void run_mp_int_tests(void);
+
+#endif
@@ -0,0 +1,84 @@
+#include "test_pi_accel.h"
+
+// ============= Acceleration Name Tests =============
+
+void test_accel_names_roundtrip(void) {
+    for (int i = 0; i < ACCEL_COUNT; i++) {
+        PiAcceleration parsed;
+        TEST_ASSERT_EQUAL_INT(1, accel_from_name(accel_name((PiAcceleration)i), &parsed));
+        TEST_ASSERT_EQUAL_INT(i, parsed);
+    }
+}
+
+void test_accel_rejects_unknown_name(void) {
+    PiAcceleration parsed;
+    TEST_ASSERT_EQUAL_INT(0, accel_from_name("shanks", &parsed));
+    TEST_ASSERT_EQUAL_INT(0, accel_from_name(NULL, &parsed));
+}
+
+// ============= Transform Tests =============
+
+void test_accel_euler_beats_raw_leibniz(void) {
+    long long effective = 0;
+    long double estimate = leibniz_accel_euler(ACCEL_EULER_TERMS, &effective);
+    TEST_ASSERT_EQUAL_INT64(ACCEL_EULER_TERMS, effective);
+    // 64 raw terms give one digit
+    TEST_ASSERT_TRUE(fabsl(estimate - PI_REFERENCE) < 1e-16L);
+}
+
+void test_accel_aitken_alternating_series(void) {
+    long long effective = 0;
+    TEST_ASSERT_TRUE(fabsl(leibniz_accel_aitken(32, &effective) - PI_REFERENCE) < 1e-16L);
+    TEST_ASSERT_TRUE(fabsl(nilakantha_accel_aitken(32, &effective) - PI_REFERENCE) < 1e-16L);
+}
+
+void test_accel_richardson_basel(void) {
+    long long effective = 0;
+    long double estimate = euler_accel_richardson(1000, &effective);
+    // Checkpoints 14, 28, ..., 896: one doubling ladder
+    TEST_ASSERT_EQUAL_INT64(896, effective);
+    TEST_ASSERT_TRUE(fabsl(estimate - PI_REFERENCE) < 1e-13L);
+    TEST_ASSERT_TRUE(fabsl(euler(1000) - PI_REFERENCE) > 1e-4L);
+}
+
+void test_accel_levin_logarithmic_series(void) {
+    long long effective = 0;
+    TEST_ASSERT_TRUE(fabsl(euler_accel_levin(15, &effective) - PI_REFERENCE) < 1e-11L);
+    TEST_ASSERT_TRUE(fabsl(leibniz_accel_levin(ACCEL_LEVIN_TERMS, &effective) - PI_REFERENCE) < 1e-16L);
+}
+
+void test_accel_window_saturates(void) {
+    long long effective = 0;
+    long double at_window = nilakantha_accel_euler(ACCEL_EULER_TERMS, &effective);
+    long double beyond = nilakantha_accel_euler(1000000, &effective);
+    TEST_ASSERT_EQUAL_INT64(ACCEL_EULER_TERMS, effective);
+    TEST_ASSERT_TRUE(at_window == beyond);
+}
+
+void test_accel_zero_terms(void) {
+    long long effective = -1;
+    TEST_ASSERT_EQUAL_FLOAT(0.0, leibniz_accel_levin(0, &effective));
+    TEST_ASSERT_EQUAL_INT64(0, effective);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, euler_accel_richardson(-5, &effective));
+}
+
+// ============= Optimizer Tests =============
+
+void test_optimize_accelerated_kernel(void) {
+    PiKernel kernel = {NULL, NULL, MAX_PRECISION_DIGITS, NULL, "euler", leibniz_accel_euler};
+    PiResult result = optimize_pi_kernel(&kernel, "leibniz", 0.5);
+    TEST_ASSERT_GREATER_OR_EQUAL(16, result.correct_digits);
+    TEST_ASSERT_TRUE(result.iterations <= ACCEL_EULER_TERMS);
+}
+
+void run_pi_accel_tests(void) {
+    RUN_TEST(test_accel_names_roundtrip);
+    RUN_TEST(test_accel_rejects_unknown_name);
+    RUN_TEST(test_accel_euler_beats_raw_leibniz);
+    RUN_TEST(test_accel_aitken_alternating_series);
+    RUN_TEST(test_accel_richardson_basel);
+    RUN_TEST(test_accel_levin_logarithmic_series);
+    RUN_TEST(test_accel_window_saturates);
+    RUN_TEST(test_accel_zero_terms);
+    RUN_TEST(test_optimize_accelerated_kernel);
+}
@@ -0,0 +1,11 @@
+#ifndef TEST_PI_ACCEL_H
+#define TEST_PI_ACCEL_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_accel.h"
+#include "../src/pi/pi_calculations.h"
+#include "../src/pi/pi_optimization.h"
+
+void run_pi_accel_tests(void);
+
+#endif
@@ -0,0 +1,63 @@
+#include "test_pi_bbp.h"
+
+void test_bbp_hex_digits_leading(void) {
+    char *hex = bbp_hex_digits(0, 64);
+    TEST_ASSERT_NOT_NULL(hex);
+    TEST_ASSERT_EQUAL_STRING(PI_HEX_64_DIGITS, hex);
+    free(hex);
+}
+
+void test_bbp_hex_digits_offset_window(void) {
+    char *hex = bbp_hex_digits(5, 20);
+    TEST_ASSERT_NOT_NULL(hex);
+    TEST_ASSERT_EQUAL_STRING_LEN(PI_HEX_64_DIGITS + 5, hex, 20);
+    free(hex);
+}
+
+// Cross-check against the decimal engine: hex-expand its fractional part
+void test_bbp_hex_digits_match_chudnovsky(void) {
+    const long long decimals = 1400;
+    const int position = 1000;
+    const int count = 40;
+    char *digits = chudnovsky_bs_digits(decimals);
+    TEST_ASSERT_NOT_NULL(digits);
+
+    MpInt frac, scale, q;
+    mp_init(&frac);
+    mp_init(&scale);
+    mp_init(&q);
+    mp_set_decimal(&frac, digits + 2);
+    mp_pow_ui(&scale, 10, (uint64_t)decimals);
+
+    char expected[64];
+    for (int i = 0; i < position + count; i++) {
+        mp_mul_ui(&frac, &frac, 16);
+        mp_divmod(&q, &frac, &frac, &scale);
+        if (i >= position) expected[i - position] = "0123456789ABCDEF"[q.size ? q.limbs[0] : 0];
+    }
+    expected[count] = '\0';
+
+    char *hex = bbp_hex_digits(position, count);
+    TEST_ASSERT_NOT_NULL(hex);
+    TEST_ASSERT_EQUAL_STRING(expected, hex);
+
+    free(hex);
+    free(digits);
+    mp_clear(&frac);
+    mp_clear(&scale);
+    mp_clear(&q);
+}
+
+void test_bbp_hex_digits_rejects_out_of_range(void) {
+    TEST_ASSERT_NULL(bbp_hex_digits(-1, 8));
+    TEST_ASSERT_NULL(bbp_hex_digits(BBP_MAX_POSITION + 1, 8));
+    TEST_ASSERT_NULL(bbp_hex_digits(0, 0));
+    TEST_ASSERT_NULL(bbp_hex_digits(0, BBP_MAX_HEX_COUNT + 1));
+}
+
+void run_pi_bbp_tests(void) {
+    RUN_TEST(test_bbp_hex_digits_leading);
+    RUN_TEST(test_bbp_hex_digits_offset_window);
+    RUN_TEST(test_bbp_hex_digits_match_chudnovsky);
+    RUN_TEST(test_bbp_hex_digits_rejects_out_of_range);
+}
@@ -0,0 +1,13 @@
+#ifndef TEST_PI_BBP_H
+#define TEST_PI_BBP_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_bbp.h"
+#include "../src/pi/pi_multiprecision.h"
+
+// First 64 hex digits of pi after the hexadecimal point
+#define PI_HEX_64_DIGITS "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89"
+
+void run_pi_bbp_tests(void);
+
+#endif
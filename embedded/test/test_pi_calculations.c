@@ -79,6 +79,101 @@ void test_single_iteration(void) {
     TEST_ASSERT_EQUAL_FLOAT(4.0, result); // 4 * (1/1) = 4.0
 }
 
+// Test de evaluación incremental
+static void assert_incremental_matches(long double (*func)(long long), long long total) {
+    const PiIncremental *series = pi_incremental_for(func);
+    TEST_ASSERT_NOT_NULL(series);
+
+    PiSeriesState state;
+    series->init(&state);
+    long long done = 0;
+    for (long long step = 1; done < total; step *= 3) {
+        long long slice = step < total - done ? step : total - done;
+        series->advance(&state, slice);
+        done += slice;
+    }
+    TEST_ASSERT_EQUAL_INT64(total, state.count);
+    TEST_ASSERT_TRUE(series->estimate(&state) == func(total));
+}
+
+void test_incremental_matches_one_shot(void) {
+    assert_incremental_matches(leibniz, 1000);
+    assert_incremental_matches(euler, 1000);
+    assert_incremental_matches(euler_kahan, 1000);
+    assert_incremental_matches(nilakantha, 1000);
+    assert_incremental_matches(ramanujan_fast, 4);
+    assert_incremental_matches(chudnovsky_fast, 3);
+    assert_incremental_matches(gauss_legendre, 5);
+    assert_incremental_matches(bbp, 20);
+    assert_incremental_matches(borwein, 4);
+    // Pasado el punto de convergencia
+    assert_incremental_matches(ramanujan_fast, 100);
+    assert_incremental_matches(gauss_legendre, 100);
+    assert_incremental_matches(bbp, 100);
+}
+
+// Test de parada anticipada: las series rápidas se detienen al llegar a la
+// precisión de long double, sin NaN aunque se pidan muchos términos
+void test_early_exit_effective_terms(void) {
+    long double (*funcs[])(long long) = {
+        ramanujan_fast, chudnovsky_fast, gauss_legendre, bbp, borwein
+    };
+    for (size_t i = 0; i < sizeof(funcs) / sizeof(funcs[0]); i++) {
+        long long effective = 0;
+        long double estimate = pi_evaluate(pi_incremental_for(funcs[i]), 1000000, &effective);
+        TEST_ASSERT_TRUE(effective > 0 && effective < 100);
+        TEST_ASSERT_FALSE(isnan(estimate));
+        TEST_ASSERT_TRUE(fabsl(estimate - PI_REFERENCE) < 1e-17L);
+        TEST_ASSERT_TRUE(estimate == funcs[i](effective));
+    }
+}
+
+void test_early_exit_keeps_count(void) {
+    PiSeriesState state;
+    const PiIncremental *series = pi_incremental_for(bbp);
+    series->init(&state);
+    series->advance(&state, 1000);
+    series->advance(&state, 1000);
+    TEST_ASSERT_EQUAL_INT64(2000, state.count);
+    TEST_ASSERT_TRUE(state.effective < 100);
+
+    long long effective = 0;
+    pi_evaluate(pi_incremental_for(leibniz), 1000, &effective);
+    TEST_ASSERT_EQUAL_INT64(1000, effective);
+}
+
+// Nilakantha más allá de k ~ 1e6, donde el denominador desbordaba long long
+void test_nilakantha_large_terms(void) {
+    TEST_ASSERT_TRUE(fabsl(nilakantha(2000000) - PI_REFERENCE) < 1e-17L);
+}
+
+void test_incremental_zero_terms(void) {
+    PiSeriesState state;
+    const PiIncremental *series = pi_incremental_for(chudnovsky_fast);
+    series->init(&state);
+    series->advance(&state, 0);
+    TEST_ASSERT_EQUAL_INT64(0, state.count);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, series->estimate(&state));
+}
+
+void test_incremental_not_for_random_methods(void) {
+    TEST_ASSERT_NULL(pi_incremental_for(monte_carlo));
+    TEST_ASSERT_NULL(pi_incremental_for(buffon));
+    TEST_ASSERT_NULL(pi_incremental_for(pi_coprimes));
+}
+
+void test_random_methods_reproducible_with_seed(void) {
+    long double (*methods[3])(long long) = {monte_carlo, buffon, pi_coprimes};
+    for (int i = 0; i < 3; i++) {
+        pi_random_seed(42);
+        long double first = methods[i](10000);
+        long double unseeded = methods[i](10000);  // the seed moved on
+        pi_random_seed(42);
+        TEST_ASSERT_TRUE(first == methods[i](10000));
+        TEST_ASSERT_TRUE(first != unseeded);
+    }
+}
+
 void run_pi_calculations_tests(void) {
     RUN_TEST(test_leibniz_basic);
     RUN_TEST(test_monte_carlo_basic);
@@ -95,4 +190,11 @@ void run_pi_calculations_tests(void) {
     RUN_TEST(test_methods_consistency);
     RUN_TEST(test_zero_iterations);
     RUN_TEST(test_single_iteration);
+    RUN_TEST(test_incremental_matches_one_shot);
+    RUN_TEST(test_incremental_zero_terms);
+    RUN_TEST(test_incremental_not_for_random_methods);
+    RUN_TEST(test_random_methods_reproducible_with_seed);
+    RUN_TEST(test_early_exit_effective_terms);
+    RUN_TEST(test_early_exit_keeps_count);
+    RUN_TEST(test_nilakantha_large_terms);
 }
\ No newline at end of file
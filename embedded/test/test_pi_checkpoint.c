@@ -0,0 +1,224 @@
+#include "test_pi_checkpoint.h"
+#include <string.h>
+#include <unistd.h>
+
+static const char *TEST_CHECKPOINT_PATH = "/tmp/test_pi_checkpoint.ckpt";
+
+static void fill_state(CheckpointState *state, const char *algorithm, long long done, int count) {
+    memset(state, 0, sizeof(*state));
+    snprintf(state->algorithm, sizeof(state->algorithm), "%s", algorithm);
+    state->digits = 1000;
+    state->done = done;
+    state->total = 10;
+    state->count = count;
+    for (int i = 0; i < count; i++) state->tags[i] = 100 + i;
+}
+
+// Run to completion, stopping after every checkpoint and starting again
+static char *run_with_restarts(CalculatePiDigitsCheckpointed func, long long digits, int *runs) {
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    char *result = NULL;
+    for (*runs = 0; result == NULL && *runs < 200; (*runs)++) {
+        PiCheckpoint checkpoint;
+        checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 0.0);
+        checkpoint_request_stop(&checkpoint);
+        result = func(digits, &checkpoint);
+        TEST_ASSERT_EQUAL_INT(*runs > 0, checkpoint.resumed);
+    }
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    return result;
+}
+
+// ============= Checkpoint File Tests =============
+
+void test_checkpoint_round_trip(void) {
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    MpInt a, b, loaded[2];
+    mp_init(&a);
+    mp_init(&b);
+    mp_init(&loaded[0]);
+    mp_init(&loaded[1]);
+    mp_pow_ui(&a, 10, 500);
+    mp_set_ui(&b, 12345);
+    mp_sub(&b, &b, &a);  // negative
+
+    PiCheckpoint checkpoint;
+    checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 0.0);
+    CheckpointState state, read_back;
+    fill_state(&state, "test", 4, 2);
+    const MpInt *values[2] = {&a, &b};
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_save(&checkpoint, &state, values));
+    TEST_ASSERT_EQUAL_INT(1, checkpoint.checkpoints);
+    TEST_ASSERT_TRUE(checkpoint.bytes > 0);
+
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_load(TEST_CHECKPOINT_PATH, &read_back, loaded, 2));
+    TEST_ASSERT_EQUAL_STRING("test", read_back.algorithm);
+    TEST_ASSERT_EQUAL_INT(4, (int)read_back.done);
+    TEST_ASSERT_EQUAL_INT(2, read_back.count);
+    TEST_ASSERT_EQUAL_INT(101, (int)read_back.tags[1]);
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&a, &loaded[0]));
+    TEST_ASSERT_EQUAL_INT(0, mp_cmp(&b, &loaded[1]));
+
+    // Too few slots for the values is refused rather than overrun
+    TEST_ASSERT_EQUAL_INT(-1, checkpoint_load(TEST_CHECKPOINT_PATH, &read_back, loaded, 1));
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    TEST_ASSERT_EQUAL_INT(-1, checkpoint_peek(TEST_CHECKPOINT_PATH, &read_back));
+
+    mp_clear(&a);
+    mp_clear(&b);
+    mp_clear(&loaded[0]);
+    mp_clear(&loaded[1]);
+}
+
+void test_checkpoint_corrupt_falls_back_to_previous(void) {
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    MpInt value;
+    mp_init(&value);
+    mp_pow_ui(&value, 3, 2000);
+    const MpInt *values[1] = {&value};
+    PiCheckpoint checkpoint;
+    checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 0.0);
+    CheckpointState state, read_back;
+    fill_state(&state, "test", 1, 1);
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_save(&checkpoint, &state, values));
+    fill_state(&state, "test", 2, 1);
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_save(&checkpoint, &state, values));
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_peek(TEST_CHECKPOINT_PATH, &read_back));
+    TEST_ASSERT_EQUAL_INT(2, (int)read_back.done);
+
+    // Flip one byte in the middle of the latest: the checksum catches it
+    FILE *file = fopen(TEST_CHECKPOINT_PATH, "r+b");
+    TEST_ASSERT_NOT_NULL(file);
+    fseek(file, -64, SEEK_END);
+    int byte = fgetc(file);
+    fseek(file, -64, SEEK_END);
+    fputc(byte ^ 0x10, file);
+    fclose(file);
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_peek(TEST_CHECKPOINT_PATH, &read_back));
+    TEST_ASSERT_EQUAL_INT(1, (int)read_back.done);
+
+    // A truncated latest falls back the same way
+    TEST_ASSERT_EQUAL_INT(0, truncate(TEST_CHECKPOINT_PATH, 40));
+    TEST_ASSERT_EQUAL_INT(0, checkpoint_peek(TEST_CHECKPOINT_PATH, &read_back));
+    TEST_ASSERT_EQUAL_INT(1, (int)read_back.done);
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    mp_clear(&value);
+}
+
+void test_checkpoint_due_keeps_overhead_bounded(void) {
+    PiCheckpoint checkpoint;
+    checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 0.0);
+    TEST_ASSERT_TRUE(checkpoint_due(&checkpoint));
+
+    // A write that took 1 s pushes the next one out to 1 / max_overhead
+    checkpoint.last_write_seconds = 1.0;
+    TEST_ASSERT_FALSE(checkpoint_due(&checkpoint));
+    checkpoint.last.tv_sec -= (time_t)(1.0 / CHECKPOINT_MAX_OVERHEAD) + 1;
+    TEST_ASSERT_TRUE(checkpoint_due(&checkpoint));
+
+    // A stop is due at once
+    checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 3600.0);
+    TEST_ASSERT_FALSE(checkpoint_due(&checkpoint));
+    checkpoint_request_stop(&checkpoint);
+    TEST_ASSERT_TRUE(checkpoint_due(&checkpoint));
+}
+
+// ============= Resume Tests =============
+
+void test_chudnovsky_bs_resumes_to_same_digits(void) {
+    int runs = 0;
+    char *resumed = run_with_restarts(chudnovsky_bs_digits_checkpointed, 5000, &runs);
+    char *expected = chudnovsky_bs_digits(5000);
+    TEST_ASSERT_TRUE(runs > CHECKPOINT_SEGMENTS / 2);
+    TEST_ASSERT_NOT_NULL(resumed);
+    TEST_ASSERT_EQUAL_STRING(expected, resumed);
+    free(resumed);
+    free(expected);
+}
+
+void test_gauss_legendre_resumes_to_same_digits(void) {
+    int runs = 0;
+    char *resumed = run_with_restarts(gauss_legendre_digits_checkpointed, 5000, &runs);
+    char *expected = chudnovsky_bs_digits(5000);
+    TEST_ASSERT_TRUE(runs > 5);
+    TEST_ASSERT_NOT_NULL(resumed);
+    TEST_ASSERT_EQUAL_STRING(expected, resumed);
+    free(resumed);
+    free(expected);
+}
+
+void test_checkpoint_ignores_other_runs(void) {
+    // A checkpoint of different digits is not resumed
+    PiCheckpoint checkpoint;
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+    checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 0.0);
+    checkpoint_request_stop(&checkpoint);
+    TEST_ASSERT_NULL(chudnovsky_bs_digits_checkpointed(3000, &checkpoint));
+    checkpoint_init(&checkpoint, TEST_CHECKPOINT_PATH, 3600.0);
+    char *result = chudnovsky_bs_digits_checkpointed(2000, &checkpoint);
+    char *expected = chudnovsky_bs_digits(2000);
+    TEST_ASSERT_EQUAL_INT(0, checkpoint.resumed);
+    TEST_ASSERT_EQUAL_STRING(expected, result);
+    free(result);
+    free(expected);
+    checkpoint_remove(TEST_CHECKPOINT_PATH);
+}
+
+// ============= Job Tests =============
+
+static JobStatus wait_for_job(const char *id, JobInfo *info) {
+    for (int i = 0; i < 2000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, jobs_info(id, info));
+        if (info->status != JOB_RUNNING) break;
+        usleep(5000);
+    }
+    return info->status;
+}
+
+void test_jobs_run_and_resume_after_restart(void) {
+    TEST_ASSERT_EQUAL_INT(0, results_store_open("/tmp/test_pi_job_results"));
+    TEST_ASSERT_EQUAL_INT(0, jobs_open("/tmp/test_pi_jobs"));
+    char id[RESULTS_ID_LENGTH];
+    TEST_ASSERT_EQUAL_INT(-1, jobs_start("leibniz", 1000, id));
+    TEST_ASSERT_EQUAL_INT(-1, jobs_start("chudnovsky_bs", 0, id));
+
+    JobInfo info;
+    TEST_ASSERT_EQUAL_INT(0, jobs_start("chudnovsky_bs", 3000, id));
+    TEST_ASSERT_EQUAL_INT(JOB_DONE, wait_for_job(id, &info));
+    TEST_ASSERT_EQUAL_INT(-1, jobs_resume(id));  // its checkpoint is gone
+    TEST_ASSERT_TRUE(results_id_valid(info.result_id));
+    size_t size = 0;
+    int fd = results_store_open_file(info.result_id, 0, &size);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(3002, (int)size);
+    close(fd);
+
+    // Closing stops running jobs at a checkpoint; a new process sees the
+    // job as interrupted and resumes it
+    TEST_ASSERT_EQUAL_INT(0, jobs_start("gauss_legendre", 100000, id));
+    jobs_close();
+    TEST_ASSERT_EQUAL_INT(0, jobs_open("/tmp/test_pi_jobs"));
+    TEST_ASSERT_EQUAL_INT(0, jobs_info(id, &info));
+    TEST_ASSERT_EQUAL_INT(JOB_INTERRUPTED, info.status);
+    TEST_ASSERT_EQUAL_STRING("gauss_legendre", info.algorithm);
+    TEST_ASSERT_EQUAL_INT(0, jobs_resume(id));
+    TEST_ASSERT_EQUAL_INT(-2, jobs_resume(id));
+    TEST_ASSERT_EQUAL_INT(JOB_DONE, wait_for_job(id, &info));
+    TEST_ASSERT_EQUAL_INT(1, info.resumed);
+    TEST_ASSERT_EQUAL_INT(100000, (int)info.digits);
+    TEST_ASSERT_TRUE(results_id_valid(info.result_id));
+    TEST_ASSERT_EQUAL_INT(-1, jobs_info("0123456789abcdef", &info));
+
+    jobs_close();
+    results_store_close();
+}
+
+void run_pi_checkpoint_tests(void) {
+    RUN_TEST(test_checkpoint_round_trip);
+    RUN_TEST(test_checkpoint_corrupt_falls_back_to_previous);
+    RUN_TEST(test_checkpoint_due_keeps_overhead_bounded);
+    RUN_TEST(test_chudnovsky_bs_resumes_to_same_digits);
+    RUN_TEST(test_gauss_legendre_resumes_to_same_digits);
+    RUN_TEST(test_checkpoint_ignores_other_runs);
+    RUN_TEST(test_jobs_run_and_resume_after_restart);
+}
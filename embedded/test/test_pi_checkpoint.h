@@ -0,0 +1,12 @@
+#ifndef TEST_PI_CHECKPOINT_H
+#define TEST_PI_CHECKPOINT_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_checkpoint.h"
+#include "../src/pi/pi_multiprecision.h"
+#include "../src/server/jobs.h"
+#include "../src/server/results.h"
+
+void run_pi_checkpoint_tests(void);
+
+#endif
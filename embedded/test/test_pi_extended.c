@@ -0,0 +1,96 @@
+#include "test_pi_extended.h"
+
+// ============= Arithmetic Tests =============
+
+void test_two_prod_is_exact(void) {
+    double a = 1.0 + ldexp(1.0, -30);
+    double err;
+    double p = two_prod(a, a, &err);
+    // (1 + 2^-30)^2 = 1 + 2^-29 + 2^-60; the last term lands in err
+    TEST_ASSERT_EQUAL_DOUBLE(1.0 + ldexp(1.0, -29), p);
+    TEST_ASSERT_EQUAL_DOUBLE(ldexp(1.0, -60), err);
+}
+
+void test_dd_division_roundtrip(void) {
+    dd_real third = dd_div(dd_from_d(1.0), dd_from_d(3.0));
+    dd_real back = dd_mul_d(third, 3.0);
+    dd_real diff = dd_sub(back, dd_from_d(1.0));
+    TEST_ASSERT_TRUE(fabs(dd_to_d(diff)) < 1e-31);
+}
+
+void test_dd_sqrt_two(void) {
+    char text[48];
+    dd_to_string(dd_sqrt(dd_from_d(2.0)), 30, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING_LEN("1.414213562373095048801688724209", text, 31);
+}
+
+void test_qd_sqrt_squares_back(void) {
+    qd_real root = qd_sqrt(qd_from_d(10005.0));
+    qd_real diff = qd_sub(qd_mul(root, root), qd_from_d(10005.0));
+    TEST_ASSERT_TRUE(fabs(diff.x[0]) < 1e-58);
+}
+
+void test_qd_to_string_pi(void) {
+    char text[80];
+    qd_to_string(QD_PI, 60, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("3.141592653589793238462643383279502884197169399375105820974944", text);
+}
+
+void test_qd_from_ld_is_exact(void) {
+    long double value = 1.0L / 3.0L;
+    TEST_ASSERT_TRUE(qd_to_ld(qd_from_ld(value)) == value);
+}
+
+// ============= Kernel Tests =============
+
+void test_dd_kernels_reach_double_double_precision(void) {
+    TEST_ASSERT_GREATER_OR_EQUAL(29, qd_correct_digits(chudnovsky_dd_wide(4), DD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(29, qd_correct_digits(ramanujan_dd_wide(5), DD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(29, qd_correct_digits(gauss_legendre_dd_wide(6), DD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(28, qd_correct_digits(borwein_dd_wide(4), DD_MAX_DIGITS));
+}
+
+void test_qd_kernels_pass_double_double(void) {
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(chudnovsky_qd(6), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(ramanujan_qd(9), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(gauss_legendre_qd(7), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(borwein_qd(4), QD_MAX_DIGITS));
+}
+
+// Past convergence the kernels stop early instead of running into NaN
+void test_qd_kernels_stop_at_precision(void) {
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(chudnovsky_qd(1000000), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(ramanujan_qd(1000000), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(gauss_legendre_qd(1000000), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(borwein_qd(1000000), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(bbp_qd(1000000), QD_MAX_DIGITS));
+}
+
+void test_dd_series_match_long_double(void) {
+    long double reference = leibniz(1000);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, (double)reference, dd_to_d(leibniz_dd(1000)));
+    reference = nilakantha(1000);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, (double)reference, dd_to_d(nilakantha_dd(1000)));
+}
+
+void test_optimize_pi_kernel_wide(void) {
+    PiKernel kernel = {NULL, chudnovsky_qd, QD_MAX_DIGITS};
+    PiResult result = optimize_pi_kernel(&kernel, "chudnovsky_fast", 1.0);
+    TEST_ASSERT_GREATER_OR_EQUAL(60, result.correct_digits);
+    TEST_ASSERT_EQUAL_INT(QD_MAX_DIGITS, result.max_digits);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, 3.141592653589793, result.wide_estimate.x[0]);
+}
+
+void run_pi_extended_tests(void) {
+    RUN_TEST(test_two_prod_is_exact);
+    RUN_TEST(test_dd_division_roundtrip);
+    RUN_TEST(test_dd_sqrt_two);
+    RUN_TEST(test_qd_sqrt_squares_back);
+    RUN_TEST(test_qd_to_string_pi);
+    RUN_TEST(test_qd_from_ld_is_exact);
+    RUN_TEST(test_dd_kernels_reach_double_double_precision);
+    RUN_TEST(test_qd_kernels_pass_double_double);
+    RUN_TEST(test_qd_kernels_stop_at_precision);
+    RUN_TEST(test_dd_series_match_long_double);
+    RUN_TEST(test_optimize_pi_kernel_wide);
+}
@@ -0,0 +1,10 @@
+#ifndef TEST_PI_EXTENDED_H
+#define TEST_PI_EXTENDED_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_extended.h"
+#include "../src/pi/pi_optimization.h"
+
+void run_pi_extended_tests(void);
+
+#endif
@@ -0,0 +1,74 @@
+#include "test_pi_machin.h"
+
+// ============= Long Double Tests =============
+
+void test_machin_formulas_reach_long_double(void) {
+    TEST_ASSERT_TRUE(fabsl(machin(30) - PI_REFERENCE) < 1e-17L);
+    TEST_ASSERT_TRUE(fabsl(takano(30) - PI_REFERENCE) < 1e-17L);
+    TEST_ASSERT_TRUE(fabsl(stormer(30) - PI_REFERENCE) < 1e-17L);
+}
+
+void test_machin_converges_by_term(void) {
+    // 1.4 digits per term from atan(1/5)
+    TEST_ASSERT_TRUE(fabsl(machin(3) - PI_REFERENCE) > 1e-6L);
+    TEST_ASSERT_TRUE(fabsl(machin(6) - PI_REFERENCE) < 1e-7L);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, machin(0));
+}
+
+void test_machin_counted_stops_early(void) {
+    CalculatePiCounted counted = machin_counted_for(machin);
+    TEST_ASSERT_NOT_NULL(counted);
+    long long effective = 0;
+    long double estimate = counted(1000000, &effective);
+    TEST_ASSERT_TRUE(effective > 10 && effective < 20);
+    TEST_ASSERT_TRUE(estimate == machin(effective));
+    TEST_ASSERT_NULL(machin_counted_for(leibniz));
+}
+
+// ============= Extended Precision Tests =============
+
+void test_machin_extended_precision(void) {
+    TEST_ASSERT_GREATER_OR_EQUAL(29, qd_correct_digits(machin_dd_wide(40), DD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(takano_qd_wide(60), QD_MAX_DIGITS));
+    TEST_ASSERT_GREATER_OR_EQUAL(60, qd_correct_digits(stormer_qd_wide(60), QD_MAX_DIGITS));
+}
+
+// ============= Multiprecision Tests =============
+
+void test_machin_digits_match_chudnovsky(void) {
+    char *reference = chudnovsky_bs_digits(2000);
+    CalculatePiDigits kernels[] = {machin_digits, takano_digits, stormer_digits};
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        char *digits = kernels[i](2000);
+        TEST_ASSERT_NOT_NULL(digits);
+        TEST_ASSERT_EQUAL_STRING(reference, digits);
+        free(digits);
+    }
+    free(reference);
+}
+
+void test_machin_digits_small_and_invalid(void) {
+    char *digits = machin_digits(0);
+    TEST_ASSERT_EQUAL_STRING("3", digits);
+    free(digits);
+    TEST_ASSERT_NULL(takano_digits(-1));
+    TEST_ASSERT_NULL(stormer_digits(MAX_MP_DIGITS + 1));
+}
+
+// ============= Optimizer Tests =============
+
+void test_optimize_machin_reports_effective_terms(void) {
+    PiResult result = optimize_pi_precision(stormer, "stormer", 0.5);
+    TEST_ASSERT_GREATER_OR_EQUAL(18, result.correct_digits);
+    TEST_ASSERT_TRUE(result.iterations < 20);
+}
+
+void run_pi_machin_tests(void) {
+    RUN_TEST(test_machin_formulas_reach_long_double);
+    RUN_TEST(test_machin_converges_by_term);
+    RUN_TEST(test_machin_counted_stops_early);
+    RUN_TEST(test_machin_extended_precision);
+    RUN_TEST(test_machin_digits_match_chudnovsky);
+    RUN_TEST(test_machin_digits_small_and_invalid);
+    RUN_TEST(test_optimize_machin_reports_effective_terms);
+}
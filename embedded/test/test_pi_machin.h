@@ -0,0 +1,12 @@
+#ifndef TEST_PI_MACHIN_H
+#define TEST_PI_MACHIN_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_machin.h"
+#include "../src/pi/pi_precision.h"
+#include "../src/pi/pi_multiprecision.h"
+#include "../src/pi/pi_optimization.h"
+
+void run_pi_machin_tests(void);
+
+#endif
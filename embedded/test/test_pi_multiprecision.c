@@ -0,0 +1,144 @@
+#include "test_pi_multiprecision.h"
+
+void test_chudnovsky_digits_first_100(void) {
+    char *digits = chudnovsky_digits(100);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(PI_100_DIGITS, digits);
+    free(digits);
+}
+
+void test_chudnovsky_digits_exact_length(void) {
+    char *digits = chudnovsky_digits(2500);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_INT(2502, (int)strlen(digits));
+    TEST_ASSERT_EQUAL_STRING_LEN(PI_100_DIGITS, digits, 102);
+    free(digits);
+}
+
+void test_chudnovsky_digits_zero(void) {
+    char *digits = chudnovsky_digits(0);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING("3", digits);
+    free(digits);
+}
+
+void test_chudnovsky_digits_rejects_out_of_range(void) {
+    TEST_ASSERT_NULL(chudnovsky_digits(-1));
+    TEST_ASSERT_NULL(chudnovsky_digits(MAX_MP_DIGITS + 1));
+}
+
+void test_chudnovsky_bs_digits_first_100(void) {
+    char *digits = chudnovsky_bs_digits(100);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(PI_100_DIGITS, digits);
+    free(digits);
+}
+
+void test_chudnovsky_bs_matches_term_by_term(void) {
+    char *reference = chudnovsky_digits(5000);
+    char *digits = chudnovsky_bs_digits(5000);
+    TEST_ASSERT_NOT_NULL(reference);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(reference, digits);
+    free(reference);
+    free(digits);
+}
+
+void test_chudnovsky_bs_digits_edges(void) {
+    char *digits = chudnovsky_bs_digits(0);
+    TEST_ASSERT_EQUAL_STRING("3", digits);
+    free(digits);
+    TEST_ASSERT_NULL(chudnovsky_bs_digits(-1));
+    TEST_ASSERT_NULL(chudnovsky_bs_digits(MAX_MP_DIGITS + 1));
+}
+
+void test_gauss_legendre_digits_first_100(void) {
+    char *digits = gauss_legendre_digits(100);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(PI_100_DIGITS, digits);
+    free(digits);
+}
+
+void test_borwein_digits_first_100(void) {
+    char *digits = borwein_digits(100);
+    TEST_ASSERT_NOT_NULL(digits);
+    TEST_ASSERT_EQUAL_STRING(PI_100_DIGITS, digits);
+    free(digits);
+}
+
+void test_agm_kernels_match_chudnovsky(void) {
+    char *reference = chudnovsky_bs_digits(20000);
+    char *gauss = gauss_legendre_digits(20000);
+    char *quartic = borwein_digits(20000);
+    TEST_ASSERT_NOT_NULL(reference);
+    TEST_ASSERT_NOT_NULL(gauss);
+    TEST_ASSERT_NOT_NULL(quartic);
+    TEST_ASSERT_EQUAL_STRING(reference, gauss);
+    TEST_ASSERT_EQUAL_STRING(reference, quartic);
+    free(reference);
+    free(gauss);
+    free(quartic);
+}
+
+void test_mp_fixed_roots(void) {
+    const size_t bits = 256;
+    MpInt x, r, check;
+    mp_init(&x);
+    mp_init(&r);
+    mp_init(&check);
+
+    // sqrt(3)^2 == 3 and (5^(1/4))^4 == 5, both to within a few ulps
+    mp_fixed_set_ui(&x, 3, bits);
+    mp_fixed_sqrt(&r, &x, bits);
+    mp_fixed_mul(&check, &r, &r, bits);
+    mp_sub(&check, &check, &x);
+    TEST_ASSERT_TRUE(mp_bit_length(&check) < 8);
+
+    mp_fixed_set_ui(&x, 5, bits);
+    mp_fixed_root4(&r, &x, bits);
+    mp_fixed_mul(&check, &r, &r, bits);
+    mp_fixed_mul(&check, &check, &check, bits);
+    mp_sub(&check, &check, &x);
+    TEST_ASSERT_TRUE(mp_bit_length(&check) < 10);
+
+    mp_clear(&x);
+    mp_clear(&r);
+    mp_clear(&check);
+}
+
+void test_format_pi_digits_drops_guard_digits(void) {
+    MpInt scaled;
+    mp_init(&scaled);
+    // 3.14159 followed by MP_GUARD_DIGITS guard digits
+    mp_set_decimal(&scaled, "3141592653589");
+    char *text = format_pi_digits(&scaled, 13 - 1 - MP_GUARD_DIGITS);
+    TEST_ASSERT_EQUAL_STRING("3.14", text);
+    free(text);
+    mp_clear(&scaled);
+}
+
+void test_compute_pi_digits_reports_time(void) {
+    PiDigitsResult result = compute_pi_digits(chudnovsky_digits, 500);
+    TEST_ASSERT_NOT_NULL(result.digits);
+    TEST_ASSERT_EQUAL_INT64(500, result.digit_count);
+    TEST_ASSERT_TRUE(result.time_seconds >= 0.0);
+    TEST_ASSERT_TRUE(result.peak_memory_bytes > 0);
+    free_pi_digits_result(&result);
+    TEST_ASSERT_NULL(result.digits);
+}
+
+void run_pi_multiprecision_tests(void) {
+    RUN_TEST(test_chudnovsky_digits_first_100);
+    RUN_TEST(test_chudnovsky_digits_exact_length);
+    RUN_TEST(test_chudnovsky_digits_zero);
+    RUN_TEST(test_chudnovsky_digits_rejects_out_of_range);
+    RUN_TEST(test_chudnovsky_bs_digits_first_100);
+    RUN_TEST(test_chudnovsky_bs_matches_term_by_term);
+    RUN_TEST(test_chudnovsky_bs_digits_edges);
+    RUN_TEST(test_gauss_legendre_digits_first_100);
+    RUN_TEST(test_borwein_digits_first_100);
+    RUN_TEST(test_agm_kernels_match_chudnovsky);
+    RUN_TEST(test_mp_fixed_roots);
+    RUN_TEST(test_format_pi_digits_drops_guard_digits);
+    RUN_TEST(test_compute_pi_digits_reports_time);
+}
@@ -0,0 +1,12 @@
+#ifndef TEST_PI_MULTIPRECISION_H
+#define TEST_PI_MULTIPRECISION_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_multiprecision.h"
+
+// First 100 decimals of pi
+#define PI_100_DIGITS "3.1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679"
+
+void run_pi_multiprecision_tests(void);
+
+#endif
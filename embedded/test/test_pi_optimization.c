@@ -250,6 +250,28 @@ void test_phase3_skips_if_time_limit_near(void) {
     TEST_ASSERT_EQUAL_INT64(original, best.iterations);
 }
 
+void test_phase3_candidates_stay_in_bracket(void) {
+    TestResult best = {1000, mock_fast_converge(1000), 0.0L, 3};
+    
+    phase3_fine_refinement(mock_fast_converge, 10.0, &best);
+    
+    TEST_ASSERT_TRUE(best.iterations > 1000);
+    TEST_ASSERT_TRUE(best.iterations <= 1500);
+    TEST_ASSERT_GREATER_OR_EQUAL(3, best.digits);
+}
+
+void test_phase3_never_picks_timed_out_candidate(void) {
+    TestResult probe;
+    test_execution(mock_slow_accurate, 2000, 10.0, &probe);
+    double time_limit = (double)probe.time_used * 1.2 + 1e-4;
+    TestResult best = {2000, probe.estimate, 0.0L, probe.digits};
+    
+    phase3_fine_refinement(mock_slow_accurate, time_limit, &best);
+    
+    TEST_ASSERT_GREATER_OR_EQUAL(2000, best.iterations);
+    TEST_ASSERT_TRUE(best.time_used <= time_limit);
+}
+
 // ============= optimize_pi_precision Tests =============
 
 void test_optimize_pi_precision_returns_valid_result(void) {
@@ -310,6 +332,98 @@ void test_optimization_consistency(void) {
     TEST_ASSERT_INT_WITHIN(2, result1.correct_digits, result2.correct_digits);
 }
 
+// ============= Incremental Search Tests =============
+
+void test_incremental_search_respects_time_limit(void) {
+    PiResult result = optimize_pi_precision(leibniz, "leibniz", 0.5);
+
+    TEST_ASSERT_TRUE(result.cpu_time_used <= 1.0);
+    TEST_ASSERT_GREATER_OR_EQUAL(5, result.correct_digits);
+}
+
+void test_incremental_search_spends_less_time(void) {
+    PiKernel from_scratch = {leibniz, NULL, MAX_PRECISION_DIGITS, NULL};
+    PiKernel incremental = {leibniz, NULL, MAX_PRECISION_DIGITS, pi_incremental_for(leibniz)};
+
+    clock_t start = clock();
+    PiResult scratch_result = optimize_pi_kernel(&from_scratch, "leibniz", 0.3);
+    clock_t middle = clock();
+    PiResult incremental_result = optimize_pi_kernel(&incremental, "leibniz", 0.3);
+    clock_t end = clock();
+
+    // Re-running earlier terms makes the from-scratch search cost several limits
+    TEST_ASSERT_TRUE(end - middle < middle - start);
+    TEST_ASSERT_GREATER_OR_EQUAL(scratch_result.iterations / 2, incremental_result.iterations);
+    TEST_ASSERT_TRUE(incremental_result.pi_estimate == leibniz(incremental_result.iterations));
+}
+
+void test_incremental_search_stops_at_fixed_point(void) {
+    PiResult result = optimize_pi_precision(gauss_legendre, "gauss_legendre", 1.0);
+
+    TEST_ASSERT_TRUE(result.iterations < 100);
+    TEST_ASSERT_GREATER_OR_EQUAL(17, result.correct_digits);
+}
+
+void test_incremental_search_keeps_peak_past_jump(void) {
+    // Predicted jumps go past where rounding starts costing digits
+    PiResult result = optimize_pi_precision(nilakantha, NULL, 0.5);
+
+    TEST_ASSERT_TRUE(result.cpu_time_used <= 0.5L);
+    TEST_ASSERT_GREATER_OR_EQUAL(17, result.correct_digits);
+    TEST_ASSERT_TRUE(result.pi_estimate == nilakantha(result.iterations));
+}
+
+void test_execution_reports_effective_terms(void) {
+    TestResult result;
+    TEST_ASSERT_EQUAL(EXEC_VALID, test_execution(bbp, 1000000, 1.0, &result));
+    TEST_ASSERT_TRUE(result.iterations < 100);
+    TEST_ASSERT_GREATER_OR_EQUAL(17, result.digits);
+}
+
+// ============= Target Digits Tests =============
+
+void test_convergence_rate_lookup(void) {
+    ConvergenceModel model;
+    double a, b;
+    TEST_ASSERT_EQUAL_INT(1, pi_convergence_rate("chudnovsky_fast", &model, &a, &b));
+    TEST_ASSERT_EQUAL_INT(CONVERGENCE_LINEAR, model);
+    TEST_ASSERT_EQUAL_INT(1, pi_convergence_rate("gauss_legendre", &model, &a, &b));
+    TEST_ASSERT_EQUAL_INT(CONVERGENCE_QUADRATIC, model);
+    TEST_ASSERT_EQUAL_INT(0, pi_convergence_rate("unknown", &model, &a, &b));
+    TEST_ASSERT_EQUAL_INT(0, pi_convergence_rate(NULL, &model, &a, &b));
+}
+
+void test_optimize_pi_digits_finds_minimal_count(void) {
+    PiResult result = optimize_pi_digits(nilakantha, "nilakantha", 12, 5.0);
+    
+    TEST_ASSERT_EQUAL_INT(1, result.target_reached);
+    TEST_ASSERT_EQUAL_INT(12, result.target_digits);
+    TEST_ASSERT_GREATER_OR_EQUAL(12, result.correct_digits);
+    TEST_ASSERT_LESS_THAN(12, count_correct_digits(nilakantha(result.iterations - 1)));
+}
+
+void test_optimize_pi_digits_probe_search_minimal(void) {
+    // No incremental form: found by probing and bisection
+    PiKernel kernel = {bbp, NULL, MAX_PRECISION_DIGITS, NULL};
+    PiResult result = optimize_pi_kernel_digits(&kernel, "bbp", 12, 5.0);
+    
+    TEST_ASSERT_EQUAL_INT(1, result.target_reached);
+    TEST_ASSERT_GREATER_OR_EQUAL(12, result.correct_digits);
+    TEST_ASSERT_LESS_THAN(12, count_correct_digits(bbp(result.iterations - 1)));
+}
+
+void test_optimize_pi_digits_gives_up_at_time_limit(void) {
+    PiResult result = optimize_pi_digits(leibniz, "leibniz", 20, 0.05);
+    
+    TEST_ASSERT_EQUAL_INT(0, result.target_reached);
+    TEST_ASSERT_TRUE(result.cpu_time_used <= 0.05L);
+}
+
+void test_optimize_pi_digits_rejects_out_of_range(void) {
+    TEST_ASSERT_EQUAL_INT(0, optimize_pi_digits(leibniz, "leibniz", 0, 1.0).target_reached);
+    TEST_ASSERT_EQUAL_INT(0, optimize_pi_digits(leibniz, "leibniz", MAX_PRECISION_DIGITS + 1, 1.0).target_reached);
+}
+
 // ============= Public Function to Run All Tests =============
 
 void run_pi_optimization_tests(void) {
@@ -360,6 +474,8 @@ void run_pi_optimization_tests(void) {
     RUN_TEST(test_phase3_refines_result);
     RUN_TEST(test_phase3_skips_if_near_max_precision);
     RUN_TEST(test_phase3_skips_if_time_limit_near);
+    RUN_TEST(test_phase3_candidates_stay_in_bracket);
+    RUN_TEST(test_phase3_never_picks_timed_out_candidate);
     
     // optimize_pi_precision tests
     RUN_TEST(test_optimize_pi_precision_returns_valid_result);
@@ -368,7 +484,21 @@ void run_pi_optimization_tests(void) {
     RUN_TEST(test_optimize_pi_precision_handles_poor_convergence);
     RUN_TEST(test_optimize_pi_precision_with_real_algorithm);
     
+    // target-digits mode tests
+    RUN_TEST(test_convergence_rate_lookup);
+    RUN_TEST(test_optimize_pi_digits_finds_minimal_count);
+    RUN_TEST(test_optimize_pi_digits_probe_search_minimal);
+    RUN_TEST(test_optimize_pi_digits_gives_up_at_time_limit);
+    RUN_TEST(test_optimize_pi_digits_rejects_out_of_range);
+    
     // Integration tests
     RUN_TEST(test_full_optimization_workflow);
     RUN_TEST(test_optimization_consistency);
+
+    // incremental search tests
+    RUN_TEST(test_incremental_search_respects_time_limit);
+    RUN_TEST(test_incremental_search_spends_less_time);
+    RUN_TEST(test_incremental_search_stops_at_fixed_point);
+    RUN_TEST(test_incremental_search_keeps_peak_past_jump);
+    RUN_TEST(test_execution_reports_effective_terms);
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "test_pi_precision.h"
+
+// ============= Precision Name Tests =============
+
+void test_precision_names_roundtrip(void) {
+    for (int i = 0; i < PRECISION_COUNT; i++) {
+        PiPrecision parsed;
+        if (i == PRECISION_FLOAT128 && !PI_HAVE_FLOAT128) continue;
+        TEST_ASSERT_EQUAL_INT(1, precision_from_name(precision_name((PiPrecision)i), &parsed));
+        TEST_ASSERT_EQUAL_INT(i, parsed);
+    }
+}
+
+void test_precision_rejects_unknown_name(void) {
+    PiPrecision parsed;
+    TEST_ASSERT_EQUAL_INT(0, precision_from_name("half", &parsed));
+    TEST_ASSERT_EQUAL_INT(0, precision_from_name(NULL, &parsed));
+}
+
+void test_precision_max_digits_order(void) {
+    TEST_ASSERT_EQUAL_INT(7, precision_max_digits(PRECISION_FLOAT));
+    TEST_ASSERT_EQUAL_INT(15, precision_max_digits(PRECISION_DOUBLE));
+    TEST_ASSERT_TRUE(precision_max_digits(PRECISION_LONG_DOUBLE) >= 15);
+    TEST_ASSERT_EQUAL_INT(DD_MAX_DIGITS, precision_max_digits(PRECISION_DD));
+    TEST_ASSERT_EQUAL_INT(QD_MAX_DIGITS, precision_max_digits(PRECISION_QD));
+}
+
+// ============= Instantiation Tests =============
+
+void test_chudnovsky_saturates_every_precision(void) {
+    CalculatePiWide kernels[PRECISION_COUNT] = PI_PRECISION_KERNELS(chudnovsky);
+    for (int i = 0; i < PRECISION_COUNT; i++) {
+        if (kernels[i] == NULL) continue;
+        int max_digits = precision_max_digits((PiPrecision)i);
+        TEST_ASSERT_GREATER_OR_EQUAL(max_digits - 1, qd_correct_digits(kernels[i](8), max_digits));
+    }
+}
+
+void test_gauss_legendre_saturates_every_precision(void) {
+    CalculatePiWide kernels[PRECISION_COUNT] = PI_PRECISION_KERNELS(gauss_legendre);
+    for (int i = 0; i < PRECISION_COUNT; i++) {
+        if (kernels[i] == NULL) continue;
+        int max_digits = precision_max_digits((PiPrecision)i);
+        TEST_ASSERT_GREATER_OR_EQUAL(max_digits - 2, qd_correct_digits(kernels[i](8), max_digits));
+    }
+}
+
+void test_generic_long_double_matches_hand_written(void) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, (double)leibniz(1000), (double)leibniz_long_double(1000));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, (double)bbp(10), (double)bbp_long_double(10));
+}
+
+void test_float_series_converge(void) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 3.14159265f, leibniz_float(10000));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 3.14159265f, nilakantha_float(1000));
+}
+
+#if PI_HAVE_FLOAT128
+void test_float128_beats_double_double(void) {
+    int digits = qd_correct_digits(borwein_float128_wide(4), QD_MAX_DIGITS);
+    TEST_ASSERT_GREATER_OR_EQUAL(32, digits);
+}
+#endif
+
+void test_optimize_pi_kernel_double(void) {
+    PiKernel kernel = {NULL, ramanujan_double_wide, precision_max_digits(PRECISION_DOUBLE)};
+    PiResult result = optimize_pi_kernel(&kernel, "ramanujan_fast", 1.0);
+    TEST_ASSERT_EQUAL_INT(15, result.correct_digits);
+    TEST_ASSERT_TRUE(result.iterations <= 10);
+}
+
+void run_pi_precision_tests(void) {
+    RUN_TEST(test_precision_names_roundtrip);
+    RUN_TEST(test_precision_rejects_unknown_name);
+    RUN_TEST(test_precision_max_digits_order);
+    RUN_TEST(test_chudnovsky_saturates_every_precision);
+    RUN_TEST(test_gauss_legendre_saturates_every_precision);
+    RUN_TEST(test_generic_long_double_matches_hand_written);
+    RUN_TEST(test_float_series_converge);
+#if PI_HAVE_FLOAT128
+    RUN_TEST(test_float128_beats_double_double);
+#endif
+    RUN_TEST(test_optimize_pi_kernel_double);
+}
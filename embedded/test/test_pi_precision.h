@@ -0,0 +1,10 @@
+#ifndef TEST_PI_PRECISION_H
+#define TEST_PI_PRECISION_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_precision.h"
+#include "../src/pi/pi_optimization.h"
+
+void run_pi_precision_tests(void);
+
+#endif
@@ -0,0 +1,189 @@
+#include "test_pi_predictor.h"
+
+// Synthetic probes: 1 microsecond per iteration, digits from the given curve
+static void observe_curve(IterationPredictor *predictor, const long long *iterations,
+                          int count, int (*digits)(long long)) {
+    for (int i = 0; i < count; i++) {
+        predictor_observe(predictor, iterations[i], iterations[i] * 1e-6, digits(iterations[i]));
+    }
+}
+
+static int logarithmic_digits(long long n) { return (int)floor(log10((double)n)); }
+static int linear_digits(long long n) { return (int)(n / 10); }
+static int quadratic_digits(long long n) { return 1 << n; }
+
+// ============= Model Fitting Tests =============
+
+void test_predictor_needs_probes(void) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    TEST_ASSERT_EQUAL_INT64(0, predictor_next_iterations(&predictor, 100, 1.0, 18));
+    predictor_observe(&predictor, 1000, 1e-3, 3);
+    TEST_ASSERT_EQUAL_INT64(0, predictor_next_iterations(&predictor, 1000, 1.0, 18));
+}
+
+void test_predictor_ignores_unmeasurable_probes(void) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    predictor_observe(&predictor, 10, 1e-6, 1);
+    predictor_observe(&predictor, 20, 2e-6, 1);
+    TimeModel model;
+    double coefficient;
+    TEST_ASSERT_EQUAL_INT(0, predictor_fit_time(&predictor, &model, &coefficient));
+}
+
+void test_predictor_fits_linear_time(void) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    long long iterations[] = {1000, 10000, 100000};
+    observe_curve(&predictor, iterations, 3, logarithmic_digits);
+    TimeModel model;
+    double coefficient;
+    TEST_ASSERT_EQUAL_INT(1, predictor_fit_time(&predictor, &model, &coefficient));
+    TEST_ASSERT_EQUAL_INT(TIME_MODEL_LINEAR, model);
+    TEST_ASSERT_FLOAT_WITHIN(1e-8, 1e-6, coefficient);
+}
+
+void test_predictor_fits_nlogn_time(void) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    long long iterations[] = {1024, 16384, 262144, 4194304};
+    for (int i = 0; i < 4; i++) {
+        double n = (double)iterations[i];
+        predictor_observe(&predictor, iterations[i], 1e-8 * n * log2(n), 5 + i);
+    }
+    TimeModel model;
+    double coefficient;
+    TEST_ASSERT_EQUAL_INT(1, predictor_fit_time(&predictor, &model, &coefficient));
+    TEST_ASSERT_EQUAL_INT(TIME_MODEL_NLOGN, model);
+    TEST_ASSERT_FLOAT_WITHIN(1e-10, 1e-8, coefficient);
+}
+
+void test_predictor_classifies_convergence(void) {
+    ConvergenceModel model;
+    double a, b;
+
+    IterationPredictor logarithmic;
+    predictor_init(&logarithmic);
+    long long log_iterations[] = {10, 100, 1000, 10000};
+    observe_curve(&logarithmic, log_iterations, 4, logarithmic_digits);
+    TEST_ASSERT_EQUAL_INT(1, predictor_fit_convergence(&logarithmic, &model, &a, &b));
+    TEST_ASSERT_EQUAL_INT(CONVERGENCE_LOGARITHMIC, model);
+
+    IterationPredictor linear;
+    predictor_init(&linear);
+    long long linear_iterations[] = {10, 50, 100, 200};
+    observe_curve(&linear, linear_iterations, 4, linear_digits);
+    TEST_ASSERT_EQUAL_INT(1, predictor_fit_convergence(&linear, &model, &a, &b));
+    TEST_ASSERT_EQUAL_INT(CONVERGENCE_LINEAR, model);
+
+    IterationPredictor quadratic;
+    predictor_init(&quadratic);
+    long long quadratic_iterations[] = {1, 2, 3, 4};
+    observe_curve(&quadratic, quadratic_iterations, 4, quadratic_digits);
+    TEST_ASSERT_EQUAL_INT(1, predictor_fit_convergence(&quadratic, &model, &a, &b));
+    TEST_ASSERT_EQUAL_INT(CONVERGENCE_QUADRATIC, model);
+}
+
+// ============= Prediction Tests =============
+
+void test_predictor_jumps_to_time_budget(void) {
+    // Logarithmic convergence never reaches 18 digits in budget: spend it all
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    long long iterations[] = {1000, 10000};
+    observe_curve(&predictor, iterations, 2, logarithmic_digits);
+    long long next = predictor_next_iterations(&predictor, 10000, 0.5, 18);
+    TEST_ASSERT_TRUE(llabs(next - (long long)(0.5 * PREDICTOR_BUDGET_FRACTION / 1e-6)) <= 1000);
+}
+
+void test_predictor_stops_at_saturation(void) {
+    // Linear convergence reaches 30 digits at n = 300, well inside the budget
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    long long iterations[] = {100, 150, 200};
+    for (int i = 0; i < 3; i++) {
+        predictor_observe(&predictor, iterations[i], iterations[i] * 1e-5, linear_digits(iterations[i]));
+    }
+    long long next = predictor_next_iterations(&predictor, 200, 10.0, 30);
+    TEST_ASSERT_TRUE(llabs(next - 300) <= 1);
+}
+
+void test_predictor_caps_growth(void) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    long long iterations[] = {100, 200};
+    for (int i = 0; i < 2; i++) {
+        predictor_observe(&predictor, iterations[i], iterations[i] * 1e-5, 2);
+    }
+    TEST_ASSERT_EQUAL_INT64(200LL * PREDICTOR_MAX_GROWTH,
+                            predictor_next_iterations(&predictor, 200, 1000.0, 18));
+}
+
+void test_predictor_detects_precision_floor(void) {
+    // Quadratic convergence stuck at 16 digits: more iterations cannot help,
+    // which the predictor trusts once the stall has lasted a few probes
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    predictor_observe(&predictor, 1000, 1e-3, 2);
+    predictor_observe(&predictor, 2000, 2e-3, 4);
+    predictor_observe(&predictor, 3000, 3e-3, 8);
+    predictor_observe(&predictor, 4000, 4e-3, 16);
+    long long n = 4000;
+    for (int stalled = 0; stalled < NO_IMPROVEMENT_THRESHOLD; stalled++) {
+        TEST_ASSERT_TRUE(predictor_next_iterations(&predictor, n, 10.0, 1000) > n);
+        n += 1000;
+        predictor_observe(&predictor, n, n * 1e-6, 16);
+    }
+    TEST_ASSERT_EQUAL_INT64(n, predictor_next_iterations(&predictor, n, 10.0, 1000));
+}
+
+void test_predictor_keeps_recent_probes(void) {
+    IterationPredictor predictor;
+    predictor_init(&predictor);
+    for (int i = 1; i <= PREDICTOR_MAX_PROBES + 5; i++) {
+        predictor_observe(&predictor, i, i * 1e-3, 1);
+    }
+    TEST_ASSERT_EQUAL_INT(PREDICTOR_MAX_PROBES, predictor.probes);
+    TEST_ASSERT_EQUAL_INT64(PREDICTOR_MAX_PROBES + 5, predictor.iterations[PREDICTOR_MAX_PROBES - 1]);
+}
+
+void test_predictor_solves_for_digits(void) {
+    TEST_ASSERT_EQUAL_INT64(1000, predictor_solve_convergence(CONVERGENCE_LOGARITHMIC, 0.0, 1.0, 3));
+    TEST_ASSERT_EQUAL_INT64(3, predictor_solve_convergence(CONVERGENCE_LINEAR, 0.0, 8.0, 17));
+    TEST_ASSERT_EQUAL_INT64(4, predictor_solve_convergence(CONVERGENCE_QUADRATIC, 0.0, 1.0, 16));
+    TEST_ASSERT_EQUAL_INT64(0, predictor_solve_convergence(CONVERGENCE_LINEAR, 0.0, -1.0, 5));
+    TEST_ASSERT_EQUAL_INT64(MAX_ITERATIONS, predictor_solve_convergence(CONVERGENCE_LOGARITHMIC, 0.0, 1.0, 30));
+}
+
+// ============= Optimizer Integration Tests =============
+
+void test_predicted_search_respects_time_limit(void) {
+    PiKernel kernel = {leibniz, NULL, MAX_PRECISION_DIGITS, NULL};
+    PiResult result = optimize_pi_kernel(&kernel, "leibniz", 0.2);
+    TEST_ASSERT_TRUE(result.cpu_time_used <= 0.2L);
+    TEST_ASSERT_GREATER_OR_EQUAL(5, result.correct_digits);
+}
+
+void test_predicted_search_saturates_fast_kernel(void) {
+    PiKernel kernel = {chudnovsky_fast, NULL, MAX_PRECISION_DIGITS, NULL};
+    PiResult result = optimize_pi_kernel(&kernel, "chudnovsky_fast", 1.0);
+    TEST_ASSERT_GREATER_OR_EQUAL(17, result.correct_digits);
+    TEST_ASSERT_TRUE(result.cpu_time_used < 0.1L);
+}
+
+void run_pi_predictor_tests(void) {
+    RUN_TEST(test_predictor_needs_probes);
+    RUN_TEST(test_predictor_ignores_unmeasurable_probes);
+    RUN_TEST(test_predictor_fits_linear_time);
+    RUN_TEST(test_predictor_fits_nlogn_time);
+    RUN_TEST(test_predictor_classifies_convergence);
+    RUN_TEST(test_predictor_jumps_to_time_budget);
+    RUN_TEST(test_predictor_stops_at_saturation);
+    RUN_TEST(test_predictor_caps_growth);
+    RUN_TEST(test_predictor_detects_precision_floor);
+    RUN_TEST(test_predictor_keeps_recent_probes);
+    RUN_TEST(test_predictor_solves_for_digits);
+    RUN_TEST(test_predicted_search_respects_time_limit);
+    RUN_TEST(test_predicted_search_saturates_fast_kernel);
+}
@@ -0,0 +1,10 @@
+#ifndef TEST_PI_PREDICTOR_H
+#define TEST_PI_PREDICTOR_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_predictor.h"
+#include "../src/pi/pi_optimization.h"
+
+void run_pi_predictor_tests(void);
+
+#endif
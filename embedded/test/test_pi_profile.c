@@ -0,0 +1,158 @@
+#include "test_pi_profile.h"
+#include <string.h>
+#include <unistd.h>
+
+static const char *TEST_PROFILE_PATH = "/tmp/test_pi_profiles.bin";
+
+static PiProfile make_profile(const char *algorithm, const char *backend, long long iterations) {
+    PiProfile profile;
+    memset(&profile, 0, sizeof(profile));
+    snprintf(profile.algorithm, sizeof(profile.algorithm), "%s", algorithm);
+    snprintf(profile.backend, sizeof(profile.backend), "%s", backend);
+    profile.time_limit = 1.0;
+    profile.best_iterations = iterations;
+    profile.best_seconds = 0.5;
+    profile.best_digits = 7;
+    profile.probes = 1;
+    profile.iterations[0] = iterations;
+    profile.seconds[0] = 0.5;
+    profile.digits[0] = 7;
+    return profile;
+}
+
+static void open_empty_store(void) {
+    unlink(TEST_PROFILE_PATH);
+    TEST_ASSERT_EQUAL_INT(0, profile_store_open(TEST_PROFILE_PATH));
+}
+
+// ============= Store Tests =============
+
+void test_profile_lookup_without_store(void) {
+    profile_store_close();
+    PiProfile profile;
+    TEST_ASSERT_EQUAL_INT(0, profile_lookup("leibniz", "long_double", &profile));
+    TEST_ASSERT_EQUAL_INT(0, profile_store_count());
+}
+
+void test_profile_record_and_lookup(void) {
+    open_empty_store();
+    PiProfile stored = make_profile("leibniz", "dd", 12345);
+    profile_record(&stored);
+
+    PiProfile loaded;
+    TEST_ASSERT_EQUAL_INT(1, profile_lookup("leibniz", "dd", &loaded));
+    TEST_ASSERT_EQUAL_INT64(12345, loaded.best_iterations);
+    TEST_ASSERT_EQUAL_INT(0, profile_lookup("leibniz", "qd", &loaded));
+    TEST_ASSERT_EQUAL_INT(0, profile_lookup("euler", "dd", &loaded));
+    profile_store_close();
+}
+
+void test_profile_record_replaces_key(void) {
+    open_empty_store();
+    PiProfile first = make_profile("bbp", "long_double", 10);
+    PiProfile second = make_profile("bbp", "long_double", 20);
+    profile_record(&first);
+    profile_record(&second);
+
+    PiProfile loaded;
+    TEST_ASSERT_EQUAL_INT(1, profile_store_count());
+    TEST_ASSERT_EQUAL_INT(1, profile_lookup("bbp", "long_double", &loaded));
+    TEST_ASSERT_EQUAL_INT64(20, loaded.best_iterations);
+    profile_store_close();
+}
+
+void test_profile_persists_across_reopen(void) {
+    open_empty_store();
+    PiProfile stored = make_profile("euler", "float128", 777);
+    profile_record(&stored);
+    profile_store_close();
+
+    TEST_ASSERT_EQUAL_INT(1, profile_store_open(TEST_PROFILE_PATH));
+    PiProfile loaded;
+    TEST_ASSERT_EQUAL_INT(1, profile_lookup("euler", "float128", &loaded));
+    TEST_ASSERT_EQUAL_INT64(777, loaded.best_iterations);
+    profile_store_close();
+}
+
+void test_profile_evicts_stalest_when_full(void) {
+    open_empty_store();
+    char name[PROFILE_NAME_LENGTH];
+    for (int i = 0; i < PROFILE_MAX_ENTRIES + 1; i++) {
+        snprintf(name, sizeof(name), "kernel%d", i);
+        PiProfile profile = make_profile(name, "long_double", i + 1);
+        profile_record(&profile);
+    }
+    PiProfile loaded;
+    TEST_ASSERT_EQUAL_INT(PROFILE_MAX_ENTRIES, profile_store_count());
+    TEST_ASSERT_EQUAL_INT(0, profile_lookup("kernel0", "long_double", &loaded));
+    snprintf(name, sizeof(name), "kernel%d", PROFILE_MAX_ENTRIES);
+    TEST_ASSERT_EQUAL_INT(1, profile_lookup(name, "long_double", &loaded));
+    profile_store_close();
+}
+
+void test_profile_discards_foreign_file(void) {
+    FILE *file = fopen(TEST_PROFILE_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    fputs("not a profile file", file);
+    fclose(file);
+    TEST_ASSERT_EQUAL_INT(0, profile_store_open(TEST_PROFILE_PATH));
+    profile_store_close();
+}
+
+void test_profile_open_fails_gracefully(void) {
+    TEST_ASSERT_EQUAL_INT(-1, profile_store_open("/nonexistent/dir/profiles.bin"));
+    TEST_ASSERT_EQUAL_INT(0, profile_store_count());
+}
+
+// ============= Warm Start Tests =============
+
+void test_optimizer_records_profile(void) {
+    open_empty_store();
+    optimize_pi_precision(nilakantha, "nilakantha", 0.2);
+    PiProfile loaded;
+    TEST_ASSERT_EQUAL_INT(1, profile_lookup("nilakantha", "long_double", &loaded));
+    TEST_ASSERT_TRUE(loaded.best_digits > 0);
+    TEST_ASSERT_TRUE(loaded.probes > 0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.2, loaded.time_limit);
+    profile_store_close();
+}
+
+void test_warm_start_reuses_optimum(void) {
+    open_empty_store();
+    PiResult cold = optimize_pi_precision(nilakantha, "nilakantha", 0.2);
+    PiResult warm = optimize_pi_precision(nilakantha, "nilakantha", 0.2);
+    // The deterministic optimum is found again, for far less work
+    TEST_ASSERT_GREATER_OR_EQUAL(cold.correct_digits - 1, warm.correct_digits);
+    TEST_ASSERT_TRUE(warm.iterations <= cold.iterations);
+    TEST_ASSERT_TRUE(warm.iterations * 2 >= cold.iterations);
+    profile_store_close();
+}
+
+void test_warm_start_rejects_stale_profile(void) {
+    open_empty_store();
+    // Claims more digits than the kernel can deliver at that count
+    PiProfile stale = make_profile("chudnovsky_fast", "long_double", 1);
+    stale.time_limit = 0.2;
+    stale.best_digits = 18;
+    stale.best_seconds = 0.0;
+    profile_record(&stale);
+
+    PiResult result = optimize_pi_precision(chudnovsky_fast, "chudnovsky_fast", 0.2);
+    TEST_ASSERT_GREATER_OR_EQUAL(17, result.correct_digits);
+    TEST_ASSERT_TRUE(result.iterations > 1);
+    profile_store_close();
+}
+
+void run_pi_profile_tests(void) {
+    RUN_TEST(test_profile_lookup_without_store);
+    RUN_TEST(test_profile_record_and_lookup);
+    RUN_TEST(test_profile_record_replaces_key);
+    RUN_TEST(test_profile_persists_across_reopen);
+    RUN_TEST(test_profile_evicts_stalest_when_full);
+    RUN_TEST(test_profile_discards_foreign_file);
+    RUN_TEST(test_profile_open_fails_gracefully);
+    RUN_TEST(test_optimizer_records_profile);
+    RUN_TEST(test_warm_start_reuses_optimum);
+    RUN_TEST(test_warm_start_rejects_stale_profile);
+    unlink(TEST_PROFILE_PATH);
+}
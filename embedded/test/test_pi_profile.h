@@ -0,0 +1,10 @@
+#ifndef TEST_PI_PROFILE_H
+#define TEST_PI_PROFILE_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_profile.h"
+#include "../src/pi/pi_optimization.h"
+
+void run_pi_profile_tests(void);
+
+#endif
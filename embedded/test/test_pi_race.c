@@ -0,0 +1,117 @@
+#include "test_pi_race.h"
+#include <string.h>
+
+static RaceEntrant entrant(const char *name, CalculatePi func) {
+    PiKernel kernel = {func, NULL, MAX_PRECISION_DIGITS, pi_incremental_for(func), "long_double",
+                       machin_counted_for(func)};
+    RaceEntrant race_entrant = {name, kernel};
+    return race_entrant;
+}
+
+typedef struct {
+    const char *names[RACE_MAX_ENTRANTS];
+    int places[RACE_MAX_ENTRANTS];
+    int count;
+    int stop_after;  // 0: keep listening
+} RaceLog;
+
+static int log_runner(const RaceRunner *runner, void *context) {
+    RaceLog *log = (RaceLog *)context;
+    log->names[log->count] = runner->name;
+    log->places[log->count] = runner->place;
+    log->count++;
+    return log->stop_after == 0 || log->count < log->stop_after;
+}
+
+// ============= Race Tests =============
+
+void test_race_ranks_finishers(void) {
+    RaceEntrant entrants[3] = {
+        entrant("leibniz", leibniz),
+        entrant("gauss_legendre", gauss_legendre),
+        entrant("chudnovsky_fast", chudnovsky_fast)
+    };
+    RaceRunner runners[3];
+    RaceLog log;
+    memset(&log, 0, sizeof(log));
+    TEST_ASSERT_EQUAL_INT(2, race_run(entrants, 3, 12, 0.5, log_runner, &log, runners));
+
+    // Everyone is reported once, finishers in place order, leibniz last
+    TEST_ASSERT_EQUAL_INT(3, log.count);
+    TEST_ASSERT_EQUAL_INT(1, log.places[0]);
+    TEST_ASSERT_EQUAL_INT(2, log.places[1]);
+    TEST_ASSERT_EQUAL_STRING("leibniz", log.names[2]);
+    TEST_ASSERT_EQUAL_INT(0, log.places[2]);
+    TEST_ASSERT_EQUAL_INT(RACE_CANCELLED, runners[0].status);
+    TEST_ASSERT_TRUE(runners[0].digits < 12);
+    for (int i = 1; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(RACE_FINISHED, runners[i].status);
+        TEST_ASSERT_TRUE(runners[i].digits >= 12);
+        TEST_ASSERT_TRUE(runners[i].iterations > 0);
+        TEST_ASSERT_TRUE(runners[i].elapsed_seconds <= runners[0].elapsed_seconds);
+    }
+}
+
+void test_race_saturation_ends_early(void) {
+    // Long double runs out of digits well before 25; nobody waits for the deadline
+    RaceEntrant entrants[2] = {
+        entrant("chudnovsky_fast", chudnovsky_fast),
+        entrant("bbp", bbp)
+    };
+    RaceRunner runners[2];
+    TEST_ASSERT_EQUAL_INT(0, race_run(entrants, 2, 25, 10.0, NULL, NULL, runners));
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT(RACE_SATURATED, runners[i].status);
+        TEST_ASSERT_TRUE(runners[i].digits >= 15);
+        TEST_ASSERT_TRUE(runners[i].elapsed_seconds < 5.0);
+    }
+}
+
+void test_race_rerun_kernel_finishes(void) {
+    // machin has no incremental form: it is re-run at doubling counts
+    RaceEntrant entrants[1] = {entrant("machin", machin)};
+    RaceRunner runners[1];
+    TEST_ASSERT_EQUAL_INT(1, race_run(entrants, 1, 12, 2.0, NULL, NULL, runners));
+    TEST_ASSERT_EQUAL_INT(RACE_FINISHED, runners[0].status);
+    TEST_ASSERT_EQUAL_INT(1, runners[0].place);
+    TEST_ASSERT_TRUE(runners[0].digits >= 12);
+}
+
+void test_race_sink_can_stop(void) {
+    RaceEntrant entrants[3] = {
+        entrant("chudnovsky_fast", chudnovsky_fast),
+        entrant("leibniz", leibniz),
+        entrant("monte_carlo", monte_carlo)
+    };
+    RaceRunner runners[3];
+    RaceLog log;
+    memset(&log, 0, sizeof(log));
+    log.stop_after = 1;
+    race_run(entrants, 3, 12, 30.0, log_runner, &log, runners);
+
+    // Only the first leaver is heard; the rest are called off at once
+    TEST_ASSERT_EQUAL_INT(1, log.count);
+    TEST_ASSERT_EQUAL_STRING("chudnovsky_fast", log.names[0]);
+    TEST_ASSERT_EQUAL_INT(RACE_CANCELLED, runners[1].status);
+    TEST_ASSERT_EQUAL_INT(RACE_CANCELLED, runners[2].status);
+    TEST_ASSERT_TRUE(runners[2].elapsed_seconds < 5.0);
+}
+
+void test_race_rejects_bad_input(void) {
+    RaceEntrant entrants[1] = {entrant("leibniz", leibniz)};
+    RaceRunner runners[1];
+    TEST_ASSERT_EQUAL_INT(-1, race_run(entrants, 0, 12, 1.0, NULL, NULL, runners));
+    TEST_ASSERT_EQUAL_INT(-1, race_run(entrants, RACE_MAX_ENTRANTS + 1, 12, 1.0, NULL, NULL, runners));
+    TEST_ASSERT_EQUAL_INT(-1, race_run(entrants, 1, 0, 1.0, NULL, NULL, runners));
+    TEST_ASSERT_EQUAL_INT(-1, race_run(entrants, 1, MAX_PRECISION_DIGITS + 1, 1.0, NULL, NULL, runners));
+    TEST_ASSERT_EQUAL_INT(-1, race_run(entrants, 1, 12, 0.0, NULL, NULL, runners));
+    TEST_ASSERT_EQUAL_STRING("saturated", race_status_name(RACE_SATURATED));
+}
+
+void run_pi_race_tests(void) {
+    RUN_TEST(test_race_ranks_finishers);
+    RUN_TEST(test_race_saturation_ends_early);
+    RUN_TEST(test_race_rerun_kernel_finishes);
+    RUN_TEST(test_race_sink_can_stop);
+    RUN_TEST(test_race_rejects_bad_input);
+}
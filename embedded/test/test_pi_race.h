@@ -0,0 +1,11 @@
+#ifndef TEST_PI_RACE_H
+#define TEST_PI_RACE_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_race.h"
+#include "../src/pi/pi_calculations.h"
+#include "../src/pi/pi_machin.h"
+
+void run_pi_race_tests(void);
+
+#endif
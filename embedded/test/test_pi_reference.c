@@ -0,0 +1,111 @@
+#include "test_pi_reference.h"
+#include <string.h>
+#include <unistd.h>
+
+static const char *TEST_REFERENCE_PATH = "/tmp/test_pi_reference.bin";
+
+static void open_fresh_store(long long digits) {
+    unlink(TEST_REFERENCE_PATH);
+    TEST_ASSERT_EQUAL_INT(digits, (int)reference_store_open(TEST_REFERENCE_PATH, digits));
+}
+
+// ============= Store Tests =============
+
+void test_reference_without_store(void) {
+    reference_store_close();
+    long long checked = 1;
+    TEST_ASSERT_EQUAL_INT(-1, (int)reference_check_decimal("3.14", &checked));
+    TEST_ASSERT_EQUAL_INT(0, (int)checked);
+    TEST_ASSERT_EQUAL_INT(0, (int)reference_decimal_digits());
+    TEST_ASSERT_NULL(reference_hex());
+}
+
+void test_reference_generates_decimal_and_hex(void) {
+    open_fresh_store(5000);
+    char *pi = chudnovsky_bs_digits(5000);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pi + 2, reference_decimal(), 5000));
+    free(pi);
+
+    // Hex digits agree with BBP extraction at both ends
+    long long hex_digits = reference_hex_digits();
+    TEST_ASSERT_TRUE(hex_digits > 3900);
+    char *head = bbp_hex_digits(0, 16);
+    char *tail = bbp_hex_digits(hex_digits - 16, 16);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(head, reference_hex(), 16));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(tail, reference_hex() + hex_digits - 16, 16));
+    free(head);
+    free(tail);
+    reference_store_close();
+}
+
+void test_reference_reopens_and_regenerates(void) {
+    open_fresh_store(1000);
+    reference_store_close();
+    // Enough digits already: mapped as is
+    TEST_ASSERT_EQUAL_INT(1000, (int)reference_store_open(TEST_REFERENCE_PATH, 500));
+    reference_store_close();
+    // Too few: regenerated at the requested size
+    TEST_ASSERT_EQUAL_INT(2000, (int)reference_store_open(TEST_REFERENCE_PATH, 2000));
+    reference_store_close();
+
+    // Damaged: regenerated
+    TEST_ASSERT_EQUAL_INT(0, truncate(TEST_REFERENCE_PATH, 100));
+    TEST_ASSERT_EQUAL_INT(2000, (int)reference_store_open(TEST_REFERENCE_PATH, 2000));
+    TEST_ASSERT_EQUAL_INT(-1, (int)reference_store_open(TEST_REFERENCE_PATH, 0));
+}
+
+// ============= Checker Tests =============
+
+void test_reference_check_finds_first_mismatch(void) {
+    open_fresh_store(3000);
+    char *pi = chudnovsky_bs_digits(3000);
+    long long checked = 0;
+    TEST_ASSERT_EQUAL_INT(3000, (int)reference_check_decimal(pi, &checked));
+    TEST_ASSERT_EQUAL_INT(3000, (int)checked);
+
+    pi[2 + 1234] = pi[2 + 1234] == '0' ? '1' : '0';
+    TEST_ASSERT_EQUAL_INT(1234, (int)reference_check_decimal(pi, &checked));
+    free(pi);
+
+    // Longer than the reference: only the covered part is checked
+    char *longer = chudnovsky_bs_digits(3500);
+    TEST_ASSERT_EQUAL_INT(3000, (int)reference_check_decimal(longer, &checked));
+    TEST_ASSERT_EQUAL_INT(3000, (int)checked);
+    free(longer);
+
+    TEST_ASSERT_EQUAL_INT(0, (int)reference_check_decimal("3", &checked));
+    TEST_ASSERT_EQUAL_INT(-1, (int)reference_check_decimal("2.718", &checked));
+
+    char *hex = bbp_hex_digits(1000, 32);
+    TEST_ASSERT_EQUAL_INT(32, (int)reference_check_hex(1000, hex, &checked));
+    TEST_ASSERT_TRUE(reference_check_hex(1001, hex, &checked) < 32);
+    TEST_ASSERT_EQUAL_INT(0, (int)reference_check_hex(1 << 20, hex, &checked));
+    free(hex);
+    reference_store_close();
+}
+
+void test_reference_mismatch_every_level(void) {
+    char a[300], b[300];
+    for (int i = 0; i < 300; i++) a[i] = b[i] = (char)('0' + i % 10);
+    CpuLevel detected = cpu_detected_level();
+    for (int level = 0; level < CPU_LEVEL_COUNT; level++) {
+        if (!cpu_level_override((CpuLevel)level)) continue;
+        TEST_ASSERT_EQUAL_INT(300, (int)reference_mismatch(a, b, 300));
+        int positions[] = {0, 7, 8, 15, 31, 63, 64, 130, 299};
+        for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+            b[positions[p]] = 'x';
+            TEST_ASSERT_EQUAL_INT(positions[p], (int)reference_mismatch(a, b, 300));
+            TEST_ASSERT_EQUAL_INT(positions[p], (int)reference_mismatch(a, b, (size_t)positions[p] + 1));
+            b[positions[p]] = a[positions[p]];
+        }
+    }
+    cpu_level_override(detected);
+}
+
+void run_pi_reference_tests(void) {
+    RUN_TEST(test_reference_without_store);
+    RUN_TEST(test_reference_generates_decimal_and_hex);
+    RUN_TEST(test_reference_reopens_and_regenerates);
+    RUN_TEST(test_reference_check_finds_first_mismatch);
+    RUN_TEST(test_reference_mismatch_every_level);
+}
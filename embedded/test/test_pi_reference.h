@@ -0,0 +1,12 @@
+#ifndef TEST_PI_REFERENCE_H
+#define TEST_PI_REFERENCE_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_reference.h"
+#include "../src/pi/pi_multiprecision.h"
+#include "../src/pi/pi_bbp.h"
+#include "../src/cpu/cpu_features.h"
+
+void run_pi_reference_tests(void);
+
+#endif
@@ -0,0 +1,91 @@
+#include "test_pi_spigot.h"
+
+typedef struct {
+    int chunks;
+    size_t largest;
+    size_t total;
+    int stop_after;  // chunks to accept before stopping, 0 for no limit
+} ChunkCounter;
+
+static int count_chunks(const char *text, size_t length, void *context) {
+    (void)text;
+    ChunkCounter *counter = (ChunkCounter *)context;
+    counter->chunks++;
+    counter->total += length;
+    if (length > counter->largest) counter->largest = length;
+    return counter->stop_after == 0 || counter->chunks < counter->stop_after;
+}
+
+// ============= Digit Tests =============
+
+void test_spigot_variants_match_chudnovsky(void) {
+    char *reference = chudnovsky_bs_digits(3000);
+    for (int i = 0; i < SPIGOT_COUNT; i++) {
+        char *digits = spigot_digits((SpigotVariant)i, 3000);
+        TEST_ASSERT_NOT_NULL(digits);
+        TEST_ASSERT_EQUAL_STRING(reference, digits);
+        free(digits);
+    }
+    free(reference);
+}
+
+void test_spigot_small_and_invalid(void) {
+    char *digits = spigot_digits(SPIGOT_GIBBONS, 0);
+    TEST_ASSERT_EQUAL_STRING("3", digits);
+    free(digits);
+    digits = spigot_digits(SPIGOT_RABINOWITZ_WAGON, 1);
+    TEST_ASSERT_EQUAL_STRING("3.1", digits);
+    free(digits);
+    TEST_ASSERT_NULL(spigot_digits(SPIGOT_GIBBONS, -1));
+    TEST_ASSERT_NULL(spigot_digits(SPIGOT_RABINOWITZ_WAGON, SPIGOT_MAX_DIGITS + 1));
+    TEST_ASSERT_NULL(spigot_digits(SPIGOT_COUNT, 10));
+}
+
+// ============= Streaming Tests =============
+
+void test_spigot_streams_bounded_chunks(void) {
+    ChunkCounter counter = {0, 0, 0, 0};
+    SpigotStats stats;
+    TEST_ASSERT_EQUAL_INT(0, spigot_stream(SPIGOT_GIBBONS, 3000, count_chunks, &counter, &stats));
+    TEST_ASSERT_TRUE(counter.chunks >= 3);
+    TEST_ASSERT_TRUE(counter.largest <= SPIGOT_CHUNK_DIGITS + 1);
+    TEST_ASSERT_EQUAL_INT(3002, (int)counter.total);
+    TEST_ASSERT_EQUAL_INT(3000, (int)stats.digits);
+    TEST_ASSERT_TRUE(stats.memory_bytes > 0);
+}
+
+void test_spigot_sink_can_stop(void) {
+    for (int i = 0; i < SPIGOT_COUNT; i++) {
+        ChunkCounter counter = {0, 0, 0, 1};
+        SpigotStats stats;
+        TEST_ASSERT_EQUAL_INT(-1, spigot_stream((SpigotVariant)i, 5000, count_chunks, &counter, &stats));
+        TEST_ASSERT_EQUAL_INT(1, counter.chunks);
+        TEST_ASSERT_TRUE(stats.digits < 5000);
+    }
+}
+
+// ============= Benchmark Tests =============
+
+void test_spigot_names_and_last_run(void) {
+    SpigotVariant variant;
+    for (int i = 0; i < SPIGOT_COUNT; i++) {
+        TEST_ASSERT_TRUE(spigot_variant_from_name(spigot_variant_name((SpigotVariant)i), &variant));
+        TEST_ASSERT_EQUAL_INT(i, variant);
+    }
+    TEST_ASSERT_FALSE(spigot_variant_from_name("plouffe", &variant));
+
+    char *digits = spigot_digits(SPIGOT_RABINOWITZ_WAGON, 500);
+    free(digits);
+    SpigotStats stats;
+    TEST_ASSERT_TRUE(spigot_last_run(SPIGOT_RABINOWITZ_WAGON, &stats));
+    TEST_ASSERT_EQUAL_INT(500, (int)stats.digits);
+    TEST_ASSERT_TRUE(stats.time_seconds >= 0.0);
+}
+
+void run_pi_spigot_tests(void) {
+    RUN_TEST(test_spigot_variants_match_chudnovsky);
+    RUN_TEST(test_spigot_small_and_invalid);
+    RUN_TEST(test_spigot_streams_bounded_chunks);
+    RUN_TEST(test_spigot_sink_can_stop);
+    RUN_TEST(test_spigot_names_and_last_run);
+}
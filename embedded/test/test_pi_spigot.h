@@ -0,0 +1,10 @@
+#ifndef TEST_PI_SPIGOT_H
+#define TEST_PI_SPIGOT_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/pi/pi_spigot.h"
+#include "../src/pi/pi_multiprecision.h"
+
+void run_pi_spigot_tests(void);
+
+#endif
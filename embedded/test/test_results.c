@@ -0,0 +1,160 @@
+#include "test_results.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char *TEST_RESULTS_DIRECTORY = "/tmp/test_pi_results";
+
+static char *read_fd(int fd, size_t size) {
+    char *data = (char *)malloc(size + 1);
+    size_t done = 0;
+    while (done < size) {
+        ssize_t got = read(fd, data + done, size - done);
+        if (got <= 0) break;
+        done += (size_t)got;
+    }
+    data[done] = '\0';
+    close(fd);
+    return data;
+}
+
+static uint32_t le32(const unsigned char *bytes) {
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+// ============= Gzip Tests =============
+
+void test_gzip_crc32_check_value(void) {
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926u, gzip_crc32(0, "123456789", 9));
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926u, gzip_crc32(gzip_crc32(0, "1234", 4), "56789", 5));
+    TEST_ASSERT_EQUAL_HEX32(0, gzip_crc32(0, "", 0));
+}
+
+void test_gzip_member_layout(void) {
+    const char *path = "/tmp/test_pi_results.gz";
+    char digits[20001];
+    for (int i = 0; i < 20000; i++) digits[i] = (char)('0' + (i * 7 + i / 13) % 10);
+    digits[20000] = '\0';
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    TEST_ASSERT_EQUAL_INT(0, gzip_write(fd, digits, 20000));
+    close(fd);
+
+    struct stat info;
+    TEST_ASSERT_EQUAL_INT(0, stat(path, &info));
+    size_t size = (size_t)info.st_size;
+    unsigned char *bytes = (unsigned char *)read_fd(open(path, O_RDONLY), size);
+    TEST_ASSERT_EQUAL_INT(0x1F, bytes[0]);
+    TEST_ASSERT_EQUAL_INT(0x8B, bytes[1]);
+    TEST_ASSERT_EQUAL_INT(8, bytes[2]);
+    // Final dynamic-Huffman block
+    TEST_ASSERT_EQUAL_INT(5, bytes[10] & 7);
+    TEST_ASSERT_EQUAL_HEX32(gzip_crc32(0, digits, 20000), le32(bytes + size - 8));
+    TEST_ASSERT_EQUAL_UINT32(20000, le32(bytes + size - 4));
+    // Ten symbols: about 3.4 bits each
+    TEST_ASSERT_TRUE(size < 20000 / 2);
+    free(bytes);
+    unlink(path);
+}
+
+// ============= Store Tests =============
+
+void test_results_id_validation(void) {
+    TEST_ASSERT_TRUE(results_id_valid("0123456789abcdef"));
+    TEST_ASSERT_FALSE(results_id_valid("0123456789ABCDEF"));
+    TEST_ASSERT_FALSE(results_id_valid("../../etc/passwd"));
+    TEST_ASSERT_FALSE(results_id_valid("0123456789abcde"));
+    TEST_ASSERT_FALSE(results_id_valid(NULL));
+}
+
+void test_results_save_and_open(void) {
+    TEST_ASSERT_EQUAL_INT(0, results_store_open(TEST_RESULTS_DIRECTORY));
+    TEST_ASSERT_TRUE(results_store_available());
+    char id[RESULTS_ID_LENGTH];
+    const char *text = "3.14159265358979323846";
+    TEST_ASSERT_EQUAL_INT(0, results_store_save(text, strlen(text), id));
+    TEST_ASSERT_TRUE(results_id_valid(id));
+
+    size_t size = 0;
+    int fd = results_store_open_file(id, 0, &size);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT((int)strlen(text), (int)size);
+    char *stored = read_fd(fd, size);
+    TEST_ASSERT_EQUAL_STRING(text, stored);
+    free(stored);
+    fd = results_store_open_file(id, 1, &size);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    TEST_ASSERT_EQUAL_INT(-1, results_store_open_file("ffffffffffffffff", 0, &size));
+    TEST_ASSERT_EQUAL_INT(-1, results_store_open_file("../secret", 0, &size));
+    results_store_close();
+    TEST_ASSERT_FALSE(results_store_available());
+    TEST_ASSERT_EQUAL_INT(-1, results_store_save(text, strlen(text), id));
+}
+
+void test_results_keep_newest(void) {
+    TEST_ASSERT_EQUAL_INT(0, results_store_open(TEST_RESULTS_DIRECTORY));
+    char first[RESULTS_ID_LENGTH], id[RESULTS_ID_LENGTH];
+    TEST_ASSERT_EQUAL_INT(0, results_store_save("3.1", 3, first));
+    for (int i = 0; i < RESULTS_MAX_FILES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, results_store_save("3.14", 4, id));
+    }
+    size_t size;
+    TEST_ASSERT_EQUAL_INT(-1, results_store_open_file(first, 0, &size));
+    int fd = results_store_open_file(id, 0, &size);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+    results_store_close();
+}
+
+void test_results_keep_newest_across_runs(void) {
+    TEST_ASSERT_EQUAL_INT(0, results_store_open(TEST_RESULTS_DIRECTORY));
+    char earlier[RESULTS_ID_LENGTH], id[RESULTS_ID_LENGTH];
+    TEST_ASSERT_EQUAL_INT(0, results_store_save("3.1", 3, earlier));
+    results_store_close();
+
+    // Reopening starts with no memory of `earlier`, as a restart would
+    TEST_ASSERT_EQUAL_INT(0, results_store_open(TEST_RESULTS_DIRECTORY));
+    for (int i = 0; i < RESULTS_MAX_FILES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, results_store_save("3.14", 4, id));
+    }
+    size_t size;
+    TEST_ASSERT_EQUAL_INT(-1, results_store_open_file(earlier, 0, &size));
+    TEST_ASSERT_EQUAL_INT(-1, results_store_open_file(earlier, 1, &size));
+    results_store_close();
+}
+
+// ============= Range Tests =============
+
+void test_results_parse_range(void) {
+    size_t first = 0, last = 0;
+    TEST_ASSERT_EQUAL_INT(1, results_parse_range("bytes=0-99", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(0, (int)first);
+    TEST_ASSERT_EQUAL_INT(99, (int)last);
+    TEST_ASSERT_EQUAL_INT(1, results_parse_range("bytes=900-", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(999, (int)last);
+    TEST_ASSERT_EQUAL_INT(1, results_parse_range("bytes=-10", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(990, (int)first);
+    TEST_ASSERT_EQUAL_INT(1, results_parse_range("bytes=500-5000", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(999, (int)last);
+    TEST_ASSERT_EQUAL_INT(1, results_parse_range("bytes=-5000", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(0, (int)first);
+
+    TEST_ASSERT_EQUAL_INT(0, results_parse_range("bytes=1000-", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(0, results_parse_range("bytes=-0", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(-1, results_parse_range("bytes=0-1,5-6", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(-1, results_parse_range("bytes=9-1", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(-1, results_parse_range("bytes=-", 1000, &first, &last));
+    TEST_ASSERT_EQUAL_INT(-1, results_parse_range("items=0-1", 1000, &first, &last));
+}
+
+void run_results_tests(void) {
+    RUN_TEST(test_gzip_crc32_check_value);
+    RUN_TEST(test_gzip_member_layout);
+    RUN_TEST(test_results_id_validation);
+    RUN_TEST(test_results_save_and_open);
+    RUN_TEST(test_results_keep_newest);
+    RUN_TEST(test_results_keep_newest_across_runs);
+    RUN_TEST(test_results_parse_range);
+}
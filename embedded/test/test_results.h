@@ -0,0 +1,10 @@
+#ifndef TEST_RESULTS_H
+#define TEST_RESULTS_H
+
+#include "../libs/Unity/src/unity.h"
+#include "../src/server/results.h"
+#include "../src/server/gzip.h"
+
+void run_results_tests(void);
+
+#endif
@@ -449,6 +449,72 @@ void test_algorithm_table_completeness(void) {
     TEST_ASSERT_EQUAL(12, expected_count);
 }
 
+// ============= Spigot Stream Tests =============
+
+void test_spigot_stream_runs_off_the_accept_loop(void) {
+    int fds[2];
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    server_handle_spigot_stream(fds[0], "digits=3000&variant=gibbons");
+    close(fds[0]);  // as server_handle_client does; the stream has its own copy
+
+    static char response[16384];
+    size_t used = 0;
+    ssize_t n;
+    while ((n = read(fds[1], response + used, sizeof(response) - 1 - used)) > 0) used += (size_t)n;
+    response[used] = '\0';
+    close(fds[1]);
+
+    TEST_ASSERT_TRUE(contains_substring(response, "HTTP/1.1 200 OK"));
+    TEST_ASSERT_TRUE(contains_substring(response, "3.14159265358979323846"));
+    TEST_ASSERT_TRUE(contains_substring(response, "\"memory_bytes\""));
+    TEST_ASSERT_TRUE(contains_substring(response, "\r\n0\r\n\r\n"));
+}
+
+// ============= BBP Hex Tests =============
+
+void test_bbp_hex_rejects_work_over_budget(void) {
+    int fds[2];
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    server_handle_bbp_hex(fds[0], "position=10000000&count=64");
+    close(fds[0]);
+
+    char response[2048];
+    size_t used = 0;
+    ssize_t n;
+    while ((n = read(fds[1], response + used, sizeof(response) - 1 - used)) > 0) used += (size_t)n;
+    response[used] = '\0';
+    close(fds[1]);
+
+    TEST_ASSERT_TRUE(contains_substring(response, "HTTP/1.1 400"));
+    TEST_ASSERT_TRUE(contains_substring(response, "must be at most"));
+}
+
+// ============= Result Download Tests =============
+
+void test_result_download_runs_off_the_accept_loop(void) {
+    TEST_ASSERT_EQUAL_INT(0, results_store_open("/tmp/test_pi_server_results"));
+    char id[RESULTS_ID_LENGTH];
+    const char *text = "3.14159265358979323846";
+    TEST_ASSERT_EQUAL_INT(0, results_store_save(text, strlen(text), id));
+
+    int fds[2];
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    server_handle_result_download(fds[0], "GET /api/results/x/digits HTTP/1.1\r\nRange: bytes=0-3\r\n\r\n", id);
+    close(fds[0]);  // the download has its own copy
+
+    char response[2048];
+    size_t used = 0;
+    ssize_t n;
+    while ((n = read(fds[1], response + used, sizeof(response) - 1 - used)) > 0) used += (size_t)n;
+    response[used] = '\0';
+    close(fds[1]);
+    results_store_close();
+
+    TEST_ASSERT_TRUE(contains_substring(response, "HTTP/1.1 206 Partial Content"));
+    TEST_ASSERT_TRUE(contains_substring(response, "\r\n\r\n3.14"));
+    TEST_ASSERT_FALSE(contains_substring(response, "3.141"));
+}
+
 // ============= Public Function to Run All Tests =============
 
 void run_server_tests(void) {
@@ -509,4 +575,7 @@ void run_server_tests(void) {
     // Integration tests
     RUN_TEST(test_full_json_response_structure);
     RUN_TEST(test_algorithm_table_completeness);
+    RUN_TEST(test_spigot_stream_runs_off_the_accept_loop);
+    RUN_TEST(test_bbp_hex_rejects_work_over_budget);
+    RUN_TEST(test_result_download_runs_off_the_accept_loop);
 }
\ No newline at end of file